@@ -0,0 +1,188 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/flat_set.hpp>
+#include <nestl/set.hpp>
+#include <nestl/vector.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+/// every lookup measurement performs the same number of lookups, so different sizes are comparable
+const size_t LookupCount = 4 * 1024 * 1024;
+
+
+/// keys are spread over whole range in scrambled order, odd values are never inserted
+uint32_t key_at(size_t index)
+{
+    return (static_cast<uint32_t>(index) * 2654435761u) & ~1u;
+}
+
+void make_keys(nestl::vector<uint32_t>& keys, size_t count)
+{
+    nestl::default_operation_error err;
+
+    keys.reserve_nothrow(err, count);
+    if (err)
+    {
+        std::abort();
+    }
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        keys.push_back_nothrow(err, key_at(i));
+        if (err)
+        {
+            std::abort();
+        }
+    }
+}
+
+
+void build_set(nestl::set<uint32_t>& s, const nestl::vector<uint32_t>& keys)
+{
+    nestl::default_operation_error err;
+    for (uint32_t key : keys)
+    {
+        s.insert_nothrow(err, key);
+        if (err)
+        {
+            std::abort();
+        }
+    }
+}
+
+void build_flat_set(nestl::flat_set<uint32_t>& s, const nestl::vector<uint32_t>& keys)
+{
+    nestl::default_operation_error err;
+    s.insert_nothrow(err, keys.begin(), keys.end());
+    if (err)
+    {
+        std::abort();
+    }
+}
+
+
+/// half of probes are present keys, the other half are absent neighbours
+template <typename Set>
+void lookup(const Set& s, size_t count)
+{
+    size_t found = 0;
+    for (size_t i = 0; i != LookupCount; ++i)
+    {
+        const uint32_t key = key_at((i * 7) % count) | static_cast<uint32_t>(i & 1);
+        if (s.find(key) != s.end())
+        {
+            ++found;
+        }
+    }
+
+    do_not_optimize(found);
+}
+
+
+void run_lookup(size_t count, const char* setName, const char* flatSetName)
+{
+    nestl::vector<uint32_t> keys;
+    make_keys(keys, count);
+
+    nestl::set<uint32_t> s;
+    build_set(s, keys);
+
+    nestl::flat_set<uint32_t> fs;
+    build_flat_set(fs, keys);
+
+    measure(setName, [&s, count]() { lookup(s, count); });
+    measure(flatSetName, [&fs, count]() { lookup(fs, count); });
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(flat_set_benchmark)
+{
+    run_lookup(1024,
+               "nestl::set<uint32_t> find, 1K elements",
+               "nestl::flat_set<uint32_t> find, 1K elements");
+
+    run_lookup(1024 * 1024,
+               "nestl::set<uint32_t> find, 1M elements",
+               "nestl::flat_set<uint32_t> find, 1M elements");
+
+    nestl::vector<uint32_t> keys;
+    make_keys(keys, 1024 * 1024);
+
+    measure("nestl::set<uint32_t> insert_nothrow one by one, 1M elements", [&keys]()
+    {
+        nestl::set<uint32_t> s;
+        build_set(s, keys);
+        do_not_optimize(s);
+    });
+
+    measure("nestl::flat_set<uint32_t> bulk insert_nothrow, 1M elements", [&keys]()
+    {
+        nestl::flat_set<uint32_t> s;
+        build_flat_set(s, keys);
+        do_not_optimize(s);
+    });
+
+    measure("nestl::flat_set<uint32_t> bulk insert_nothrow into 1M elements", [&keys]()
+    {
+        nestl::flat_set<uint32_t> s;
+        build_flat_set(s, keys);
+
+        // every second key is new
+        nestl::default_operation_error err;
+        nestl::vector<uint32_t> more;
+        more.reserve_nothrow(err, keys.size());
+        for (uint32_t key : keys)
+        {
+            more.push_back_nothrow(err, key | 1u);
+        }
+        if (err)
+        {
+            std::abort();
+        }
+        s.insert_nothrow(err, more.begin(), more.end());
+        if (err)
+        {
+            std::abort();
+        }
+        do_not_optimize(s);
+    });
+
+    nestl::vector<uint32_t> sortedKeys;
+    make_keys(sortedKeys, 1024 * 1024);
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+
+    measure("nestl::set<uint32_t> insert_nothrow one by one from sorted range, 1M elements", [&sortedKeys]()
+    {
+        nestl::set<uint32_t> s;
+        build_set(s, sortedKeys);
+        do_not_optimize(s);
+    });
+
+    measure("nestl::set<uint32_t> assign_sorted_nothrow, 1M elements", [&sortedKeys]()
+    {
+        nestl::set<uint32_t> s;
+        nestl::default_operation_error err;
+        s.assign_sorted_nothrow(err, sortedKeys.begin(), sortedKeys.end());
+        if (err)
+        {
+            std::abort();
+        }
+        do_not_optimize(s);
+    });
+}
+
+} // namespace benchmark
+} // namespace nestl
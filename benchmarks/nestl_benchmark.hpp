@@ -0,0 +1,130 @@
+#ifndef NESTL_BENCHMARKS_NESTL_BENCHMARK_HPP
+#define NESTL_BENCHMARKS_NESTL_BENCHMARK_HPP
+
+#include <nestl/config.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @file minimal benchmark framework for nestl
+ *
+ * Benchmarks are not run as a part of test suite, they just print timings of measured operations.
+ * Results are meaningful only for optimized builds.
+ */
+
+namespace nestl
+{
+namespace benchmark
+{
+
+/// @brief Prevents compiler from optimizing out computation of given value
+template <typename T>
+void do_not_optimize(const T& val)
+{
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC
+    static const volatile void* sink = 0;
+    sink = &val;
+#else
+    asm volatile("" : : "r"(&val) : "memory");
+#endif
+}
+
+
+/**
+ * @brief Runs func given number of times and prints best observed time
+ *
+ * @note func should perform whole operation (including setup) for each run
+ */
+template <typename Func>
+void measure(const char* name, Func func, size_t runs = 5)
+{
+    typedef std::chrono::steady_clock clock_t;
+
+    clock_t::duration best = clock_t::duration::max();
+    for (size_t i = 0; i != runs; ++i)
+    {
+        const clock_t::time_point start = clock_t::now();
+        func();
+        const clock_t::duration elapsed = clock_t::now() - start;
+
+        if (elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+
+    std::cout << std::left << std::setw(60) << name
+              << std::right << std::setw(12) << std::chrono::duration_cast<std::chrono::microseconds>(best).count()
+              << " us" << std::endl;
+}
+
+
+typedef void(*BenchmarkRunner)();
+
+const size_t MaxBenchmarkCount = 1000;
+
+struct BenchmarkSuite
+{
+    BenchmarkSuite()
+        : m_benchmarkRunners()
+        , m_registeredBenchmarkRunners(0)
+    {
+    }
+
+    void AddBenchmark(BenchmarkRunner benchmarkRunner)
+    {
+        if (m_registeredBenchmarkRunners == MaxBenchmarkCount)
+        {
+            std::cerr << "benchmark limit exceeeded" << std::endl;
+            std::abort();
+        }
+
+        m_benchmarkRunners[m_registeredBenchmarkRunners] = benchmarkRunner;
+        m_registeredBenchmarkRunners += 1;
+    }
+
+    void RunBenchmarks()
+    {
+        for (size_t i = 0; i != m_registeredBenchmarkRunners; ++i)
+        {
+            m_benchmarkRunners[i]();
+        }
+    }
+
+    static BenchmarkSuite& GetInstance()
+    {
+        static BenchmarkSuite instance;
+        return instance;
+    }
+
+private:
+    BenchmarkRunner m_benchmarkRunners[MaxBenchmarkCount];
+    size_t m_registeredBenchmarkRunners;
+};
+
+} // namespace benchmark
+} // namespace nestl
+
+
+#define NESTL_ADD_BENCHMARK(benchmark_name) \
+template <size_t Unused> \
+struct NESTL_JOIN(BenchmarkRegistrator ## benchmark_name, __LINE__) \
+{ \
+    NESTL_JOIN(BenchmarkRegistrator ## benchmark_name, __LINE__)() \
+    { \
+        nestl::benchmark::BenchmarkSuite::GetInstance().AddBenchmark(BenchmarkRunner); \
+    } \
+    static void BenchmarkRunner(); \
+}; \
+namespace {NESTL_JOIN(BenchmarkRegistrator ## benchmark_name, __LINE__)<__COUNTER__> NESTL_JOIN(benchmarkRegistrator, __LINE__); }\
+template <size_t Unused> \
+void NESTL_JOIN(BenchmarkRegistrator ## benchmark_name, __LINE__)<Unused>::BenchmarkRunner()\
+
+
+#define NESTL_RUN_ALL_BENCHMARKS() nestl::benchmark::BenchmarkSuite::GetInstance().RunBenchmarks()
+
+
+#endif /* NESTL_BENCHMARKS_NESTL_BENCHMARK_HPP */
@@ -0,0 +1,81 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/list.hpp>
+#include <nestl/set.hpp>
+#include <nestl/node_pool_allocator.hpp>
+#include <nestl/default_operation_error.hpp>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+const int ElementCount = 100000;
+const int Rounds = 4;
+
+
+/// fills list and clears it several times, so freed nodes are reused
+template <typename Allocator>
+void list_push_clear()
+{
+    nestl::default_operation_error err;
+
+    nestl::list<int, Allocator> l;
+    for (int round = 0; round != Rounds; ++round)
+    {
+        for (int i = 0; i != ElementCount; ++i)
+        {
+            l.push_back_nothrow(err, i);
+            if (err)
+            {
+                std::abort();
+            }
+        }
+
+        do_not_optimize(l);
+        l.clear();
+    }
+}
+
+/// inserts elements into set in pseudo random order and erases them
+template <typename Allocator>
+void set_insert_erase()
+{
+    nestl::default_operation_error err;
+
+    nestl::set<int, std::less<int>, Allocator> s;
+    for (int round = 0; round != Rounds; ++round)
+    {
+        for (int i = 0; i != ElementCount; ++i)
+        {
+            s.insert_nothrow(err, (i * 7919) % ElementCount);
+            if (err)
+            {
+                std::abort();
+            }
+        }
+
+        do_not_optimize(s);
+        s.clear();
+    }
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(node_pool_allocator_benchmark)
+{
+    measure("nestl::list<int, nestl::allocator>", list_push_clear<nestl::allocator<int> >);
+    measure("nestl::list<int, nestl::node_pool_allocator>", list_push_clear<nestl::node_pool_allocator<int> >);
+    measure("nestl::list<int, nestl::thread_local_node_pool_allocator>", list_push_clear<nestl::thread_local_node_pool_allocator<int> >);
+
+    measure("nestl::set<int, nestl::allocator>", set_insert_erase<nestl::allocator<int> >);
+    measure("nestl::set<int, nestl::node_pool_allocator>", set_insert_erase<nestl::node_pool_allocator<int> >);
+    measure("nestl::set<int, nestl::thread_local_node_pool_allocator>", set_insert_erase<nestl::thread_local_node_pool_allocator<int> >);
+}
+
+} // namespace benchmark
+} // namespace nestl
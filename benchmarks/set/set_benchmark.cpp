@@ -0,0 +1,273 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/set.hpp>
+#include <nestl/tree_policy.hpp>
+#include <nestl/vector.hpp>
+#include <nestl/algorithm.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <cstdint>
+#include <iterator>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+const uint32_t NodeCount = 10 * 1000 * 1000;
+const uint32_t OperationNodeCount = 1000 * 1000;
+
+/// @brief Sorted sequence of integers with given step without storing it
+class counting_iterator
+{
+public:
+    typedef std::forward_iterator_tag   iterator_category;
+    typedef uint32_t                    value_type;
+    typedef std::ptrdiff_t              difference_type;
+    typedef const uint32_t*             pointer;
+    typedef const uint32_t&             reference;
+
+    explicit counting_iterator(uint32_t value, uint32_t step = 1)
+        : m_value(value)
+        , m_step(step)
+    {
+    }
+
+    reference operator*() const
+    {
+        return m_value;
+    }
+
+    counting_iterator& operator++()
+    {
+        m_value += m_step;
+        return *this;
+    }
+
+    bool operator==(const counting_iterator& other) const
+    {
+        return m_value == other.m_value;
+    }
+
+    bool operator!=(const counting_iterator& other) const
+    {
+        return m_value != other.m_value;
+    }
+
+private:
+    uint32_t m_value;
+    uint32_t m_step;
+};
+
+typedef nestl::set<uint32_t> set_t;
+
+/// @brief Set of count keys first, first + step, ...
+void fill(set_t& s, uint32_t first, uint32_t step, uint32_t count)
+{
+    nestl::default_operation_error err;
+    s.assign_sorted_nothrow(err, counting_iterator(first, step), counting_iterator(first + step * count, step));
+    if (err)
+    {
+        std::abort();
+    }
+}
+
+/**
+ * @brief Measures union of set of 1M even keys with set of count odd keys
+ *
+ * Sets are consumed by operations, so they are built before each single run.
+ */
+void measure_union(uint32_t count)
+{
+    const uint32_t step = 2 * OperationNodeCount / count;
+    nestl::default_operation_error err;
+
+    set_t large;
+    set_t small;
+    fill(large, 0, 2, OperationNodeCount);
+    fill(small, 1, step, count);
+    measure(count == OperationNodeCount ? "nestl::set<uint32_t> unite_nothrow, 1M with 1M elements"
+                                        : "nestl::set<uint32_t> unite_nothrow, 1M with 1K elements",
+            [&large, &small]()
+    {
+        nestl::default_operation_error err;
+        large.unite_nothrow(err, std::move(small));
+        if (err)
+        {
+            std::abort();
+        }
+        do_not_optimize(large);
+    }, 1);
+
+    fill(large, 0, 2, OperationNodeCount);
+    fill(small, 1, step, count);
+    measure(count == OperationNodeCount ? "nestl::set<uint32_t> insert_nothrow, 1M with 1M elements"
+                                        : "nestl::set<uint32_t> insert_nothrow, 1M with 1K elements",
+            [&large, &small]()
+    {
+        nestl::default_operation_error err;
+        for (set_t::const_iterator it = small.begin(); it != small.end(); ++it)
+        {
+            large.insert_nothrow(err, *it);
+            if (err)
+            {
+                std::abort();
+            }
+        }
+        do_not_optimize(large);
+    }, 1);
+
+    fill(large, 0, 2, OperationNodeCount);
+    nestl::vector<uint32_t> merged;
+    merged.resize_nothrow(err, OperationNodeCount + count);
+    if (err)
+    {
+        std::abort();
+    }
+    measure(count == OperationNodeCount ? "nestl::set_union to vector, 1M with 1M elements"
+                                        : "nestl::set_union to vector, 1M with 1K elements",
+            [&large, &small, &merged]()
+    {
+        nestl::default_operation_error err;
+        nestl::set_union(err, large.begin(), large.end(), small.begin(), small.end(), merged.begin());
+        if (err)
+        {
+            std::abort();
+        }
+        do_not_optimize(merged);
+    }, 1);
+}
+
+/// @brief Pseudo-random key, keys of distinct indices are distinct
+uint32_t scrambled(uint32_t i)
+{
+    return i * 2654435761u;
+}
+
+/// @brief Measures insertion and erasure of 1M keys in random order
+template <typename Set>
+void measure_modifications(const char* insertName, const char* eraseName)
+{
+    Set s;
+    measure(insertName, [&s]()
+    {
+        nestl::default_operation_error err;
+        for (uint32_t i = 0; i != OperationNodeCount; ++i)
+        {
+            s.insert_nothrow(err, scrambled(i));
+            if (err)
+            {
+                std::abort();
+            }
+        }
+        do_not_optimize(s);
+    }, 1);
+
+    measure(eraseName, [&s]()
+    {
+        for (uint32_t i = 0; i != OperationNodeCount; ++i)
+        {
+            s.erase(scrambled(i));
+        }
+        do_not_optimize(s);
+    }, 1);
+}
+
+void measure_order_statistics()
+{
+    typedef nestl::set<uint32_t, std::less<uint32_t>, nestl::allocator<uint32_t>, nestl::order_statistic_tree_policy>
+            order_statistic_set_t;
+
+    measure_modifications<set_t>("nestl::set<uint32_t> insert_nothrow, 1M random keys",
+                                 "nestl::set<uint32_t> erase, 1M random keys");
+    measure_modifications<order_statistic_set_t>("order statistic set insert_nothrow, 1M random keys",
+                                                 "order statistic set erase, 1M random keys");
+
+    const uint32_t queryCount = 100;
+
+    set_t plain;
+    fill(plain, 0, 1, OperationNodeCount);
+    measure("nestl::set<uint32_t> std::advance from begin, 100 queries", [&plain]()
+    {
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i != queryCount; ++i)
+        {
+            set_t::const_iterator it = plain.begin();
+            std::advance(it, scrambled(i) % OperationNodeCount);
+            sum += *it;
+        }
+        do_not_optimize(sum);
+    }, 1);
+
+    order_statistic_set_t ranked;
+    nestl::default_operation_error err;
+    ranked.assign_sorted_nothrow(err, counting_iterator(0), counting_iterator(OperationNodeCount));
+    if (err)
+    {
+        std::abort();
+    }
+    measure("order statistic set nth, 100 queries", [&ranked]()
+    {
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i != queryCount; ++i)
+        {
+            sum += *ranked.nth(scrambled(i) % OperationNodeCount);
+        }
+        do_not_optimize(sum);
+    });
+
+    measure("order statistic set rank, 100 queries", [&ranked]()
+    {
+        size_t sum = 0;
+        for (uint32_t i = 0; i != queryCount; ++i)
+        {
+            sum += ranked.rank(scrambled(i) % OperationNodeCount);
+        }
+        do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(set_benchmark)
+{
+    nestl::default_operation_error err;
+
+    nestl::set<uint32_t> source;
+    source.assign_sorted_nothrow(err, counting_iterator(0), counting_iterator(NodeCount));
+    if (err)
+    {
+        std::abort();
+    }
+
+    // every run of copy and clear deals with 10M nodes, so single run is enough
+    nestl::set<uint32_t> copy;
+    measure("nestl::set<uint32_t> copy_nothrow, 10M elements", [&source, &copy]()
+    {
+        nestl::default_operation_error err;
+        copy.copy_nothrow(err, source);
+        if (err)
+        {
+            std::abort();
+        }
+        do_not_optimize(copy);
+    }, 1);
+
+    measure("nestl::set<uint32_t> clear, 10M elements", [&copy]()
+    {
+        copy.clear();
+        do_not_optimize(copy);
+    }, 1);
+
+    measure_union(1000);
+    measure_union(OperationNodeCount);
+
+    measure_order_statistics();
+}
+
+} // namespace benchmark
+} // namespace nestl
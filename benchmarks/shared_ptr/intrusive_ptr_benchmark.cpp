@@ -0,0 +1,102 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/intrusive_ptr.hpp>
+#include <nestl/shared_ptr.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <cstdlib>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+const int NodeCount = 100000;
+const int WalkCount = 20;
+
+
+struct shared_node
+{
+    shared_node() NESTL_NOEXCEPT_SPEC
+        : value(0)
+    {
+    }
+
+    int value;
+    nestl::shared_ptr<shared_node> next;
+};
+
+struct intrusive_node : public nestl::intrusive_ref_counter<intrusive_node>
+{
+    intrusive_node() NESTL_NOEXCEPT_SPEC
+        : value(0)
+    {
+    }
+
+    int value;
+    nestl::intrusive_ptr<intrusive_node> next;
+};
+
+
+nestl::shared_ptr<shared_node> make_node(nestl::default_operation_error& err, shared_node*)
+{
+    return nestl::make_shared_nothrow<shared_node>(err);
+}
+
+nestl::intrusive_ptr<intrusive_node> make_node(nestl::default_operation_error& err, intrusive_node*)
+{
+    return nestl::make_intrusive_nothrow<intrusive_node>(err);
+}
+
+/// builds chain of nodes, then walks it by copying pointers from node to node
+template <typename Node, typename Pointer>
+void build_and_walk()
+{
+    nestl::default_operation_error err;
+
+    Pointer head;
+    for (int i = 0; i != NodeCount; ++i)
+    {
+        Pointer node = make_node(err, static_cast<Node*>(nullptr));
+        if (err)
+        {
+            std::abort();
+        }
+
+        node->value = i;
+        node->next = std::move(head);
+        head = std::move(node);
+    }
+
+    long sum = 0;
+    for (int i = 0; i != WalkCount; ++i)
+    {
+        for (Pointer current = head; current; current = current->next)
+        {
+            sum += current->value;
+        }
+    }
+    do_not_optimize(sum);
+
+    // release chain iteratively, recursive destruction of long chain may overflow stack
+    while (head)
+    {
+        Pointer next = std::move(head->next);
+        head = std::move(next);
+    }
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(intrusive_ptr_benchmark)
+{
+    measure("object graph, nestl::shared_ptr", build_and_walk<shared_node, nestl::shared_ptr<shared_node> >);
+    measure("object graph, nestl::intrusive_ptr", build_and_walk<intrusive_node, nestl::intrusive_ptr<intrusive_node> >);
+}
+
+} // namespace benchmark
+} // namespace nestl
@@ -0,0 +1,126 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/shared_ptr.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <thread>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+const int CopyCount = 1000000;
+const int ThreadCount = 4;
+
+
+template <typename RefCountPolicy>
+nestl::shared_ptr<int, RefCountPolicy> make_value()
+{
+    nestl::default_operation_error err;
+    nestl::shared_ptr<int, RefCountPolicy> res = nestl::make_shared_nothrow<int, RefCountPolicy>(err, 42);
+    if (err)
+    {
+        std::abort();
+    }
+
+    return res;
+}
+
+/// copies and destroys pointer, each iteration increments and decrements use count
+template <typename SharedPtr>
+void copy_pointer(const SharedPtr& sp)
+{
+    for (int i = 0; i != CopyCount; ++i)
+    {
+        SharedPtr copy(sp);
+        do_not_optimize(copy);
+    }
+}
+
+/// single thread copies its own pointer
+template <typename RefCountPolicy>
+void single_thread_copy()
+{
+    const nestl::shared_ptr<int, RefCountPolicy> sp = make_value<RefCountPolicy>();
+    copy_pointer(sp);
+}
+
+/// each thread copies its own pointer, counters are not shared
+template <typename RefCountPolicy>
+void threads_copy_own_pointer()
+{
+    std::thread threads[ThreadCount];
+    for (std::thread& t : threads)
+    {
+        t = std::thread(single_thread_copy<RefCountPolicy>);
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+/// all threads copy the same pointer, so they fight for cache line of its counter
+void threads_copy_shared_pointer()
+{
+    const nestl::shared_ptr<int, nestl::atomic_refcount_policy> sp = make_value<nestl::atomic_refcount_policy>();
+
+    std::thread threads[ThreadCount];
+    for (std::thread& t : threads)
+    {
+        t = std::thread([&sp]() { copy_pointer(sp); });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+/// all threads upgrade the same weak pointer
+void threads_lock_shared_pointer()
+{
+    const nestl::shared_ptr<int> sp = make_value<nestl::atomic_refcount_policy>();
+    const nestl::weak_ptr<int> wp(sp);
+
+    std::thread threads[ThreadCount];
+    for (std::thread& t : threads)
+    {
+        t = std::thread([&wp]()
+        {
+            for (int i = 0; i != CopyCount; ++i)
+            {
+                nestl::shared_ptr<int> locked = wp.lock();
+                do_not_optimize(locked);
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(shared_ptr_benchmark)
+{
+    measure("single thread, nestl::single_thread_refcount_policy", single_thread_copy<nestl::single_thread_refcount_policy>);
+    measure("single thread, nestl::atomic_refcount_policy", single_thread_copy<nestl::atomic_refcount_policy>);
+
+    measure("4 threads with own pointers, nestl::single_thread_refcount_policy", threads_copy_own_pointer<nestl::single_thread_refcount_policy>);
+    measure("4 threads with own pointers, nestl::atomic_refcount_policy", threads_copy_own_pointer<nestl::atomic_refcount_policy>);
+
+    measure("4 threads with shared pointer, nestl::atomic_refcount_policy", threads_copy_shared_pointer);
+    measure("4 threads lock shared weak pointer, nestl::atomic_refcount_policy", threads_lock_shared_pointer);
+}
+
+} // namespace benchmark
+} // namespace nestl
@@ -0,0 +1,154 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/string.hpp>
+#include <nestl/vector.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+const size_t KeyCount = 200000;
+const size_t LookupCount = 20;
+
+
+/// formats key which fits into inline buffer of both strings
+size_t format_key(char* buffer, size_t index)
+{
+    return static_cast<size_t>(std::sprintf(buffer, "key_%lu", static_cast<unsigned long>(index)));
+}
+
+
+/// builds short keys one by one and stores them in vector
+void build_keys_nestl()
+{
+    nestl::default_operation_error err;
+
+    nestl::vector<nestl::string> keys;
+    keys.reserve_nothrow(err, KeyCount);
+    if (err)
+    {
+        std::abort();
+    }
+
+    char buffer[32];
+    for (size_t i = 0; i != KeyCount; ++i)
+    {
+        nestl::string key;
+        key.assign_nothrow(err, buffer, format_key(buffer, i));
+        if (err)
+        {
+            std::abort();
+        }
+
+        key.push_back_nothrow(err, '#');
+        if (err)
+        {
+            std::abort();
+        }
+
+        keys.push_back_nothrow(err, std::move(key));
+        if (err)
+        {
+            std::abort();
+        }
+    }
+
+    do_not_optimize(keys);
+}
+
+void build_keys_std()
+{
+    std::vector<std::string> keys;
+    keys.reserve(KeyCount);
+
+    char buffer[32];
+    for (size_t i = 0; i != KeyCount; ++i)
+    {
+        std::string key;
+        key.assign(buffer, format_key(buffer, i));
+        key.push_back('#');
+
+        keys.push_back(std::move(key));
+    }
+
+    do_not_optimize(keys);
+}
+
+
+/// compares neighbouring keys and searches them for a character
+template <typename String>
+void lookup_keys(const String* keys, size_t count)
+{
+    size_t matches = 0;
+    for (size_t round = 0; round != LookupCount; ++round)
+    {
+        for (size_t i = 1; i != count; ++i)
+        {
+            if (keys[i - 1] < keys[i])
+            {
+                ++matches;
+            }
+
+            if (keys[i].find('9') != String::npos)
+            {
+                ++matches;
+            }
+        }
+    }
+
+    do_not_optimize(matches);
+}
+
+void lookup_keys_nestl()
+{
+    nestl::default_operation_error err;
+
+    nestl::vector<nestl::string> keys;
+    char buffer[32];
+    for (size_t i = 0; i != KeyCount; ++i)
+    {
+        keys.emplace_back_nothrow(err, buffer, format_key(buffer, i));
+        if (err)
+        {
+            std::abort();
+        }
+    }
+
+    lookup_keys(&keys[0], keys.size());
+}
+
+void lookup_keys_std()
+{
+    std::vector<std::string> keys;
+    char buffer[32];
+    for (size_t i = 0; i != KeyCount; ++i)
+    {
+        keys.emplace_back(buffer, format_key(buffer, i));
+    }
+
+    lookup_keys(&keys[0], keys.size());
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(string_benchmark)
+{
+    measure("nestl::string short keys: assign_nothrow + push_back_nothrow", build_keys_nestl);
+    measure("std::string short keys: assign + push_back", build_keys_std);
+
+    measure("nestl::string short keys: operator< + find", lookup_keys_nestl);
+    measure("std::string short keys: operator< + find", lookup_keys_std);
+}
+
+} // namespace benchmark
+} // namespace nestl
@@ -0,0 +1,114 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/detail/char_search.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+typedef nestl::detail::char_search::kernels kernels_t;
+
+/// every measurement scans the same number of bytes, so timings of different sizes are comparable
+const size_t TotalBytes = 64 * 1024 * 1024;
+
+const size_t HaystackSizes[] = {16, 64, 256, 1024, 4096, 65536};
+
+
+/// log line like text without delimiters, so each search scans the whole haystack
+std::vector<char> make_haystack(size_t size)
+{
+    const char text[] = "2017-01-01 12:00:00 INFO request processed by worker in time ";
+
+    std::vector<char> res(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        res[i] = text[i % (sizeof(text) - 1)];
+    }
+
+    return res;
+}
+
+void run(const kernels_t& k, size_t size)
+{
+    const std::vector<char> haystack = make_haystack(size);
+    const std::vector<char> copy = haystack;
+    const char* s = &haystack[0];
+    const size_t rounds = TotalBytes / size;
+
+    const std::string prefix = std::string(k.name) + " size " + std::to_string(size) + ": ";
+
+    measure((prefix + "find_char").c_str(), [&]()
+    {
+        for (size_t i = 0; i != rounds; ++i)
+        {
+            do_not_optimize(k.find_char(s, size, '|'));
+        }
+    });
+
+    measure((prefix + "rfind_char").c_str(), [&]()
+    {
+        for (size_t i = 0; i != rounds; ++i)
+        {
+            do_not_optimize(k.rfind_char(s, size, '|'));
+        }
+    });
+
+    measure((prefix + "find_any(4 chars)").c_str(), [&]()
+    {
+        for (size_t i = 0; i != rounds; ++i)
+        {
+            do_not_optimize(k.find_any(s, size, "|;\t\n", 4));
+        }
+    });
+
+    measure((prefix + "find(\"ERROR\")").c_str(), [&]()
+    {
+        for (size_t i = 0; i != rounds; ++i)
+        {
+            do_not_optimize(k.find(s, size, "ERROR", 5));
+        }
+    });
+
+    measure((prefix + "mismatch").c_str(), [&]()
+    {
+        for (size_t i = 0; i != rounds; ++i)
+        {
+            do_not_optimize(k.mismatch(s, &copy[0], size));
+        }
+    });
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(string_benchmark_search)
+{
+    const kernels_t* all[] =
+    {
+        &nestl::detail::char_search::scalar_kernels(),
+        nestl::detail::char_search::sse2_kernels(),
+        nestl::detail::char_search::avx2_kernels()
+    };
+
+    for (size_t size : HaystackSizes)
+    {
+        for (const kernels_t* k : all)
+        {
+            if (k)
+            {
+                run(*k, size);
+            }
+        }
+    }
+}
+
+} // namespace benchmark
+} // namespace nestl
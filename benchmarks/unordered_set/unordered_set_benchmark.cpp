@@ -0,0 +1,168 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/flat_set.hpp>
+#include <nestl/set.hpp>
+#include <nestl/unordered_set.hpp>
+#include <nestl/vector.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_set>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+/// every lookup measurement performs the same number of lookups, so different sizes are comparable
+const size_t LookupCount = 4 * 1024 * 1024;
+
+
+/// keys are spread over whole range in scrambled order, odd values are never inserted
+uint32_t key_at(size_t index)
+{
+    return (static_cast<uint32_t>(index) * 2654435761u) & ~1u;
+}
+
+void make_keys(nestl::vector<uint32_t>& keys, size_t count)
+{
+    nestl::default_operation_error err;
+
+    keys.reserve_nothrow(err, count);
+    if (err)
+    {
+        std::abort();
+    }
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        keys.push_back_nothrow(err, key_at(i));
+        if (err)
+        {
+            std::abort();
+        }
+    }
+}
+
+
+template <typename Set>
+void build_one_by_one(Set& s, const nestl::vector<uint32_t>& keys)
+{
+    nestl::default_operation_error err;
+    for (uint32_t key : keys)
+    {
+        s.insert_nothrow(err, key);
+        if (err)
+        {
+            std::abort();
+        }
+    }
+}
+
+void build_flat_set(nestl::flat_set<uint32_t>& s, const nestl::vector<uint32_t>& keys)
+{
+    nestl::default_operation_error err;
+    s.insert_nothrow(err, keys.begin(), keys.end());
+    if (err)
+    {
+        std::abort();
+    }
+}
+
+
+/// half of probes are present keys, the other half are absent neighbours
+template <typename Set>
+void lookup(const Set& s, size_t count)
+{
+    size_t found = 0;
+    for (size_t i = 0; i != LookupCount; ++i)
+    {
+        const uint32_t key = key_at((i * 7) % count) | static_cast<uint32_t>(i & 1);
+        if (s.find(key) != s.end())
+        {
+            ++found;
+        }
+    }
+
+    do_not_optimize(found);
+}
+
+
+void run_lookup(size_t count, const char* suffix)
+{
+    nestl::vector<uint32_t> keys;
+    make_keys(keys, count);
+
+    nestl::set<uint32_t> s;
+    build_one_by_one(s, keys);
+
+    nestl::flat_set<uint32_t> fs;
+    build_flat_set(fs, keys);
+
+    nestl::unordered_set<uint32_t> us;
+    build_one_by_one(us, keys);
+
+    std::unordered_set<uint32_t> stdSet(keys.begin(), keys.end());
+
+    const std::string name = std::string(" find, ") + suffix;
+    measure(("nestl::set<uint32_t>" + name).c_str(), [&s, count]() { lookup(s, count); });
+    measure(("nestl::flat_set<uint32_t>" + name).c_str(), [&fs, count]() { lookup(fs, count); });
+    measure(("nestl::unordered_set<uint32_t>" + name).c_str(), [&us, count]() { lookup(us, count); });
+    measure(("std::unordered_set<uint32_t>" + name).c_str(), [&stdSet, count]() { lookup(stdSet, count); });
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(unordered_set_benchmark)
+{
+    run_lookup(1024, "1K elements");
+    run_lookup(1024 * 1024, "1M elements");
+
+    nestl::vector<uint32_t> keys;
+    make_keys(keys, 1024 * 1024);
+
+    measure("nestl::set<uint32_t> insert_nothrow one by one, 1M elements", [&keys]()
+    {
+        nestl::set<uint32_t> s;
+        build_one_by_one(s, keys);
+        do_not_optimize(s);
+    });
+
+    measure("nestl::unordered_set<uint32_t> insert_nothrow one by one, 1M elements", [&keys]()
+    {
+        nestl::unordered_set<uint32_t> s;
+        build_one_by_one(s, keys);
+        do_not_optimize(s);
+    });
+
+    measure("nestl::unordered_set<uint32_t> reserve_nothrow + insert_nothrow, 1M elements", [&keys]()
+    {
+        nestl::default_operation_error err;
+        nestl::unordered_set<uint32_t> s;
+        s.reserve_nothrow(err, keys.size());
+        if (err)
+        {
+            std::abort();
+        }
+        build_one_by_one(s, keys);
+        do_not_optimize(s);
+    });
+
+    measure("std::unordered_set<uint32_t> insert one by one, 1M elements", [&keys]()
+    {
+        std::unordered_set<uint32_t> s;
+        for (uint32_t key : keys)
+        {
+            s.insert(key);
+        }
+        do_not_optimize(s);
+    });
+}
+
+} // namespace benchmark
+} // namespace nestl
@@ -0,0 +1,144 @@
+#include "benchmarks/nestl_benchmark.hpp"
+
+#include <nestl/vector.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <vector>
+
+namespace nestl
+{
+namespace benchmark
+{
+
+namespace
+{
+
+const size_t InitialSize = 1000;
+const size_t InsertCount = 2000;
+const size_t ElementSize = 16;
+
+
+void fill_heavy(nestl::vector<int>& val)
+{
+    nestl::default_operation_error err;
+    val.assign_nothrow(err, ElementSize, 1);
+    if (err)
+    {
+        std::abort();
+    }
+}
+
+void fill_heavy(std::vector<int>& val)
+{
+    val.assign(ElementSize, 1);
+}
+
+
+/// inserts heavy elements (which own heap memory) at the front of vector
+template <typename Outer>
+void insert_front_nestl()
+{
+    nestl::default_operation_error err;
+
+    Outer vec;
+    for (size_t i = 0; i != InitialSize + InsertCount; ++i)
+    {
+        typename Outer::value_type val;
+        fill_heavy(val);
+
+        if (i < InitialSize)
+        {
+            vec.push_back_nothrow(err, std::move(val));
+        }
+        else
+        {
+            vec.emplace_nothrow(err, vec.begin(), std::move(val));
+        }
+
+        if (err)
+        {
+            std::abort();
+        }
+    }
+
+    do_not_optimize(vec);
+}
+
+template <typename Outer>
+void insert_front_std()
+{
+    Outer vec;
+    for (size_t i = 0; i != InitialSize + InsertCount; ++i)
+    {
+        typename Outer::value_type val;
+        fill_heavy(val);
+
+        if (i < InitialSize)
+        {
+            vec.push_back(std::move(val));
+        }
+        else
+        {
+            vec.emplace(vec.begin(), std::move(val));
+        }
+    }
+
+    do_not_optimize(vec);
+}
+
+
+/// inserts ranges of ints in the middle of vector
+void insert_range_nestl()
+{
+    nestl::default_operation_error err;
+
+    int values[64];
+    for (int i = 0; i != 64; ++i)
+    {
+        values[i] = i;
+    }
+
+    nestl::vector<int> vec;
+    for (size_t i = 0; i != InsertCount; ++i)
+    {
+        vec.insert_nothrow(err, vec.begin() + vec.size() / 2, values, values + 64);
+        if (err)
+        {
+            std::abort();
+        }
+    }
+
+    do_not_optimize(vec);
+}
+
+void insert_range_std()
+{
+    int values[64];
+    for (int i = 0; i != 64; ++i)
+    {
+        values[i] = i;
+    }
+
+    std::vector<int> vec;
+    for (size_t i = 0; i != InsertCount; ++i)
+    {
+        vec.insert(vec.begin() + vec.size() / 2, values, values + 64);
+    }
+
+    do_not_optimize(vec);
+}
+
+} // namespace
+
+
+NESTL_ADD_BENCHMARK(vector_benchmark_insert)
+{
+    measure("nestl::vector<nestl::vector<int>>::emplace_nothrow(begin)", insert_front_nestl<nestl::vector<nestl::vector<int> > >);
+    measure("std::vector<std::vector<int>>::emplace(begin)", insert_front_std<std::vector<std::vector<int> > >);
+
+    measure("nestl::vector<int>::insert_nothrow(middle, range)", insert_range_nestl);
+    measure("std::vector<int>::insert(middle, range)", insert_range_std);
+}
+
+} // namespace benchmark
+} // namespace nestl
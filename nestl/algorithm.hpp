@@ -7,6 +7,7 @@
 
 #include <nestl/config.hpp>
 #include <nestl/class_operations.hpp>
+#include <nestl/functional.hpp>
 
 #include <iterator>
 
@@ -121,6 +122,228 @@ bool lexicographical_compare(InputIterator1 first1,
     return (first1 == last1) && (first2 != last2);
 }
 
+/**
+ * @brief Merges sorted ranges into range starting at d_first, equivalent elements of the first range go first
+ *
+ * @return end of output range, in case of error position which failed to be assigned
+ */
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Compare>
+OutputIterator
+merge(OperationError& err,
+      InputIterator1 first1, InputIterator1 last1,
+      InputIterator2 first2, InputIterator2 last2,
+      OutputIterator d_first, Compare comp)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first2, *first1))
+        {
+            nestl::class_operations::assign(err, *d_first, *first2);
+            ++first2;
+        }
+        else
+        {
+            nestl::class_operations::assign(err, *d_first, *first1);
+            ++first1;
+        }
+        if (err)
+        {
+            return d_first;
+        }
+        ++d_first;
+    }
+
+    d_first = nestl::copy(err, first1, last1, d_first);
+    if (err)
+    {
+        return d_first;
+    }
+    return nestl::copy(err, first2, last2, d_first);
+}
+
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator
+merge(OperationError& err,
+      InputIterator1 first1, InputIterator1 last1,
+      InputIterator2 first2, InputIterator2 last2,
+      OutputIterator d_first)
+{
+    return nestl::merge(err, first1, last1, first2, last2, d_first, nestl::less<>());
+}
+
+/**
+ * @brief Copies elements present in any of sorted ranges, of equivalent elements the one of the first range is taken
+ *
+ * @return end of output range, in case of error position which failed to be assigned
+ */
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Compare>
+OutputIterator
+set_union(OperationError& err,
+          InputIterator1 first1, InputIterator1 last1,
+          InputIterator2 first2, InputIterator2 last2,
+          OutputIterator d_first, Compare comp)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first2, *first1))
+        {
+            nestl::class_operations::assign(err, *d_first, *first2);
+            ++first2;
+        }
+        else
+        {
+            if (!comp(*first1, *first2))
+            {
+                ++first2;
+            }
+            nestl::class_operations::assign(err, *d_first, *first1);
+            ++first1;
+        }
+        if (err)
+        {
+            return d_first;
+        }
+        ++d_first;
+    }
+
+    d_first = nestl::copy(err, first1, last1, d_first);
+    if (err)
+    {
+        return d_first;
+    }
+    return nestl::copy(err, first2, last2, d_first);
+}
+
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator
+set_union(OperationError& err,
+          InputIterator1 first1, InputIterator1 last1,
+          InputIterator2 first2, InputIterator2 last2,
+          OutputIterator d_first)
+{
+    return nestl::set_union(err, first1, last1, first2, last2, d_first, nestl::less<>());
+}
+
+/**
+ * @brief Copies elements of the first sorted range which have equivalent in the second one
+ *
+ * @return end of output range, in case of error position which failed to be assigned
+ */
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Compare>
+OutputIterator
+set_intersection(OperationError& err,
+                 InputIterator1 first1, InputIterator1 last1,
+                 InputIterator2 first2, InputIterator2 last2,
+                 OutputIterator d_first, Compare comp)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first1, *first2))
+        {
+            ++first1;
+        }
+        else if (comp(*first2, *first1))
+        {
+            ++first2;
+        }
+        else
+        {
+            nestl::class_operations::assign(err, *d_first, *first1);
+            if (err)
+            {
+                return d_first;
+            }
+            ++d_first;
+            ++first1;
+            ++first2;
+        }
+    }
+    return d_first;
+}
+
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator
+set_intersection(OperationError& err,
+                 InputIterator1 first1, InputIterator1 last1,
+                 InputIterator2 first2, InputIterator2 last2,
+                 OutputIterator d_first)
+{
+    return nestl::set_intersection(err, first1, last1, first2, last2, d_first, nestl::less<>());
+}
+
+/**
+ * @brief Copies elements of the first sorted range which have no equivalent in the second one
+ *
+ * @return end of output range, in case of error position which failed to be assigned
+ */
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Compare>
+OutputIterator
+set_difference(OperationError& err,
+               InputIterator1 first1, InputIterator1 last1,
+               InputIterator2 first2, InputIterator2 last2,
+               OutputIterator d_first, Compare comp)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first1, *first2))
+        {
+            nestl::class_operations::assign(err, *d_first, *first1);
+            if (err)
+            {
+                return d_first;
+            }
+            ++d_first;
+            ++first1;
+        }
+        else
+        {
+            if (!comp(*first2, *first1))
+            {
+                ++first1;
+            }
+            ++first2;
+        }
+    }
+    return nestl::copy(err, first1, last1, d_first);
+}
+
+template<typename OperationError, typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator
+set_difference(OperationError& err,
+               InputIterator1 first1, InputIterator1 last1,
+               InputIterator2 first2, InputIterator2 last2,
+               OutputIterator d_first)
+{
+    return nestl::set_difference(err, first1, last1, first2, last2, d_first, nestl::less<>());
+}
+
+/// @brief Checks if every element of the second sorted range has equivalent in the first one
+template<typename InputIterator1, typename InputIterator2, typename Compare>
+bool includes(InputIterator1 first1, InputIterator1 last1,
+              InputIterator2 first2, InputIterator2 last2,
+              Compare comp)
+{
+    for ( ; first2 != last2; ++first1)
+    {
+        if (first1 == last1 || comp(*first2, *first1))
+        {
+            return false;
+        }
+        if (!comp(*first1, *first2))
+        {
+            ++first2;
+        }
+    }
+    return true;
+}
+
+template<typename InputIterator1, typename InputIterator2>
+bool includes(InputIterator1 first1, InputIterator1 last1,
+              InputIterator2 first2, InputIterator2 last2)
+{
+    return nestl::includes(first1, last1, first2, last2, nestl::less<>());
+}
+
 } // namespace nestl
 
 #endif /* NESTL_ALGORITHM_HPP */
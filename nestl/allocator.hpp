@@ -3,6 +3,7 @@
 
 #include <nestl/config.hpp>
 
+#include <nestl/type_traits.hpp>
 
 #include <type_traits>
 #include <limits>
@@ -39,6 +40,8 @@ public:
     {
     }
 
+    allocator& operator=(const allocator&) = default;
+
     template <typename Y>
     allocator(const allocator<Y>& /* other */) NESTL_NOEXCEPT_SPEC
     {
@@ -66,6 +69,12 @@ public:
     }
 };
 
+/// @brief allocator is stateless, so it may be relocated by copying its bytes
+template <typename T>
+struct is_trivially_relocatable<allocator<T> > : public std::true_type
+{
+};
+
 } // namespace nestl
 
 #endif /* NESTL_ALLOCATOR_HPP */
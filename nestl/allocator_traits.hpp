@@ -26,6 +26,16 @@ struct allocator_traits
 	NESTL_SELECT_NESTED_TYPE(Allocator, propagate_on_container_move_assignment, std::false_type);
     typedef nestl_nested_type_propagate_on_container_move_assignment propagate_on_container_move_assignment;
 
+    NESTL_SELECT_NESTED_TYPE(Allocator, propagate_on_container_copy_assignment, std::false_type);
+    typedef nestl_nested_type_propagate_on_container_copy_assignment propagate_on_container_copy_assignment;
+
+    NESTL_SELECT_NESTED_TYPE(Allocator, propagate_on_container_swap, std::false_type);
+    typedef nestl_nested_type_propagate_on_container_swap propagate_on_container_swap;
+
+    /// @note allocators without state are always equal unless allocator says otherwise
+    NESTL_SELECT_NESTED_TYPE(Allocator, is_always_equal, typename std::is_empty<Allocator>::type);
+    typedef nestl_nested_type_is_always_equal         is_always_equal;
+
 	NESTL_SELECT_NESTED_TYPE(Allocator, size_type, std::size_t);
     typedef nestl_nested_type_size_type               size_type;
 
@@ -47,6 +57,54 @@ struct allocator_traits
     {
         alloc.deallocate(ptr, n);
     }
+
+    /**
+     * @brief Maximum number of elements which may be requested from allocator
+     *
+     * Uses method max_size of allocator if it exists
+     */
+    static size_type max_size(const Allocator& alloc) NESTL_NOEXCEPT_SPEC
+    {
+        return max_size_helper(alloc, 0);
+    }
+
+    /**
+     * @brief Number of elements which are actually available when n elements are requested
+     *
+     * Allocators usually round requests up to their internal size classes.
+     * Such allocator may provide method `size_type usable_size(size_type n) const`,
+     * so containers may use the slack. Otherwise n is returned.
+     */
+    static size_type usable_size(const Allocator& alloc, size_type n) NESTL_NOEXCEPT_SPEC
+    {
+        return usable_size_helper(alloc, n, 0);
+    }
+
+private:
+
+    template <typename A>
+    static auto max_size_helper(const A& alloc, int) NESTL_NOEXCEPT_SPEC -> decltype(alloc.max_size())
+    {
+        return alloc.max_size();
+    }
+
+    template <typename A>
+    static size_type max_size_helper(const A& /* alloc */, ...) NESTL_NOEXCEPT_SPEC
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    template <typename A>
+    static auto usable_size_helper(const A& alloc, size_type n, int) NESTL_NOEXCEPT_SPEC -> decltype(alloc.usable_size(n))
+    {
+        return alloc.usable_size(n);
+    }
+
+    template <typename A>
+    static size_type usable_size_helper(const A& /* alloc */, size_type n, ...) NESTL_NOEXCEPT_SPEC
+    {
+        return n;
+    }
 };
 
 } // namespace nestl
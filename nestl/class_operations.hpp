@@ -72,6 +72,17 @@ assign(OperationError& err, T& dest, Y&& src) NESTL_NOEXCEPT_SPEC
     detail::class_operations_helper::assign(err, dest, std::forward<Y>(src));
 }
 
+
+/// @brief Checks whether assign(err, T&, Y&&) is usable in current exception mode
+/// @note Without exceptions assignment should not throw
+template <typename T, typename Y>
+struct is_assignable : public std::integral_constant<bool,
+                                                     exception_support_t::value ?
+                                                         std::is_assignable<T&, Y>::value :
+                                                         std::is_nothrow_assignable<T&, Y>::value>
+{
+};
+
 } // namespace class_operations
 } // namespace nestl
 
@@ -3,10 +3,12 @@
 
 #include <nestl/config.hpp>
 
+#include <nestl/allocator_traits.hpp>
 #include <nestl/class_operations.hpp>
 
 #include <nestl/detail/select_type.hpp>
 
+#include <cassert>
 #include <utility>
 
 namespace nestl
@@ -54,6 +56,19 @@ void alloc_on_move(Alloc& src, Alloc& dst) NESTL_NOEXCEPT_SPEC
     alloc_on_move(src, dst, move_required());
 }
 
+/**
+ * @brief Checks whether container move assignment always takes storage of other container
+ *
+ * Otherwise containers with unequal allocators have to move elements one by one, which may fail,
+ * so such move is available via move_assign_nothrow only.
+ */
+template <typename Alloc>
+struct alloc_move_takes_storage
+    : std::integral_constant<bool, nestl::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+                                   nestl::allocator_traits<Alloc>::is_always_equal::value>
+{
+};
+
 
 template <typename OperationError, typename Alloc>
 void alloc_on_copy(OperationError& err, Alloc& src, const Alloc& dst, std::true_type) NESTL_NOEXCEPT_SPEC
@@ -75,6 +90,71 @@ void alloc_on_copy(OperationError& err, Alloc& src, const Alloc& dst) NESTL_NOEX
     alloc_on_copy(err, src, dst, copy_requred());
 }
 
+/**
+ * @brief Allocator which container should have after copy assignment from container with source allocator
+ */
+template <typename Alloc>
+const Alloc& alloc_for_copy(const Alloc& current, const Alloc& source) NESTL_NOEXCEPT_SPEC
+{
+    typedef nestl::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::propagate_on_container_copy_assignment copy_requred;
+
+    return copy_requred::value ? source : current;
+}
+
+
+template <typename Alloc>
+bool allocators_equal(const Alloc& /* left */, const Alloc& /* right */, std::true_type) NESTL_NOEXCEPT_SPEC
+{
+    return true;
+}
+
+template <typename Alloc>
+bool allocators_equal(const Alloc& left, const Alloc& right, std::false_type) NESTL_NOEXCEPT_SPEC
+{
+    return left == right;
+}
+
+/**
+ * @brief Checks whether memory allocated by one allocator may be deallocated by another one
+ *
+ * Allocators which are always equal are not required to provide operator==
+ */
+template <typename Alloc>
+bool allocators_equal(const Alloc& left, const Alloc& right) NESTL_NOEXCEPT_SPEC
+{
+    typedef nestl::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::is_always_equal always_equal;
+
+    return allocators_equal(left, right, always_equal());
+}
+
+
+template <typename Alloc>
+void alloc_on_swap(Alloc& left, Alloc& right, std::true_type) NESTL_NOEXCEPT_SPEC
+{
+    using std::swap;
+    swap(left, right);
+}
+
+template <typename Alloc>
+void alloc_on_swap(Alloc& left, Alloc& right, std::false_type) NESTL_NOEXCEPT_SPEC
+{
+    // containers with different allocators which do not propagate on swap can not exchange their storage
+    assert(allocators_equal(left, right));
+    (void)left;
+    (void)right;
+}
+
+template <typename Alloc>
+void alloc_on_swap(Alloc& left, Alloc& right) NESTL_NOEXCEPT_SPEC
+{
+    typedef nestl::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::propagate_on_container_swap swap_required;
+
+    alloc_on_swap(left, right, swap_required());
+}
+
 } // namespace detail
 } // namespace nestl
 
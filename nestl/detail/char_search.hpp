@@ -0,0 +1,757 @@
+#ifndef NESTL_DETAIL_CHAR_SEARCH_HPP
+#define NESTL_DETAIL_CHAR_SEARCH_HPP
+
+/**
+ * @file Search and comparison kernels for strings of char
+ *
+ * Each kernel set scans the same input in blocks of different width: scalar one processes
+ * single character, SSE2 one processes 16 characters, AVX2 one processes 32 characters.
+ * The widest set supported by processor is chosen at first use by CPUID, build flags are
+ * not required: vector kernels are compiled for their instruction set only.
+ *
+ * Define NESTL_DISABLE_SIMD to build scalar kernels only.
+ */
+
+#include <nestl/config.hpp>
+
+#include <cstddef>
+#include <string>
+
+#if !defined(NESTL_DISABLE_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#   define NESTL_HAS_X86_SIMD 1
+#else
+#   define NESTL_HAS_X86_SIMD 0
+#endif
+
+#if NESTL_HAS_X86_SIMD
+#   if NESTL_COMPILER == NESTL_COMPILER_MSVC
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#   include <immintrin.h>
+#endif
+
+namespace nestl
+{
+namespace detail
+{
+namespace char_search
+{
+
+/// @brief Set of kernels which scan the same way, so they may be compared with each other
+struct kernels
+{
+    /// name of instruction set
+    const char* name;
+
+    /// first occurrence of ch in [s, s + count), or nullptr
+    const char* (*find_char)(const char* s, std::size_t count, char ch);
+
+    /// last occurrence of ch in [s, s + count), or nullptr
+    const char* (*rfind_char)(const char* s, std::size_t count, char ch);
+
+    /// first character of [s, s + count) which is one of [set, set + setSize), or nullptr
+    const char* (*find_any)(const char* s, std::size_t count, const char* set, std::size_t setSize);
+
+    /// first occurrence of needle in [s, s + count), or nullptr; needleSize should be in [1, count]
+    const char* (*find)(const char* s, std::size_t count, const char* needle, std::size_t needleSize);
+
+    /// index of first different character of a and b, or count if they are equal
+    std::size_t (*mismatch)(const char* a, const char* b, std::size_t count);
+};
+
+
+namespace scalar
+{
+
+inline const char* find_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+{
+    for (const char* last = s + count; s != last; ++s)
+    {
+        if (*s == ch)
+        {
+            return s;
+        }
+    }
+
+    return nullptr;
+}
+
+inline const char* rfind_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+{
+    while (count > 0)
+    {
+        --count;
+        if (s[count] == ch)
+        {
+            return s + count;
+        }
+    }
+
+    return nullptr;
+}
+
+/// @brief Longer inputs are searched by table, building it costs more than direct comparison of short input
+const std::size_t max_direct_comparisons = 16;
+
+inline const char* find_any(const char* s, std::size_t count, const char* set, std::size_t setSize) NESTL_NOEXCEPT_SPEC
+{
+    if (count * setSize <= max_direct_comparisons)
+    {
+        for (const char* last = s + count; s != last; ++s)
+        {
+            if (find_char(set, setSize, *s))
+            {
+                return s;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool table[256] = {};
+    for (std::size_t i = 0; i != setSize; ++i)
+    {
+        table[static_cast<unsigned char>(set[i])] = true;
+    }
+
+    for (const char* last = s + count; s != last; ++s)
+    {
+        if (table[static_cast<unsigned char>(*s)])
+        {
+            return s;
+        }
+    }
+
+    return nullptr;
+}
+
+inline std::size_t mismatch(const char* a, const char* b, std::size_t count) NESTL_NOEXCEPT_SPEC
+{
+    std::size_t i = 0;
+    while (i != count && a[i] == b[i])
+    {
+        ++i;
+    }
+
+    return i;
+}
+
+inline const char* find(const char* s, std::size_t count, const char* needle, std::size_t needleSize) NESTL_NOEXCEPT_SPEC
+{
+    const char* last = s + count - needleSize + 1;
+    for (; s != last; ++s)
+    {
+        if (*s == needle[0] && mismatch(s + 1, needle + 1, needleSize - 1) == needleSize - 1)
+        {
+            return s;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace scalar
+
+
+inline const kernels& scalar_kernels() NESTL_NOEXCEPT_SPEC
+{
+    static const kernels res =
+    {
+        "scalar",
+        &scalar::find_char,
+        &scalar::rfind_char,
+        &scalar::find_any,
+        &scalar::find,
+        &scalar::mismatch
+    };
+
+    return res;
+}
+
+
+#if NESTL_HAS_X86_SIMD
+
+/// @brief Index of lowest set bit, mask should not be zero
+inline unsigned lowest_bit(unsigned mask) NESTL_NOEXCEPT_SPEC
+{
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC
+    unsigned long res;
+    _BitScanForward(&res, mask);
+    return static_cast<unsigned>(res);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+/// @brief Index of highest set bit, mask should not be zero
+inline unsigned highest_bit(unsigned mask) NESTL_NOEXCEPT_SPEC
+{
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC
+    unsigned long res;
+    _BitScanReverse(&res, mask);
+    return static_cast<unsigned>(res);
+#else
+    return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#endif
+}
+
+/// @brief Sets with more characters are searched by table of scalar kernel
+const std::size_t max_vector_set_size = 8;
+
+
+namespace sse2
+{
+
+const std::size_t block_size = 16;
+
+NESTL_TARGET("sse2")
+inline unsigned equal_mask(__m128i left, __m128i right) NESTL_NOEXCEPT_SPEC
+{
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(left, right)));
+}
+
+NESTL_TARGET("sse2")
+inline __m128i load(const char* s) NESTL_NOEXCEPT_SPEC
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+}
+
+NESTL_TARGET("sse2")
+inline const char* find_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+{
+    const __m128i pattern = _mm_set1_epi8(ch);
+
+    std::size_t i = 0;
+    for (; i + block_size <= count; i += block_size)
+    {
+        const unsigned mask = equal_mask(load(s + i), pattern);
+        if (mask != 0)
+        {
+            return s + i + lowest_bit(mask);
+        }
+    }
+
+    return scalar::find_char(s + i, count - i, ch);
+}
+
+NESTL_TARGET("sse2")
+inline const char* rfind_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+{
+    const __m128i pattern = _mm_set1_epi8(ch);
+
+    std::size_t i = count;
+    for (; i >= block_size; i -= block_size)
+    {
+        const unsigned mask = equal_mask(load(s + i - block_size), pattern);
+        if (mask != 0)
+        {
+            return s + i - block_size + highest_bit(mask);
+        }
+    }
+
+    return scalar::rfind_char(s, i, ch);
+}
+
+NESTL_TARGET("sse2")
+inline const char* find_any(const char* s, std::size_t count, const char* set, std::size_t setSize) NESTL_NOEXCEPT_SPEC
+{
+    if (setSize > max_vector_set_size)
+    {
+        return scalar::find_any(s, count, set, setSize);
+    }
+
+    __m128i patterns[max_vector_set_size];
+    for (std::size_t j = 0; j != setSize; ++j)
+    {
+        patterns[j] = _mm_set1_epi8(set[j]);
+    }
+
+    std::size_t i = 0;
+    for (; i + block_size <= count; i += block_size)
+    {
+        const __m128i block = load(s + i);
+
+        __m128i found = _mm_setzero_si128();
+        for (std::size_t j = 0; j != setSize; ++j)
+        {
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(block, patterns[j]));
+        }
+
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(found));
+        if (mask != 0)
+        {
+            return s + i + lowest_bit(mask);
+        }
+    }
+
+    return scalar::find_any(s + i, count - i, set, setSize);
+}
+
+NESTL_TARGET("sse2")
+inline std::size_t mismatch(const char* a, const char* b, std::size_t count) NESTL_NOEXCEPT_SPEC
+{
+    const unsigned allEqual = 0xFFFFu;
+
+    std::size_t i = 0;
+    for (; i + block_size <= count; i += block_size)
+    {
+        const unsigned mask = equal_mask(load(a + i), load(b + i));
+        if (mask != allEqual)
+        {
+            return i + lowest_bit(~mask & allEqual);
+        }
+    }
+
+    return i + scalar::mismatch(a + i, b + i, count - i);
+}
+
+/**
+ * Candidates are positions where both first and last characters of needle match,
+ * only they are compared completely
+ */
+NESTL_TARGET("sse2")
+inline const char* find(const char* s, std::size_t count, const char* needle, std::size_t needleSize) NESTL_NOEXCEPT_SPEC
+{
+    if (needleSize == 1)
+    {
+        return find_char(s, count, needle[0]);
+    }
+
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleSize - 1]);
+    const std::size_t positions = count - needleSize + 1;
+
+    std::size_t i = 0;
+    for (; i + block_size <= positions; i += block_size)
+    {
+        unsigned mask = equal_mask(load(s + i), first) & equal_mask(load(s + i + needleSize - 1), last);
+        while (mask != 0)
+        {
+            const std::size_t pos = i + lowest_bit(mask);
+            if (mismatch(s + pos + 1, needle + 1, needleSize - 2) == needleSize - 2)
+            {
+                return s + pos;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    return scalar::find(s + i, count - i, needle, needleSize);
+}
+
+} // namespace sse2
+
+
+namespace avx2
+{
+
+const std::size_t block_size = 32;
+
+NESTL_TARGET("avx2")
+inline unsigned equal_mask(__m256i left, __m256i right) NESTL_NOEXCEPT_SPEC
+{
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(left, right)));
+}
+
+NESTL_TARGET("avx2")
+inline __m256i load(const char* s) NESTL_NOEXCEPT_SPEC
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+}
+
+NESTL_TARGET("avx2")
+inline const char* find_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+{
+    const __m256i pattern = _mm256_set1_epi8(ch);
+
+    std::size_t i = 0;
+    for (; i + block_size <= count; i += block_size)
+    {
+        const unsigned mask = equal_mask(load(s + i), pattern);
+        if (mask != 0)
+        {
+            return s + i + lowest_bit(mask);
+        }
+    }
+
+    return sse2::find_char(s + i, count - i, ch);
+}
+
+NESTL_TARGET("avx2")
+inline const char* rfind_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+{
+    const __m256i pattern = _mm256_set1_epi8(ch);
+
+    std::size_t i = count;
+    for (; i >= block_size; i -= block_size)
+    {
+        const unsigned mask = equal_mask(load(s + i - block_size), pattern);
+        if (mask != 0)
+        {
+            return s + i - block_size + highest_bit(mask);
+        }
+    }
+
+    return sse2::rfind_char(s, i, ch);
+}
+
+NESTL_TARGET("avx2")
+inline const char* find_any(const char* s, std::size_t count, const char* set, std::size_t setSize) NESTL_NOEXCEPT_SPEC
+{
+    if (setSize > max_vector_set_size)
+    {
+        return scalar::find_any(s, count, set, setSize);
+    }
+
+    __m256i patterns[max_vector_set_size];
+    for (std::size_t j = 0; j != setSize; ++j)
+    {
+        patterns[j] = _mm256_set1_epi8(set[j]);
+    }
+
+    std::size_t i = 0;
+    for (; i + block_size <= count; i += block_size)
+    {
+        const __m256i block = load(s + i);
+
+        __m256i found = _mm256_setzero_si256();
+        for (std::size_t j = 0; j != setSize; ++j)
+        {
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(block, patterns[j]));
+        }
+
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(found));
+        if (mask != 0)
+        {
+            return s + i + lowest_bit(mask);
+        }
+    }
+
+    return sse2::find_any(s + i, count - i, set, setSize);
+}
+
+NESTL_TARGET("avx2")
+inline std::size_t mismatch(const char* a, const char* b, std::size_t count) NESTL_NOEXCEPT_SPEC
+{
+    const unsigned allEqual = 0xFFFFFFFFu;
+
+    std::size_t i = 0;
+    for (; i + block_size <= count; i += block_size)
+    {
+        const unsigned mask = equal_mask(load(a + i), load(b + i));
+        if (mask != allEqual)
+        {
+            return i + lowest_bit(~mask);
+        }
+    }
+
+    return i + sse2::mismatch(a + i, b + i, count - i);
+}
+
+NESTL_TARGET("avx2")
+inline const char* find(const char* s, std::size_t count, const char* needle, std::size_t needleSize) NESTL_NOEXCEPT_SPEC
+{
+    if (needleSize == 1)
+    {
+        return find_char(s, count, needle[0]);
+    }
+
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needleSize - 1]);
+    const std::size_t positions = count - needleSize + 1;
+
+    std::size_t i = 0;
+    for (; i + block_size <= positions; i += block_size)
+    {
+        unsigned mask = equal_mask(load(s + i), first) & equal_mask(load(s + i + needleSize - 1), last);
+        while (mask != 0)
+        {
+            const std::size_t pos = i + lowest_bit(mask);
+            if (mismatch(s + pos + 1, needle + 1, needleSize - 2) == needleSize - 2)
+            {
+                return s + pos;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    return sse2::find(s + i, count - i, needle, needleSize);
+}
+
+} // namespace avx2
+
+
+inline void cpuid(unsigned leaf, unsigned subleaf, unsigned (&regs)[4]) NESTL_NOEXCEPT_SPEC
+{
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC
+    int res[4];
+    __cpuidex(res, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i != 4; ++i)
+    {
+        regs[i] = static_cast<unsigned>(res[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/// @brief State of registers which is saved by operating system on context switch
+inline unsigned long long xgetbv() NESTL_NOEXCEPT_SPEC
+{
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC
+    return _xgetbv(0);
+#else
+    unsigned eax;
+    unsigned edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+inline bool cpu_has_sse2() NESTL_NOEXCEPT_SPEC
+{
+    unsigned regs[4];
+    cpuid(1, 0, regs);
+    return (regs[3] & (1u << 26)) != 0;
+}
+
+/// @brief AVX2 is usable only if operating system saves upper halves of vector registers
+inline bool cpu_has_avx2() NESTL_NOEXCEPT_SPEC
+{
+    unsigned regs[4];
+    cpuid(0, 0, regs);
+    if (regs[0] < 7)
+    {
+        return false;
+    }
+
+    cpuid(1, 0, regs);
+    const unsigned osxsave = 1u << 27;
+    const unsigned avx = 1u << 28;
+    if ((regs[2] & osxsave) == 0 || (regs[2] & avx) == 0)
+    {
+        return false;
+    }
+
+    const unsigned long long sseAndAvxState = 0x6;
+    if ((xgetbv() & sseAndAvxState) != sseAndAvxState)
+    {
+        return false;
+    }
+
+    cpuid(7, 0, regs);
+    return (regs[1] & (1u << 5)) != 0;
+}
+
+/// @brief Kernels for SSE2, or nullptr if processor does not support it
+inline const kernels* sse2_kernels() NESTL_NOEXCEPT_SPEC
+{
+    static const kernels res =
+    {
+        "sse2",
+        &sse2::find_char,
+        &sse2::rfind_char,
+        &sse2::find_any,
+        &sse2::find,
+        &sse2::mismatch
+    };
+
+    return cpu_has_sse2() ? &res : nullptr;
+}
+
+/// @brief Kernels for AVX2, or nullptr if processor does not support it
+inline const kernels* avx2_kernels() NESTL_NOEXCEPT_SPEC
+{
+    static const kernels res =
+    {
+        "avx2",
+        &avx2::find_char,
+        &avx2::rfind_char,
+        &avx2::find_any,
+        &avx2::find,
+        &avx2::mismatch
+    };
+
+    return (cpu_has_sse2() && cpu_has_avx2()) ? &res : nullptr;
+}
+
+#else /* NESTL_HAS_X86_SIMD */
+
+inline const kernels* sse2_kernels() NESTL_NOEXCEPT_SPEC
+{
+    return nullptr;
+}
+
+inline const kernels* avx2_kernels() NESTL_NOEXCEPT_SPEC
+{
+    return nullptr;
+}
+
+#endif /* NESTL_HAS_X86_SIMD */
+
+
+inline const kernels& choose_kernels() NESTL_NOEXCEPT_SPEC
+{
+    if (const kernels* res = avx2_kernels())
+    {
+        return *res;
+    }
+
+    if (const kernels* res = sse2_kernels())
+    {
+        return *res;
+    }
+
+    return scalar_kernels();
+}
+
+/// @brief Widest kernels supported by processor, processor is queried once
+inline const kernels& selected_kernels() NESTL_NOEXCEPT_SPEC
+{
+    static const kernels& res = choose_kernels();
+    return res;
+}
+
+/// @brief Shorter input is scanned in place: call through pointer costs more than the scan
+const std::size_t min_kernel_input = 16;
+
+} // namespace char_search
+
+
+/**
+ * @brief Search primitives of basic_string_view
+ *
+ * Generic version works through Traits, so custom character types and comparison rules are kept.
+ */
+template <typename CharType, typename Traits>
+struct string_search
+{
+    static const CharType* find_char(const CharType* s, std::size_t count, CharType ch) NESTL_NOEXCEPT_SPEC
+    {
+        return Traits::find(s, count, ch);
+    }
+
+    static const CharType* rfind_char(const CharType* s, std::size_t count, CharType ch) NESTL_NOEXCEPT_SPEC
+    {
+        while (count > 0)
+        {
+            --count;
+            if (Traits::eq(s[count], ch))
+            {
+                return s + count;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static const CharType* find_any(const CharType* s,
+                                    std::size_t count,
+                                    const CharType* set,
+                                    std::size_t setSize) NESTL_NOEXCEPT_SPEC
+    {
+        for (const CharType* last = s + count; s != last; ++s)
+        {
+            if (Traits::find(set, setSize, *s))
+            {
+                return s;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static const CharType* find(const CharType* s,
+                                std::size_t count,
+                                const CharType* needle,
+                                std::size_t needleSize) NESTL_NOEXCEPT_SPEC
+    {
+        const CharType* last = s + count - needleSize + 1;
+        for (const CharType* it = s; it != last; ++it)
+        {
+            it = Traits::find(it, last - it, needle[0]);
+            if (!it)
+            {
+                break;
+            }
+
+            if (Traits::compare(it + 1, needle + 1, needleSize - 1) == 0)
+            {
+                return it;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static int compare(const CharType* left, const CharType* right, std::size_t count) NESTL_NOEXCEPT_SPEC
+    {
+        return Traits::compare(left, right, count);
+    }
+};
+
+
+/**
+ * @brief Plain char is scanned by kernels of char_search
+ */
+template <>
+struct string_search<char, std::char_traits<char> >
+{
+    static const char* find_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+    {
+        if (count < char_search::min_kernel_input)
+        {
+            return char_search::scalar::find_char(s, count, ch);
+        }
+
+        return char_search::selected_kernels().find_char(s, count, ch);
+    }
+
+    static const char* rfind_char(const char* s, std::size_t count, char ch) NESTL_NOEXCEPT_SPEC
+    {
+        if (count < char_search::min_kernel_input)
+        {
+            return char_search::scalar::rfind_char(s, count, ch);
+        }
+
+        return char_search::selected_kernels().rfind_char(s, count, ch);
+    }
+
+    static const char* find_any(const char* s, std::size_t count, const char* set, std::size_t setSize) NESTL_NOEXCEPT_SPEC
+    {
+        return char_search::selected_kernels().find_any(s, count, set, setSize);
+    }
+
+    static const char* find(const char* s, std::size_t count, const char* needle, std::size_t needleSize) NESTL_NOEXCEPT_SPEC
+    {
+        if (count < char_search::min_kernel_input)
+        {
+            return char_search::scalar::find(s, count, needle, needleSize);
+        }
+
+        return char_search::selected_kernels().find(s, count, needle, needleSize);
+    }
+
+    /// @brief Characters are compared as unsigned char, as std::char_traits<char> does
+    static int compare(const char* left, const char* right, std::size_t count) NESTL_NOEXCEPT_SPEC
+    {
+        const std::size_t pos = (count < char_search::min_kernel_input)
+                              ? char_search::scalar::mismatch(left, right, count)
+                              : char_search::selected_kernels().mismatch(left, right, count);
+        if (pos == count)
+        {
+            return 0;
+        }
+
+        return static_cast<unsigned char>(left[pos]) < static_cast<unsigned char>(right[pos]) ? -1 : 1;
+    }
+};
+
+} // namespace detail
+} // namespace nestl
+
+#endif /* NESTL_DETAIL_CHAR_SEARCH_HPP */
@@ -5,6 +5,9 @@
 
 #define NESTL_UNUSED                             __attribute__((unused))
 
+/// @brief Allows instructions of given set in function, while the rest of code is compiled without them
+#define NESTL_TARGET(isa)                        __attribute__((target(isa)))
+
 #if defined(__EXCEPTIONS)
 #   define NESTL_HAS_EXCEPTIONS                  (__EXCEPTIONS == 1)
 #else /* __EXCEPTIONS */
@@ -71,7 +71,10 @@ struct deallocation_scoped_guard
 
     ~deallocation_scoped_guard() NESTL_NOEXCEPT_SPEC
     {
-        nestl::allocator_traits<Allocator>::deallocate(m_alloc, m_ptr, m_size);
+        if (m_ptr)
+        {
+            nestl::allocator_traits<Allocator>::deallocate(m_alloc, m_ptr, m_size);
+        }
     }
 
     void release()
@@ -0,0 +1,291 @@
+#ifndef NESTL_DETAIL_HASH_GROUP_HPP
+#define NESTL_DETAIL_HASH_GROUP_HPP
+
+/**
+ * @file Control bytes of open addressing hash table and their groups
+ *
+ * Each slot of table has one control byte: it is either empty, deleted (tombstone) or full.
+ * Control byte of full slot keeps 7 low bits of hash of its element, so probing compares keys
+ * only for slots whose bits match. Control bytes are scanned by groups: SSE2 group checks
+ * 16 bytes by one comparison, portable group checks 8 bytes packed in 64-bit word.
+ *
+ * SSE2 is part of x86-64, so SSE2 group is chosen at compile time whenever compiler targets it.
+ * Define NESTL_DISABLE_SIMD to use portable group only.
+ */
+
+#include <nestl/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(NESTL_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define NESTL_HAS_SSE2_GROUP 1
+#   include <emmintrin.h>
+#else
+#   define NESTL_HAS_SSE2_GROUP 0
+#endif
+
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC
+#   include <intrin.h>
+#endif
+
+namespace nestl
+{
+namespace detail
+{
+namespace hash_group
+{
+
+typedef signed char ctrl_t;
+
+/// slot was never used, so probing stops at it
+const ctrl_t ctrl_empty = -128;
+
+/// element of slot was erased, slot may be reused but probing continues past it
+const ctrl_t ctrl_deleted = -2;
+
+/// control byte after the last slot, iteration stops at it
+const ctrl_t ctrl_sentinel = -1;
+
+/// control byte of full slot is in [0, 127]
+inline bool is_full(ctrl_t ctrl) NESTL_NOEXCEPT_SPEC
+{
+    return ctrl >= 0;
+}
+
+inline bool is_empty_or_deleted(ctrl_t ctrl) NESTL_NOEXCEPT_SPEC
+{
+    return ctrl < ctrl_sentinel;
+}
+
+
+/// @brief Index of lowest set bit, x should not be zero
+inline unsigned trailing_zeros(std::uint64_t x) NESTL_NOEXCEPT_SPEC
+{
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC && defined(_M_X64)
+    unsigned long res;
+    _BitScanForward64(&res, x);
+    return static_cast<unsigned>(res);
+#elif NESTL_COMPILER == NESTL_COMPILER_MSVC
+    unsigned long res;
+    if (static_cast<std::uint32_t>(x) != 0)
+    {
+        _BitScanForward(&res, static_cast<std::uint32_t>(x));
+        return static_cast<unsigned>(res);
+    }
+    _BitScanForward(&res, static_cast<std::uint32_t>(x >> 32));
+    return static_cast<unsigned>(res) + 32;
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+/// @brief Number of zero bits above highest set bit, x should not be zero
+inline unsigned leading_zeros(std::uint64_t x) NESTL_NOEXCEPT_SPEC
+{
+#if NESTL_COMPILER == NESTL_COMPILER_MSVC && defined(_M_X64)
+    unsigned long res;
+    _BitScanReverse64(&res, x);
+    return 63u - static_cast<unsigned>(res);
+#elif NESTL_COMPILER == NESTL_COMPILER_MSVC
+    unsigned long res;
+    if ((x >> 32) != 0)
+    {
+        _BitScanReverse(&res, static_cast<std::uint32_t>(x >> 32));
+        return 31u - static_cast<unsigned>(res);
+    }
+    _BitScanReverse(&res, static_cast<std::uint32_t>(x));
+    return 63u - static_cast<unsigned>(res);
+#else
+    return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+}
+
+
+/**
+ * @brief Set of slots of one group
+ *
+ * Slot i is represented by bit i << Shift, so both one bit per slot (SSE2)
+ * and high bit of each byte (portable) masks are supported.
+ */
+template <typename T, unsigned Width, unsigned Shift>
+class bitmask
+{
+public:
+    explicit bitmask(T mask) NESTL_NOEXCEPT_SPEC
+        : m_mask(mask)
+    {
+    }
+
+    explicit operator bool() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_mask != 0;
+    }
+
+    /// index of first slot of set, set should not be empty
+    unsigned lowest() const NESTL_NOEXCEPT_SPEC
+    {
+        return hash_group::trailing_zeros(m_mask) >> Shift;
+    }
+
+    void clear_lowest() NESTL_NOEXCEPT_SPEC
+    {
+        m_mask &= m_mask - 1;
+    }
+
+    /// number of slots before the first one of set
+    unsigned trailing_zeros() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_mask == 0 ? Width : lowest();
+    }
+
+    /// number of slots after the last one of set
+    unsigned leading_zeros() const NESTL_NOEXCEPT_SPEC
+    {
+        if (m_mask == 0)
+        {
+            return Width;
+        }
+
+        // significant bits are moved to the top of 64-bit word
+        const unsigned extra = 64 - (Width << Shift);
+        return hash_group::leading_zeros(static_cast<std::uint64_t>(m_mask) << extra) >> Shift;
+    }
+
+private:
+    T m_mask;
+};
+
+
+#if NESTL_HAS_SSE2_GROUP
+
+/// @brief 16 control bytes checked by SSE2 comparisons
+class sse2_group
+{
+public:
+    static const std::size_t width = 16;
+
+    typedef bitmask<std::uint32_t, 16, 0> mask_type;
+
+    /// @note Load is unaligned, group may start at any slot
+    explicit sse2_group(const ctrl_t* pos) NESTL_NOEXCEPT_SPEC
+        : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)))
+    {
+    }
+
+    mask_type match(ctrl_t h2) const NESTL_NOEXCEPT_SPEC
+    {
+        return mask_type(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl))));
+    }
+
+    mask_type mask_empty() const NESTL_NOEXCEPT_SPEC
+    {
+        return match(ctrl_empty);
+    }
+
+    mask_type mask_empty_or_deleted() const NESTL_NOEXCEPT_SPEC
+    {
+        // empty and deleted are the only values less than sentinel
+        return mask_type(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), m_ctrl))));
+    }
+
+    /// number of empty or deleted slots at the beginning of group
+    unsigned count_leading_empty_or_deleted() const NESTL_NOEXCEPT_SPEC
+    {
+        const std::uint32_t mask = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), m_ctrl)));
+        return trailing_zeros(mask + 1);
+    }
+
+private:
+    __m128i m_ctrl;
+};
+
+#endif /* NESTL_HAS_SSE2_GROUP */
+
+
+/// @brief 8 control bytes checked by arithmetic on 64-bit word
+class portable_group
+{
+    static const std::uint64_t lsbs = 0x0101010101010101ull;
+    static const std::uint64_t msbs = 0x8080808080808080ull;
+
+public:
+    static const std::size_t width = 8;
+
+    typedef bitmask<std::uint64_t, 8, 3> mask_type;
+
+    explicit portable_group(const ctrl_t* pos) NESTL_NOEXCEPT_SPEC
+    {
+        std::memcpy(&m_ctrl, pos, sizeof(m_ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        m_ctrl = __builtin_bswap64(m_ctrl);
+#endif
+    }
+
+    /**
+     * @note Byte following true match may be reported as false positive,
+     * such byte is always full, so probing just compares one more key
+     */
+    mask_type match(ctrl_t h2) const NESTL_NOEXCEPT_SPEC
+    {
+        const std::uint64_t x = m_ctrl ^ (lsbs * static_cast<unsigned char>(h2));
+        return mask_type((x - lsbs) & ~x & msbs);
+    }
+
+    mask_type mask_empty() const NESTL_NOEXCEPT_SPEC
+    {
+        // empty is the only value with high bit set and bit 1 clear
+        return mask_type(m_ctrl & ~(m_ctrl << 6) & msbs);
+    }
+
+    mask_type mask_empty_or_deleted() const NESTL_NOEXCEPT_SPEC
+    {
+        // empty and deleted are the only values with high bit set and bit 0 clear
+        return mask_type(m_ctrl & ~(m_ctrl << 7) & msbs);
+    }
+
+    /// number of empty or deleted slots at the beginning of group
+    unsigned count_leading_empty_or_deleted() const NESTL_NOEXCEPT_SPEC
+    {
+        // carry of increment runs through bytes of leading empty or deleted slots
+        const std::uint64_t x = (m_ctrl & ~(m_ctrl << 7) & msbs) | ~msbs;
+        const std::uint64_t y = x + 1;
+        return y == 0 ? static_cast<unsigned>(width) : trailing_zeros(y) >> 3;
+    }
+
+private:
+    std::uint64_t m_ctrl;
+};
+
+
+#if NESTL_HAS_SSE2_GROUP
+typedef sse2_group group;
+#else
+typedef portable_group group;
+#endif
+
+
+/**
+ * @brief Control bytes of table without slots
+ *
+ * Sentinel is the first byte, so iteration over empty table stops immediately,
+ * the rest is empty, so lookup does not find anything.
+ */
+inline ctrl_t* empty_group() NESTL_NOEXCEPT_SPEC
+{
+    alignas(16) static const ctrl_t ctrl[16] = {
+        ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+        ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty
+    };
+
+    // table of zero capacity never writes control bytes
+    return const_cast<ctrl_t*>(ctrl);
+}
+
+} // namespace hash_group
+} // namespace detail
+} // namespace nestl
+
+#endif /* NESTL_DETAIL_HASH_GROUP_HPP */
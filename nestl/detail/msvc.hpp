@@ -16,6 +16,9 @@
 
 #define NESTL_UNUSED
 
+/// @brief Intrinsics of any instruction set are available without attribute
+#define NESTL_TARGET(isa)
+
 #if !defined(_CPPUNWIND)
 #   define NESTL_HAS_EXCEPTIONS                  0
 #else /* _CPPUNWIND */
@@ -0,0 +1,380 @@
+#ifndef NESTL_DETAIL_NODE_POOL_HPP
+#define NESTL_DETAIL_NODE_POOL_HPP
+
+/**
+ * @file Pool of fixed size blocks for node based containers
+ *
+ * Memory is requested from global operator new by slabs, each slab is carved into blocks of equal size.
+ * Freed blocks are kept in intrusive free list and reused by following allocations.
+ */
+
+#include <nestl/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#   include <immintrin.h>
+#   define NESTL_SPIN_PAUSE() _mm_pause()
+#else
+#   define NESTL_SPIN_PAUSE() ((void)0)
+#endif
+
+namespace nestl
+{
+namespace detail
+{
+
+/// @brief Minimal lock for short critical sections which never throws
+class spin_lock
+{
+public:
+    spin_lock() NESTL_NOEXCEPT_SPEC
+        : m_locked(false)
+    {
+    }
+
+    void lock() NESTL_NOEXCEPT_SPEC
+    {
+        while (m_locked.exchange(true, std::memory_order_acquire))
+        {
+            /// waiting threads only read the flag, so its cache line is not bounced between them,
+            /// and give their time slice away if the lock is held for long
+            for (unsigned spins = 0; m_locked.load(std::memory_order_relaxed); ++spins)
+            {
+                if (spins < max_spins)
+                {
+                    NESTL_SPIN_PAUSE();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    void unlock() NESTL_NOEXCEPT_SPEC
+    {
+        m_locked.store(false, std::memory_order_release);
+    }
+
+private:
+    spin_lock(const spin_lock&) = delete;
+    spin_lock& operator=(const spin_lock&) = delete;
+
+    static const unsigned max_spins = 64;
+
+    std::atomic<bool> m_locked;
+};
+
+
+/// @brief Lock which does nothing, for pools used by single thread
+struct null_lock
+{
+    void lock() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    void unlock() NESTL_NOEXCEPT_SPEC
+    {
+    }
+};
+
+
+/// @brief Locks given lock in constructor and unlocks it in destructor
+template <typename Lock>
+class lock_guard
+{
+public:
+    explicit lock_guard(Lock& lock) NESTL_NOEXCEPT_SPEC
+        : m_lock(lock)
+    {
+        m_lock.lock();
+    }
+
+    ~lock_guard() NESTL_NOEXCEPT_SPEC
+    {
+        m_lock.unlock();
+    }
+
+private:
+    lock_guard(const lock_guard&) = delete;
+    lock_guard& operator=(const lock_guard&) = delete;
+
+    Lock& m_lock;
+};
+
+
+/**
+ * @brief Pool of blocks which can hold objects of given size and alignment
+ *
+ * Pool is not thread safe, all slabs are released by destructor.
+ */
+template <std::size_t Size, std::size_t Alignment>
+class node_pool
+{
+    struct free_block
+    {
+        free_block* m_next;
+    };
+
+    struct slab_header
+    {
+        slab_header* m_next;
+    };
+
+    static const std::size_t raw_alignment = (Alignment > alignof(free_block)) ? Alignment : alignof(free_block);
+    static const std::size_t raw_size = (Size > sizeof(free_block)) ? Size : sizeof(free_block);
+
+    static_assert(raw_alignment <= alignof(std::max_align_t), "over-aligned types are not supported by node_pool");
+
+public:
+
+    /// @brief alignment of each block
+    static const std::size_t block_alignment = raw_alignment;
+
+    /// @brief size of each block, big enough to keep pointer of free list
+    static const std::size_t block_size = (raw_size + block_alignment - 1) / block_alignment * block_alignment;
+
+    /// @brief number of blocks in each slab, slab takes about 4 KiB
+    static const std::size_t blocks_per_slab = (4096 / block_size > 16) ? 4096 / block_size : 16;
+
+    node_pool() NESTL_NOEXCEPT_SPEC
+        : m_free_list(nullptr)
+        , m_slabs(nullptr)
+        , m_slab_count(0)
+    {
+    }
+
+    ~node_pool() NESTL_NOEXCEPT_SPEC
+    {
+        release();
+    }
+
+    /**
+     * @brief Returns block from free list, allocates new slab if free list is empty
+     *
+     * @note bad_alloc is reported if slab can not be allocated
+     */
+    template <typename OperationError>
+    void* allocate(OperationError& err) NESTL_NOEXCEPT_SPEC
+    {
+        if (!m_free_list)
+        {
+            add_slab(err);
+            if (err)
+            {
+                return nullptr;
+            }
+        }
+
+        free_block* block = m_free_list;
+        m_free_list = block->m_next;
+
+        return block;
+    }
+
+    /// @brief Returns block to free list, memory is not released until pool is destroyed
+    void deallocate(void* ptr) NESTL_NOEXCEPT_SPEC
+    {
+        free_block* block = ::new(ptr) free_block;
+        block->m_next = m_free_list;
+        m_free_list = block;
+    }
+
+    /// @brief Releases all slabs, all blocks should be deallocated already
+    void release() NESTL_NOEXCEPT_SPEC
+    {
+        while (m_slabs)
+        {
+            slab_header* next = m_slabs->m_next;
+            ::operator delete(m_slabs);
+            m_slabs = next;
+        }
+
+        m_free_list = nullptr;
+        m_slab_count = 0;
+    }
+
+    std::size_t slab_count() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_slab_count;
+    }
+
+private:
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    static const std::size_t header_size = (sizeof(slab_header) + block_alignment - 1) / block_alignment * block_alignment;
+
+    template <typename OperationError>
+    void add_slab(OperationError& err) NESTL_NOEXCEPT_SPEC
+    {
+        void* memory = ::operator new(header_size + blocks_per_slab * block_size, std::nothrow);
+        if (!memory)
+        {
+            build_bad_alloc(err);
+            return;
+        }
+
+        slab_header* slab = ::new(memory) slab_header;
+        slab->m_next = m_slabs;
+        m_slabs = slab;
+        ++m_slab_count;
+
+        /// blocks are linked in reverse order, so first allocations go in address order
+        char* first = static_cast<char*>(memory) + header_size;
+        for (std::size_t i = blocks_per_slab; i != 0; --i)
+        {
+            deallocate(first + (i - 1) * block_size);
+        }
+    }
+
+    free_block* m_free_list;
+    slab_header* m_slabs;
+    std::size_t m_slab_count;
+};
+
+
+/**
+ * @brief Pools of one thread, one pool per block size
+ *
+ * Pools are alive while their thread runs or anything refers to them: allocators and blocks
+ * taken from pools hold references, so containers may outlive the thread which created them.
+ * Reference counter is not synchronized, so allocators and blocks should stay in one thread.
+ */
+class thread_node_pools
+{
+    struct entry
+    {
+        entry* m_next;
+        const void* m_key;
+        void (*m_destroy)(entry*);
+    };
+
+    template <typename Pool>
+    struct pool_entry : public entry
+    {
+        Pool m_pool;
+    };
+
+    /// @brief Address of value identifies pool type
+    template <typename Pool>
+    struct pool_key
+    {
+        static const char value;
+    };
+
+public:
+
+    /// @brief Pools of current thread (with new reference), nullptr if they can not be allocated
+    static thread_node_pools* acquire_current() NESTL_NOEXCEPT_SPEC
+    {
+        static thread_local thread_guard guard;
+
+        if (guard.m_pools)
+        {
+            guard.m_pools->acquire();
+        }
+        return guard.m_pools;
+    }
+
+    void acquire() NESTL_NOEXCEPT_SPEC
+    {
+        ++m_refs;
+    }
+
+    /// @brief Pools are destroyed with the last reference
+    void release() NESTL_NOEXCEPT_SPEC
+    {
+        if (--m_refs == 0)
+        {
+            delete this;
+        }
+    }
+
+    /// @brief Pool of given type, it is created on first request. Returns nullptr if pool can not be allocated
+    template <typename Pool>
+    Pool* pool() NESTL_NOEXCEPT_SPEC
+    {
+        for (entry* cur = m_entries; cur; cur = cur->m_next)
+        {
+            if (cur->m_key == &pool_key<Pool>::value)
+            {
+                return &static_cast<pool_entry<Pool>*>(cur)->m_pool;
+            }
+        }
+
+        pool_entry<Pool>* res = ::new(std::nothrow) pool_entry<Pool>();
+        if (!res)
+        {
+            return nullptr;
+        }
+
+        res->m_next = m_entries;
+        res->m_key = &pool_key<Pool>::value;
+        res->m_destroy = &destroy_entry<Pool>;
+        m_entries = res;
+
+        return &res->m_pool;
+    }
+
+private:
+    thread_node_pools(const thread_node_pools&) = delete;
+    thread_node_pools& operator=(const thread_node_pools&) = delete;
+
+    /// @brief Holds reference of running thread
+    struct thread_guard
+    {
+        thread_guard() NESTL_NOEXCEPT_SPEC
+            : m_pools(::new(std::nothrow) thread_node_pools())
+        {
+        }
+
+        ~thread_guard() NESTL_NOEXCEPT_SPEC
+        {
+            if (m_pools)
+            {
+                m_pools->release();
+            }
+        }
+
+        thread_node_pools* m_pools;
+    };
+
+    thread_node_pools() NESTL_NOEXCEPT_SPEC
+        : m_entries(nullptr)
+        , m_refs(1)
+    {
+    }
+
+    ~thread_node_pools() NESTL_NOEXCEPT_SPEC
+    {
+        while (m_entries)
+        {
+            entry* next = m_entries->m_next;
+            m_entries->m_destroy(m_entries);
+            m_entries = next;
+        }
+    }
+
+    template <typename Pool>
+    static void destroy_entry(entry* ptr) NESTL_NOEXCEPT_SPEC
+    {
+        delete static_cast<pool_entry<Pool>*>(ptr);
+    }
+
+    entry* m_entries;
+    std::size_t m_refs;
+};
+
+template <typename Pool>
+const char thread_node_pools::pool_key<Pool>::value = 0;
+
+} // namespace detail
+} // namespace nestl
+
+#endif /* NESTL_DETAIL_NODE_POOL_HPP */
@@ -0,0 +1,208 @@
+#ifndef NESTL_DETAIL_RELOCATE_HPP
+#define NESTL_DETAIL_RELOCATE_HPP
+
+/**
+ * @file Relocation of objects to uninitialised memory
+ *
+ * Relocation is move construction to new location followed by destruction of source.
+ * Depending on element type it is performed by plain memcpy, by nothrow move construction or by copying.
+ */
+
+#include <nestl/config.hpp>
+
+#include <nestl/type_traits.hpp>
+#include <nestl/class_operations.hpp>
+
+#include <nestl/detail/destroy.hpp>
+#include <nestl/detail/uninitialised_copy.hpp>
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace nestl
+{
+namespace detail
+{
+
+/// @brief Objects may be relocated by copying their bytes
+struct relocate_bitwise_tag
+{
+};
+
+/// @brief Objects may be relocated by nothrow move construction
+struct relocate_move_tag
+{
+};
+
+/// @brief Objects should be copied, relocation may fail
+struct relocate_copy_tag
+{
+};
+
+template <typename T>
+struct relocate_category
+{
+    typedef typename std::conditional<nestl::is_trivially_relocatable<T>::value,
+                                      relocate_bitwise_tag,
+                                      typename std::conditional<std::is_nothrow_move_constructible<T>::value,
+                                                                relocate_move_tag,
+                                                                relocate_copy_tag>::type>::type type;
+};
+
+/// @brief Relocation of given type never fails
+template <typename T>
+struct is_nothrow_relocatable
+    : public std::integral_constant<bool, !std::is_same<typename relocate_category<T>::type, relocate_copy_tag>::value>
+{
+};
+
+
+template <typename OperationError, typename T>
+T* uninitialised_relocate(OperationError& /* err */,
+                          T* first,
+                          T* last,
+                          T* output,
+                          relocate_bitwise_tag /* tag */) NESTL_NOEXCEPT_SPEC
+{
+    if (first != last)
+    {
+        std::memcpy(static_cast<void*>(output), static_cast<const void*>(first), (last - first) * sizeof(T));
+    }
+
+    return output + (last - first);
+}
+
+template <typename OperationError, typename T>
+T* uninitialised_relocate(OperationError& /* err */,
+                          T* first,
+                          T* last,
+                          T* output,
+                          relocate_move_tag /* tag */) NESTL_NOEXCEPT_SPEC
+{
+    for ( ; first != last; ++first, ++output)
+    {
+        ::new(static_cast<void*>(output)) T(std::move(*first));
+    }
+
+    return output;
+}
+
+template <typename OperationError, typename T>
+T* uninitialised_relocate(OperationError& err,
+                          T* first,
+                          T* last,
+                          T* output,
+                          relocate_copy_tag /* tag */) NESTL_NOEXCEPT_SPEC
+{
+    return nestl::detail::uninitialised_copy(err, first, last, output);
+}
+
+/**
+ * @brief First phase of relocation: constructs copy of [first, last) in uninitialised memory at output
+ *
+ * Source range stays alive (possibly in moved-from state) until destroy_relocated is called.
+ * On failure nothing is constructed at output and source range is left untouched.
+ */
+template <typename OperationError, typename T>
+T* uninitialised_relocate(OperationError& err, T* first, T* last, T* output) NESTL_NOEXCEPT_SPEC
+{
+    return uninitialised_relocate(err, first, last, output, typename relocate_category<T>::type());
+}
+
+
+template <typename T>
+void destroy_relocated(T* /* first */, T* /* last */, relocate_bitwise_tag /* tag */) NESTL_NOEXCEPT_SPEC
+{
+    // bytes already belong to new location, nothing to destroy
+}
+
+template <typename T, typename Tag>
+void destroy_relocated(T* first, T* last, Tag /* tag */) NESTL_NOEXCEPT_SPEC
+{
+    nestl::detail::destroy(first, last);
+}
+
+/**
+ * @brief Second phase of relocation: finishes lifetime of source range after successful uninitialised_relocate
+ */
+template <typename T>
+void destroy_relocated(T* first, T* last) NESTL_NOEXCEPT_SPEC
+{
+    destroy_relocated(first, last, typename relocate_category<T>::type());
+}
+
+
+/**
+ * @brief Relocates [first, last) into uninitialised memory at output
+ *
+ * On success source range is not alive anymore, on failure source range is left untouched
+ */
+template <typename OperationError, typename T>
+T* relocate(OperationError& err, T* first, T* last, T* output) NESTL_NOEXCEPT_SPEC
+{
+    T* res = uninitialised_relocate(err, first, last, output);
+    if (err)
+    {
+        return res;
+    }
+
+    destroy_relocated(first, last);
+    return res;
+}
+
+
+template <typename T>
+void relocate_overlapping(T* first, T* last, T* output, relocate_bitwise_tag /* tag */) NESTL_NOEXCEPT_SPEC
+{
+    if (first != last)
+    {
+        std::memmove(static_cast<void*>(output), static_cast<const void*>(first), (last - first) * sizeof(T));
+    }
+}
+
+template <typename T>
+void relocate_overlapping(T* first, T* last, T* output, relocate_move_tag /* tag */) NESTL_NOEXCEPT_SPEC
+{
+    if (output < first)
+    {
+        for ( ; first != last; ++first, ++output)
+        {
+            ::new(static_cast<void*>(output)) T(std::move(*first));
+            nestl::detail::destroy(first);
+        }
+    }
+    else if (output > first)
+    {
+        output += (last - first);
+        while (last != first)
+        {
+            --last;
+            --output;
+            ::new(static_cast<void*>(output)) T(std::move(*last));
+            nestl::detail::destroy(last);
+        }
+    }
+}
+
+/**
+ * @brief Relocates [first, last) to output, destination range may overlap with source one
+ *
+ * Memory of destination range which does not overlap with source one should be uninitialised,
+ * after relocation memory of source range which does not overlap with destination one becomes uninitialised.
+ *
+ * @note Available only for nothrow relocatable types
+ */
+template <typename T>
+void relocate_overlapping(T* first, T* last, T* output) NESTL_NOEXCEPT_SPEC
+{
+    static_assert(is_nothrow_relocatable<T>::value, "relocation of overlapping ranges requires nothrow relocatable type");
+
+    relocate_overlapping(first, last, output, typename relocate_category<T>::type());
+}
+
+} // namespace detail
+} // namespace nestl
+
+#endif /* NESTL_DETAIL_RELOCATE_HPP */
@@ -0,0 +1,76 @@
+#ifndef NESTL_DETAIL_REPEAT_ITERATOR_HPP
+#define NESTL_DETAIL_REPEAT_ITERATOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <cstddef>
+#include <iterator>
+
+namespace nestl
+{
+namespace detail
+{
+
+/**
+ * @brief Forward iterator over range which consists of the same value repeated several times
+ *
+ * Allows to insert count copies of value by algorithms which accept ranges
+ */
+template <typename T>
+class repeat_iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T                         value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef const T*                  pointer;
+    typedef const T&                  reference;
+
+    repeat_iterator(const T& value, std::size_t index) NESTL_NOEXCEPT_SPEC
+        : m_value(&value)
+        , m_index(index)
+    {
+    }
+
+    reference operator*() const NESTL_NOEXCEPT_SPEC
+    {
+        return *m_value;
+    }
+
+    pointer operator->() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_value;
+    }
+
+    repeat_iterator& operator++() NESTL_NOEXCEPT_SPEC
+    {
+        ++m_index;
+        return *this;
+    }
+
+    repeat_iterator operator++(int) NESTL_NOEXCEPT_SPEC
+    {
+        repeat_iterator res = *this;
+        ++m_index;
+        return res;
+    }
+
+    bool operator==(const repeat_iterator& other) const NESTL_NOEXCEPT_SPEC
+    {
+        return m_index == other.m_index;
+    }
+
+    bool operator!=(const repeat_iterator& other) const NESTL_NOEXCEPT_SPEC
+    {
+        return m_index != other.m_index;
+    }
+
+private:
+    const T* m_value;
+    std::size_t m_index;
+};
+
+} // namespace detail
+} // namespace nestl
+
+#endif /* NESTL_DETAIL_REPEAT_ITERATOR_HPP */
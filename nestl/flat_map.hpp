@@ -0,0 +1,20 @@
+#ifndef NESTL_FLAT_MAP_HPP
+#define NESTL_FLAT_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/exception_support.hpp>
+
+#include <nestl/has_exceptions/flat_map.hpp>
+#include <nestl/no_exceptions/flat_map.hpp>
+
+namespace nestl
+{
+
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<std::pair<Key, T> > >
+using flat_map = exception_support::dispatch<has_exceptions::flat_map<Key, T, Compare, Alloc>,
+                                             no_exceptions::flat_map<Key, T, Compare, Alloc>>;
+
+} // namespace nestl
+
+#endif /* NESTL_FLAT_MAP_HPP */
@@ -0,0 +1,19 @@
+#ifndef NESTL_FLAT_SET_HPP
+#define NESTL_FLAT_SET_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/exception_support.hpp>
+
+#include <nestl/has_exceptions/flat_set.hpp>
+#include <nestl/no_exceptions/flat_set.hpp>
+
+namespace nestl
+{
+
+template<typename Key, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<Key> >
+using flat_set = exception_support::dispatch<has_exceptions::flat_set<Key, Compare, Alloc>, no_exceptions::flat_set<Key, Compare, Alloc>>;
+
+} // namespace nestl
+
+#endif /* NESTL_FLAT_SET_HPP */
@@ -0,0 +1,77 @@
+#ifndef NESTL_FUNCTIONAL_HPP
+#define NESTL_FUNCTIONAL_HPP
+
+#include <nestl/config.hpp>
+
+#include <functional>
+#include <utility>
+
+/**
+ * @file Function objects which are missing in C++-11
+ */
+
+namespace nestl
+{
+
+/**
+ * @brief Same as std::less<T>, less<> (less<void>) is transparent comparator of C++-14
+ *
+ * Ordered containers with less<> accept any argument comparable with keys in lookup methods,
+ * for example set<string, less<>> is searched by const char* or string_view without building temporary string.
+ */
+template <typename T = void>
+struct less : public std::less<T>
+{
+};
+
+template <>
+struct less<void>
+{
+    typedef void is_transparent;
+
+    template <typename Left, typename Right>
+    auto operator()(Left&& left, Right&& right) const NESTL_NOEXCEPT_SPEC
+        -> decltype(std::forward<Left>(left) < std::forward<Right>(right))
+    {
+        return std::forward<Left>(left) < std::forward<Right>(right);
+    }
+};
+
+/**
+ * @brief Same as std::equal_to<T>, equal_to<> (equal_to<void>) is transparent as in C++-14
+ */
+template <typename T = void>
+struct equal_to : public std::equal_to<T>
+{
+};
+
+template <>
+struct equal_to<void>
+{
+    typedef void is_transparent;
+
+    template <typename Left, typename Right>
+    auto operator()(Left&& left, Right&& right) const NESTL_NOEXCEPT_SPEC
+        -> decltype(std::forward<Left>(left) == std::forward<Right>(right))
+    {
+        return std::forward<Left>(left) == std::forward<Right>(right);
+    }
+};
+
+
+/**
+ * @brief Hash used by nestl unordered containers, same as std::hash<T> unless specialized
+ *
+ * nestl strings and string views are hashed by content, their hashes declare is_transparent,
+ * so containers with equal_to<> may be searched by any string-like argument.
+ *
+ * @note Unordered containers mix result themselves, so identity hash of integers is fine
+ */
+template <typename T>
+struct hash : public std::hash<T>
+{
+};
+
+} // namespace nestl
+
+#endif /* NESTL_FUNCTIONAL_HPP */
@@ -0,0 +1,185 @@
+#ifndef NESTL_GROWTH_POLICY_HPP
+#define NESTL_GROWTH_POLICY_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/allocator_traits.hpp>
+
+#include <cstddef>
+#include <limits>
+
+/**
+ * @file Growth policies for contiguous containers
+ *
+ * Growth policy decides how many elements should be allocated when container needs more storage.
+ * Each policy provides following static methods:
+ * @code
+ * /// capacity for container of current capacity which needs at least required elements
+ * template <typename Allocator>
+ * static std::size_t grow(const Allocator& alloc, std::size_t current, std::size_t required, std::size_t maxSize) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// capacity for explicit request (reserve) of at least required elements
+ * template <typename Allocator>
+ * static std::size_t reserve(const Allocator& alloc, std::size_t required, std::size_t maxSize) NESTL_NOEXCEPT_SPEC;
+ * @endcode
+ *
+ * Caller guarantees that required <= maxSize, result should be in range [required, maxSize].
+ */
+
+namespace nestl
+{
+namespace detail
+{
+
+/// @brief Computes value * Numerator / Denominator without overflow, saturates at limit
+inline
+std::size_t scale_saturated(std::size_t value,
+                            std::size_t numerator,
+                            std::size_t denominator,
+                            std::size_t limit) NESTL_NOEXCEPT_SPEC
+{
+    const std::size_t whole = value / denominator;
+    const std::size_t rest = value % denominator;
+
+    if (whole > limit / numerator)
+    {
+        return limit;
+    }
+
+    const std::size_t res = whole * numerator + (rest * numerator) / denominator;
+    return (res > limit) ? limit : res;
+}
+
+/// @brief Extends capacity up to size which allocator actually provides for it
+template <typename Allocator>
+std::size_t take_allocator_slack(const Allocator& alloc, std::size_t capacity, std::size_t maxSize) NESTL_NOEXCEPT_SPEC
+{
+    const std::size_t usable = nestl::allocator_traits<Allocator>::usable_size(alloc, capacity);
+
+    return (usable > capacity && usable <= maxSize) ? usable : capacity;
+}
+
+} // namespace detail
+
+
+/**
+ * @brief Multiplies capacity by Numerator / Denominator on each growth
+ */
+template <std::size_t Numerator, std::size_t Denominator>
+struct geometric_growth_policy
+{
+    static_assert(Numerator > Denominator, "growth factor should be greater than 1");
+    static_assert(Denominator > 0, "denominator should not be zero");
+
+    template <typename Allocator>
+    static std::size_t grow(const Allocator& alloc,
+                            std::size_t current,
+                            std::size_t required,
+                            std::size_t maxSize) NESTL_NOEXCEPT_SPEC
+    {
+        std::size_t increment = nestl::detail::scale_saturated(current, Numerator - Denominator, Denominator, maxSize);
+        if (increment == 0)
+        {
+            increment = 1;
+        }
+
+        std::size_t res = (current > maxSize - increment) ? maxSize : current + increment;
+        if (res < required)
+        {
+            res = required;
+        }
+
+        return nestl::detail::take_allocator_slack(alloc, res, maxSize);
+    }
+
+    template <typename Allocator>
+    static std::size_t reserve(const Allocator& alloc, std::size_t required, std::size_t maxSize) NESTL_NOEXCEPT_SPEC
+    {
+        return nestl::detail::take_allocator_slack(alloc, required, maxSize);
+    }
+};
+
+/// @brief Growth by 1.5, good balance between number of reallocations and memory overhead
+typedef geometric_growth_policy<3, 2> default_growth_policy;
+
+/// @brief Growth by 2, minimal number of reallocations for append-heavy workloads
+typedef geometric_growth_policy<2, 1> doubling_growth_policy;
+
+/// @brief Growth by 1.25, for memory constrained environments
+typedef geometric_growth_policy<5, 4> conservative_growth_policy;
+
+
+/**
+ * @brief Rounds capacity computed by BasePolicy up to typical allocator size class
+ *
+ * Size classes are multiples of 16 bytes up to 128 bytes, then four classes per each power of two
+ * (like in jemalloc or tcmalloc), so memory which allocator would waste on rounding is used by container.
+ */
+template <typename BasePolicy = default_growth_policy>
+struct size_class_growth_policy
+{
+    template <typename Allocator>
+    static std::size_t grow(const Allocator& alloc,
+                            std::size_t current,
+                            std::size_t required,
+                            std::size_t maxSize) NESTL_NOEXCEPT_SPEC
+    {
+        return round_up(alloc, BasePolicy::grow(alloc, current, required, maxSize), maxSize);
+    }
+
+    template <typename Allocator>
+    static std::size_t reserve(const Allocator& alloc, std::size_t required, std::size_t maxSize) NESTL_NOEXCEPT_SPEC
+    {
+        return round_up(alloc, BasePolicy::reserve(alloc, required, maxSize), maxSize);
+    }
+
+    /// @brief Size of smallest size class which can hold given number of bytes (or bytes itself on overflow)
+    static std::size_t size_class(std::size_t bytes) NESTL_NOEXCEPT_SPEC
+    {
+        const std::size_t minimalSpacing = 16;
+        const std::size_t smallLimit = 128;
+
+        std::size_t spacing = minimalSpacing;
+        if (bytes > smallLimit)
+        {
+            std::size_t power = smallLimit;
+            while (power < (bytes - 1) / 2 + 1)
+            {
+                power *= 2;
+            }
+            spacing = power / 4;
+        }
+
+        const std::size_t rest = bytes % spacing;
+        if (rest == 0)
+        {
+            return bytes;
+        }
+
+        const std::size_t padding = spacing - rest;
+        return (bytes > std::numeric_limits<std::size_t>::max() - padding) ? bytes : bytes + padding;
+    }
+
+private:
+
+    template <typename Allocator>
+    static std::size_t round_up(const Allocator& alloc, std::size_t capacity, std::size_t maxSize) NESTL_NOEXCEPT_SPEC
+    {
+        typedef typename nestl::allocator_traits<Allocator>::value_type value_type;
+
+        if (capacity == 0)
+        {
+            return capacity;
+        }
+
+        /// capacity <= maxSize, so this multiplication does not overflow for sane allocators
+        const std::size_t elements = size_class(capacity * sizeof(value_type)) / sizeof(value_type);
+        const std::size_t res = (elements > maxSize) ? maxSize : elements;
+
+        return nestl::detail::take_allocator_slack(alloc, (res < capacity) ? capacity : res, maxSize);
+    }
+};
+
+} // namespace nestl
+
+#endif /* NESTL_GROWTH_POLICY_HPP */
@@ -0,0 +1,19 @@
+#ifndef NESTL_HAS_EXCEPTIONS_FLAT_MAP_HPP
+#define NESTL_HAS_EXCEPTIONS_FLAT_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/flat_map.hpp>
+
+namespace nestl
+{
+namespace has_exceptions
+{
+
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<std::pair<Key, T> > >
+using flat_map = impl::flat_map<Key, T, Compare, Alloc>;
+
+} // namespace has_exceptions
+} // namespace nestl
+
+#endif /* NESTL_HAS_EXCEPTIONS_FLAT_MAP_HPP */
@@ -0,0 +1,19 @@
+#ifndef NESTL_HAS_EXCEPTIONS_FLAT_SET_HPP
+#define NESTL_HAS_EXCEPTIONS_FLAT_SET_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/flat_set.hpp>
+
+namespace nestl
+{
+namespace has_exceptions
+{
+
+template<typename Key, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<Key> >
+using flat_set = impl::flat_set<Key, Compare, Alloc>;
+
+} // namespace has_exceptions
+} // namespace nestl
+
+#endif /* NESTL_HAS_EXCEPTIONS_FLAT_SET_HPP */
@@ -43,10 +43,19 @@ public:
 
     list& operator=(list&& other) NESTL_NOEXCEPT_SPEC
     {
-        return base_t::operator=(other);
+        base_t::operator=(std::move(other));
+
+        return *this;
+    }
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, list&& other) NESTL_NOEXCEPT_SPEC
+    {
+        base_t::move_assign_nothrow(err, std::move(other));
     }
 
     list(const list& other)
+        : base_t(other.get_allocator())
     {
         default_operation_error err;
         this->copy_nothrow(err, other);
@@ -58,7 +67,14 @@ public:
 
     list& operator=(const list& other)
     {
-        list tmp(other);
+        list tmp(nestl::detail::alloc_for_copy(this->get_allocator(), other.get_allocator()));
+        default_operation_error err;
+        tmp.copy_nothrow(err, other);
+        if (err)
+        {
+            throw_exception(err);
+        }
+
         this->swap(tmp);
 
         return *this;
@@ -93,7 +109,6 @@ public:
     using base_t::emplace_front_nothrow;
     using base_t::pop_front;
     using base_t::resize_nothrow;
-    using base_t::swap;
     using base_t::splice;
     using base_t::remove;
     using base_t::reverse;
@@ -120,6 +135,11 @@ public:
         }
     }
 
+    void swap(list& other) NESTL_NOEXCEPT_SPEC
+    {
+        base_t::swap(other);
+    }
+
     void merge(list& other) NESTL_NOEXCEPT_SPEC
     {
         base_t::merge(other);
@@ -172,6 +192,16 @@ public:
         base_t::splice(pos, other, first, last);
     }
 
+    void splice(const_iterator pos, list& other, const_iterator first, const_iterator last, size_type count) NESTL_NOEXCEPT_SPEC
+    {
+        base_t::splice(pos, other, first, last, count);
+    }
+
+    void splice(const_iterator pos, list&& other, const_iterator first, const_iterator last, size_type count) NESTL_NOEXCEPT_SPEC
+    {
+        base_t::splice(pos, other, first, last, count);
+    }
+
 private:
 };
 
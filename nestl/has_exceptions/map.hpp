@@ -0,0 +1,23 @@
+#ifndef NESTL_HAS_EXCEPTIONS_MAP_HPP
+#define NESTL_HAS_EXCEPTIONS_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/map.hpp>
+#include <nestl/implementation/multimap.hpp>
+
+namespace nestl
+{
+namespace has_exceptions
+{
+
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+using map = impl::map<Key, T, Compare, Alloc>;
+
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+using multimap = impl::multimap<Key, T, Compare, Alloc>;
+
+} // namespace has_exceptions
+} // namespace nestl
+
+#endif /* NESTL_HAS_EXCEPTIONS_MAP_HPP */
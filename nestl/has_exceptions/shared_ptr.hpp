@@ -11,11 +11,11 @@ namespace has_exceptions
 {
 
 
-template <typename T>
-using weak_ptr = impl::weak_ptr<T>;
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
+using weak_ptr = impl::weak_ptr<T, RefCountPolicy>;
 
-template <typename T>
-using shared_ptr = impl::shared_ptr<T>;
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
+using shared_ptr = impl::shared_ptr<T, RefCountPolicy>;
 
 
 } // namespace has_exceptions
@@ -0,0 +1,24 @@
+#ifndef NESTL_HAS_EXCEPTIONS_SMALL_VECTOR_HPP
+#define NESTL_HAS_EXCEPTIONS_SMALL_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/small_vector.hpp>
+#include <nestl/has_exceptions/vector.hpp>
+
+namespace nestl
+{
+namespace has_exceptions
+{
+
+
+template <typename T,
+          std::size_t N,
+          typename Allocator = nestl::allocator<T>,
+          typename GrowthPolicy = nestl::default_growth_policy>
+using small_vector = vector<T, Allocator, GrowthPolicy, nestl::impl::detail::vector_inline_storage<T, N, true> >;
+
+} // namespace has_exceptions
+} // namespace nestl
+
+#endif /* NESTL_HAS_EXCEPTIONS_SMALL_VECTOR_HPP */
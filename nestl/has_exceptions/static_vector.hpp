@@ -0,0 +1,24 @@
+#ifndef NESTL_HAS_EXCEPTIONS_STATIC_VECTOR_HPP
+#define NESTL_HAS_EXCEPTIONS_STATIC_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/static_vector.hpp>
+#include <nestl/has_exceptions/vector.hpp>
+
+namespace nestl
+{
+namespace has_exceptions
+{
+
+
+template <typename T, std::size_t N>
+using static_vector = vector<T,
+                             nestl::allocator<T>,
+                             nestl::default_growth_policy,
+                             nestl::impl::detail::vector_inline_storage<T, N, false> >;
+
+} // namespace has_exceptions
+} // namespace nestl
+
+#endif /* NESTL_HAS_EXCEPTIONS_STATIC_VECTOR_HPP */
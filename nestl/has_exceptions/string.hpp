@@ -4,6 +4,7 @@
 #include <nestl/config.hpp>
 
 #include <nestl/implementation/string.hpp>
+#include <nestl/has_exceptions/default_operation_error.hpp>
 
 namespace nestl
 {
@@ -11,16 +12,583 @@ namespace has_exceptions
 {
 
 
-template<typename CharType, typename Traits, typename Alloc>
-using basic_string = impl::basic_string<CharType, Traits, Alloc>;
+template <typename CharType,
+          typename Traits = std::char_traits<CharType>,
+          typename Alloc = nestl::allocator<CharType> >
+class basic_string : private impl::basic_string<CharType, Traits, Alloc>
+{
+    typedef impl::basic_string<CharType, Traits, Alloc> base_t;
+
+public:
+
+    typedef typename base_t::traits_type            traits_type;
+    typedef typename base_t::value_type             value_type;
+    typedef typename base_t::allocator_type         allocator_type;
+    typedef typename base_t::size_type              size_type;
+    typedef typename base_t::difference_type        difference_type;
+    typedef typename base_t::reference              reference;
+    typedef typename base_t::const_reference        const_reference;
+    typedef typename base_t::pointer                pointer;
+    typedef typename base_t::const_pointer          const_pointer;
+    typedef typename base_t::iterator               iterator;
+    typedef typename base_t::const_iterator         const_iterator;
+    typedef typename base_t::reverse_iterator       reverse_iterator;
+    typedef typename base_t::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_t::string_view_type       string_view_type;
+
+    typedef base_t                                  as_noexcept_type;
+
+    typedef as_noexcept_type&                       as_noexcept_reference;
+    typedef const as_noexcept_type&                 as_noexcept_const_reference;
+
+    using base_t::npos;
+    using base_t::inline_capacity;
+
+    explicit basic_string(const allocator_type& alloc = allocator_type()) NESTL_NOEXCEPT_SPEC;
+
+    basic_string(const value_type* s, const allocator_type& alloc = allocator_type());
+
+    basic_string(const value_type* s, size_type count, const allocator_type& alloc = allocator_type());
+
+    explicit basic_string(string_view_type str, const allocator_type& alloc = allocator_type());
+
+    basic_string(basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+    basic_string(const basic_string& other);
+
+    basic_string(const as_noexcept_type& other);
+
+    basic_string(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC;
+
+    basic_string& operator=(const basic_string& other);
+
+    basic_string& operator=(const as_noexcept_type& other);
+
+    basic_string& operator=(const value_type* s);
+
+    basic_string& operator=(string_view_type str);
+
+    basic_string& operator=(basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+    basic_string& operator=(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC;
+
+    as_noexcept_reference as_noexcept() NESTL_NOEXCEPT_SPEC;
+
+    as_noexcept_const_reference as_noexcept() const NESTL_NOEXCEPT_SPEC;
+
+    operator string_view_type() const NESTL_NOEXCEPT_SPEC;
+
+    using base_t::get_allocator;
+    using base_t::copy_nothrow;
+    using base_t::assign_nothrow;
+    using base_t::operator[];
+    using base_t::front;
+    using base_t::back;
+    using base_t::data;
+    using base_t::c_str;
+    using base_t::begin;
+    using base_t::cbegin;
+    using base_t::end;
+    using base_t::cend;
+    using base_t::rbegin;
+    using base_t::crbegin;
+    using base_t::rend;
+    using base_t::crend;
+    using base_t::empty;
+    using base_t::size;
+    using base_t::length;
+    using base_t::max_size;
+    using base_t::reserve_nothrow;
+    using base_t::capacity;
+    using base_t::shrink_to_fit_nothrow;
+    using base_t::clear;
+    using base_t::insert_nothrow;
+    using base_t::erase;
+    using base_t::push_back_nothrow;
+    using base_t::pop_back;
+    using base_t::append_nothrow;
+    using base_t::resize_nothrow;
+    using base_t::find;
+    using base_t::rfind;
+    using base_t::find_first_of;
+    using base_t::compare;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void assign_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void insert_nothrow(OperationError& err, size_type pos, const basic_string& str) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void append_nothrow(OperationError& err, const basic_string& str) NESTL_NOEXCEPT_SPEC;
+
+    size_type find(const basic_string& str, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    int compare(const basic_string& other) const NESTL_NOEXCEPT_SPEC;
+
+    void swap(basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+    void push_back(value_type ch);
+
+    basic_string& append(const value_type* s, size_type count);
+
+    basic_string& append(const value_type* s);
+
+    basic_string& append(const basic_string& str);
+
+    basic_string& append(string_view_type str);
+
+    basic_string& operator+=(value_type ch);
+
+    basic_string& operator+=(const value_type* s);
+
+    basic_string& operator+=(const basic_string& str);
+
+    basic_string& operator+=(string_view_type str);
+
+    void reserve(size_type new_cap);
+
+    void resize(size_type count, value_type ch = value_type());
+};
+
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+    : base_t(alloc)
+{
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(const value_type* s, const allocator_type& alloc)
+    : base_t(alloc)
+{
+    default_operation_error err;
+    this->assign_nothrow(err, s);
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(const value_type* s, size_type count, const allocator_type& alloc)
+    : base_t(alloc)
+{
+    default_operation_error err;
+    this->assign_nothrow(err, s, count);
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(string_view_type str, const allocator_type& alloc)
+    : base_t(alloc)
+{
+    default_operation_error err;
+    this->assign_nothrow(err, str);
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(basic_string&& other) NESTL_NOEXCEPT_SPEC
+    : base_t(std::move(other.as_noexcept()))
+{
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(const basic_string& other)
+    : base_t(other.get_allocator())
+{
+    default_operation_error err;
+    this->copy_nothrow(err, other.as_noexcept());
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(const as_noexcept_type& other)
+    : base_t(other.get_allocator())
+{
+    default_operation_error err;
+    this->copy_nothrow(err, other);
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC
+    : base_t(std::move(other))
+{
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator=(const basic_string& other)
+{
+    return *this = other.as_noexcept();
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator=(const as_noexcept_type& other)
+{
+    basic_string tmp(nestl::detail::alloc_for_copy(this->get_allocator(), other.get_allocator()));
+    default_operation_error err;
+    tmp.copy_nothrow(err, other);
+    if (err)
+    {
+        throw_exception(err);
+    }
+
+    this->swap(tmp);
+
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator=(const value_type* s)
+{
+    default_operation_error err;
+    this->assign_nothrow(err, s);
+    if (err)
+    {
+        throw_exception(err);
+    }
+
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator=(string_view_type str)
+{
+    default_operation_error err;
+    this->assign_nothrow(err, str);
+    if (err)
+    {
+        throw_exception(err);
+    }
+
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator=(basic_string&& other) NESTL_NOEXCEPT_SPEC
+{
+    static_cast<base_t*>(this)->operator=(std::move(other.as_noexcept()));
+
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator=(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC
+{
+    static_cast<base_t*>(this)->operator=(std::move(other));
+
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::as_noexcept_reference
+basic_string<C, T, A>::as_noexcept() NESTL_NOEXCEPT_SPEC
+{
+    return static_cast<as_noexcept_reference>(*this);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::as_noexcept_const_reference
+basic_string<C, T, A>::as_noexcept() const NESTL_NOEXCEPT_SPEC
+{
+    return static_cast<as_noexcept_const_reference>(*this);
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::operator string_view_type() const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(as_noexcept());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::move_assign_nothrow(OperationError& err, basic_string&& other) NESTL_NOEXCEPT_SPEC
+{
+    base_t::move_assign_nothrow(err, std::move(other.as_noexcept()));
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::copy_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    base_t::copy_nothrow(err, other.as_noexcept());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::assign_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    base_t::assign_nothrow(err, other.as_noexcept());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::insert_nothrow(OperationError& err, size_type pos, const basic_string& str) NESTL_NOEXCEPT_SPEC
+{
+    base_t::insert_nothrow(err, pos, str.as_noexcept());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::append_nothrow(OperationError& err, const basic_string& str) NESTL_NOEXCEPT_SPEC
+{
+    base_t::append_nothrow(err, str.as_noexcept());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find(const basic_string& str, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return base_t::find(str.as_noexcept(), pos);
+}
+
+template <typename C, typename T, typename A>
+int basic_string<C, T, A>::compare(const basic_string& other) const NESTL_NOEXCEPT_SPEC
+{
+    return base_t::compare(other.as_noexcept());
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::swap(basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    base_t::swap(other);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::push_back(value_type ch)
+{
+    default_operation_error err;
+    this->push_back_nothrow(err, ch);
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::append(const value_type* s, size_type count)
+{
+    default_operation_error err;
+    this->append_nothrow(err, s, count);
+    if (err)
+    {
+        throw_exception(err);
+    }
+
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::append(const value_type* s)
+{
+    return append(s, traits_type::length(s));
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::append(const basic_string& str)
+{
+    return append(str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::append(string_view_type str)
+{
+    return append(str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator+=(value_type ch)
+{
+    push_back(ch);
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator+=(const value_type* s)
+{
+    return append(s);
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator+=(const basic_string& str)
+{
+    return append(str);
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>& basic_string<C, T, A>::operator+=(string_view_type str)
+{
+    return append(str);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::reserve(size_type new_cap)
+{
+    default_operation_error err;
+    this->reserve_nothrow(err, new_cap);
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::resize(size_type count, value_type ch)
+{
+    default_operation_error err;
+    this->resize_nothrow(err, count, ch);
+    if (err)
+    {
+        throw_exception(err);
+    }
+}
+
+
+template <typename C, typename T, typename A>
+bool operator==(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.as_noexcept() == right.as_noexcept();
+}
+
+template <typename C, typename T, typename A>
+bool operator==(const basic_string<C, T, A>& left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return left.as_noexcept() == right;
+}
+
+template <typename C, typename T, typename A>
+bool operator==(const C* left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left == right.as_noexcept();
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const basic_string<C, T, A>& left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const C* left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator==(const basic_string<C, T, A>& left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return left.as_noexcept() == right;
+}
+
+template <typename C, typename T, typename A>
+bool operator==(basic_string_view<C, T> left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left == right.as_noexcept();
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const basic_string<C, T, A>& left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(basic_string_view<C, T> left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.as_noexcept() < right.as_noexcept();
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const basic_string<C, T, A>& left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return left.as_noexcept() < right;
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const C* left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left < right.as_noexcept();
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const basic_string<C, T, A>& left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return left.as_noexcept() < right;
+}
+
+template <typename C, typename T, typename A>
+bool operator<(basic_string_view<C, T> left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left < right.as_noexcept();
+}
+
+template <typename C, typename T, typename A>
+bool operator>(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return right < left;
+}
+
+template <typename C, typename T, typename A>
+bool operator<=(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(right < left);
+}
+
+template <typename C, typename T, typename A>
+bool operator>=(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left < right);
+}
 
 
 typedef basic_string<char, std::char_traits<char>, nestl::allocator<char> > string;
 typedef basic_string<wchar_t, std::char_traits<wchar_t>, nestl::allocator<wchar_t> > wstring;
 
+} // namespace has_exceptions
 
 
+template <typename CharType, typename Traits, typename Allocator>
+struct hash<has_exceptions::basic_string<CharType, Traits, Allocator> >
+    : public hash<basic_string_view<CharType, Traits> >
+{
+};
 
-} // namespace has_exceptions
 } // namespace nestl
 #endif /* NESTL_HAS_EXCEPTIONS_STRING_HPP */
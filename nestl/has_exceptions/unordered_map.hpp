@@ -0,0 +1,23 @@
+#ifndef NESTL_HAS_EXCEPTIONS_UNORDERED_MAP_HPP
+#define NESTL_HAS_EXCEPTIONS_UNORDERED_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/unordered_map.hpp>
+
+namespace nestl
+{
+namespace has_exceptions
+{
+
+template <typename Key,
+          typename T,
+          typename Hash = nestl::hash<Key>,
+          typename KeyEqual = nestl::equal_to<Key>,
+          typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+using unordered_map = impl::unordered_map<Key, T, Hash, KeyEqual, Alloc>;
+
+} // namespace has_exceptions
+} // namespace nestl
+
+#endif /* NESTL_HAS_EXCEPTIONS_UNORDERED_MAP_HPP */
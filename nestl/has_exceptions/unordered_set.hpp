@@ -0,0 +1,22 @@
+#ifndef NESTL_HAS_EXCEPTIONS_UNORDERED_SET_HPP
+#define NESTL_HAS_EXCEPTIONS_UNORDERED_SET_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/unordered_set.hpp>
+
+namespace nestl
+{
+namespace has_exceptions
+{
+
+template <typename Key,
+          typename Hash = nestl::hash<Key>,
+          typename KeyEqual = nestl::equal_to<Key>,
+          typename Alloc = nestl::allocator<Key> >
+using unordered_set = impl::unordered_set<Key, Hash, KeyEqual, Alloc>;
+
+} // namespace has_exceptions
+} // namespace nestl
+
+#endif /* NESTL_HAS_EXCEPTIONS_UNORDERED_SET_HPP */
@@ -12,15 +12,20 @@ namespace has_exceptions
 {
 
 
-template <typename T, typename Allocator = nestl::allocator<T> >
-class vector: private impl::vector<T, Allocator>
+template <typename T,
+          typename Allocator = nestl::allocator<T>,
+          typename GrowthPolicy = nestl::default_growth_policy,
+          typename Storage = nestl::impl::detail::vector_heap_storage<T> >
+class vector: private impl::vector<T, Allocator, GrowthPolicy, Storage>
 {
-    typedef impl::vector<T, Allocator> base_t;
+    typedef impl::vector<T, Allocator, GrowthPolicy, Storage> base_t;
 
 public:
 
     typedef typename base_t::value_type             value_type;
     typedef typename base_t::allocator_type         allocator_type;
+    typedef typename base_t::growth_policy_type     growth_policy_type;
+    typedef typename base_t::storage_type           storage_type;
     typedef typename base_t::size_type              size_type;
     typedef typename base_t::difference_type        difference_type;
     typedef typename base_t::reference              reference;
@@ -87,7 +92,10 @@ public:
     using base_t::emplace_back_nothrow;
     using base_t::pop_back;
     using base_t::resize_nothrow;
-    using base_t::swap;
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, vector&& other) NESTL_NOEXCEPT_SPEC;
+
+    void swap(vector& other) NESTL_NOEXCEPT_SPEC;
 
     void push_back(const value_type& value);
 
@@ -95,20 +103,20 @@ public:
 };
 
 
-template <typename T, typename A>
-vector<T, A>::vector(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::vector(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
     : base_t(alloc)
 {
 }
 
-template <typename T, typename A>
-vector<T, A>::vector(vector&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::vector(vector&& other) NESTL_NOEXCEPT_SPEC
     : base_t(std::move(other))
 {
 }
 
-template <typename T, typename A>
-vector<T, A>::vector(const vector& other)
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::vector(const vector& other)
     : base_t(other.get_allocator())
 {
     default_operation_error err;
@@ -119,8 +127,8 @@ vector<T, A>::vector(const vector& other)
     }
 }
 
-template <typename T, typename A>
-vector<T, A>::vector(const as_noexcept_type& other)
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::vector(const as_noexcept_type& other)
     : base_t(other.get_allocator())
 {
     default_operation_error err;
@@ -131,63 +139,92 @@ vector<T, A>::vector(const as_noexcept_type& other)
     }
 }
 
-template <typename T, typename A>
-vector<T, A>::vector(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::vector(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC
     : base_t(std::move(other))
 {
 }
 
-template <typename T, typename A>
-vector<T, A>& vector<T, A>::operator=(const vector& other)
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>& vector<T, A, G, S>::operator=(const vector& other)
 {
-    vector tmp{other};
+    vector tmp(nestl::detail::alloc_for_copy(this->get_allocator(), other.get_allocator()));
+    default_operation_error err;
+    tmp.copy_nothrow(err, other);
+    if (err)
+    {
+        throw_exception(err);
+    }
+
     this->swap(tmp);
 
     return *this;
 }
 
-template <typename T, typename A>
-vector<T, A>& vector<T, A>::operator=(const as_noexcept_type& other)
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>& vector<T, A, G, S>::operator=(const as_noexcept_type& other)
 {
-    vector tmp{other};
+    vector tmp(nestl::detail::alloc_for_copy(this->get_allocator(), other.get_allocator()));
+    default_operation_error err;
+    tmp.copy_nothrow(err, other);
+    if (err)
+    {
+        throw_exception(err);
+    }
+
     this->swap(tmp);
 
     return *this;
 }
 
-template <typename T, typename A>
-vector<T, A>& vector<T, A>::operator=(vector&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>& vector<T, A, G, S>::operator=(vector&& other) NESTL_NOEXCEPT_SPEC
 {
     static_cast<base_t*>(this)->operator=(std::move(other.as_noexcept()));
 
     return *this;
 }
 
-template <typename T, typename A>
-vector<T, A>& vector<T, A>::operator=(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>& vector<T, A, G, S>::operator=(as_noexcept_type&& other) NESTL_NOEXCEPT_SPEC
 {
     static_cast<base_t*>(this)->operator=(std::move(other));
 
     return *this;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::as_noexcept_reference
-vector<T, A>::as_noexcept() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::as_noexcept_reference
+vector<T, A, G, S>::as_noexcept() NESTL_NOEXCEPT_SPEC
 {
     return static_cast<as_noexcept_reference>(*this);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::as_noexcept_const_reference
-vector<T, A>::as_noexcept() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::as_noexcept_const_reference
+vector<T, A, G, S>::as_noexcept() const NESTL_NOEXCEPT_SPEC
 {
     return static_cast<as_noexcept_const_reference>(*this);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
 void
-vector<T, A>::push_back(const value_type& value)
+vector<T, A, G, S>::move_assign_nothrow(OperationError& err, vector&& other) NESTL_NOEXCEPT_SPEC
+{
+    base_t::move_assign_nothrow(err, std::move(other.as_noexcept()));
+}
+
+template <typename T, typename A, typename G, typename S>
+void
+vector<T, A, G, S>::swap(vector& other) NESTL_NOEXCEPT_SPEC
+{
+    base_t::swap(other);
+}
+
+template <typename T, typename A, typename G, typename S>
+void
+vector<T, A, G, S>::push_back(const value_type& value)
 {
     default_operation_error error;
     push_back_nothrow(error, value);
@@ -197,9 +234,9 @@ vector<T, A>::push_back(const value_type& value)
     }
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 void
-vector<T, A>::push_back(value_type&& value)
+vector<T, A, G, S>::push_back(value_type&& value)
 {
     default_operation_error error;
     push_back_nothrow(error, std::move(value));
@@ -210,6 +247,13 @@ vector<T, A>::push_back(value_type&& value)
 }
 
 } // namespace has_exceptions
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+struct is_trivially_relocatable<nestl::has_exceptions::vector<T, Allocator, GrowthPolicy, Storage>>
+    : public is_trivially_relocatable<nestl::impl::vector<T, Allocator, GrowthPolicy, Storage>>
+{
+};
+
 } // namespace nestl
 
 #endif /* NESTL_HAS_EXCEPTIONS_VECTOR_HPP */
@@ -0,0 +1,528 @@
+/**
+ * @file Implementation of ordered unique associative container on top of sorted vector
+ *
+ * Elements are stored contiguously in key order, lookup is a binary search.
+ * Such layout needs no per-element nodes, so it is much more compact and cache friendly
+ * than red-black tree, at the cost of linear insertion and erasure in the middle.
+ */
+
+#ifndef NESTL_IMPLEMENTATION_DETAIL_FLAT_TREE_HPP
+#define NESTL_IMPLEMENTATION_DETAIL_FLAT_TREE_HPP
+
+#include <nestl/config.hpp>
+#include <nestl/alignment.hpp>
+#include <nestl/allocator.hpp>
+#include <nestl/class_operations.hpp>
+#include <nestl/type_traits.hpp>
+
+#include <nestl/detail/destroy.hpp>
+
+#include <nestl/implementation/vector.hpp>
+#include <nestl/implementation/detail/piecewise.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace nestl
+{
+namespace impl
+{
+namespace detail
+{
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc = allocator<Val> >
+class flat_tree
+{
+    flat_tree(const flat_tree&) = delete;
+    flat_tree& operator=(const flat_tree&) = delete;
+
+public:
+    typedef impl::vector<Val, Alloc>                       container_type;
+
+    typedef Key                                            key_type;
+    typedef Val                                            value_type;
+    typedef Compare                                        key_compare;
+    typedef Alloc                                          allocator_type;
+
+    typedef typename container_type::size_type             size_type;
+    typedef typename container_type::difference_type       difference_type;
+    typedef typename container_type::reference             reference;
+    typedef typename container_type::const_reference       const_reference;
+    typedef typename container_type::pointer               pointer;
+    typedef typename container_type::const_pointer         const_pointer;
+
+    typedef typename container_type::iterator               iterator;
+    typedef typename container_type::const_iterator         const_iterator;
+    typedef typename container_type::reverse_iterator       reverse_iterator;
+    typedef typename container_type::const_reverse_iterator const_reverse_iterator;
+
+    /// @brief Orders values by their keys
+    class value_compare
+    {
+    public:
+        explicit value_compare(const Compare& comp) NESTL_NOEXCEPT_SPEC
+            : m_comp(comp)
+        {
+        }
+
+        bool operator()(const value_type& left, const value_type& right) const NESTL_NOEXCEPT_SPEC
+        {
+            return m_comp(KeyOfValue()(left), KeyOfValue()(right));
+        }
+
+    private:
+        Compare m_comp;
+    };
+
+    explicit flat_tree(const Compare& comp, const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+        : m_data(alloc)
+        , m_compare(comp)
+    {
+    }
+
+    explicit flat_tree(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+        : m_data(alloc)
+        , m_compare()
+    {
+    }
+
+    flat_tree(flat_tree&& other) NESTL_NOEXCEPT_SPEC
+        : m_data(std::move(other.m_data))
+        , m_compare(other.m_compare)
+    {
+    }
+
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_data.get_allocator();
+    }
+
+    key_compare key_comp() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_compare;
+    }
+
+    value_compare value_comp() const NESTL_NOEXCEPT_SPEC
+    {
+        return value_compare(m_compare);
+    }
+
+    flat_tree& operator=(flat_tree&& other) NESTL_NOEXCEPT_SPEC
+    {
+        m_data = std::move(other.m_data);
+        m_compare = other.m_compare;
+        return *this;
+    }
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, flat_tree&& other) NESTL_NOEXCEPT_SPEC
+    {
+        m_data.move_assign_nothrow(err, std::move(other.m_data));
+        if (!err)
+        {
+            m_compare = other.m_compare;
+        }
+    }
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const flat_tree& other) NESTL_NOEXCEPT_SPEC
+    {
+        m_data.copy_nothrow(err, other.m_data);
+        if (!err)
+        {
+            m_compare = other.m_compare;
+        }
+    }
+
+    // iterators
+    iterator begin() NESTL_NOEXCEPT_SPEC { return m_data.begin(); }
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC { return m_data.begin(); }
+    iterator end() NESTL_NOEXCEPT_SPEC { return m_data.end(); }
+    const_iterator end() const NESTL_NOEXCEPT_SPEC { return m_data.end(); }
+    reverse_iterator rbegin() NESTL_NOEXCEPT_SPEC { return m_data.rbegin(); }
+    const_reverse_iterator rbegin() const NESTL_NOEXCEPT_SPEC { return m_data.rbegin(); }
+    reverse_iterator rend() NESTL_NOEXCEPT_SPEC { return m_data.rend(); }
+    const_reverse_iterator rend() const NESTL_NOEXCEPT_SPEC { return m_data.rend(); }
+
+    // capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC { return m_data.empty(); }
+    size_type size() const NESTL_NOEXCEPT_SPEC { return m_data.size(); }
+    size_type max_size() const NESTL_NOEXCEPT_SPEC { return m_data.max_size(); }
+    size_type capacity() const NESTL_NOEXCEPT_SPEC { return m_data.capacity(); }
+
+    template <typename OperationError>
+    void reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
+    {
+        m_data.reserve_nothrow(err, new_cap);
+    }
+
+    template <typename OperationError>
+    void shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC
+    {
+        m_data.shrink_to_fit_nothrow(err);
+    }
+
+    // modifiers
+    void clear() NESTL_NOEXCEPT_SPEC
+    {
+        m_data.clear();
+    }
+
+    /**
+     * @brief Inserts value if there is no equivalent key yet
+     *
+     * @return position of inserted or already present element and true if value was inserted.
+     * In case of error end() and false are returned and content is left unchanged.
+     */
+    template <typename OperationError, typename Arg>
+    std::pair<iterator, bool> m_insert_unique(OperationError& err, Arg&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Constructs pair from key and args for mapped value if there is no equivalent key yet (maps only)
+     *
+     * Nothing is constructed if key is present, so args are left untouched then.
+     * Members of pair are built one by one aside and moved into vector (see piecewise.hpp).
+     */
+    template <typename OperationError, typename K, typename ... Args>
+    std::pair<iterator, bool> m_try_emplace_unique(OperationError& err, K&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts elements of range whose keys are not present yet
+     *
+     * Range is appended, sorted and merged with existing elements once,
+     * so insertion of n elements into container of size m takes O(n log n + m) instead of O(n * m).
+     * If several elements of range have equivalent keys it is unspecified which of them is inserted.
+     * In case of error content is left unchanged.
+     */
+    template <typename OperationError, typename InputIterator>
+    void m_insert_range_unique(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator erase_nothrow(OperationError& err, const_iterator pos) NESTL_NOEXCEPT_SPEC
+    {
+        return m_data.erase_nothrow(err, pos);
+    }
+
+    template <typename OperationError>
+    iterator erase_nothrow(OperationError& err, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+    {
+        return m_data.erase_nothrow(err, first, last);
+    }
+
+    template <typename OperationError>
+    size_type erase_nothrow(OperationError& err, const key_type& key) NESTL_NOEXCEPT_SPEC
+    {
+        std::pair<const_iterator, const_iterator> range = m_equal_range(key);
+        const size_type count = static_cast<size_type>(range.second - range.first);
+        if (count != 0)
+        {
+            m_data.erase_nothrow(err, range.first, range.second);
+        }
+        return err ? 0 : count;
+    }
+
+    void swap(flat_tree& other) NESTL_NOEXCEPT_SPEC
+    {
+        using std::swap;
+
+        m_data.swap(other.m_data);
+        swap(m_compare, other.m_compare);
+    }
+
+    // lookup, K is either key_type or any type comparable with keys by transparent Compare
+    template <typename K>
+    iterator m_find(const K& key) NESTL_NOEXCEPT_SPEC
+    {
+        return m_mutable(static_cast<const flat_tree&>(*this).m_find(key));
+    }
+
+    template <typename K>
+    const_iterator m_find(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        const_iterator pos = m_lower_bound(key);
+        if (pos == end() || m_compare(key, KeyOfValue()(*pos)))
+        {
+            return end();
+        }
+        return pos;
+    }
+
+    template <typename K>
+    size_type m_count(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        std::pair<const_iterator, const_iterator> range = m_equal_range(key);
+        return static_cast<size_type>(range.second - range.first);
+    }
+
+    template <typename K>
+    iterator m_lower_bound(const K& key) NESTL_NOEXCEPT_SPEC
+    {
+        return m_mutable(static_cast<const flat_tree&>(*this).m_lower_bound(key));
+    }
+
+    template <typename K>
+    const_iterator m_lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        return m_lower_bound(begin(), end(), key);
+    }
+
+    template <typename K>
+    iterator m_upper_bound(const K& key) NESTL_NOEXCEPT_SPEC
+    {
+        return m_mutable(static_cast<const flat_tree&>(*this).m_upper_bound(key));
+    }
+
+    template <typename K>
+    const_iterator m_upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    std::pair<iterator, iterator> m_equal_range(const K& key) NESTL_NOEXCEPT_SPEC
+    {
+        std::pair<const_iterator, const_iterator> range = static_cast<const flat_tree&>(*this).m_equal_range(key);
+        return std::pair<iterator, iterator>(m_mutable(range.first), m_mutable(range.second));
+    }
+
+    template <typename K>
+    std::pair<const_iterator, const_iterator> m_equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        // keys are unique, so range contains at most one element
+        const_iterator first = m_find(key);
+        if (first == end())
+        {
+            const_iterator pos = m_lower_bound(key);
+            return std::pair<const_iterator, const_iterator>(pos, pos);
+        }
+        return std::pair<const_iterator, const_iterator>(first, first + 1);
+    }
+
+private:
+    iterator m_mutable(const_iterator pos) NESTL_NOEXCEPT_SPEC
+    {
+        return m_data.begin() + (pos - m_data.cbegin());
+    }
+
+    template <typename K>
+    const_iterator m_lower_bound(const_iterator first, const_iterator last, const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Removes elements starting from given size, never fails
+    void m_truncate(size_type newSize) NESTL_NOEXCEPT_SPEC
+    {
+        while (m_data.size() > newSize)
+        {
+            m_data.pop_back();
+        }
+    }
+
+    /// @brief Merges sorted unique tail starting at oldSize into sorted head
+    template <typename OperationError>
+    void m_merge_tail(OperationError& err, size_type oldSize) NESTL_NOEXCEPT_SPEC;
+
+    container_type m_data;
+    Compare m_compare;
+};
+
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template <typename K>
+typename flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::const_iterator
+flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_lower_bound(const_iterator first,
+                                                               const_iterator last,
+                                                               const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    /// Range is halved by moving its base only, so the loop has no data dependent branch
+    /// and compiler emits conditional move, probe results are never mispredicted
+    size_type len = static_cast<size_type>(last - first);
+    if (len == 0)
+    {
+        return first;
+    }
+
+    while (len > 1)
+    {
+        const size_type half = len / 2;
+        first = m_compare(KeyOfValue()(first[half]), key) ? first + half : first;
+        len -= half;
+    }
+    return m_compare(KeyOfValue()(*first), key) ? first + 1 : first;
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template <typename K>
+typename flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::const_iterator
+flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    const_iterator first = begin();
+    size_type len = size();
+    if (len == 0)
+    {
+        return first;
+    }
+
+    while (len > 1)
+    {
+        const size_type half = len / 2;
+        first = m_compare(key, KeyOfValue()(first[half])) ? first : first + half;
+        len -= half;
+    }
+    return m_compare(key, KeyOfValue()(*first)) ? first : first + 1;
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template <typename OperationError, typename Arg>
+std::pair<typename flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator, bool>
+flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_unique(OperationError& err, Arg&& val) NESTL_NOEXCEPT_SPEC
+{
+    iterator pos = m_lower_bound(KeyOfValue()(val));
+    if (pos != end() && !m_compare(KeyOfValue()(val), KeyOfValue()(*pos)))
+    {
+        return std::pair<iterator, bool>(pos, false);
+    }
+
+    pos = m_data.insert_nothrow(err, pos, std::forward<Arg>(val));
+    if (err)
+    {
+        return std::pair<iterator, bool>(end(), false);
+    }
+    return std::pair<iterator, bool>(pos, true);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template <typename OperationError, typename K, typename ... Args>
+std::pair<typename flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator, bool>
+flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_try_emplace_unique(OperationError& err,
+                                                                      K&& key,
+                                                                      Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    iterator pos = m_lower_bound(key);
+    if (pos != end() && !m_compare(key, KeyOfValue()(*pos)))
+    {
+        return std::pair<iterator, bool>(pos, false);
+    }
+
+    // members are built one by one aside, since piecewise constructor of pair is not usable without exceptions
+    nestl::aligned_buffer<value_type> tmp;
+    construct_pair(err, tmp.ptr(), std::forward<K>(key), std::forward<Args>(args)...);
+    if (err)
+    {
+        return std::pair<iterator, bool>(end(), false);
+    }
+    value_type* tmpEnd = tmp.ptr() + 1;
+    nestl::detail::destruction_scoped_guard<value_type*> tmpGuard(tmp.ptr(), tmpEnd);
+
+    pos = m_data.insert_nothrow(err, pos, std::move(*tmp.ptr()));
+    if (err)
+    {
+        return std::pair<iterator, bool>(end(), false);
+    }
+    return std::pair<iterator, bool>(pos, true);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template <typename OperationError, typename InputIterator>
+void
+flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_range_unique(OperationError& err,
+                                                                       InputIterator first,
+                                                                       InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    const size_type oldSize = size();
+
+    m_data.insert_nothrow(err, m_data.cend(), first, last);
+    if (err)
+    {
+        m_truncate(oldSize);
+        return;
+    }
+
+    // appended tail is sorted and deduplicated on its own
+    const value_compare less = value_comp();
+    iterator tail = m_data.begin() + oldSize;
+    std::sort(tail, m_data.end(), less);
+
+    iterator out = tail;
+    const_iterator head = m_data.cbegin();
+    const_iterator headEnd = head + oldSize;
+    for (iterator cur = tail; cur != m_data.end(); ++cur)
+    {
+        // skip element equal to previous kept one
+        if (out != tail && !less(*(out - 1), *cur))
+        {
+            continue;
+        }
+
+        // skip element which is already present, tail is sorted so search range only shrinks
+        head = m_lower_bound(head, headEnd, KeyOfValue()(*cur));
+        if (head != headEnd && !m_compare(KeyOfValue()(*cur), KeyOfValue()(*head)))
+        {
+            continue;
+        }
+
+        if (out != cur)
+        {
+            *out = std::move(*cur);
+        }
+        ++out;
+    }
+    m_truncate(static_cast<size_type>(out - m_data.begin()));
+
+    m_merge_tail(err, oldSize);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template <typename OperationError>
+void
+flat_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_merge_tail(OperationError& err, size_type oldSize) NESTL_NOEXCEPT_SPEC
+{
+    const size_type tailSize = size() - oldSize;
+    if (oldSize == 0 || tailSize == 0)
+    {
+        return;
+    }
+
+    const value_compare less = value_comp();
+    if (less(m_data[oldSize - 1], m_data[oldSize]))
+    {
+        // all new elements are greater, nothing to merge
+        return;
+    }
+
+    // tail is moved aside, then both runs are merged backward into the place they occupy now
+    container_type buffer(m_data.get_allocator());
+    buffer.reserve_nothrow(err, tailSize);
+    if (err)
+    {
+        m_truncate(oldSize);
+        return;
+    }
+
+    for (size_type i = oldSize; i != size(); ++i)
+    {
+        buffer.push_back_nothrow(err, std::move(m_data[i]));
+        if (err)
+        {
+            m_truncate(oldSize);
+            return;
+        }
+    }
+
+    iterator out = m_data.end();
+    iterator head = m_data.begin() + oldSize;
+    iterator moved = buffer.end();
+    while (moved != buffer.begin())
+    {
+        --out;
+        if (head != m_data.begin() && less(*(moved - 1), *(head - 1)))
+        {
+            *out = std::move(*--head);
+        }
+        else
+        {
+            *out = std::move(*--moved);
+        }
+    }
+}
+
+} // namespace detail
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_DETAIL_FLAT_TREE_HPP */
@@ -0,0 +1,1068 @@
+/**
+ * @file Implementation of unordered unique associative container as open addressing hash table
+ *
+ * Elements are stored in one flat array of slots, every slot has control byte in parallel array
+ * (see detail/hash_group.hpp). Lookup checks whole group of control bytes at once and compares keys
+ * only in slots whose 7 bits of hash match, so absent keys are usually rejected without touching slots.
+ *
+ * Capacity is always 2^k - 1, so probing wraps by mask, and at most 7/8 of slots are used.
+ * Control bytes are followed by sentinel and by copy of the first group, so group may be loaded
+ * at any slot without wrapping.
+ */
+
+#ifndef NESTL_IMPLEMENTATION_DETAIL_HASH_TABLE_HPP
+#define NESTL_IMPLEMENTATION_DETAIL_HASH_TABLE_HPP
+
+#include <nestl/config.hpp>
+#include <nestl/alignment.hpp>
+#include <nestl/allocator.hpp>
+#include <nestl/allocator_traits.hpp>
+#include <nestl/class_operations.hpp>
+#include <nestl/type_traits.hpp>
+
+#include <nestl/detail/allocator_traits_helper.hpp>
+#include <nestl/detail/destroy.hpp>
+#include <nestl/detail/hash_group.hpp>
+#include <nestl/detail/relocate.hpp>
+
+#include <nestl/implementation/detail/piecewise.hpp>
+
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace nestl
+{
+namespace impl
+{
+namespace detail
+{
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+class hash_table;
+
+/// @brief Source is pair whose first member is key, so map may be searched before value is built
+template <typename Key, typename Source>
+struct is_pair_with_key : std::false_type
+{
+};
+
+template <typename Key, typename Second>
+struct is_pair_with_key<Key, std::pair<Key, Second> > : std::true_type
+{
+};
+
+/**
+ * @brief Forward iterator over full slots of hash table
+ *
+ * @tparam T value type of table for mutable iterator, const value type for constant one
+ */
+template <typename T>
+class hash_table_iterator
+{
+    template <typename>
+    friend class hash_table_iterator;
+
+    template <typename, typename, typename, typename, typename, typename>
+    friend class hash_table;
+
+    typedef nestl::detail::hash_group::ctrl_t ctrl_t;
+    typedef nestl::detail::hash_group::group  group;
+
+public:
+    typedef typename std::remove_const<T>::type value_type;
+    typedef T&                                  reference;
+    typedef T*                                  pointer;
+    typedef std::forward_iterator_tag           iterator_category;
+    typedef std::ptrdiff_t                      difference_type;
+
+    hash_table_iterator() NESTL_NOEXCEPT_SPEC
+        : m_ctrl(nullptr)
+        , m_slot(nullptr)
+    {
+    }
+
+    /// @brief Mutable iterator is convertible to constant one
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    hash_table_iterator(const hash_table_iterator<U>& other) NESTL_NOEXCEPT_SPEC
+        : m_ctrl(other.m_ctrl)
+        , m_slot(other.m_slot)
+    {
+    }
+
+    reference operator*() const NESTL_NOEXCEPT_SPEC
+    {
+        return *m_slot;
+    }
+
+    pointer operator->() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_slot;
+    }
+
+    hash_table_iterator& operator++() NESTL_NOEXCEPT_SPEC
+    {
+        ++m_ctrl;
+        ++m_slot;
+        m_skip_empty_or_deleted();
+        return *this;
+    }
+
+    hash_table_iterator operator++(int) NESTL_NOEXCEPT_SPEC
+    {
+        hash_table_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    friend bool operator==(const hash_table_iterator& left, const hash_table_iterator& right) NESTL_NOEXCEPT_SPEC
+    {
+        return left.m_ctrl == right.m_ctrl;
+    }
+
+    friend bool operator!=(const hash_table_iterator& left, const hash_table_iterator& right) NESTL_NOEXCEPT_SPEC
+    {
+        return left.m_ctrl != right.m_ctrl;
+    }
+
+private:
+    hash_table_iterator(const ctrl_t* ctrl, T* slot) NESTL_NOEXCEPT_SPEC
+        : m_ctrl(ctrl)
+        , m_slot(slot)
+    {
+    }
+
+    /// @brief Moves to the first full slot starting from current one, sentinel stops the scan
+    void m_skip_empty_or_deleted() NESTL_NOEXCEPT_SPEC
+    {
+        while (nestl::detail::hash_group::is_empty_or_deleted(*m_ctrl))
+        {
+            const unsigned shift = group(m_ctrl).count_leading_empty_or_deleted();
+            m_ctrl += shift;
+            m_slot += shift;
+        }
+    }
+
+    const ctrl_t* m_ctrl;
+    T* m_slot;
+};
+
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc = allocator<Val> >
+class hash_table
+{
+    hash_table(const hash_table&) = delete;
+    hash_table& operator=(const hash_table&) = delete;
+
+    typedef nestl::detail::hash_group::ctrl_t               ctrl_t;
+    typedef nestl::detail::hash_group::group                group;
+    typedef nestl::allocator_traits<Alloc>                  allocator_traits;
+
+public:
+    typedef Key                                             key_type;
+    typedef Val                                             value_type;
+    typedef Hash                                            hasher;
+    typedef KeyEqual                                        key_equal;
+    typedef Alloc                                           allocator_type;
+
+    typedef std::size_t                                     size_type;
+    typedef std::ptrdiff_t                                  difference_type;
+    typedef value_type&                                     reference;
+    typedef const value_type&                               const_reference;
+    typedef value_type*                                     pointer;
+    typedef const value_type*                               const_pointer;
+
+    typedef hash_table_iterator<value_type>                 iterator;
+    typedef hash_table_iterator<const value_type>           const_iterator;
+
+    explicit hash_table(const Hash& hash, const KeyEqual& equal, const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+        : m_ctrl(nestl::detail::hash_group::empty_group())
+        , m_slots(nullptr)
+        , m_size(0)
+        , m_capacity(0)
+        , m_growth_left(0)
+        , m_hash(hash)
+        , m_equal(equal)
+        , m_alloc(alloc)
+    {
+    }
+
+    explicit hash_table(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+        : hash_table(Hash(), KeyEqual(), alloc)
+    {
+    }
+
+    hash_table(hash_table&& other) NESTL_NOEXCEPT_SPEC
+        : m_ctrl(other.m_ctrl)
+        , m_slots(other.m_slots)
+        , m_size(other.m_size)
+        , m_capacity(other.m_capacity)
+        , m_growth_left(other.m_growth_left)
+        , m_hash(other.m_hash)
+        , m_equal(other.m_equal)
+        , m_alloc(other.m_alloc)
+    {
+        other.m_reset_storage();
+    }
+
+    ~hash_table() NESTL_NOEXCEPT_SPEC
+    {
+        m_destroy_elements();
+        m_release_storage();
+    }
+
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_alloc;
+    }
+
+    hasher hash_function() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_hash;
+    }
+
+    key_equal key_eq() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_equal;
+    }
+
+    /**
+     * @note Does not compile for allocators which neither propagate on move assignment
+     * nor are always equal, use move_assign_nothrow for such allocators.
+     */
+    hash_table& operator=(hash_table&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, hash_table&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const hash_table& other) NESTL_NOEXCEPT_SPEC;
+
+    // iterators
+    iterator begin() NESTL_NOEXCEPT_SPEC
+    {
+        iterator res(m_ctrl, m_slots);
+        res.m_skip_empty_or_deleted();
+        return res;
+    }
+
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC
+    {
+        const_iterator res(m_ctrl, m_slots);
+        res.m_skip_empty_or_deleted();
+        return res;
+    }
+
+    iterator end() NESTL_NOEXCEPT_SPEC
+    {
+        return m_iterator_at(m_capacity);
+    }
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_iterator_at(m_capacity);
+    }
+
+    // capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC { return m_size == 0; }
+    size_type size() const NESTL_NOEXCEPT_SPEC { return m_size; }
+    size_type capacity() const NESTL_NOEXCEPT_SPEC { return m_capacity; }
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC
+    {
+        // capacity may be twice as large as number of elements, control bytes need space as well
+        return (allocator_traits::max_size(m_alloc) - group::width) / 4;
+    }
+
+    float load_factor() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_capacity == 0 ? 0.0f : static_cast<float>(m_size) / static_cast<float>(m_capacity);
+    }
+
+    /**
+     * @brief Makes room for count elements, so inserting them does not rehash the table
+     *
+     * In case of error table is left unchanged.
+     */
+    template <typename OperationError>
+    void reserve_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
+    {
+        if (count > max_size())
+        {
+            build_length_error(err);
+            return;
+        }
+
+        if (count > m_size + m_growth_left)
+        {
+            m_resize(err, m_capacity_for(count));
+        }
+    }
+
+    // modifiers
+
+    /// @brief Destroys all elements, memory is kept for following insertions
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts value if there is no equivalent key yet
+     *
+     * @return position of inserted or already present element and true if value was inserted.
+     * In case of error end() and false are returned and content is left unchanged.
+     */
+    template <typename OperationError, typename Arg>
+    std::pair<iterator, bool> m_insert_unique(OperationError& err, Arg&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Constructs pair from key and args for mapped value if there is no equivalent key yet (maps only)
+     *
+     * Nothing is constructed if key is present, so args are left untouched then.
+     */
+    template <typename OperationError, typename K, typename ... Args>
+    std::pair<iterator, bool> m_try_emplace_unique(OperationError& err, K&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts elements of range whose keys are not present yet
+     *
+     * Table is reserved for whole range first if its length is known.
+     * In case of error elements inserted before failure are kept.
+     */
+    template <typename OperationError, typename InputIterator>
+    void m_insert_range_unique(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /// @note Erasure never fails, slot is marked deleted or empty and storage is never shrunk
+    iterator erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
+    {
+        const size_type index = static_cast<size_type>(pos.m_slot - m_slots);
+        m_erase_at(index);
+
+        iterator res = m_iterator_at(index);
+        res.m_skip_empty_or_deleted();
+        return res;
+    }
+
+    template <typename K>
+    size_type m_erase(const K& key) NESTL_NOEXCEPT_SPEC
+    {
+        if (empty())
+        {
+            return 0;
+        }
+
+        const size_type index = m_find_index(key, m_hash_of(key));
+        if (index == m_capacity)
+        {
+            return 0;
+        }
+
+        m_erase_at(index);
+        return 1;
+    }
+
+    void swap(hash_table& other) NESTL_NOEXCEPT_SPEC
+    {
+        nestl::detail::alloc_on_swap(m_alloc, other.m_alloc);
+        m_swap_contents(other);
+    }
+
+    // lookup, K is either key_type or any type which both transparent Hash and KeyEqual accept
+    template <typename K>
+    iterator m_find(const K& key) NESTL_NOEXCEPT_SPEC
+    {
+        return empty() ? end() : m_iterator_at(m_find_index(key, m_hash_of(key)));
+    }
+
+    template <typename K>
+    const_iterator m_find(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        return empty() ? end() : m_iterator_at(m_find_index(key, m_hash_of(key)));
+    }
+
+    template <typename K>
+    size_type m_count(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        return m_find(key) == end() ? 0 : 1;
+    }
+
+    template <typename K>
+    std::pair<iterator, iterator> m_equal_range(const K& key) NESTL_NOEXCEPT_SPEC
+    {
+        iterator first = m_find(key);
+        iterator last = first;
+        if (last != end())
+        {
+            ++last;
+        }
+        return std::pair<iterator, iterator>(first, last);
+    }
+
+    template <typename K>
+    std::pair<const_iterator, const_iterator> m_equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        const_iterator first = m_find(key);
+        const_iterator last = first;
+        if (last != end())
+        {
+            ++last;
+        }
+        return std::pair<const_iterator, const_iterator>(first, last);
+    }
+
+private:
+
+    /// @brief Sequence of groups to check: offsets grow by 1, 2, 3... groups, so every group is visited
+    class probe_seq
+    {
+    public:
+        probe_seq(size_type hash, size_type mask) NESTL_NOEXCEPT_SPEC
+            : m_mask(mask)
+            , m_offset(hash & mask)
+            , m_index(0)
+        {
+        }
+
+        size_type offset() const NESTL_NOEXCEPT_SPEC
+        {
+            return m_offset;
+        }
+
+        size_type offset(size_type i) const NESTL_NOEXCEPT_SPEC
+        {
+            return (m_offset + i) & m_mask;
+        }
+
+        void next() NESTL_NOEXCEPT_SPEC
+        {
+            m_index += group::width;
+            m_offset = (m_offset + m_index) & m_mask;
+        }
+
+    private:
+        size_type m_mask;
+        size_type m_offset;
+        size_type m_index;
+    };
+
+    /// @brief Maximum number of elements in table of given capacity, at least one slot is always empty
+    static size_type m_capacity_to_growth(size_type capacity) NESTL_NOEXCEPT_SPEC
+    {
+        return capacity - (capacity + 1) / 8;
+    }
+
+    /// @brief The smallest capacity which holds count elements
+    static size_type m_capacity_for(size_type count) NESTL_NOEXCEPT_SPEC
+    {
+        size_type capacity = 1;
+        while (m_capacity_to_growth(capacity) < count)
+        {
+            capacity = capacity * 2 + 1;
+        }
+        return capacity;
+    }
+
+    /// @brief Number of value_type elements allocated for slots and control bytes which follow them
+    static size_type m_alloc_size(size_type capacity) NESTL_NOEXCEPT_SPEC
+    {
+        const size_type ctrlSize = capacity + group::width;
+        return capacity + (ctrlSize + sizeof(value_type) - 1) / sizeof(value_type);
+    }
+
+    /**
+     * @brief Hash of key used by table
+     *
+     * Result of Hash is mixed first: std::hash of integers is identity,
+     * but probing position and control byte need well distributed bits.
+     */
+    template <typename K>
+    std::size_t m_hash_of(const K& key) const NESTL_NOEXCEPT_SPEC
+    {
+        std::uint64_t x = static_cast<std::uint64_t>(m_hash(key));
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+
+    /// @brief Start of probing
+    static size_type m_h1(std::size_t hash) NESTL_NOEXCEPT_SPEC
+    {
+        return hash >> 7;
+    }
+
+    /// @brief Bits kept in control byte
+    static ctrl_t m_h2(std::size_t hash) NESTL_NOEXCEPT_SPEC
+    {
+        return static_cast<ctrl_t>(hash & 0x7F);
+    }
+
+    iterator m_iterator_at(size_type index) NESTL_NOEXCEPT_SPEC
+    {
+        return iterator(m_ctrl + index, m_slots + index);
+    }
+
+    const_iterator m_iterator_at(size_type index) const NESTL_NOEXCEPT_SPEC
+    {
+        return const_iterator(m_ctrl + index, m_slots + index);
+    }
+
+    template <typename OperationError, typename Arg>
+    void m_insert_from(OperationError& err, Arg&& val, std::true_type /* is_value */) NESTL_NOEXCEPT_SPEC
+    {
+        m_insert_unique(err, std::forward<Arg>(val));
+    }
+
+    template <typename OperationError, typename Arg>
+    void m_insert_from(OperationError& err, Arg&& arg, std::false_type /* is_value */) NESTL_NOEXCEPT_SPEC
+    {
+        typedef typename std::decay<Arg>::type source_type;
+        m_insert_converted(err, std::forward<Arg>(arg), is_pair_with_key<key_type, source_type>());
+    }
+
+    /// @brief Pair with key is looked up by its key, value is built in slot only if key is absent
+    template <typename OperationError, typename Arg>
+    void m_insert_converted(OperationError& err, Arg&& arg, std::true_type /* is_pair_with_key */) NESTL_NOEXCEPT_SPEC
+    {
+        m_try_emplace_unique(err, std::forward<Arg>(arg).first, std::forward<Arg>(arg).second);
+    }
+
+    /// @brief Key of element of other type is not known until value is built, value is built aside then
+    template <typename OperationError, typename Arg>
+    void m_insert_converted(OperationError& err, Arg&& arg, std::false_type /* is_pair_with_key */) NESTL_NOEXCEPT_SPEC
+    {
+        nestl::aligned_buffer<value_type> tmp;
+        construct_value(err, tmp.ptr(), std::forward<Arg>(arg));
+        if (err)
+        {
+            return;
+        }
+        value_type* tmpEnd = tmp.ptr() + 1;
+        nestl::detail::destruction_scoped_guard<value_type*> tmpGuard(tmp.ptr(), tmpEnd);
+
+        m_insert_unique(err, std::move(*tmp.ptr()));
+    }
+
+    /// @brief Index of slot with key or capacity if key is absent
+    template <typename K>
+    size_type m_find_index(const K& key, std::size_t hash) const NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Index of the first empty or deleted slot on probe sequence of hash, table should have slots
+    size_type m_find_first_non_full(std::size_t hash) const NESTL_NOEXCEPT_SPEC
+    {
+        probe_seq seq(m_h1(hash), m_capacity);
+        for (;;)
+        {
+            const typename group::mask_type mask = group(m_ctrl + seq.offset()).mask_empty_or_deleted();
+            if (mask)
+            {
+                return seq.offset(mask.lowest());
+            }
+            seq.next();
+        }
+    }
+
+    /**
+     * @brief Finds key or free slot for it
+     *
+     * @return index of slot and true if slot is free. Table is grown if it is full,
+     * in case of error capacity and false are returned.
+     */
+    template <typename OperationError, typename K>
+    std::pair<size_type, bool> m_find_or_prepare_insert(OperationError& err, const K& key, std::size_t hash) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Marks free slot with constructed element as full
+    void m_commit_insert(size_type index, std::size_t hash) NESTL_NOEXCEPT_SPEC
+    {
+        if (m_ctrl[index] == nestl::detail::hash_group::ctrl_empty)
+        {
+            --m_growth_left;
+        }
+        m_set_ctrl(index, m_h2(hash));
+        ++m_size;
+    }
+
+    /// @brief Sets control byte of slot and its copy after sentinel
+    void m_set_ctrl(size_type index, ctrl_t ctrl) NESTL_NOEXCEPT_SPEC
+    {
+        const size_type cloned = group::width - 1;
+
+        m_ctrl[index] = ctrl;
+        // for tables smaller than group both indexes may point to the same byte
+        m_ctrl[((index - cloned) & m_capacity) + (cloned & m_capacity)] = ctrl;
+    }
+
+    void m_erase_at(size_type index) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Table is full: it is grown, or rehashed with the same capacity if most of used slots are deleted
+    template <typename OperationError>
+    void m_rehash_for_insert(OperationError& err) NESTL_NOEXCEPT_SPEC
+    {
+        if (m_capacity > group::width && m_size * 32 <= m_capacity * 25)
+        {
+            m_resize(err, m_capacity);
+        }
+        else
+        {
+            m_resize(err, m_capacity * 2 + 1);
+        }
+    }
+
+    /// @brief First phase of relocation of slot, values which can not be moved are copied member by member
+    template <typename OperationError>
+    static void m_relocate_slot(OperationError& err,
+                                value_type* src,
+                                value_type* dst,
+                                nestl::detail::relocate_copy_tag /* tag */) NESTL_NOEXCEPT_SPEC
+    {
+        const value_type& val = *src;
+        construct_value(err, dst, val);
+    }
+
+    template <typename OperationError, typename Tag>
+    static void m_relocate_slot(OperationError& err, value_type* src, value_type* dst, Tag tag) NESTL_NOEXCEPT_SPEC
+    {
+        nestl::detail::uninitialised_relocate(err, src, src + 1, dst, tag);
+    }
+
+    /**
+     * @brief Moves elements to new storage of given capacity
+     *
+     * Elements are relocated, for types which are not nothrow movable that is done by copying.
+     * In case of error table is left unchanged.
+     */
+    template <typename OperationError>
+    void m_resize(OperationError& err, size_type newCapacity) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Fills empty table with copies (or moved values) of elements of other table
+    template <typename OperationError, typename Source>
+    void m_assign_elements(OperationError& err, Source& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void m_allocate(OperationError& err, size_type capacity) NESTL_NOEXCEPT_SPEC;
+
+    void m_destroy_elements() NESTL_NOEXCEPT_SPEC
+    {
+        if (std::is_trivially_destructible<value_type>::value || m_size == 0)
+        {
+            return;
+        }
+
+        for (size_type i = 0; i != m_capacity; ++i)
+        {
+            if (nestl::detail::hash_group::is_full(m_ctrl[i]))
+            {
+                nestl::detail::destroy(m_slots + i);
+            }
+        }
+    }
+
+    /// @brief Deallocates memory, elements should be destroyed already
+    void m_release_storage() NESTL_NOEXCEPT_SPEC
+    {
+        if (m_capacity != 0)
+        {
+            allocator_traits::deallocate(m_alloc, m_slots, m_alloc_size(m_capacity));
+        }
+        m_reset_storage();
+    }
+
+    void m_reset_storage() NESTL_NOEXCEPT_SPEC
+    {
+        m_ctrl = nestl::detail::hash_group::empty_group();
+        m_slots = nullptr;
+        m_size = 0;
+        m_capacity = 0;
+        m_growth_left = 0;
+    }
+
+    /// @brief Takes storage of other table, allocators should propagate or be equal
+    void m_take_storage(hash_table& other) NESTL_NOEXCEPT_SPEC
+    {
+        const hash_table destroyContentAtExit(std::move(*this));
+
+        nestl::detail::alloc_on_move(m_alloc, other.m_alloc);
+        m_swap_contents(other);
+    }
+
+    void m_swap_contents(hash_table& other) NESTL_NOEXCEPT_SPEC
+    {
+        using std::swap;
+
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_size, other.m_size);
+        swap(m_capacity, other.m_capacity);
+        swap(m_growth_left, other.m_growth_left);
+        swap(m_hash, other.m_hash);
+        swap(m_equal, other.m_equal);
+    }
+
+    ctrl_t* m_ctrl;
+    value_type* m_slots;
+    size_type m_size;
+    size_type m_capacity;
+    size_type m_growth_left;
+    Hash m_hash;
+    KeyEqual m_equal;
+    allocator_type m_alloc;
+};
+
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>&
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::operator=(hash_table&& other) NESTL_NOEXCEPT_SPEC
+{
+    static_assert(nestl::detail::alloc_move_takes_storage<allocator_type>::value,
+                  "move assignment may fail for this allocator, use move_assign_nothrow");
+
+    m_take_storage(other);
+    return *this;
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::move_assign_nothrow(OperationError& err,
+                                                                             hash_table&& other) NESTL_NOEXCEPT_SPEC
+{
+    typedef typename allocator_traits::propagate_on_container_move_assignment propagate;
+
+    if (propagate::value || nestl::detail::allocators_equal(m_alloc, other.m_alloc))
+    {
+        m_take_storage(other);
+        return;
+    }
+
+    /// memory of other can not be taken, so elements are moved into storage of our allocator
+    hash_table tmp(other.m_hash, other.m_equal, m_alloc);
+    tmp.m_assign_elements(err, other);
+    if (err)
+    {
+        return;
+    }
+
+    m_swap_contents(tmp);
+    other.clear();
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::copy_nothrow(OperationError& err,
+                                                                      const hash_table& other) NESTL_NOEXCEPT_SPEC
+{
+    hash_table tmp(other.m_hash, other.m_equal, m_alloc);
+    tmp.m_assign_elements(err, other);
+    if (err)
+    {
+        return;
+    }
+
+    m_swap_contents(tmp);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::clear() NESTL_NOEXCEPT_SPEC
+{
+    if (m_capacity == 0)
+    {
+        return;
+    }
+
+    m_destroy_elements();
+
+    std::memset(m_ctrl, nestl::detail::hash_group::ctrl_empty, m_capacity + group::width);
+    m_ctrl[m_capacity] = nestl::detail::hash_group::ctrl_sentinel;
+    m_size = 0;
+    m_growth_left = m_capacity_to_growth(m_capacity);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError, typename Arg>
+std::pair<typename hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::iterator, bool>
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_insert_unique(OperationError& err, Arg&& val) NESTL_NOEXCEPT_SPEC
+{
+    const std::size_t hash = m_hash_of(KeyOfValue()(val));
+    const std::pair<size_type, bool> res = m_find_or_prepare_insert(err, KeyOfValue()(val), hash);
+    if (err)
+    {
+        return std::pair<iterator, bool>(end(), false);
+    }
+
+    if (!res.second)
+    {
+        return std::pair<iterator, bool>(m_iterator_at(res.first), false);
+    }
+
+    construct_value(err, m_slots + res.first, std::forward<Arg>(val));
+    if (err)
+    {
+        return std::pair<iterator, bool>(end(), false);
+    }
+
+    m_commit_insert(res.first, hash);
+    return std::pair<iterator, bool>(m_iterator_at(res.first), true);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError, typename K, typename ... Args>
+std::pair<typename hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::iterator, bool>
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_try_emplace_unique(OperationError& err,
+                                                                              K&& key,
+                                                                              Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    const std::size_t hash = m_hash_of(key);
+    const std::pair<size_type, bool> res = m_find_or_prepare_insert(err, key, hash);
+    if (err)
+    {
+        return std::pair<iterator, bool>(end(), false);
+    }
+
+    if (!res.second)
+    {
+        return std::pair<iterator, bool>(m_iterator_at(res.first), false);
+    }
+
+    // members are built one by one, since piecewise constructor of pair is not usable without exceptions
+    construct_pair(err, m_slots + res.first, std::forward<K>(key), std::forward<Args>(args)...);
+    if (err)
+    {
+        return std::pair<iterator, bool>(end(), false);
+    }
+
+    m_commit_insert(res.first, hash);
+    return std::pair<iterator, bool>(m_iterator_at(res.first), true);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError, typename InputIterator>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_insert_range_unique(OperationError& err,
+                                                                               InputIterator first,
+                                                                               InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+
+    if (std::is_base_of<std::forward_iterator_tag, category>::value)
+    {
+        // duplicates are not known in advance, so reservation may be excessive
+        reserve_nothrow(err, m_size + static_cast<size_type>(std::distance(first, last)));
+        if (err)
+        {
+            return;
+        }
+    }
+
+    typedef typename std::decay<typename std::iterator_traits<InputIterator>::reference>::type source_type;
+    typedef std::integral_constant<bool, std::is_same<source_type, value_type>::value> is_value;
+
+    for ( ; first != last; ++first)
+    {
+        m_insert_from(err, *first, is_value());
+        if (err)
+        {
+            return;
+        }
+    }
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename K>
+typename hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::size_type
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_find_index(const K& key, std::size_t hash) const NESTL_NOEXCEPT_SPEC
+{
+    const ctrl_t h2 = m_h2(hash);
+
+    probe_seq seq(m_h1(hash), m_capacity);
+    for (;;)
+    {
+        const group g(m_ctrl + seq.offset());
+        for (typename group::mask_type match = g.match(h2); match; match.clear_lowest())
+        {
+            const size_type index = seq.offset(match.lowest());
+            if (m_equal(KeyOfValue()(m_slots[index]), key))
+            {
+                return index;
+            }
+        }
+
+        // key would have been inserted into empty slot, so probing stops at group which has one
+        if (g.mask_empty())
+        {
+            return m_capacity;
+        }
+        seq.next();
+    }
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError, typename K>
+std::pair<typename hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::size_type, bool>
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_find_or_prepare_insert(OperationError& err,
+                                                                                  const K& key,
+                                                                                  std::size_t hash) NESTL_NOEXCEPT_SPEC
+{
+    const size_type found = m_find_index(key, hash);
+    if (found != m_capacity)
+    {
+        return std::pair<size_type, bool>(found, false);
+    }
+
+    // deleted slot may be reused even if table is full
+    size_type target = m_capacity == 0 ? 0 : m_find_first_non_full(hash);
+    if (m_growth_left == 0 && (m_capacity == 0 || m_ctrl[target] != nestl::detail::hash_group::ctrl_deleted))
+    {
+        m_rehash_for_insert(err);
+        if (err)
+        {
+            return std::pair<size_type, bool>(m_capacity, false);
+        }
+        target = m_find_first_non_full(hash);
+    }
+
+    return std::pair<size_type, bool>(target, true);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_erase_at(size_type index) NESTL_NOEXCEPT_SPEC
+{
+    nestl::detail::destroy(m_slots + index);
+    --m_size;
+
+    // if every group containing the slot has empty slot, probing never went past this slot
+    // while the slot was full, so it may become empty instead of deleted
+    const size_type indexBefore = (index - group::width) & m_capacity;
+    const typename group::mask_type emptyAfter = group(m_ctrl + index).mask_empty();
+    const typename group::mask_type emptyBefore = group(m_ctrl + indexBefore).mask_empty();
+    const bool wasNeverFull = emptyBefore && emptyAfter &&
+                              emptyAfter.trailing_zeros() + emptyBefore.leading_zeros() < group::width;
+
+    if (wasNeverFull)
+    {
+        m_set_ctrl(index, nestl::detail::hash_group::ctrl_empty);
+        ++m_growth_left;
+    }
+    else
+    {
+        m_set_ctrl(index, nestl::detail::hash_group::ctrl_deleted);
+    }
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_resize(OperationError& err, size_type newCapacity) NESTL_NOEXCEPT_SPEC
+{
+    if (newCapacity > (allocator_traits::max_size(m_alloc) - group::width) / 2)
+    {
+        build_length_error(err);
+        return;
+    }
+
+    hash_table tmp(m_hash, m_equal, m_alloc);
+    tmp.m_allocate(err, newCapacity);
+    if (err)
+    {
+        return;
+    }
+
+    // elements are constructed in new storage first, so failure leaves this table untouched
+    for (size_type i = 0; i != m_capacity; ++i)
+    {
+        if (!nestl::detail::hash_group::is_full(m_ctrl[i]))
+        {
+            continue;
+        }
+
+        const std::size_t hash = m_hash_of(KeyOfValue()(m_slots[i]));
+        const size_type target = tmp.m_find_first_non_full(hash);
+        m_relocate_slot(err, m_slots + i, tmp.m_slots + target, typename nestl::detail::relocate_category<value_type>::type());
+        if (err)
+        {
+            return;
+        }
+        tmp.m_commit_insert(target, hash);
+    }
+
+    for (size_type i = 0; i != m_capacity; ++i)
+    {
+        if (nestl::detail::hash_group::is_full(m_ctrl[i]))
+        {
+            nestl::detail::destroy_relocated(m_slots + i, m_slots + i + 1);
+        }
+    }
+
+    m_release_storage();
+    m_swap_contents(tmp);
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError, typename Source>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_assign_elements(OperationError& err, Source& other) NESTL_NOEXCEPT_SPEC
+{
+    typedef typename std::conditional<std::is_const<Source>::value, const value_type&, value_type&&>::type source_reference;
+
+    assert(empty());
+    if (other.empty())
+    {
+        return;
+    }
+
+    m_allocate(err, m_capacity_for(other.size()));
+    if (err)
+    {
+        return;
+    }
+
+    for (size_type i = 0; i != other.m_capacity; ++i)
+    {
+        if (!nestl::detail::hash_group::is_full(other.m_ctrl[i]))
+        {
+            continue;
+        }
+
+        const std::size_t hash = m_hash_of(KeyOfValue()(other.m_slots[i]));
+        const size_type target = m_find_first_non_full(hash);
+        construct_value(err, m_slots + target, static_cast<source_reference>(other.m_slots[i]));
+        if (err)
+        {
+            return;
+        }
+        m_commit_insert(target, hash);
+    }
+}
+
+template <typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+template <typename OperationError>
+void
+hash_table<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::m_allocate(OperationError& err, size_type capacity) NESTL_NOEXCEPT_SPEC
+{
+    assert(m_capacity == 0);
+
+    value_type* slots = allocator_traits::allocate(err, m_alloc, m_alloc_size(capacity));
+    if (err)
+    {
+        return;
+    }
+
+    m_slots = slots;
+    m_ctrl = reinterpret_cast<ctrl_t*>(slots + capacity);
+    m_capacity = capacity;
+    m_growth_left = m_capacity_to_growth(capacity);
+
+    std::memset(m_ctrl, nestl::detail::hash_group::ctrl_empty, capacity + group::width);
+    m_ctrl[capacity] = nestl::detail::hash_group::ctrl_sentinel;
+}
+
+} // namespace detail
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_DETAIL_HASH_TABLE_HPP */
@@ -0,0 +1,51 @@
+#ifndef NESTL_IMPLEMENTATION_DETAIL_KEY_OF_VALUE_HPP
+#define NESTL_IMPLEMENTATION_DETAIL_KEY_OF_VALUE_HPP
+
+#include <nestl/config.hpp>
+
+/**
+ * @file Extractors of key from value stored in associative containers
+ */
+
+namespace nestl
+{
+namespace impl
+{
+namespace detail
+{
+
+/// @brief Value is key itself (sets)
+template <typename T>
+struct identity
+{
+    T& operator()(T& x) const NESTL_NOEXCEPT_SPEC
+    {
+        return x;
+    }
+
+    const T& operator()(const T& x) const NESTL_NOEXCEPT_SPEC
+    {
+        return x;
+    }
+};
+
+/// @brief Key is first member of pair (maps)
+template <typename Pair>
+struct select1st
+{
+    typename Pair::first_type& operator()(Pair& x) const NESTL_NOEXCEPT_SPEC
+    {
+        return x.first;
+    }
+
+    const typename Pair::first_type& operator()(const Pair& x) const NESTL_NOEXCEPT_SPEC
+    {
+        return x.first;
+    }
+};
+
+} // namespace detail
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_DETAIL_KEY_OF_VALUE_HPP */
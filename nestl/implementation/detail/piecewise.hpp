@@ -0,0 +1,85 @@
+#ifndef NESTL_IMPLEMENTATION_DETAIL_PIECEWISE_HPP
+#define NESTL_IMPLEMENTATION_DETAIL_PIECEWISE_HPP
+
+#include <nestl/config.hpp>
+#include <nestl/class_operations.hpp>
+
+#include <nestl/detail/destroy.hpp>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file Member by member construction of map values
+ *
+ * Piecewise constructor of std::pair is not noexcept, so without exceptions
+ * maps build members of their values one by one straight in raw storage (construct_pair).
+ */
+
+namespace nestl
+{
+namespace impl
+{
+namespace detail
+{
+
+/**
+ * @brief Constructs pair in raw storage at ptr from key and args for its second member
+ *
+ * First member may be const (map keys). On failure nothing is left constructed.
+ */
+template <typename First, typename Second, typename OperationError, typename K, typename ... Args>
+void construct_pair(OperationError& err, std::pair<First, Second>* ptr, K&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    typedef typename std::remove_const<First>::type first_type;
+
+    first_type* first = const_cast<first_type*>(&ptr->first);
+    nestl::class_operations::construct(err, first, std::forward<K>(key));
+    if (err)
+    {
+        return;
+    }
+
+    nestl::class_operations::construct(err, &ptr->second, std::forward<Args>(args)...);
+    if (err)
+    {
+        nestl::detail::destroy(first);
+    }
+}
+
+template <typename T>
+struct is_pair : std::false_type
+{
+};
+
+template <typename First, typename Second>
+struct is_pair<std::pair<First, Second> > : std::true_type
+{
+};
+
+/// @brief Constructs value at ptr from src
+template <typename T, typename OperationError, typename Arg>
+typename std::enable_if<!is_pair<T>::value>::type
+construct_value(OperationError& err, T* ptr, Arg&& src) NESTL_NOEXCEPT_SPEC
+{
+    nestl::class_operations::construct(err, ptr, std::forward<Arg>(src));
+}
+
+/**
+ * @brief Constructs pair at ptr from members of pair src one by one
+ *
+ * Const key of rvalue src can not be moved from, so it is copied.
+ */
+template <typename First, typename Second, typename OperationError, typename Pair>
+typename std::enable_if<is_pair<typename std::decay<Pair>::type>::value>::type
+construct_value(OperationError& err, std::pair<First, Second>* ptr, Pair&& src) NESTL_NOEXCEPT_SPEC
+{
+    construct_pair(err, ptr, std::forward<Pair>(src).first, std::forward<Pair>(src).second);
+}
+
+} // namespace detail
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_DETAIL_PIECEWISE_HPP */
@@ -12,10 +12,16 @@
 #include <nestl/allocator.hpp>
 #include <nestl/class_operations.hpp>
 #include <nestl/algorithm.hpp>
+#include <nestl/tree_policy.hpp>
+#include <nestl/type_traits.hpp>
 
 #include <nestl/detail/allocator_traits_helper.hpp>
 
+#include <nestl/implementation/detail/piecewise.hpp>
+
+
 #include <cassert>
+#include <iterator>
 
 namespace nestl
 {
@@ -82,10 +88,10 @@ struct rb_tree_node_base
 };
 
 
-template<typename Val>
-struct rb_tree_node : public rb_tree_node_base
+template<typename Val, typename TreePolicy = nestl::default_tree_policy>
+struct rb_tree_node : public TreePolicy::template node<rb_tree_node_base>
 {
-    typedef rb_tree_node<Val>* link_type;
+    typedef rb_tree_node<Val, TreePolicy>* link_type;
 
     nestl::aligned_buffer<Val> m_storage;
 
@@ -104,6 +110,13 @@ struct rb_tree_node : public rb_tree_node_base
     {
         return nestl::class_operations::construct(err, m_valptr(), std::forward<Args>(args) ...);
     }
+
+    /// @brief Map value is built from other pair member by member, see piecewise.hpp
+    template <typename OperationError, typename Arg>
+    void construct_val(OperationError& err, Arg&& arg) NESTL_NOEXCEPT_SPEC
+    {
+        construct_value(err, m_valptr(), std::forward<Arg>(arg));
+    }
 };
 
 template <typename RbTreeNodeBasePtr>
@@ -159,7 +172,7 @@ RbTreeNodeBasePtr rb_tree_decrement(RbTreeNodeBasePtr x) NESTL_NOEXCEPT_SPEC
 }
 
 
-template <typename T>
+template <typename T, typename TreePolicy = nestl::default_tree_policy>
 struct rb_tree_iterator
 {
     typedef std::ptrdiff_t                    difference_type;
@@ -169,7 +182,7 @@ struct rb_tree_iterator
     typedef T*                                pointer;
 
     typedef rb_tree_node_base*                base_ptr;
-    typedef rb_tree_node<T>*                  link_type;
+    typedef rb_tree_node<T, TreePolicy>*      link_type;
 
     rb_tree_iterator() NESTL_NOEXCEPT_SPEC
         : m_node()
@@ -236,7 +249,7 @@ struct rb_tree_iterator
     base_ptr m_node;
 };
 
-template <typename T>
+template <typename T, typename TreePolicy = nestl::default_tree_policy>
 struct rb_tree_const_iterator
 {
     typedef std::ptrdiff_t                      difference_type;
@@ -245,10 +258,10 @@ struct rb_tree_const_iterator
     typedef const T&                            reference;
     typedef const T*                            pointer;
 
-    typedef rb_tree_iterator<T>                 iterator;
+    typedef rb_tree_iterator<T, TreePolicy>     iterator;
 
     typedef rb_tree_node_base::const_base_ptr   base_ptr;
-    typedef const rb_tree_node<T>*              link_type;
+    typedef const rb_tree_node<T, TreePolicy>*  link_type;
 
     rb_tree_const_iterator() NESTL_NOEXCEPT_SPEC
         : m_node()
@@ -330,21 +343,22 @@ struct rb_tree_const_iterator
     base_ptr m_node;
   };
 
-template<typename Val>
+template<typename Val, typename TreePolicy>
 inline bool
-operator== (const rb_tree_iterator<Val>& x, const rb_tree_const_iterator<Val>& y) NESTL_NOEXCEPT_SPEC
+operator== (const rb_tree_iterator<Val, TreePolicy>& x, const rb_tree_const_iterator<Val, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
 {
     return x.m_node == y.m_node;
 }
 
-template<typename Val>
+template<typename Val, typename TreePolicy>
 inline bool
-operator!=(const rb_tree_iterator<Val>& x, const rb_tree_const_iterator<Val>& y) NESTL_NOEXCEPT_SPEC
+operator!=(const rb_tree_iterator<Val, TreePolicy>& x, const rb_tree_const_iterator<Val, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
 {
     return x.m_node != y.m_node;
 }
 
 
+template <typename TreePolicy>
 inline void local_rb_tree_rotate_left(rb_tree_node_base* const x, rb_tree_node_base*& root)
 {
     rb_tree_node_base* const y = x->m_right;
@@ -362,8 +376,12 @@ inline void local_rb_tree_rotate_left(rb_tree_node_base* const x, rb_tree_node_b
         x->m_parent->m_right = y;
     y->m_left = x;
     x->m_parent = y;
+
+    TreePolicy::update(x);
+    TreePolicy::update(y);
 }
 
+template <typename TreePolicy>
 inline void local_rb_tree_rotate_right(rb_tree_node_base* const x, rb_tree_node_base*& root)
 {
     rb_tree_node_base* const y = x->m_left;
@@ -381,46 +399,20 @@ inline void local_rb_tree_rotate_right(rb_tree_node_base* const x, rb_tree_node_
         x->m_parent->m_left = y;
     y->m_right = x;
     x->m_parent = y;
+
+    TreePolicy::update(x);
+    TreePolicy::update(y);
 }
 
 
-inline void rb_tree_insert_and_rebalance(const bool insert_left,
-                                         rb_tree_node_base* x,
-                                         rb_tree_node_base* p,
-                                         rb_tree_node_base& header) NESTL_NOEXCEPT_SPEC
+/**
+ * @brief Restores red-black properties after red node x was linked into tree with given root
+ *
+ * Children of x should be black and have equal black height. Root may be left red.
+ */
+template <typename TreePolicy>
+inline void rb_tree_rebalance_after_insert(rb_tree_node_base* x, rb_tree_node_base*& root) NESTL_NOEXCEPT_SPEC
 {
-    rb_tree_node_base *& root = header.m_parent;
-
-    // Initialize fields in new node to insert.
-    x->m_parent = p;
-    x->m_left = 0;
-    x->m_right = 0;
-    x->m_color = rb_red;
-
-    // Insert.
-    // Make new node child of parent and maintain root, leftmost and
-    // rightmost nodes.
-    // N.B. First node is always inserted left.
-    if (insert_left)
-    {
-        p->m_left = x; // also makes leftmost = x when p == &header
-
-        if (p == &header)
-        {
-            header.m_parent = x;
-            header.m_right = x;
-        }
-        else if (p == header.m_left)
-            header.m_left = x; // maintain leftmost pointing to min node
-    }
-    else
-    {
-        p->m_right = x;
-
-        if (p == header.m_right)
-            header.m_right = x; // maintain rightmost pointing to max node
-    }
-    // Rebalance.
     while (x != root && x->m_parent->m_color == rb_red)
     {
         rb_tree_node_base* const xpp = x->m_parent->m_parent;
@@ -440,11 +432,11 @@ inline void rb_tree_insert_and_rebalance(const bool insert_left,
                 if (x == x->m_parent->m_right)
                 {
                     x = x->m_parent;
-                    local_rb_tree_rotate_left(x, root);
+                    local_rb_tree_rotate_left<TreePolicy>(x, root);
                 }
                 x->m_parent->m_color = rb_black;
                 xpp->m_color = rb_red;
-                local_rb_tree_rotate_right(xpp, root);
+                local_rb_tree_rotate_right<TreePolicy>(xpp, root);
             }
         }
         else
@@ -462,17 +454,61 @@ inline void rb_tree_insert_and_rebalance(const bool insert_left,
                 if (x == x->m_parent->m_left)
                 {
                     x = x->m_parent;
-                    local_rb_tree_rotate_right(x, root);
+                    local_rb_tree_rotate_right<TreePolicy>(x, root);
                 }
                 x->m_parent->m_color = rb_black;
                 xpp->m_color = rb_red;
-                local_rb_tree_rotate_left(xpp, root);
+                local_rb_tree_rotate_left<TreePolicy>(xpp, root);
             }
         }
     }
+}
+
+template <typename TreePolicy>
+inline void rb_tree_insert_and_rebalance(const bool insert_left,
+                                         rb_tree_node_base* x,
+                                         rb_tree_node_base* p,
+                                         rb_tree_node_base& header) NESTL_NOEXCEPT_SPEC
+{
+    rb_tree_node_base *& root = header.m_parent;
+
+    // Initialize fields in new node to insert.
+    x->m_parent = p;
+    x->m_left = 0;
+    x->m_right = 0;
+    x->m_color = rb_red;
+
+    // Insert.
+    // Make new node child of parent and maintain root, leftmost and
+    // rightmost nodes.
+    // N.B. First node is always inserted left.
+    if (insert_left)
+    {
+        p->m_left = x; // also makes leftmost = x when p == &header
+
+        if (p == &header)
+        {
+            header.m_parent = x;
+            header.m_right = x;
+        }
+        else if (p == header.m_left)
+            header.m_left = x; // maintain leftmost pointing to min node
+    }
+    else
+    {
+        p->m_right = x;
+
+        if (p == header.m_right)
+            header.m_right = x; // maintain rightmost pointing to max node
+    }
+    TreePolicy::on_insert(x, &header);
+
+    // Rebalance.
+    rb_tree_rebalance_after_insert<TreePolicy>(x, root);
     root->m_color = rb_black;
 }
 
+template <typename TreePolicy>
 inline rb_tree_node_base*
 rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
                             rb_tree_node_base& header) NESTL_NOEXCEPT_SPEC
@@ -497,6 +533,7 @@ rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
                 y = y->m_left;
             x = y->m_right;
         }
+    TreePolicy::on_erase(y->m_parent, &header);
     if (y != z)
     {
         // relink y in place of z.  y is z's successor
@@ -519,6 +556,7 @@ rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
         else
             z->m_parent->m_right = y;
         y->m_parent = z->m_parent;
+        TreePolicy::copy(y, static_cast<const rb_tree_node_base*>(z));
         std::swap(y->m_color, z->m_color);
         y = z;
         // y now points to node to be actually deleted
@@ -562,7 +600,7 @@ rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
         {
           w->m_color = rb_black;
           x_parent->m_color = rb_red;
-          local_rb_tree_rotate_left(x_parent, root);
+          local_rb_tree_rotate_left<TreePolicy>(x_parent, root);
           w = x_parent->m_right;
         }
           if ((w->m_left == 0 ||
@@ -581,14 +619,14 @@ rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
             {
               w->m_left->m_color = rb_black;
               w->m_color = rb_red;
-              local_rb_tree_rotate_right(w, root);
+              local_rb_tree_rotate_right<TreePolicy>(w, root);
               w = x_parent->m_right;
             }
           w->m_color = x_parent->m_color;
           x_parent->m_color = rb_black;
           if (w->m_right)
             w->m_right->m_color = rb_black;
-          local_rb_tree_rotate_left(x_parent, root);
+          local_rb_tree_rotate_left<TreePolicy>(x_parent, root);
           break;
         }
         }
@@ -600,7 +638,7 @@ rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
         {
           w->m_color = rb_black;
           x_parent->m_color = rb_red;
-          local_rb_tree_rotate_right(x_parent, root);
+          local_rb_tree_rotate_right<TreePolicy>(x_parent, root);
           w = x_parent->m_left;
         }
           if ((w->m_right == 0 ||
@@ -618,14 +656,14 @@ rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
             {
               w->m_right->m_color = rb_black;
               w->m_color = rb_red;
-              local_rb_tree_rotate_left(w, root);
+              local_rb_tree_rotate_left<TreePolicy>(w, root);
               w = x_parent->m_left;
             }
           w->m_color = x_parent->m_color;
           x_parent->m_color = rb_black;
           if (w->m_left)
             w->m_left->m_color = rb_black;
-          local_rb_tree_rotate_right(x_parent, root);
+          local_rb_tree_rotate_right<TreePolicy>(x_parent, root);
           break;
         }
         }
@@ -635,11 +673,177 @@ rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
   }
 
 
+/**
+ * @brief Subtree detached from tree: root is black or null and has no parent
+ *
+ * Split and join of such subtrees (see Blelloch, Ferizovic, Sun "Just Join for Parallel Ordered Sets")
+ * let set operations relink nodes instead of inserting or erasing them one by one.
+ */
+struct rb_tree_subtree
+{
+    rb_tree_node_base* m_root;
+    size_t             m_black_height; // black nodes on path from root to leaf, root included
+};
+
+/// @brief Number of black nodes on path from subtree root x down to leaf
+inline size_t
+rb_tree_black_height(const rb_tree_node_base* x) NESTL_NOEXCEPT_SPEC
+{
+    size_t height = 0;
+    for (; x != 0; x = x->m_left)
+    {
+        if (x->m_color == rb_black)
+        {
+            ++height;
+        }
+    }
+    return height;
+}
+
+/// @brief Detaches child x whose black height counted without x's own color is blackHeight
+inline rb_tree_subtree
+rb_tree_detach_child(rb_tree_node_base* x, size_t blackHeight) NESTL_NOEXCEPT_SPEC
+{
+    rb_tree_subtree t = {x, blackHeight};
+    if (x != 0)
+    {
+        x->m_parent = 0;
+        if (x->m_color == rb_red)
+        {
+            x->m_color = rb_black;
+            ++t.m_black_height;
+        }
+    }
+    return t;
+}
+
+/// @brief Unlinks root of non-empty subtree t from its children, which become subtrees left and right
+inline rb_tree_node_base*
+rb_tree_expose(rb_tree_subtree t, rb_tree_subtree& left, rb_tree_subtree& right) NESTL_NOEXCEPT_SPEC
+{
+    rb_tree_node_base* const x = t.m_root;
+    left = rb_tree_detach_child(x->m_left, t.m_black_height - 1);
+    right = rb_tree_detach_child(x->m_right, t.m_black_height - 1);
+    x->m_left = 0;
+    x->m_right = 0;
+    return x;
+}
+
+/**
+ * @brief Joins subtrees with node k whose key is between keys of left and right
+ *
+ * k is linked as red node on the spine of the higher subtree at the black height
+ * of the lower one, so join takes O(|difference of black heights| + 1).
+ */
+template <typename TreePolicy>
+inline rb_tree_subtree
+rb_tree_join(rb_tree_subtree left, rb_tree_node_base* k, rb_tree_subtree right) NESTL_NOEXCEPT_SPEC
+{
+    if (left.m_black_height == right.m_black_height)
+    {
+        k->m_color = rb_black;
+        k->m_parent = 0;
+        k->m_left = left.m_root;
+        k->m_right = right.m_root;
+        if (left.m_root)
+            left.m_root->m_parent = k;
+        if (right.m_root)
+            right.m_root->m_parent = k;
+        TreePolicy::update(k);
+
+        rb_tree_subtree t = {k, left.m_black_height + 1};
+        return t;
+    }
+
+    const bool leftIsHigher = left.m_black_height > right.m_black_height;
+    rb_tree_subtree t = leftIsHigher ? left : right;
+    const rb_tree_subtree& lower = leftIsHigher ? right : left;
+
+    // find black node (or leaf) of the same black height as the lower subtree
+    rb_tree_node_base* p = 0;
+    rb_tree_node_base* x = t.m_root;
+    size_t height = t.m_black_height;
+    while (height > lower.m_black_height || (x && x->m_color == rb_red))
+    {
+        if (x->m_color == rb_black)
+        {
+            --height;
+        }
+        p = x;
+        x = leftIsHigher ? x->m_right : x->m_left;
+    }
+
+    k->m_color = rb_red;
+    k->m_parent = p;
+    if (leftIsHigher)
+    {
+        p->m_right = k;
+        k->m_left = x;
+        k->m_right = lower.m_root;
+    }
+    else
+    {
+        p->m_left = k;
+        k->m_left = lower.m_root;
+        k->m_right = x;
+    }
+    if (x)
+        x->m_parent = k;
+    if (lower.m_root)
+        lower.m_root->m_parent = k;
+    TreePolicy::update_path(k, t.m_root->m_parent);
+
+    rb_tree_rebalance_after_insert<TreePolicy>(k, t.m_root);
+    if (t.m_root->m_color == rb_red)
+    {
+        t.m_root->m_color = rb_black;
+        ++t.m_black_height;
+    }
+    return t;
+}
+
+/// @brief Unlinks the last node of non-empty subtree t, returns the rest
+template <typename TreePolicy>
+inline rb_tree_subtree
+rb_tree_split_last(rb_tree_subtree t, rb_tree_node_base*& last) NESTL_NOEXCEPT_SPEC
+{
+    rb_tree_subtree left;
+    rb_tree_subtree right;
+    rb_tree_node_base* const x = rb_tree_expose(t, left, right);
+    if (right.m_root == 0)
+    {
+        last = x;
+        return left;
+    }
+    return rb_tree_join<TreePolicy>(left, x, rb_tree_split_last<TreePolicy>(right, last));
+}
+
+/// @brief Joins subtrees whose keys are all less in left than in right
+template <typename TreePolicy>
+inline rb_tree_subtree
+rb_tree_join(rb_tree_subtree left, rb_tree_subtree right) NESTL_NOEXCEPT_SPEC
+{
+    if (left.m_root == 0)
+    {
+        return right;
+    }
+    if (right.m_root == 0)
+    {
+        return left;
+    }
+
+    rb_tree_node_base* last = 0;
+    rb_tree_subtree rest = rb_tree_split_last<TreePolicy>(left, last);
+    return rb_tree_join<TreePolicy>(rest, last, right);
+}
+
+
 template<typename Key, typename Val, typename KeyOfValue,
-         typename Compare, typename Alloc = allocator<Val> >
+         typename Compare, typename Alloc = allocator<Val>,
+         typename TreePolicy = nestl::default_tree_policy>
 class rb_tree
 {
-    typedef typename nestl::detail::allocator_rebind<Alloc, rb_tree_node<Val> >::other node_allocator;
+    typedef typename nestl::detail::allocator_rebind<Alloc, rb_tree_node<Val, TreePolicy> >::other node_allocator;
     typedef nestl::allocator_traits<node_allocator>            node_allocator_traits;
 
 protected:
@@ -653,14 +857,14 @@ public:
     typedef const value_type*                         const_pointer;
     typedef value_type&                               reference;
     typedef const value_type&                         const_reference;
-    typedef rb_tree_node<Val>*                        link_type;
-    typedef const rb_tree_node<Val>*                  const_link_type;
+    typedef rb_tree_node<Val, TreePolicy>*            link_type;
+    typedef const rb_tree_node<Val, TreePolicy>*      const_link_type;
     typedef size_t 				                      size_type;
     typedef ptrdiff_t 			                      difference_type;
     typedef Alloc 				                      allocator_type;
 
-    typedef rb_tree_iterator<value_type>              iterator;
-    typedef rb_tree_const_iterator<value_type>        const_iterator;
+    typedef rb_tree_iterator<value_type, TreePolicy>        iterator;
+    typedef rb_tree_const_iterator<value_type, TreePolicy>  const_iterator;
 
     typedef std::reverse_iterator<iterator>           reverse_iterator;
     typedef std::reverse_iterator<const_iterator>     const_reverse_iterator;
@@ -721,11 +925,39 @@ protected:
         return l;
     }
 
+    /**
+     * @brief Creates node with pair whose members are built from key and args
+     *
+     * Piecewise constructor of pair is not noexcept, so members are constructed
+     * one by one in storage of node (see piecewise.hpp).
+     */
+    template<typename OperationError, typename K, typename... Args>
+    link_type m_create_node_for_key(OperationError& err, K&& key, Args&&... args) NESTL_NOEXCEPT_SPEC
+    {
+        node_allocator& node_alloc = m_get_node_allocator();
+        link_type l = node_allocator_traits::allocate(err, node_alloc, 1);
+        if (err)
+        {
+            return nullptr;
+        }
+
+        nestl::detail::deallocation_scoped_guard<link_type, node_allocator> guard(node_alloc, l, 1);
+
+        construct_pair(err, l->m_valptr(), std::forward<K>(key), std::forward<Args>(args)...);
+        if (err)
+        {
+            return nullptr;
+        }
+
+        guard.release();
+        return l;
+    }
+
     void
     m_destroy_node(link_type p) NESTL_NOEXCEPT_SPEC
     {
         nestl::detail::destroy(p->m_valptr());
-        p->~rb_tree_node<Val>();
+        p->~rb_tree_node<Val, TreePolicy>();
         m_put_node(p);
     }
 
@@ -742,6 +974,7 @@ protected:
         l->m_color = x->m_color;
         l->m_left = 0;
         l->m_right = 0;
+        TreePolicy::copy(static_cast<base_ptr>(l), static_cast<const_base_ptr>(x));
 
         return l;
     }
@@ -966,28 +1199,131 @@ private:
     iterator
     m_insert_equal_lower_node(link_type z) NESTL_NOEXCEPT_SPEC;
 
+    /// @brief Erases subtree of not yet attached nodes unless released
+    class erase_guard
+    {
+        erase_guard(const erase_guard& ) = delete;
+        erase_guard& operator=(const erase_guard& ) = delete;
+    public:
+
+        erase_guard(rb_tree& tree, link_type t)
+            : m_top(t)
+            , m_tree(tree)
+        {
+        }
+
+        ~erase_guard()
+        {
+            if (m_top)
+            {
+                m_tree.m_erase(m_top);
+            }
+        }
+
+        void release()
+        {
+            m_top = 0;
+        }
+
+    private:
+        link_type m_top;
+        rb_tree& m_tree;
+    };
+
     template<typename OperationError>
     link_type
     m_copy(OperationError& err, const_link_type x, link_type p) NESTL_NOEXCEPT_SPEC;
 
+    /**
+     * @brief Builds balanced subtree of count distinct elements of sorted range starting at first
+     *
+     * Nodes on depth redDepth are colored red, all others black. first is advanced past consumed elements.
+     */
+    template<typename OperationError, typename ForwardIterator>
+    link_type
+    m_build_sorted(OperationError& err, ForwardIterator& first, ForwardIterator last,
+                   size_type count, size_type depth, size_type redDepth) NESTL_NOEXCEPT_SPEC;
+
     void
     m_erase(link_type x) NESTL_NOEXCEPT_SPEC;
 
+    /// @brief Takes all nodes out of tree, which is left empty
+    rb_tree_subtree
+    m_detach_nodes() NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Installs count nodes of subtree t into empty tree
+    void
+    m_attach_nodes(rb_tree_subtree t, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Splits subtree t into nodes with keys less and greater than k
+     *
+     * @return node with key equivalent to k or null
+     */
+    link_type
+    m_split(rb_tree_subtree t, const key_type& k,
+            rb_tree_subtree& left, rb_tree_subtree& right) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Links single node z into subtree t unless t has node with equivalent key
+     *
+     * @return false if z was not linked
+     */
+    bool
+    m_link_unique(rb_tree_subtree& t, link_type z) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Unites subtrees, nodes of t2 equivalent to ones of t1 are destroyed by other and counted
+    rb_tree_subtree
+    m_unite(rb_tree_subtree t1, rb_tree_subtree t2, rb_tree& other, size_type& duplicates) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Keeps nodes of t1 which have equivalent in t2, all nodes of t2 are destroyed by other
+    rb_tree_subtree
+    m_intersect(rb_tree_subtree t1, rb_tree_subtree t2, rb_tree& other, size_type& common) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Keeps nodes of t1 which have no equivalent in t2, all nodes of t2 are destroyed by other
+    rb_tree_subtree
+    m_subtract(rb_tree_subtree t1, rb_tree_subtree t2, rb_tree& other, size_type& common) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
     iterator
     m_lower_bound(link_type x, link_type y,
-           const Key& k) NESTL_NOEXCEPT_SPEC;
+           const K& k) NESTL_NOEXCEPT_SPEC;
 
+    template <typename K>
     const_iterator
     m_lower_bound(const_link_type x, const_link_type y,
-           const Key& k) const NESTL_NOEXCEPT_SPEC;
+           const K& k) const NESTL_NOEXCEPT_SPEC;
 
+    template <typename K>
     iterator
     m_upper_bound(link_type x, link_type y,
-           const Key& k) NESTL_NOEXCEPT_SPEC;
+           const K& k) NESTL_NOEXCEPT_SPEC;
 
+    template <typename K>
     const_iterator
     m_upper_bound(const_link_type x, const_link_type y,
-           const Key& k) const NESTL_NOEXCEPT_SPEC;
+           const K& k) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    iterator
+    m_find(const K& k) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    const_iterator
+    m_find(const K& k) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    std::pair<iterator, iterator>
+    m_equal_range(const K& k) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    std::pair<const_iterator, const_iterator>
+    m_equal_range(const K& k) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K, typename KeyLess>
+    const_link_type
+    m_lower_bound_with(const_link_type x, const_link_type y,
+           const K& k, const KeyLess& less) const NESTL_NOEXCEPT_SPEC;
 
 public:
     // allocation/deallocation
@@ -1011,7 +1347,7 @@ public:
     {
         if (x.m_root() != 0)
         {
-			m_move_data(x, std::true_type());
+			m_move_data(x);
         }
     }
 
@@ -1143,17 +1479,17 @@ public:
     iterator_with_flag
     m_insert_unique(OperationError& err, Arg&& x) NESTL_NOEXCEPT_SPEC;
 
-    template <typename Arg>
+    template <typename OperationError, typename Arg>
     iterator
-    m_insert_equal(Arg&& x) NESTL_NOEXCEPT_SPEC;
+    m_insert_equal(OperationError& err, Arg&& x) NESTL_NOEXCEPT_SPEC;
 
     template <typename OperationError, typename Arg>
     iterator
     m_insert_unique_at(OperationError& err, const_iterator position, Arg&& x) NESTL_NOEXCEPT_SPEC;
 
-    template <typename Arg>
+    template <typename OperationError, typename Arg>
     iterator
-    m_insert_equal_at(const_iterator position, Arg&& x) NESTL_NOEXCEPT_SPEC;
+    m_insert_equal_at(OperationError& err, const_iterator position, Arg&& x) NESTL_NOEXCEPT_SPEC;
 
     template<typename OperationError, typename... Args>
     iterator_with_flag
@@ -1175,9 +1511,53 @@ public:
     void
     m_insert_unique(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
 
-    template<typename InputIterator>
+    template<typename OperationError, typename InputIterator>
+    void
+    m_insert_equal(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts pair built from key and args if key is not present yet
+     *
+     * Lookup goes first, so neither node is allocated nor args are touched for present key.
+     */
+    template<typename OperationError, typename K, typename... Args>
+    iterator_with_flag
+    m_try_emplace_unique(OperationError& err, K&& key, Args&&... args) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Assigns obj to mapped value of present key, otherwise inserts pair built from key and obj
+    template<typename OperationError, typename K, typename M>
+    iterator_with_flag
+    m_insert_or_assign_unique(OperationError& err, K&& key, M&& obj) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Replaces content by elements of sorted range, equivalent elements but first one are skipped
+     *
+     * Tree is built balanced in linear time without comparisons against tree nodes.
+     * In case of error tree is left unchanged.
+     */
+    template<typename OperationError, typename ForwardIterator>
+    void
+    m_assign_sorted_unique(OperationError& err, ForwardIterator first, ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Moves elements of other tree with keys not present yet here, other is left empty
+     *
+     * With equal allocators nodes of other are relinked by split and join of trees
+     * in O(m log(n/m + 1)) for tree sizes m <= n and nothing is allocated.
+     * Otherwise elements are moved one by one, in case of error elements which are
+     * not moved yet are left in other.
+     */
+    template<typename OperationError>
+    void
+    m_unite_unique(OperationError& err, rb_tree& other) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Erases elements with keys not present in other tree, other is left empty
+    void
+    m_intersect_unique(rb_tree& other) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Erases elements with keys present in other tree, other is left empty
     void
-    m_insert_equal(InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+    m_subtract_unique(rb_tree& other) NESTL_NOEXCEPT_SPEC;
 
 private:
     void
@@ -1236,6 +1616,19 @@ public:
     const_iterator
     find(const key_type& k) const NESTL_NOEXCEPT_SPEC;
 
+    /**
+     * @brief Lookup by value of other type, which is never converted to key_type
+     *
+     * less should compare keys and k in both orders and give the same order as key_compare
+     */
+    template <typename K, typename KeyLess>
+    iterator
+    find_with(const K& k, const KeyLess& less) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K, typename KeyLess>
+    const_iterator
+    find_with(const K& k, const KeyLess& less) const NESTL_NOEXCEPT_SPEC;
+
     size_type
     count(const key_type& k) const NESTL_NOEXCEPT_SPEC;
 
@@ -1261,94 +1654,181 @@ public:
     std::pair<const_iterator, const_iterator>
     equal_range(const key_type& k) const NESTL_NOEXCEPT_SPEC;
 
-    // Debugging.
-    bool
-    __rb_verify() const NESTL_NOEXCEPT_SPEC;
+    // Order statistics, available if TreePolicy keeps subtree sizes.
+    /// @brief Element with index n in sorted order or end() if n >= size()
+    iterator
+    m_nth(size_type n) NESTL_NOEXCEPT_SPEC
+    { return static_cast<const rb_tree&>(*this).m_nth(n).m_const_cast(); }
 
-    bool
-    m_move_assign(rb_tree& other) NESTL_NOEXCEPT_SPEC;
+    const_iterator
+    m_nth(size_type n) const NESTL_NOEXCEPT_SPEC;
 
-private:
-    // Move elements from container with equal allocator.
-    void
-    m_move_data(rb_tree& other, std::true_type) NESTL_NOEXCEPT_SPEC;
+    /// @brief Number of elements with keys less than k, which is index of element with key k if present
+    template <typename K>
+    size_type
+    m_rank(const K& k) const NESTL_NOEXCEPT_SPEC;
 
-    // Move elements from container with possibly non-equal allocator,
-    // which might result in a copy not a move.
-    void
-    m_move_data(rb_tree& other, std::false_type) NESTL_NOEXCEPT_SPEC;
-};
+    // Lookup by any type comparable with keys, if Compare is transparent.
+    // Argument is passed to comparator as is, so no temporary key is built.
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    find(const K& k) NESTL_NOEXCEPT_SPEC
+    { return m_find(k); }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-inline bool
-operator==(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) NESTL_NOEXCEPT_SPEC
-{
-		return x.size() == y.size() && nestl::equal(x.begin(), x.end(), y.begin());
-}
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    find(const K& k) const NESTL_NOEXCEPT_SPEC
+    { return m_find(k); }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-inline bool
-operator<(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-		  const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) NESTL_NOEXCEPT_SPEC
-{
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, size_type>::type
+    count(const K& k) const NESTL_NOEXCEPT_SPEC
+    {
+        std::pair<const_iterator, const_iterator> p = m_equal_range(k);
+        return std::distance(p.first, p.second);
+    }
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    lower_bound(const K& k) NESTL_NOEXCEPT_SPEC
+    { return m_lower_bound(m_begin(), m_end(), k); }
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    lower_bound(const K& k) const NESTL_NOEXCEPT_SPEC
+    { return m_lower_bound(m_begin(), m_end(), k); }
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    upper_bound(const K& k) NESTL_NOEXCEPT_SPEC
+    { return m_upper_bound(m_begin(), m_end(), k); }
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    upper_bound(const K& k) const NESTL_NOEXCEPT_SPEC
+    { return m_upper_bound(m_begin(), m_end(), k); }
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<iterator, iterator> >::type
+    equal_range(const K& k) NESTL_NOEXCEPT_SPEC
+    { return m_equal_range(k); }
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& k) const NESTL_NOEXCEPT_SPEC
+    { return m_equal_range(k); }
+
+    // Debugging.
+    bool
+    __rb_verify() const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Takes nodes of other tree if allocator propagates or allocators are equal
+     *
+     * @return false if nodes can not be taken, elements should be moved by m_move_elements then
+     */
+    bool
+    m_move_assign(rb_tree& other) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Moves elements of other tree into nodes allocated by our allocator
+    template <typename OperationError>
+    void
+    m_move_elements(OperationError& err, rb_tree& other) NESTL_NOEXCEPT_SPEC;
+
+private:
+    // Checks data which TreePolicy keeps in node x.
+    bool
+    m_verify_node_data(const_link_type x) const NESTL_NOEXCEPT_SPEC
+    { return m_verify_node_data(x, std::integral_constant<bool, TreePolicy::keeps_subtree_size>()); }
+
+    bool
+    m_verify_node_data(const_link_type /* x */, std::false_type) const NESTL_NOEXCEPT_SPEC
+    { return true; }
+
+    bool
+    m_verify_node_data(const_link_type x, std::true_type) const NESTL_NOEXCEPT_SPEC
+    {
+        const_base_ptr node = x;
+        return TreePolicy::size(node) == TreePolicy::size(node->m_left) + TreePolicy::size(node->m_right) + 1;
+    }
+
+    // Move elements from container with equal allocator.
+    void
+    m_move_data(rb_tree& other) NESTL_NOEXCEPT_SPEC;
+};
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+inline bool
+operator==(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& x,
+           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
+{
+		return x.size() == y.size() && nestl::equal(x.begin(), x.end(), y.begin());
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+inline bool
+operator<(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& x,
+		  const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
+{
 	return nestl::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 inline bool
-operator!=(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) NESTL_NOEXCEPT_SPEC
+operator!=(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& x,
+           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
 {
 	return !(x == y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 inline bool
-operator>(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-          const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) NESTL_NOEXCEPT_SPEC
+operator>(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& x,
+          const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
 {
 	return y < x;
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 inline bool
-operator<=(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) NESTL_NOEXCEPT_SPEC
+operator<=(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& x,
+           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
 {
     return !(y < x);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 inline bool
-operator>=(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) NESTL_NOEXCEPT_SPEC
+operator>=(const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& x,
+           const rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
 {
     return !(x < y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 inline void
-swap(rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-     rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) NESTL_NOEXCEPT_SPEC
+swap(rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& x,
+     rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& y) NESTL_NOEXCEPT_SPEC
 {
     x.swap(y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::rb_tree(rb_tree&& x, node_allocator&& a) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::rb_tree(rb_tree&& x, node_allocator&& a) NESTL_NOEXCEPT_SPEC
     : m_impl(x.m_impl.m_key_compare, std::move(a))
 {
-    typedef std::integral_constant<bool, node_allocator_traits::s_always_equal()> eq_t;
+    static_assert(node_allocator_traits::is_always_equal::value,
+                  "elements would be moved one by one into nodes of given allocator, which may fail");
+
     if (x.m_root() != 0)
     {
-        m_move_data(x, eq_t());
+        m_move_data(x);
     }
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_move_data(rb_tree& x, std::true_type) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_move_data(rb_tree& x) NESTL_NOEXCEPT_SPEC
 {
     m_root() = x.m_root();
     m_leftmost() = x.m_leftmost();
@@ -1363,37 +1843,21 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_move_data(rb_tree& x, std::true
     x.m_impl.m_node_count = 0;
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_move_data(rb_tree& x, std::false_type) NESTL_NOEXCEPT_SPEC
-{
-    if (m_get_node_allocator() == x.m_get_node_allocator())
-    {
-        m_move_data(x, std::true_type());
-    }
-    else
-    {
-        m_root() = m_copy(x.m_begin(), m_end());
-        m_leftmost() = s_minimum(m_root());
-        m_rightmost() = s_maximum(m_root());
-        m_impl.m_node_count = x.m_impl.m_node_count;
-    }
-}
-
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 bool
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_move_assign(rb_tree& x) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_move_assign(rb_tree& x) NESTL_NOEXCEPT_SPEC
 {
+    typedef typename node_allocator_traits::propagate_on_container_move_assignment propagate;
+
     m_impl.m_key_compare = x.m_impl.m_key_compare;
 
-    if (node_allocator_traits::_S_propagate_on_move_assign()
-        || node_allocator_traits::_S_always_equal()
-        || m_get_node_allocator() == x.m_get_node_allocator())
+    if (propagate::value
+        || nestl::detail::allocators_equal(m_get_node_allocator(), x.m_get_node_allocator()))
     {
         clear();
         if (x.m_root() != 0)
         {
-            m_move_data(x, std::true_type());
+            m_move_data(x);
         }
         nestl::detail::alloc_on_move(m_get_node_allocator(), x.m_get_node_allocator());
         return true;
@@ -1401,11 +1865,35 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_move_assign(rb_tree& x) NESTL_N
     return false;
 }
 
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template <typename OperationError>
+void
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_move_elements(OperationError& err, rb_tree& x) NESTL_NOEXCEPT_SPEC
+{
+    rb_tree tmp(m_impl.m_key_compare, get_allocator());
+    for (iterator it = x.begin(); it != x.end(); ++it)
+    {
+        /// elements go in order, so each of them is inserted after the last one
+        tmp.m_emplace_hint_equal(err, tmp.end(), std::move(*it));
+        if (err)
+        {
+            return;
+        }
+    }
+
+    clear();
+    if (tmp.m_root() != 0)
+    {
+        m_move_data(tmp);
+    }
+    x.clear();
+}
+
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template <typename OperationError, typename Arg>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_(OperationError& err, base_ptr x, base_ptr p, Arg&& v) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_(OperationError& err, base_ptr x, base_ptr p, Arg&& v) NESTL_NOEXCEPT_SPEC
 {
     bool insert_left = (x != 0 || p == m_end()
                         || m_impl.m_key_compare(KeyOfValue()(v), s_key(p)));
@@ -1416,15 +1904,15 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_(OperationError& err, ba
         return end();
     }
 
-    rb_tree_insert_and_rebalance(insert_left, l, p, this->m_impl.m_header);
+    rb_tree_insert_and_rebalance<TreePolicy>(insert_left, l, p, this->m_impl.m_header);
     ++m_impl.m_node_count;
     return iterator(l);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template <typename OperationError, typename Arg>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_lower(OperationError& err, base_ptr p, Arg&& v) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_lower(OperationError& err, base_ptr p, Arg&& v) NESTL_NOEXCEPT_SPEC
 {
     bool insert_left = (p == m_end() || !m_impl.m_key_compare(s_key(p), KeyOfValue()(v)));
 
@@ -1434,16 +1922,16 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_lower(OperationError& er
         return end();
     }
 
-    rb_tree_insert_and_rebalance(insert_left, l, p, this->m_impl.m_header);
+    rb_tree_insert_and_rebalance<TreePolicy>(insert_left, l, p, this->m_impl.m_header);
     ++m_impl.m_node_count;
 
     return iterator(l);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template <typename OperationError, typename Arg>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_equal_lower(OperationError& err, Arg&& v) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_equal_lower(OperationError& err, Arg&& v) NESTL_NOEXCEPT_SPEC
 {
     link_type x = m_begin();
     link_type y = m_end();
@@ -1455,12 +1943,14 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_equal_lower(OperationErr
     return m_insert_lower(err, y, std::forward<Arg>(v));
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template <typename OperationError>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::link_type
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_copy(OperationError& err, const_link_type x, link_type p) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::link_type
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_copy(OperationError& err, const_link_type x, link_type p) NESTL_NOEXCEPT_SPEC
 {
     // Structural copy.  x and p must be non-null.
+    // Walk goes by parent pointers of both trees, so stack depth does not depend on tree height.
+    // Cloned nodes have no children, so null child of copy means that child is not copied yet.
     link_type top = m_clone_node(err, x);
     if (err)
     {
@@ -1468,90 +1958,487 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_copy(OperationError& err, const
     }
     top->m_parent = p;
 
-    class erase_guard
+    erase_guard guard(*this, top);
+
+    const_base_ptr src = x;
+    base_ptr dst = top;
+    for (;;)
     {
-        erase_guard(const erase_guard& ) = delete;
-        erase_guard& operator=(const erase_guard& ) = delete;
-    public:
+        if (src->m_left != 0 && dst->m_left == 0)
+        {
+            link_type y = m_clone_node(err, s_left(src));
+            if (err)
+            {
+                return nullptr;
+            }
+            dst->m_left = y;
+            y->m_parent = dst;
 
-        erase_guard(rb_tree& tree, link_type t)
-            : m_top(t)
-            , m_tree(tree)
+            src = src->m_left;
+            dst = y;
+        }
+        else if (src->m_right != 0 && dst->m_right == 0)
+        {
+            link_type y = m_clone_node(err, s_right(src));
+            if (err)
+            {
+                return nullptr;
+            }
+            dst->m_right = y;
+            y->m_parent = dst;
+
+            src = src->m_right;
+            dst = y;
+        }
+        else if (src == x)
+        {
+            break;
+        }
+        else
         {
+            src = src->m_parent;
+            dst = dst->m_parent;
         }
+    }
 
-        ~erase_guard()
+    guard.release();
+    return top;
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename OperationError, typename ForwardIterator>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::link_type
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_build_sorted(OperationError& err,
+                                                                          ForwardIterator& first,
+                                                                          ForwardIterator last,
+                                                                          size_type count,
+                                                                          size_type depth,
+                                                                          size_type redDepth) NESTL_NOEXCEPT_SPEC
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // sizes of subtrees differ at most by one, so all levels but the deepest one are full
+    const size_type leftCount = (count - 1) / 2;
+    link_type left = m_build_sorted(err, first, last, leftCount, depth + 1, redDepth);
+    if (err)
+    {
+        return nullptr;
+    }
+    erase_guard leftGuard(*this, left);
+
+    link_type top = m_create_node(err, *first);
+    if (err)
+    {
+        return nullptr;
+    }
+    leftGuard.release();
+
+    top->m_color = (depth == redDepth) ? rb_red : rb_black;
+    top->m_left = left;
+    top->m_right = 0;
+    if (left)
+    {
+        left->m_parent = top;
+    }
+    erase_guard guard(*this, top);
+
+    const ForwardIterator consumed = first;
+    ++first;
+    while (first != last && !m_impl.m_key_compare(KeyOfValue()(*consumed), KeyOfValue()(*first)))
+    {
+        ++first;
+    }
+
+    link_type right = m_build_sorted(err, first, last, count - 1 - leftCount, depth + 1, redDepth);
+    if (err)
+    {
+        return nullptr;
+    }
+
+    top->m_right = right;
+    if (right)
+    {
+        right->m_parent = top;
+    }
+    TreePolicy::update(static_cast<base_ptr>(top));
+
+    guard.release();
+    return top;
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename OperationError, typename ForwardIterator>
+void
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_assign_sorted_unique(OperationError& err,
+                                                                                  ForwardIterator first,
+                                                                                  ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    size_type count = 0;
+    if (first != last)
+    {
+        count = 1;
+        ForwardIterator prev = first;
+        for (ForwardIterator it = std::next(first); it != last; prev = it, ++it)
         {
-            if (m_top)
+            assert(!m_impl.m_key_compare(KeyOfValue()(*it), KeyOfValue()(*prev)) && "range is not sorted");
+            if (m_impl.m_key_compare(KeyOfValue()(*prev), KeyOfValue()(*it)))
             {
-                m_tree.m_erase(m_top);
+                ++count;
             }
         }
+    }
 
-        void release()
+    // levels 0 .. height - 1 are full, nodes below them are red
+    size_type height = 0;
+    while ((size_type(2) << height) - 1 <= count)
+    {
+        ++height;
+    }
+
+    link_type root = m_build_sorted(err, first, last, count, 0, height);
+    if (err)
+    {
+        return;
+    }
+
+    clear();
+    if (root)
+    {
+        m_root() = root;
+        root->m_parent = m_end();
+        m_leftmost() = s_minimum(root);
+        m_rightmost() = s_maximum(root);
+        m_impl.m_node_count = count;
+    }
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+void
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_erase(link_type x) NESTL_NOEXCEPT_SPEC
+{
+    // Erase without rebalancing and without recursion:
+    // left child is rotated up until node has no left child, then node is destroyed
+    // and its right subtree is processed the same way. Each rotation moves one node
+    // to the right spine for good, so walk is linear.
+    while (x != 0)
+    {
+        link_type y = s_left(x);
+        if (y != 0)
         {
-            m_top = 0;
+            x->m_left = y->m_right;
+            y->m_right = x;
+            x = y;
+        }
+        else
+        {
+            y = s_right(x);
+            m_destroy_node(x);
+            x = y;
         }
+    }
+}
 
-    private:
-        link_type m_top;
-        rb_tree& m_tree;
-    };
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+rb_tree_subtree
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_detach_nodes() NESTL_NOEXCEPT_SPEC
+{
+    rb_tree_subtree t = {m_root(), 0};
+    if (t.m_root)
+    {
+        t.m_root->m_parent = 0;
+        t.m_black_height = rb_tree_black_height(t.m_root);
 
-    erase_guard guard(*this, top);
+        m_root() = 0;
+        m_leftmost() = m_end();
+        m_rightmost() = m_end();
+        m_impl.m_node_count = 0;
+    }
+    return t;
+}
 
-    if (x->m_right)
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+void
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_attach_nodes(rb_tree_subtree t, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    assert(m_root() == 0);
+    if (t.m_root)
     {
-        top->m_right = m_copy(err, s_right(x), top);
-        if (err)
+        m_root() = t.m_root;
+        t.m_root->m_parent = m_end();
+        m_leftmost() = s_minimum(t.m_root);
+        m_rightmost() = s_maximum(t.m_root);
+        m_impl.m_node_count = count;
+    }
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::link_type
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_split(rb_tree_subtree t, const key_type& k,
+                                                                   rb_tree_subtree& left, rb_tree_subtree& right) NESTL_NOEXCEPT_SPEC
+{
+    if (t.m_root == 0)
+    {
+        left = t;
+        right = t;
+        return 0;
+    }
+
+    rb_tree_subtree l;
+    rb_tree_subtree r;
+    link_type x = static_cast<link_type>(rb_tree_expose(t, l, r));
+    if (m_impl.m_key_compare(k, s_key(x)))
+    {
+        link_type found = m_split(l, k, left, l);
+        right = rb_tree_join<TreePolicy>(l, x, r);
+        return found;
+    }
+    if (m_impl.m_key_compare(s_key(x), k))
+    {
+        link_type found = m_split(r, k, r, right);
+        left = rb_tree_join<TreePolicy>(l, x, r);
+        return found;
+    }
+
+    left = l;
+    right = r;
+    return x;
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+bool
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_link_unique(rb_tree_subtree& t, link_type z) NESTL_NOEXCEPT_SPEC
+{
+    base_ptr p = 0;
+    base_ptr x = t.m_root;
+    bool insertLeft = true;
+    while (x != 0)
+    {
+        p = x;
+        if (m_impl.m_key_compare(s_key(z), s_key(x)))
         {
-            return nullptr;
+            insertLeft = true;
+            x = x->m_left;
+        }
+        else if (m_impl.m_key_compare(s_key(x), s_key(z)))
+        {
+            insertLeft = false;
+            x = x->m_right;
+        }
+        else
+        {
+            return false;
         }
     }
-    p = top;
-    x = s_left(x);
 
-    while (x != 0)
+    z->m_parent = p;
+    z->m_left = 0;
+    z->m_right = 0;
+    if (p == 0)
     {
-        link_type y = m_clone_node(err, x);
-        if (err)
+        TreePolicy::on_insert(static_cast<base_ptr>(z), p);
+        z->m_color = rb_black;
+        t.m_root = z;
+        t.m_black_height = 1;
+        return true;
+    }
+
+    z->m_color = rb_red;
+    if (insertLeft)
+        p->m_left = z;
+    else
+        p->m_right = z;
+
+    TreePolicy::on_insert(static_cast<base_ptr>(z), t.m_root->m_parent);
+    rb_tree_rebalance_after_insert<TreePolicy>(z, t.m_root);
+    if (t.m_root->m_color == rb_red)
+    {
+        t.m_root->m_color = rb_black;
+        ++t.m_black_height;
+    }
+    return true;
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+rb_tree_subtree
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_unite(rb_tree_subtree t1, rb_tree_subtree t2,
+                                                                   rb_tree& other, size_type& duplicates) NESTL_NOEXCEPT_SPEC
+{
+    if (t1.m_root == 0)
+    {
+        return t2;
+    }
+    if (t2.m_root == 0)
+    {
+        return t1;
+    }
+    if (t2.m_root->m_left == 0 && t2.m_root->m_right == 0)
+    {
+        // plain insertion is cheaper than split of t1 for the last node
+        link_type z = static_cast<link_type>(t2.m_root);
+        if (!m_link_unique(t1, z))
         {
-            return nullptr;
+            other.m_destroy_node(z);
+            ++duplicates;
         }
-        p->m_left = y;
-        y->m_parent = p;
-        if (x->m_right)
+        return t1;
+    }
+
+    rb_tree_subtree l1;
+    rb_tree_subtree r1;
+    link_type x = static_cast<link_type>(rb_tree_expose(t1, l1, r1));
+
+    rb_tree_subtree l2;
+    rb_tree_subtree r2;
+    link_type found = m_split(t2, s_key(x), l2, r2);
+    if (found)
+    {
+        other.m_destroy_node(found);
+        ++duplicates;
+    }
+
+    rb_tree_subtree left = m_unite(l1, l2, other, duplicates);
+    rb_tree_subtree right = m_unite(r1, r2, other, duplicates);
+    return rb_tree_join<TreePolicy>(left, x, right);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+rb_tree_subtree
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_intersect(rb_tree_subtree t1, rb_tree_subtree t2,
+                                                                       rb_tree& other, size_type& common) NESTL_NOEXCEPT_SPEC
+{
+    if (t1.m_root == 0 || t2.m_root == 0)
+    {
+        m_erase(static_cast<link_type>(t1.m_root));
+        other.m_erase(static_cast<link_type>(t2.m_root));
+        rb_tree_subtree empty = {0, 0};
+        return empty;
+    }
+
+    rb_tree_subtree l1;
+    rb_tree_subtree r1;
+    link_type x = static_cast<link_type>(rb_tree_expose(t1, l1, r1));
+
+    rb_tree_subtree l2;
+    rb_tree_subtree r2;
+    link_type found = m_split(t2, s_key(x), l2, r2);
+
+    rb_tree_subtree left = m_intersect(l1, l2, other, common);
+    rb_tree_subtree right = m_intersect(r1, r2, other, common);
+    if (found)
+    {
+        other.m_destroy_node(found);
+        ++common;
+        return rb_tree_join<TreePolicy>(left, x, right);
+    }
+
+    m_destroy_node(x);
+    return rb_tree_join<TreePolicy>(left, right);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+rb_tree_subtree
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_subtract(rb_tree_subtree t1, rb_tree_subtree t2,
+                                                                      rb_tree& other, size_type& common) NESTL_NOEXCEPT_SPEC
+{
+    if (t1.m_root == 0 || t2.m_root == 0)
+    {
+        other.m_erase(static_cast<link_type>(t2.m_root));
+        return t1;
+    }
+
+    rb_tree_subtree l2;
+    rb_tree_subtree r2;
+    link_type x = static_cast<link_type>(rb_tree_expose(t2, l2, r2));
+
+    rb_tree_subtree l1;
+    rb_tree_subtree r1;
+    link_type found = m_split(t1, s_key(x), l1, r1);
+    other.m_destroy_node(x);
+    if (found)
+    {
+        m_destroy_node(found);
+        ++common;
+    }
+
+    rb_tree_subtree left = m_subtract(l1, l2, other, common);
+    rb_tree_subtree right = m_subtract(r1, r2, other, common);
+    return rb_tree_join<TreePolicy>(left, right);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename OperationError>
+void
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_unite_unique(OperationError& err, rb_tree& other) NESTL_NOEXCEPT_SPEC
+{
+    if (&other == this || other.m_root() == 0)
+    {
+        return;
+    }
+
+    if (!nestl::detail::allocators_equal(m_get_node_allocator(), other.m_get_node_allocator()))
+    {
+        iterator it = other.begin();
+        while (it != other.end())
         {
-            y->m_right = m_copy(err, s_right(x), y);
+            m_insert_unique(err, std::move(*it));
             if (err)
             {
-                return nullptr;
+                return;
             }
+            it = other.erase(it);
         }
-        p = y;
-        x = s_left(x);
+        return;
     }
-    guard.release();
-    return top;
+
+    const size_type count = size() + other.size();
+    size_type duplicates = 0;
+    rb_tree_subtree t1 = m_detach_nodes();
+    rb_tree_subtree t2 = other.m_detach_nodes();
+    rb_tree_subtree result = m_unite(t1, t2, other, duplicates);
+    m_attach_nodes(result, count - duplicates);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_erase(link_type x) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_intersect_unique(rb_tree& other) NESTL_NOEXCEPT_SPEC
 {
-    // Erase without rebalancing.
-    while (x != 0)
+    if (&other == this)
     {
-        m_erase(s_right(x));
-        link_type y = s_left(x);
-        m_destroy_node(x);
-        x = y;
+        return;
+    }
+
+    size_type common = 0;
+    rb_tree_subtree t1 = m_detach_nodes();
+    rb_tree_subtree t2 = other.m_detach_nodes();
+    rb_tree_subtree result = m_intersect(t1, t2, other, common);
+    m_attach_nodes(result, common);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+void
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_subtract_unique(rb_tree& other) NESTL_NOEXCEPT_SPEC
+{
+    if (&other == this)
+    {
+        clear();
+        return;
     }
+
+    const size_type count = size();
+    size_type common = 0;
+    rb_tree_subtree t1 = m_detach_nodes();
+    rb_tree_subtree t2 = other.m_detach_nodes();
+    rb_tree_subtree result = m_subtract(t1, t2, other, common);
+    m_attach_nodes(result, count - common);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_lower_bound(link_type x, link_type y, const Key& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_lower_bound(link_type x, link_type y, const K& k) NESTL_NOEXCEPT_SPEC
 {
     while (x != 0)
     {
@@ -1567,9 +2454,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_lower_bound(link_type x, link_t
     return iterator(y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::const_iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_lower_bound(const_link_type x, const_link_type y, const Key& k) const NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_lower_bound(const_link_type x, const_link_type y, const K& k) const NESTL_NOEXCEPT_SPEC
 {
     while (x != 0)
     {
@@ -1585,9 +2473,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_lower_bound(const_link_type x,
     return const_iterator(y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_upper_bound(link_type x, link_type y, const Key& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_upper_bound(link_type x, link_type y, const K& k) NESTL_NOEXCEPT_SPEC
 {
     while (x != 0)
     {
@@ -1603,9 +2492,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_upper_bound(link_type x, link_t
     return iterator(y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::const_iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_upper_bound(const_link_type x, const_link_type y, const Key& k) const NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_upper_bound(const_link_type x, const_link_type y, const K& k) const NESTL_NOEXCEPT_SPEC
 {
     while (x != 0)
     {
@@ -1621,10 +2511,19 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_upper_bound(const_link_type x,
     return const_iterator(y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator,
-          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator>
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::equal_range(const Key& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::equal_range(const Key& k) NESTL_NOEXCEPT_SPEC
+{
+    return m_equal_range(k);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_equal_range(const K& k) NESTL_NOEXCEPT_SPEC
 {
     link_type x = m_begin();
     link_type y = m_end();
@@ -1649,10 +2548,19 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::equal_range(const Key& k) NESTL_N
     return std::pair<iterator, iterator>(iterator(y), iterator(y));
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::const_iterator,
-          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::const_iterator>
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::equal_range(const Key& k) const NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::equal_range(const Key& k) const NESTL_NOEXCEPT_SPEC
+{
+    return m_equal_range(k);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_equal_range(const K& k) const NESTL_NOEXCEPT_SPEC
 {
     const_link_type x = m_begin();
     const_link_type y = m_end();
@@ -1677,9 +2585,9 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::equal_range(const Key& k) const N
     return std::pair<const_iterator, const_iterator>(const_iterator(y), const_iterator(y));
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::swap(rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& t) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::swap(rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>& t) NESTL_NOEXCEPT_SPEC
 {
     if (m_root() == 0)
     {
@@ -1719,14 +2627,13 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::swap(rb_tree<Key, Val, KeyOfValue
     std::swap(this->m_impl.m_node_count, t.m_impl.m_node_count);
     std::swap(this->m_impl.m_key_compare, t.m_impl.m_key_compare);
 
-    node_allocator_traits::_S_on_swap(m_get_node_allocator(),
-              t.m_get_node_allocator());
-  }
+    nestl::detail::alloc_on_swap(m_get_node_allocator(), t.m_get_node_allocator());
+}
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr,
-          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr>
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_unique_pos(const key_type& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_get_insert_unique_pos(const key_type& k) NESTL_NOEXCEPT_SPEC
 {
     typedef std::pair<base_ptr, base_ptr> result_type;
     link_type x = m_begin();
@@ -1757,10 +2664,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_unique_pos(const key
     return result_type(j.m_node, 0);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr,
-          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr>
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_equal_pos(const key_type& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_get_insert_equal_pos(const key_type& k) NESTL_NOEXCEPT_SPEC
 {
     typedef std::pair<base_ptr, base_ptr> result_type;
     link_type x = m_begin();
@@ -1773,10 +2680,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_equal_pos(const key_
     return result_type(x, y);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template <typename OperationError, typename Arg>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator_with_flag
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_unique(OperationError& err, Arg&& v) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator_with_flag
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_unique(OperationError& err, Arg&& v) NESTL_NOEXCEPT_SPEC
 {
     std::pair<base_ptr, base_ptr> res = m_get_insert_unique_pos(KeyOfValue()(v));
 
@@ -1790,19 +2697,19 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_unique(OperationError& e
     return {iterator(static_cast<link_type>(res.first)), false};
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-template <typename Arg>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_equal(Arg&& v) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template <typename OperationError, typename Arg>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_equal(OperationError& err, Arg&& v) NESTL_NOEXCEPT_SPEC
 {
     std::pair<base_ptr, base_ptr> res = m_get_insert_equal_pos(KeyOfValue()(v));
-    return m_insert_(res.first, res.second, std::forward<Arg>(v));
+    return m_insert_(err, res.first, res.second, std::forward<Arg>(v));
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr,
-          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr>
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_hint_unique_pos(const_iterator position, const key_type& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_get_insert_hint_unique_pos(const_iterator position, const key_type& k) NESTL_NOEXCEPT_SPEC
 {
     iterator pos = position.m_const_cast();
     typedef std::pair<base_ptr, base_ptr> result_type;
@@ -1874,10 +2781,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_hint_unique_pos(cons
     }
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template <typename OperationError, typename Arg>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_unique_at(OperationError& err, const_iterator position, Arg&& v) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_unique_at(OperationError& err, const_iterator position, Arg&& v) NESTL_NOEXCEPT_SPEC
 {
     std::pair<base_ptr, base_ptr> res = m_get_insert_hint_unique_pos(position, KeyOfValue()(v));
 
@@ -1888,10 +2795,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_unique_at(OperationError
     return iterator(static_cast<link_type>(res.first));
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr,
-          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::base_ptr>
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_hint_equal_pos(const_iterator position, const key_type& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+std::pair<typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr,
+          typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::base_ptr>
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_get_insert_hint_equal_pos(const_iterator position, const key_type& k) NESTL_NOEXCEPT_SPEC
 {
     iterator pos = position.m_const_cast();
     typedef std::pair<base_ptr, base_ptr> result_type;
@@ -1958,46 +2865,46 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_get_insert_hint_equal_pos(const
     }
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-template <typename Arg>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_equal_at(const_iterator position, Arg&& v) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template <typename OperationError, typename Arg>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_equal_at(OperationError& err, const_iterator position, Arg&& v) NESTL_NOEXCEPT_SPEC
 {
     std::pair<base_ptr, base_ptr> res = m_get_insert_hint_equal_pos(position, KeyOfValue()(v));
     if (res.second)
     {
-        return m_insert_(res.first, res.second, std::forward<Arg>(v));
+        return m_insert_(err, res.first, res.second, std::forward<Arg>(v));
     }
 
-    return m_insert_equal_lower(std::forward<Arg>(v));
+    return m_insert_equal_lower(err, std::forward<Arg>(v));
 }
 
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_node(base_ptr x, base_ptr p, link_type z) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_node(base_ptr x, base_ptr p, link_type z) NESTL_NOEXCEPT_SPEC
 {
     bool insert_left = (x != 0 || p == m_end() || m_impl.m_key_compare(s_key(z), s_key(p)));
 
-    rb_tree_insert_and_rebalance(insert_left, z, p, this->m_impl.m_header);
+    rb_tree_insert_and_rebalance<TreePolicy>(insert_left, z, p, this->m_impl.m_header);
     ++m_impl.m_node_count;
     return iterator(z);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_lower_node(base_ptr p, link_type z) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_lower_node(base_ptr p, link_type z) NESTL_NOEXCEPT_SPEC
 {
     bool insert_left = (p == m_end() || !m_impl.m_key_compare(s_key(p), s_key(z)));
 
-    rb_tree_insert_and_rebalance(insert_left, z, p, this->m_impl.m_header);
+    rb_tree_insert_and_rebalance<TreePolicy>(insert_left, z, p, this->m_impl.m_header);
     ++m_impl.m_node_count;
     return iterator(z);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_equal_lower_node(link_type z) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_equal_lower_node(link_type z) NESTL_NOEXCEPT_SPEC
 {
     link_type x = m_begin();
     link_type y = m_end();
@@ -2009,10 +2916,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_equal_lower_node(link_ty
     return m_insert_lower_node(y, z);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template<typename OperationError, typename... Args>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator_with_flag
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_unique(OperationError& err, Args&&... args) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator_with_flag
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_emplace_unique(OperationError& err, Args&&... args) NESTL_NOEXCEPT_SPEC
 {
     link_type z = m_create_node(err, std::forward<Args>(args)...);
     if (err)
@@ -2031,10 +2938,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_unique(OperationError&
     return iterator_with_flag(iterator(static_cast<link_type>(res.first)), false);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template<typename OperationError, typename... Args>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_equal(OperationError& err, Args&&... args) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_emplace_equal(OperationError& err, Args&&... args) NESTL_NOEXCEPT_SPEC
 {
     link_type z = m_create_node(err, std::forward<Args>(args)...);
     if (err)
@@ -2055,10 +2962,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_equal(OperationError& e
 #endif //0
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template<typename OperationError, typename... Args>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_hint_unique(OperationError& err, const_iterator pos, Args&&... args) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_emplace_hint_unique(OperationError& err, const_iterator pos, Args&&... args) NESTL_NOEXCEPT_SPEC
 {
     link_type z = m_create_node(err, std::forward<Args>(args)...);
     if (err)
@@ -2085,10 +2992,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_hint_unique(OperationEr
 #endif //0
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template<typename OperationError, typename... Args>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_hint_equal(OperationError& err, const_iterator pos, Args&&... args) NESTL_NOEXCEPT_SPEC
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_emplace_hint_equal(OperationError& err, const_iterator pos, Args&&... args) NESTL_NOEXCEPT_SPEC
 {
     link_type z = m_create_node(err, std::forward<Args>(args)...);
     if (err)
@@ -2113,10 +3020,10 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_emplace_hint_equal(OperationErr
 #endif //0
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 template<typename OperationError, class InputIterator>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_unique(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_unique(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
 {
     for (; first != last; ++first)
     {
@@ -2128,31 +3035,77 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_unique(OperationError& e
     }
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-template<class InputIterator>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename OperationError, class InputIterator>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_insert_equal(InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_equal(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
 {
     for (; first != last; ++first)
     {
-        m_insert_equal_at(end(), *first);
+        m_insert_equal_at(err, end(), *first);
+        if (err)
+        {
+            return;
+        }
+    }
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename OperationError, typename K, typename... Args>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator_with_flag
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_try_emplace_unique(OperationError& err, K&& key, Args&&... args) NESTL_NOEXCEPT_SPEC
+{
+    std::pair<base_ptr, base_ptr> res = m_get_insert_unique_pos(key);
+    if (!res.second)
+    {
+        return iterator_with_flag(iterator(static_cast<link_type>(res.first)), false);
+    }
+
+    link_type z = m_create_node_for_key(err, std::forward<K>(key), std::forward<Args>(args)...);
+    if (err)
+    {
+        return iterator_with_flag(end(), false);
     }
+
+    return iterator_with_flag(m_insert_node(res.first, res.second, z), true);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename OperationError, typename K, typename M>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator_with_flag
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_insert_or_assign_unique(OperationError& err, K&& key, M&& obj) NESTL_NOEXCEPT_SPEC
+{
+    std::pair<base_ptr, base_ptr> res = m_get_insert_unique_pos(key);
+    if (!res.second)
+    {
+        iterator pos(static_cast<link_type>(res.first));
+        nestl::class_operations::assign(err, pos->second, std::forward<M>(obj));
+        return iterator_with_flag(pos, false);
+    }
+
+    link_type z = m_create_node_for_key(err, std::forward<K>(key), std::forward<M>(obj));
+    if (err)
+    {
+        return iterator_with_flag(end(), false);
+    }
+
+    return iterator_with_flag(m_insert_node(res.first, res.second, z), true);
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_erase_aux(const_iterator position) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_erase_aux(const_iterator position) NESTL_NOEXCEPT_SPEC
 {
-    link_type y = static_cast<link_type>(rb_tree_rebalance_for_erase(
+    link_type y = static_cast<link_type>(rb_tree_rebalance_for_erase<TreePolicy>(
                                              const_cast<base_ptr>(position.m_node),
                                              this->m_impl.m_header));
     m_destroy_node(y);
     --m_impl.m_node_count;
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_erase_aux(const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_erase_aux(const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
 {
     if (first == begin() && last == end())
     {
@@ -2167,9 +3120,9 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::m_erase_aux(const_iterator first,
     }
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::size_type
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::erase(const Key& x) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::size_type
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::erase(const Key& x) NESTL_NOEXCEPT_SPEC
 {
     std::pair<iterator, iterator> p = equal_range(x);
     const size_type old_size = size();
@@ -2177,9 +3130,9 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::erase(const Key& x) NESTL_NOEXCEP
     return old_size - size();
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 void
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::erase(const Key* first, const Key* last) NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::erase(const Key* first, const Key* last) NESTL_NOEXCEPT_SPEC
 {
     while (first != last)
     {
@@ -2187,37 +3140,166 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::erase(const Key* first, const Key
     }
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::find(const Key& k) NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::find(const Key& k) NESTL_NOEXCEPT_SPEC
+{
+    return m_find(k);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_find(const K& k) NESTL_NOEXCEPT_SPEC
 {
     iterator j = m_lower_bound(m_begin(), m_end(), k);
     return (j == end() || m_impl.m_key_compare(k, s_key(j.m_node))) ? end() : j;
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::const_iterator
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::find(const Key& k) const NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::find(const Key& k) const NESTL_NOEXCEPT_SPEC
+{
+    return m_find(k);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_find(const K& k) const NESTL_NOEXCEPT_SPEC
 {
     const_iterator j = m_lower_bound(m_begin(), m_end(), k);
     return (j == end() || m_impl.m_key_compare(k, s_key(j.m_node))) ? end() : j;
 }
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::size_type
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::count(const Key& k) const NESTL_NOEXCEPT_SPEC
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K, typename KeyLess>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_link_type
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_lower_bound_with(const_link_type x,
+                                                                              const_link_type y,
+                                                                              const K& k,
+                                                                              const KeyLess& less) const NESTL_NOEXCEPT_SPEC
+{
+    while (x != 0)
+    {
+        if (!less(s_key(x), k))
+        {
+            y = x, x = s_left(x);
+        }
+        else
+        {
+            x = s_right(x);
+        }
+    }
+    return y;
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K, typename KeyLess>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::find_with(const K& k, const KeyLess& less) NESTL_NOEXCEPT_SPEC
+{
+    const_link_type j = m_lower_bound_with(m_begin(), m_end(), k, less);
+    return (j == m_end() || less(k, s_key(j))) ? end() : iterator(const_cast<link_type>(j));
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K, typename KeyLess>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::find_with(const K& k, const KeyLess& less) const NESTL_NOEXCEPT_SPEC
+{
+    const_link_type j = m_lower_bound_with(m_begin(), m_end(), k, less);
+    return (j == m_end() || less(k, s_key(j))) ? end() : const_iterator(j);
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::size_type
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::count(const Key& k) const NESTL_NOEXCEPT_SPEC
 {
     std::pair<const_iterator, const_iterator> p = equal_range(k);
     const size_type n = std::distance(p.first, p.second);
     return n;
 }
 
-unsigned int
-rb_tree_black_count(const rb_tree_node_base* node, const rb_tree_node_base* root) NESTL_NOEXCEPT_SPEC;
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::const_iterator
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_nth(size_type n) const NESTL_NOEXCEPT_SPEC
+{
+    static_assert(TreePolicy::keeps_subtree_size, "tree policy should keep subtree sizes (order_statistic_tree_policy)");
+
+    const_base_ptr x = m_root();
+    while (x != 0)
+    {
+        const size_type leftSize = TreePolicy::size(x->m_left);
+        if (n < leftSize)
+        {
+            x = x->m_left;
+        }
+        else if (n == leftSize)
+        {
+            return const_iterator(static_cast<const_link_type>(x));
+        }
+        else
+        {
+            n -= leftSize + 1;
+            x = x->m_right;
+        }
+    }
+    return end();
+}
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
+template<typename K>
+typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::size_type
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::m_rank(const K& k) const NESTL_NOEXCEPT_SPEC
+{
+    static_assert(TreePolicy::keeps_subtree_size, "tree policy should keep subtree sizes (order_statistic_tree_policy)");
+
+    size_type rank = 0;
+    const_base_ptr x = m_root();
+    while (x != 0)
+    {
+        if (m_impl.m_key_compare(s_key(x), k))
+        {
+            rank += TreePolicy::size(x->m_left) + 1;
+            x = x->m_right;
+        }
+        else
+        {
+            x = x->m_left;
+        }
+    }
+    return rank;
+}
+
+/// @brief Number of black nodes on path from node up to root
+inline unsigned int
+rb_tree_black_count(const rb_tree_node_base* node, const rb_tree_node_base* root) NESTL_NOEXCEPT_SPEC
+{
+    if (node == 0)
+    {
+        return 0;
+    }
+
+    unsigned int sum = 0;
+    for (;;)
+    {
+        if (node->m_color == rb_black)
+        {
+            ++sum;
+        }
+        if (node == root)
+        {
+            break;
+        }
+        node = node->m_parent;
+    }
+    return sum;
+}
 
-template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename TreePolicy>
 bool
-rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::__rb_verify() const NESTL_NOEXCEPT_SPEC
+rb_tree<Key, Val, KeyOfValue, Compare, Alloc, TreePolicy>::__rb_verify() const NESTL_NOEXCEPT_SPEC
 {
     if (m_impl.m_node_count == 0 || begin() == end())
     {
@@ -2254,6 +3336,11 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::__rb_verify() const NESTL_NOEXCEP
         {
             return false;
         }
+
+        if (!m_verify_node_data(x))
+        {
+            return false;
+        }
     }
 
     if (m_leftmost() != rb_tree_node_base::s_minimum(m_root()))
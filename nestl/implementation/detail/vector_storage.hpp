@@ -0,0 +1,88 @@
+/**
+ * @file Storage policies for nestl::impl::vector
+ *
+ * Storage policy is a base class of vector, which may provide inline buffer for elements.
+ * Each policy provides following members:
+ * @code
+ * /// number of elements which fit into inline buffer (zero if there is no inline buffer)
+ * static const std::size_t inline_capacity;
+ *
+ * /// whether vector may use allocator when inline buffer is exhausted
+ * static const bool may_allocate;
+ *
+ * /// pointer to the first element of inline buffer (null pointer if there is no inline buffer)
+ * T* inline_data() NESTL_NOEXCEPT_SPEC;
+ * @endcode
+ */
+
+#ifndef NESTL_IMPLEMENTATION_DETAIL_VECTOR_STORAGE_HPP
+#define NESTL_IMPLEMENTATION_DETAIL_VECTOR_STORAGE_HPP
+
+#include <nestl/config.hpp>
+#include <nestl/alignment.hpp>
+
+#include <cstddef>
+
+namespace nestl
+{
+namespace impl
+{
+namespace detail
+{
+
+/**
+ * @brief All elements are allocated by allocator
+ */
+template <typename T>
+struct vector_heap_storage
+{
+    static const std::size_t inline_capacity = 0;
+    static const bool may_allocate = true;
+
+    T* inline_data() NESTL_NOEXCEPT_SPEC
+    {
+        return 0;
+    }
+};
+
+/**
+ * @brief First N elements are stored inside of vector object
+ *
+ * @tparam MayAllocate whether vector spills to allocator when more than N elements are required
+ */
+template <typename T, std::size_t N, bool MayAllocate>
+struct vector_inline_storage
+{
+    static_assert(N > 0, "inline storage should hold at least one element");
+
+    static const std::size_t inline_capacity = N;
+    static const bool may_allocate = MayAllocate;
+
+    vector_inline_storage() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    /// @note inline buffer never copied, vector relocates elements explicitly
+    vector_inline_storage(const vector_inline_storage& /* other */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    vector_inline_storage& operator=(const vector_inline_storage& /* other */) NESTL_NOEXCEPT_SPEC
+    {
+        return *this;
+    }
+
+    T* inline_data() NESTL_NOEXCEPT_SPEC
+    {
+        return m_buffer[0].ptr();
+    }
+
+private:
+    nestl::aligned_buffer<T> m_buffer[N];
+};
+
+} // namespace detail
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_DETAIL_VECTOR_STORAGE_HPP */
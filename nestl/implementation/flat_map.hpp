@@ -0,0 +1,656 @@
+#ifndef NESTL_IMPLEMENTATION_FLAT_MAP_HPP
+#define NESTL_IMPLEMENTATION_FLAT_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/detail/flat_tree.hpp>
+#include <nestl/implementation/detail/key_of_value.hpp>
+
+#include <utility>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Map with unique keys stored as sorted vector of pairs
+ *
+ * Compared to node based map it has no per-element nodes and lookup is binary search over contiguous storage,
+ * which suits read-mostly lookup tables. Insertion and erasure shift elements, so they are linear.
+ *
+ * @note Keys are stored as non-const members of pairs, so elements can be moved inside of storage.
+ * Key must not be modified through iterator, since that would break the order.
+ *
+ * @note Insertion and erasure invalidate iterators, as in vector
+ */
+template<typename Key,
+         typename T,
+         typename Compare = std::less<Key>,
+         typename Alloc = nestl::allocator<std::pair<Key, T> > >
+class flat_map
+{
+    flat_map(const flat_map& ) = delete;
+    flat_map& operator=(const flat_map& ) = delete;
+public:
+
+    typedef Alloc                                                                   allocator_type;
+    typedef T                                                                       mapped_type;
+
+    typedef detail::select1st<std::pair<Key, T> >                                   key_of_value;
+    typedef detail::flat_tree<Key, std::pair<Key, T>, key_of_value, Compare, allocator_type> impl_type;
+
+    typedef typename impl_type::key_type                                            key_type;
+    typedef typename impl_type::value_type                                          value_type;
+    typedef typename impl_type::key_compare                                         key_compare;
+    typedef typename impl_type::value_compare                                       value_compare;
+
+    typedef typename impl_type::size_type                                           size_type;
+    typedef typename impl_type::difference_type                                     difference_type;
+
+    typedef typename impl_type::reference                                           reference;
+    typedef typename impl_type::const_reference                                     const_reference;
+
+    typedef typename impl_type::pointer                                             pointer;
+    typedef typename impl_type::const_pointer                                       const_pointer;
+
+    typedef typename impl_type::iterator                                            iterator;
+    typedef typename impl_type::const_iterator                                      const_iterator;
+    typedef typename impl_type::reverse_iterator                                    reverse_iterator;
+    typedef typename impl_type::const_reverse_iterator                              const_reverse_iterator;
+
+    typedef std::pair<iterator, bool>                                               iterator_with_flag;
+
+// constructors
+    explicit flat_map(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) NESTL_NOEXCEPT_SPEC;
+    explicit flat_map(const Alloc& alloc) NESTL_NOEXCEPT_SPEC;
+
+    flat_map(flat_map&& other) NESTL_NOEXCEPT_SPEC;
+
+// allocator support
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
+
+// observers
+    key_compare key_comp() const NESTL_NOEXCEPT_SPEC;
+
+    value_compare value_comp() const NESTL_NOEXCEPT_SPEC;
+
+// assignment operators and functions
+    flat_map& operator=(flat_map&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, flat_map&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const flat_map& other) NESTL_NOEXCEPT_SPEC;
+
+
+// iterators
+    iterator begin() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC;
+
+    iterator end() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rbegin() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crbegin() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rend() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rend() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crend() const NESTL_NOEXCEPT_SPEC;
+
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC;
+
+    size_type size() const NESTL_NOEXCEPT_SPEC;
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC;
+
+    size_type capacity() const NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC;
+
+
+// modifiers
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts all elements of range, whose keys are not present yet
+     *
+     * Range is sorted and merged with present elements once, this is much faster than
+     * inserting elements one by one. In case of error map is left unchanged.
+     */
+    template <typename OperationError, typename InputIterator>
+    void insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts value constructed from args if key is not present, otherwise args are left untouched
+     */
+    template <typename OperationError, typename ... Args>
+    iterator_with_flag try_emplace_nothrow(OperationError& err, const key_type& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator_with_flag try_emplace_nothrow(OperationError& err, key_type&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @note Elements after erased ones are shifted, for types which are not nothrow relocatable
+     * that is done by copying which may fail
+     */
+    template <typename OperationError>
+    iterator erase_nothrow(OperationError& err, const_iterator pos) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator erase_nothrow(OperationError& err, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    size_type erase_nothrow(OperationError& err, const key_type& key) NESTL_NOEXCEPT_SPEC;
+
+    void swap(flat_map& other) NESTL_NOEXCEPT_SPEC;
+
+
+// lookup
+
+    iterator find(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator find(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    size_type count(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator lower_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator lower_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator upper_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator upper_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    std::pair<iterator, iterator> equal_range(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup by any type which Compare compares with keys
+     *
+     * Available if Compare is transparent (nestl::less<> for example), key is never built from argument.
+     */
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    find(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    find(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, size_type>::type
+    count(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    lower_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    upper_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<iterator, iterator> >::type
+    equal_range(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+private:
+    impl_type m_impl;
+};
+
+
+// implementation
+
+template <typename K, typename T, typename C, typename A>
+flat_map<K, T, C, A>::flat_map(const C& comp, const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(comp, alloc)
+{
+}
+
+template <typename K, typename T, typename C, typename A>
+flat_map<K, T, C, A>::flat_map(const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(alloc)
+{
+}
+
+template <typename K, typename T, typename C, typename A>
+flat_map<K, T, C, A>::flat_map(flat_map&& other) NESTL_NOEXCEPT_SPEC
+    : m_impl(std::move(other.m_impl))
+{
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::allocator_type
+flat_map<K, T, C, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.get_allocator();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::key_compare
+flat_map<K, T, C, A>::key_comp() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.key_comp();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::value_compare
+flat_map<K, T, C, A>::value_comp() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.value_comp();
+}
+
+template <typename K, typename T, typename C, typename A>
+flat_map<K, T, C, A>&
+flat_map<K, T, C, A>::operator=(flat_map&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl = std::move(other.m_impl);
+    return *this;
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_map<K, T, C, A>::move_assign_nothrow(OperationError& err, flat_map&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.move_assign_nothrow(err, std::move(other.m_impl));
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_map<K, T, C, A>::copy_nothrow(OperationError& err, const flat_map& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.copy_nothrow(err, other.m_impl);
+}
+
+
+// iterators
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::iterator
+flat_map<K, T, C, A>::begin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_iterator
+flat_map<K, T, C, A>::begin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_iterator
+flat_map<K, T, C, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::iterator
+flat_map<K, T, C, A>::end() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_iterator
+flat_map<K, T, C, A>::end() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_iterator
+flat_map<K, T, C, A>::cend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::reverse_iterator
+flat_map<K, T, C, A>::rbegin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_reverse_iterator
+flat_map<K, T, C, A>::rbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_reverse_iterator
+flat_map<K, T, C, A>::crbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::reverse_iterator
+flat_map<K, T, C, A>::rend() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_reverse_iterator
+flat_map<K, T, C, A>::rend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_reverse_iterator
+flat_map<K, T, C, A>::crend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+
+// capacity
+template <typename K, typename T, typename C, typename A>
+bool
+flat_map<K, T, C, A>::empty() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.empty();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::size_type
+flat_map<K, T, C, A>::size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.size();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::size_type
+flat_map<K, T, C, A>::max_size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.max_size();
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_map<K, T, C, A>::reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.reserve_nothrow(err, new_cap);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::size_type
+flat_map<K, T, C, A>::capacity() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.capacity();
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_map<K, T, C, A>::shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.shrink_to_fit_nothrow(err);
+}
+
+
+// modifiers
+template <typename K, typename T, typename C, typename A>
+void
+flat_map<K, T, C, A>::clear() NESTL_NOEXCEPT_SPEC
+{
+    m_impl.clear();
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_map<K, T, C, A>::iterator_with_flag
+flat_map<K, T, C, A>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, val);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_map<K, T, C, A>::iterator_with_flag
+flat_map<K, T, C, A>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, std::move(val));
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename InputIterator>
+void
+flat_map<K, T, C, A>::insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_insert_range_unique(err, first, last);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename ... Args>
+typename flat_map<K, T, C, A>::iterator_with_flag
+flat_map<K, T, C, A>::try_emplace_nothrow(OperationError& err, const key_type& key, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_try_emplace_unique(err, key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename ... Args>
+typename flat_map<K, T, C, A>::iterator_with_flag
+flat_map<K, T, C, A>::try_emplace_nothrow(OperationError& err, key_type&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_try_emplace_unique(err, std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_map<K, T, C, A>::iterator
+flat_map<K, T, C, A>::erase_nothrow(OperationError& err, const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase_nothrow(err, pos);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_map<K, T, C, A>::iterator
+flat_map<K, T, C, A>::erase_nothrow(OperationError& err, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase_nothrow(err, first, last);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_map<K, T, C, A>::size_type
+flat_map<K, T, C, A>::erase_nothrow(OperationError& err, const key_type& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase_nothrow(err, key);
+}
+
+template <typename K, typename T, typename C, typename A>
+void
+flat_map<K, T, C, A>::swap(flat_map& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.swap(other.m_impl);
+}
+
+
+// lookup
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::iterator
+flat_map<K, T, C, A>::find(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_iterator
+flat_map<K, T, C, A>::find(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::size_type
+flat_map<K, T, C, A>::count(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::iterator
+flat_map<K, T, C, A>::lower_bound(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_iterator
+flat_map<K, T, C, A>::lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::iterator
+flat_map<K, T, C, A>::upper_bound(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename flat_map<K, T, C, A>::const_iterator
+flat_map<K, T, C, A>::upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+std::pair<typename flat_map<K, T, C, A>::iterator, typename flat_map<K, T, C, A>::iterator>
+flat_map<K, T, C, A>::equal_range(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+std::pair<typename flat_map<K, T, C, A>::const_iterator, typename flat_map<K, T, C, A>::const_iterator>
+flat_map<K, T, C, A>::equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename flat_map<K, T, C, A>::iterator>::type
+flat_map<K, T, C, A>::find(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename flat_map<K, T, C, A>::const_iterator>::type
+flat_map<K, T, C, A>::find(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename flat_map<K, T, C, A>::size_type>::type
+flat_map<K, T, C, A>::count(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename flat_map<K, T, C, A>::iterator>::type
+flat_map<K, T, C, A>::lower_bound(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename flat_map<K, T, C, A>::const_iterator>::type
+flat_map<K, T, C, A>::lower_bound(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename flat_map<K, T, C, A>::iterator>::type
+flat_map<K, T, C, A>::upper_bound(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename flat_map<K, T, C, A>::const_iterator>::type
+flat_map<K, T, C, A>::upper_bound(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, std::pair<typename flat_map<K, T, C, A>::iterator, typename flat_map<K, T, C, A>::iterator>>::type
+flat_map<K, T, C, A>::equal_range(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, std::pair<typename flat_map<K, T, C, A>::const_iterator, typename flat_map<K, T, C, A>::const_iterator>>::type
+flat_map<K, T, C, A>::equal_range(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_FLAT_MAP_HPP */
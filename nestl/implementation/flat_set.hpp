@@ -0,0 +1,503 @@
+#ifndef NESTL_IMPLEMENTATION_FLAT_SET_HPP
+#define NESTL_IMPLEMENTATION_FLAT_SET_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/detail/flat_tree.hpp>
+#include <nestl/implementation/detail/key_of_value.hpp>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Set of unique keys stored in sorted vector
+ *
+ * Compared to nestl::set it has no per-element nodes and lookup is binary search over contiguous storage,
+ * which suits read-mostly lookup tables. Insertion and erasure shift elements, so they are linear.
+ * Elements can not be modified through iterators, since that would break the order.
+ *
+ * @note Insertion and erasure invalidate iterators, as in vector
+ */
+template<typename Key, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<Key> >
+class flat_set
+{
+    flat_set(const flat_set& ) = delete;
+    flat_set& operator=(const flat_set& ) = delete;
+public:
+
+    typedef Alloc                                                                   allocator_type;
+
+    typedef detail::identity<Key>                                                   key_of_value;
+    typedef detail::flat_tree<Key, Key, key_of_value, Compare, allocator_type>      impl_type;
+
+    typedef typename impl_type::key_type                                            key_type;
+    typedef typename impl_type::value_type                                          value_type;
+    typedef typename impl_type::key_compare                                         key_compare;
+    typedef typename impl_type::value_compare                                       value_compare;
+
+    typedef typename impl_type::size_type                                           size_type;
+    typedef typename impl_type::difference_type                                     difference_type;
+
+    typedef typename impl_type::const_reference                                     reference;
+    typedef typename impl_type::const_reference                                     const_reference;
+
+    typedef typename impl_type::const_pointer                                       pointer;
+    typedef typename impl_type::const_pointer                                       const_pointer;
+
+    typedef typename impl_type::const_iterator                                      iterator;
+    typedef typename impl_type::const_iterator                                      const_iterator;
+    typedef typename impl_type::const_reverse_iterator                              reverse_iterator;
+    typedef typename impl_type::const_reverse_iterator                              const_reverse_iterator;
+
+    typedef std::pair<iterator, bool>                                               iterator_with_flag;
+
+// constructors
+    explicit flat_set(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) NESTL_NOEXCEPT_SPEC;
+    explicit flat_set(const Alloc& alloc) NESTL_NOEXCEPT_SPEC;
+
+    flat_set(flat_set&& other) NESTL_NOEXCEPT_SPEC;
+
+// allocator support
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
+
+// observers
+    key_compare key_comp() const NESTL_NOEXCEPT_SPEC;
+
+    value_compare value_comp() const NESTL_NOEXCEPT_SPEC;
+
+// assignment operators and functions
+    flat_set& operator=(flat_set&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, flat_set&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const flat_set& other) NESTL_NOEXCEPT_SPEC;
+
+
+// iterators
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rend() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crend() const NESTL_NOEXCEPT_SPEC;
+
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC;
+
+    size_type size() const NESTL_NOEXCEPT_SPEC;
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC;
+
+    size_type capacity() const NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC;
+
+
+// modifiers
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts all elements of range, whose keys are not present yet
+     *
+     * Range is sorted and merged with present elements once, this is much faster than
+     * inserting elements one by one. In case of error set is left unchanged.
+     */
+    template <typename OperationError, typename InputIterator>
+    void insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @note Elements after erased ones are shifted, for types which are not nothrow relocatable
+     * that is done by copying which may fail
+     */
+    template <typename OperationError>
+    iterator erase_nothrow(OperationError& err, const_iterator pos) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator erase_nothrow(OperationError& err, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    size_type erase_nothrow(OperationError& err, const key_type& key) NESTL_NOEXCEPT_SPEC;
+
+    void swap(flat_set& other) NESTL_NOEXCEPT_SPEC;
+
+
+// lookup
+
+    const_iterator find(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    size_type count(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator lower_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator upper_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup by any type which Compare compares with keys
+     *
+     * Available if Compare is transparent (nestl::less<> for example), key is never built from argument.
+     */
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    find(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, size_type>::type
+    count(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+private:
+    impl_type m_impl;
+};
+
+
+// implementation
+
+template <typename T, typename C, typename A>
+flat_set<T, C, A>::flat_set(const C& comp, const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(comp, alloc)
+{
+}
+
+template <typename T, typename C, typename A>
+flat_set<T, C, A>::flat_set(const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(alloc)
+{
+}
+
+template <typename T, typename C, typename A>
+flat_set<T, C, A>::flat_set(flat_set&& other) NESTL_NOEXCEPT_SPEC
+    : m_impl(std::move(other.m_impl))
+{
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::allocator_type
+flat_set<T, C, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.get_allocator();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::key_compare
+flat_set<T, C, A>::key_comp() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.key_comp();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::value_compare
+flat_set<T, C, A>::value_comp() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.value_comp();
+}
+
+template <typename T, typename C, typename A>
+flat_set<T, C, A>&
+flat_set<T, C, A>::operator=(flat_set&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl = std::move(other.m_impl);
+    return *this;
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_set<T, C, A>::move_assign_nothrow(OperationError& err, flat_set&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.move_assign_nothrow(err, std::move(other.m_impl));
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_set<T, C, A>::copy_nothrow(OperationError& err, const flat_set& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.copy_nothrow(err, other.m_impl);
+}
+
+
+// iterators
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_iterator
+flat_set<T, C, A>::begin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_iterator
+flat_set<T, C, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_iterator
+flat_set<T, C, A>::end() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_iterator
+flat_set<T, C, A>::cend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_reverse_iterator
+flat_set<T, C, A>::rbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_reverse_iterator
+flat_set<T, C, A>::crbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_reverse_iterator
+flat_set<T, C, A>::rend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_reverse_iterator
+flat_set<T, C, A>::crend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+
+// capacity
+template <typename T, typename C, typename A>
+bool
+flat_set<T, C, A>::empty() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.empty();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::size_type
+flat_set<T, C, A>::size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.size();
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::size_type
+flat_set<T, C, A>::max_size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.max_size();
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_set<T, C, A>::reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.reserve_nothrow(err, new_cap);
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::size_type
+flat_set<T, C, A>::capacity() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.capacity();
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+void
+flat_set<T, C, A>::shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.shrink_to_fit_nothrow(err);
+}
+
+
+// modifiers
+template <typename T, typename C, typename A>
+void
+flat_set<T, C, A>::clear() NESTL_NOEXCEPT_SPEC
+{
+    m_impl.clear();
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_set<T, C, A>::iterator_with_flag
+flat_set<T, C, A>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, val);
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_set<T, C, A>::iterator_with_flag
+flat_set<T, C, A>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, std::move(val));
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError, typename InputIterator>
+void
+flat_set<T, C, A>::insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_insert_range_unique(err, first, last);
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_set<T, C, A>::iterator
+flat_set<T, C, A>::erase_nothrow(OperationError& err, const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase_nothrow(err, pos);
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_set<T, C, A>::iterator
+flat_set<T, C, A>::erase_nothrow(OperationError& err, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase_nothrow(err, first, last);
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+typename flat_set<T, C, A>::size_type
+flat_set<T, C, A>::erase_nothrow(OperationError& err, const key_type& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase_nothrow(err, key);
+}
+
+template <typename T, typename C, typename A>
+void
+flat_set<T, C, A>::swap(flat_set& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.swap(other.m_impl);
+}
+
+
+// lookup
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_iterator
+flat_set<T, C, A>::find(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::size_type
+flat_set<T, C, A>::count(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_iterator
+flat_set<T, C, A>::lower_bound(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_lower_bound(key);
+}
+
+template <typename T, typename C, typename A>
+typename flat_set<T, C, A>::const_iterator
+flat_set<T, C, A>::upper_bound(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_upper_bound(key);
+}
+
+template <typename T, typename C, typename A>
+std::pair<typename flat_set<T, C, A>::const_iterator, typename flat_set<T, C, A>::const_iterator>
+flat_set<T, C, A>::equal_range(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename flat_set<T, C, A>::const_iterator>::type
+flat_set<T, C, A>::find(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename flat_set<T, C, A>::size_type>::type
+flat_set<T, C, A>::count(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename flat_set<T, C, A>::const_iterator>::type
+flat_set<T, C, A>::lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_lower_bound(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename flat_set<T, C, A>::const_iterator>::type
+flat_set<T, C, A>::upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_upper_bound(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename K>
+typename nestl::transparent_lookup<C, K, std::pair<typename flat_set<T, C, A>::const_iterator, typename flat_set<T, C, A>::const_iterator>>::type
+flat_set<T, C, A>::equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_FLAT_SET_HPP */
@@ -14,9 +14,13 @@
 #include <nestl/algorithm.hpp>
 #include <nestl/alignment.hpp>
 
+#include <nestl/detail/allocator_traits_helper.hpp>
 #include <nestl/detail/destroy.hpp>
 
+
 #include <cassert>
+#include <functional>
+#include <iterator>
 
 namespace nestl
 {
@@ -445,8 +449,15 @@ public:
     allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
 
     // assignment operators and functions
+    /**
+     * @note Does not compile for allocators which neither propagate on move assignment
+     * nor are always equal, use move_assign_nothrow for such allocators.
+     */
     list& operator=(list&& other) NESTL_NOEXCEPT_SPEC;
 
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, list&& other) NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError>
     void copy_nothrow(OperationError& err, const list& other) NESTL_NOEXCEPT_SPEC;
 
@@ -550,6 +561,10 @@ public:
     template <typename OperationError>
     void resize_nothrow(OperationError& err, size_type count, const value_type& value) NESTL_NOEXCEPT_SPEC;
 
+    /**
+     * @note Allocators are swapped only if allocator_type::propagate_on_container_swap is true,
+     * otherwise they should be equal
+     */
     void swap(list& other) NESTL_NOEXCEPT_SPEC;
 
     // operations
@@ -575,6 +590,11 @@ public:
 
     void splice(const_iterator pos, list&& other, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC;
 
+    /// @brief Splice of range which is known to contain count elements, takes constant time
+    void splice(const_iterator pos, list& other, const_iterator first, const_iterator last, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    void splice(const_iterator pos, list&& other, const_iterator first, const_iterator last, size_type count) NESTL_NOEXCEPT_SPEC;
+
     void remove(const value_type& value) NESTL_NOEXCEPT_SPEC;
 
     template <typename UnaryPredicate>
@@ -602,6 +622,9 @@ private:
 
     list_node_base m_node;
 
+    /// number of elements, so size() does not walk over nodes
+    size_type m_size;
+
     void init_empty_list() NESTL_NOEXCEPT_SPEC;
 
     void destroy_list_content() NESTL_NOEXCEPT_SPEC;
@@ -610,11 +633,36 @@ private:
 
     void move_assign(const std::true_type& /* true_val */, list&& other) NESTL_NOEXCEPT_SPEC;
 
+    void move_assign(const std::false_type& /* false_val */, list&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_elements(OperationError& err, list& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename Integer>
+    void insert_dispatch(OperationError& err,
+                         const_iterator pos,
+                         Integer count,
+                         Integer value,
+                         std::true_type /* is integral */) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename InputIterator>
+    void insert_dispatch(OperationError& err,
+                         const_iterator pos,
+                         InputIterator first,
+                         InputIterator last,
+                         std::false_type /* is integral */) NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError, typename ... Args>
     node_type* create_node(OperationError& err, Args&& ... args) NESTL_NOEXCEPT_SPEC;
 
     template <typename ListIterator1, typename ListIterator2, typename ListIterator3>
     void transfer(ListIterator1 pos, ListIterator2 first, ListIterator3 last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename ListIterator1, typename ListIterator2, typename ListIterator3>
+    void transfer(list& other, ListIterator1 pos, ListIterator2 first, ListIterator3 last, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    void do_resize(OperationError& err, size_type count, const Args& ... args) NESTL_NOEXCEPT_SPEC;
 };
 
 } // namespace impl
@@ -670,14 +718,16 @@ template <typename T, typename A>
 list<T, A>::list(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
     : m_node_allocator(alloc)
     , m_node()
+    , m_size(0)
 {
     init_empty_list();
 }
 
 template <typename T, typename A>
 list<T, A>::list(list&& other) NESTL_NOEXCEPT_SPEC
-    : m_node_allocator(std::move(other.m_node_allocator))
+    : m_node_allocator(other.m_node_allocator)
     , m_node()
+    , m_size(0)
 {
     init_empty_list();
     swap_data(other);
@@ -698,11 +748,30 @@ typename list<T, A>::allocator_type list<T, A>::get_allocator() const NESTL_NOEX
 template <typename T, typename A>
 list<T, A>& list<T, A>::operator=(list&& other) NESTL_NOEXCEPT_SPEC
 {
-    this->move_assign(typename nestl::allocator_traits<node_allocator_type>::propagate_on_container_move_assignment(), other);
+    static_assert(nestl::detail::alloc_move_takes_storage<node_allocator_type>::value,
+                  "move assignment may fail for this allocator, use move_assign_nothrow");
+
+    this->move_assign(typename nestl::allocator_traits<node_allocator_type>::propagate_on_container_move_assignment(), std::move(other));
 
     return *this;
 }
 
+template <typename T, typename A>
+template <typename OperationError>
+void
+list<T, A>::move_assign_nothrow(OperationError& err, list&& other) NESTL_NOEXCEPT_SPEC
+{
+    typedef typename nestl::allocator_traits<node_allocator_type>::propagate_on_container_move_assignment propagate;
+
+    if (propagate::value || nestl::detail::allocators_equal(m_node_allocator, other.m_node_allocator))
+    {
+        this->move_assign(propagate(), std::move(other));
+        return;
+    }
+
+    move_elements(err, other);
+}
+
 template <typename T, typename A>
 template <typename OperationError>
 void
@@ -716,7 +785,7 @@ template <typename OperationError>
 void
 list<T, A>::assign_nothrow(OperationError& err, size_type n, const_reference val) NESTL_NOEXCEPT_SPEC
 {
-    list tmp; tmp.swap(*this);
+    list tmp(get_allocator()); tmp.swap(*this);
 
     while (n > 0)
     {
@@ -736,7 +805,7 @@ template <typename OperationError, typename InputIterator>
 void
 list<T, A>::assign_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
 {
-    list tmp; tmp.swap(*this);
+    list tmp(get_allocator()); tmp.swap(*this);
 
     while (first != last)
     {
@@ -879,7 +948,7 @@ template <typename T, typename A>
 typename list<T, A>::size_type
 list<T, A>::size() const NESTL_NOEXCEPT_SPEC
 {
-    return std::distance(cbegin(), cend());
+    return m_size;
 }
 
 template <typename T, typename A>
@@ -935,6 +1004,30 @@ template <typename T, typename A>
 template<typename OperationError, typename InputIterator>
 void
 list<T, A>::insert_nothrow(OperationError& err, const_iterator pos, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    insert_dispatch(err, pos, first, last, std::is_integral<InputIterator>());
+}
+
+template <typename T, typename A>
+template <typename OperationError, typename Integer>
+void
+list<T, A>::insert_dispatch(OperationError& err,
+                            const_iterator pos,
+                            Integer count,
+                            Integer value,
+                            std::true_type /* is integral */) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, pos, static_cast<size_type>(count), static_cast<value_type>(value));
+}
+
+template <typename T, typename A>
+template <typename OperationError, typename InputIterator>
+void
+list<T, A>::insert_dispatch(OperationError& err,
+                            const_iterator pos,
+                            InputIterator first,
+                            InputIterator last,
+                            std::false_type /* is integral */) NESTL_NOEXCEPT_SPEC
 {
     while (first != last)
     {
@@ -963,6 +1056,7 @@ list<T, A>::emplace_nothrow(OperationError& err, const_iterator pos, Args&&... a
     NESTL_CHECK_LIST_NODE(newNode);
 
     newNode->inject(pos.get_list_node());
+    ++m_size;
 
     return iterator(newNode);
 }
@@ -975,6 +1069,7 @@ list<T, A>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
     iterator ret = iterator(node->m_next);
 
     node->remove();
+    --m_size;
 
     node->destroy_value();
     m_node_allocator.deallocate(node, 1);
@@ -991,7 +1086,7 @@ list<T, A>::erase(const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
         first = erase(first);
     }
 
-    return last.get_list_node();
+    return iterator(last.get_list_node());
 }
 
 template <typename T, typename A>
@@ -1057,10 +1152,27 @@ list<T, A>::pop_front() NESTL_NOEXCEPT_SPEC
 }
 
 
+template <typename T, typename A>
+template <typename OperationError>
+void
+list<T, A>::resize_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    do_resize(err, count);
+}
+
+template <typename T, typename A>
+template <typename OperationError>
+void
+list<T, A>::resize_nothrow(OperationError& err, size_type count, const value_type& value) NESTL_NOEXCEPT_SPEC
+{
+    do_resize(err, count, value);
+}
+
 template <typename T, typename A>
 void
 list<T, A>::swap(list& other) NESTL_NOEXCEPT_SPEC
 {
+    nestl::detail::alloc_on_swap(m_node_allocator, other.m_node_allocator);
     swap_data(other);
 }
 
@@ -1118,6 +1230,9 @@ list<T, A>::merge(list&& other, Compare comp) NESTL_NOEXCEPT_SPEC
     {
         transfer(last1, first2, last2);
     }
+
+    m_size += other.m_size;
+    other.m_size = 0;
 }
 
 template <typename T, typename A>
@@ -1133,7 +1248,7 @@ list<T, A>::splice(const_iterator pos, list&& other) NESTL_NOEXCEPT_SPEC
 {
     if (!other.empty())
     {
-        this->transfer(pos, other.begin(), other.end());
+        this->transfer(other, pos, other.begin(), other.end(), other.m_size);
     }
 }
 
@@ -1146,7 +1261,7 @@ list<T, A>::splice(const_iterator pos, list& other, const_iterator it) NESTL_NOE
 
 template <typename T, typename A>
 void
-list<T, A>::splice(const_iterator pos, list&& /* other */, const_iterator it) NESTL_NOEXCEPT_SPEC
+list<T, A>::splice(const_iterator pos, list&& other, const_iterator it) NESTL_NOEXCEPT_SPEC
 {
     iterator j = iterator(it.get_list_node());
     ++j;
@@ -1155,7 +1270,7 @@ list<T, A>::splice(const_iterator pos, list&& /* other */, const_iterator it) NE
         return;
     }
 
-    this->transfer(pos, it, j);
+    this->transfer(other, pos, it, j, 1);
 }
 
 template <typename T, typename A>
@@ -1167,11 +1282,130 @@ list<T, A>::splice(const_iterator pos, list& other, const_iterator first, const_
 
 template <typename T, typename A>
 void
-list<T, A>::splice(const_iterator pos, list&& /* other */, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+list<T, A>::splice(const_iterator pos, list&& other, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+{
+    /// elements are counted only when they move between lists
+    const size_type count = (this == &other) ? 0 : std::distance(first, last);
+
+    splice(pos, std::move(other), first, last, count);
+}
+
+template <typename T, typename A>
+void
+list<T, A>::splice(const_iterator pos,
+                   list& other,
+                   const_iterator first,
+                   const_iterator last,
+                   size_type count) NESTL_NOEXCEPT_SPEC
 {
+    splice(pos, std::move(other), first, last, count);
+}
+
+template <typename T, typename A>
+void
+list<T, A>::splice(const_iterator pos,
+                   list&& other,
+                   const_iterator first,
+                   const_iterator last,
+                   size_type count) NESTL_NOEXCEPT_SPEC
+{
+    assert((this == &other) || (count == static_cast<size_type>(std::distance(first, last))));
+
     if (first != last)
     {
-        this->transfer(pos, first, last);
+        this->transfer(other, pos, first, last, count);
+    }
+}
+
+template <typename T, typename A>
+void
+list<T, A>::remove(const value_type& value) NESTL_NOEXCEPT_SPEC
+{
+    /// value may refer to element of this list, so removed nodes are destroyed at the end
+    list removed(get_allocator());
+
+    iterator first = begin();
+    iterator last = end();
+    while (first != last)
+    {
+        iterator next = first;
+        ++next;
+
+        if (*first == value)
+        {
+            removed.transfer(*this, removed.end(), first, next, 1);
+        }
+
+        first = next;
+    }
+}
+
+template <typename T, typename A>
+template <typename UnaryPredicate>
+void
+list<T, A>::remove(UnaryPredicate p) NESTL_NOEXCEPT_SPEC
+{
+    iterator first = begin();
+    iterator last = end();
+    while (first != last)
+    {
+        iterator next = first;
+        ++next;
+
+        if (p(*first))
+        {
+            erase(first);
+        }
+
+        first = next;
+    }
+}
+
+template <typename T, typename A>
+void
+list<T, A>::reverse() NESTL_NOEXCEPT_SPEC
+{
+    list_node_base* node = &m_node;
+    do
+    {
+        std::swap(node->m_next, node->m_prev);
+        node = node->m_prev;
+    }
+    while (node != &m_node);
+}
+
+template <typename T, typename A>
+void
+list<T, A>::unique() NESTL_NOEXCEPT_SPEC
+{
+    unique(std::equal_to<value_type>());
+}
+
+template <typename T, typename A>
+template<typename BinaryPredicate>
+void
+list<T, A>::unique(BinaryPredicate p) NESTL_NOEXCEPT_SPEC
+{
+    if (empty())
+    {
+        return;
+    }
+
+    iterator first = begin();
+    iterator last = end();
+    iterator next = first;
+    while (++next != last)
+    {
+        if (p(*first, *next))
+        {
+            erase(next);
+        }
+        else
+        {
+            first = next;
+        }
+
+        next = first;
     }
 }
 
@@ -1193,6 +1427,7 @@ list<T, A>::sort(Compare comp) NESTL_NOEXCEPT_SPEC
     if ((this->m_node.m_next != &this->m_node) &&
         (this->m_node.m_next->m_next != &this->m_node))
     {
+        /// temporary lists only hold nodes of this list, so allocators of lists are never used
         list carry;
         list tmp[64];
         list* fill = &tmp[0];
@@ -1205,10 +1440,10 @@ list<T, A>::sort(Compare comp) NESTL_NOEXCEPT_SPEC
             for(counter = &tmp[0]; counter != fill && !counter->empty(); ++counter)
             {
                 counter->merge(carry, comp);
-                carry.swap(*counter);
+                carry.swap_data(*counter);
             }
 
-            carry.swap(*counter);
+            carry.swap_data(*counter);
             if (counter == fill)
             {
                 ++fill;
@@ -1220,7 +1455,7 @@ list<T, A>::sort(Compare comp) NESTL_NOEXCEPT_SPEC
         {
             counter->merge(*(counter - 1), comp);
         }
-        swap( *(fill - 1) );
+        swap_data( *(fill - 1) );
     }
 }
 
@@ -1234,6 +1469,7 @@ void
 list<T, A>::init_empty_list() NESTL_NOEXCEPT_SPEC
 {
     m_node.init_empty();
+    m_size = 0;
 }
 
 template <typename T, typename A>
@@ -1257,16 +1493,49 @@ void
 list<T, A>::swap_data(list& other) NESTL_NOEXCEPT_SPEC
 {
     list_node_base::swap(other.m_node, m_node);
+    std::swap(m_size, other.m_size);
 }
 
 template <typename T, typename A>
 void
 list<T, A>::move_assign(const std::true_type& /* true_val */, list&& other) NESTL_NOEXCEPT_SPEC
 {
+    const list tmp(std::move(*this));
+
+    m_node_allocator = other.m_node_allocator;
+    this->swap_data(other);
+}
+
+template <typename T, typename A>
+void
+list<T, A>::move_assign(const std::false_type& /* false_val */, list&& other) NESTL_NOEXCEPT_SPEC
+{
+    assert(nestl::detail::allocators_equal(m_node_allocator, other.m_node_allocator));
+
     const list tmp(std::move(*this));
     this->swap_data(other);
 }
 
+template <typename T, typename A>
+template <typename OperationError>
+void
+list<T, A>::move_elements(OperationError& err, list& other) NESTL_NOEXCEPT_SPEC
+{
+    /// nodes of other can not be taken, so elements are moved into nodes of our allocator
+    list tmp(get_allocator());
+    for (iterator it = other.begin(); it != other.end(); ++it)
+    {
+        tmp.emplace_back_nothrow(err, std::move(*it));
+        if (err)
+        {
+            return;
+        }
+    }
+
+    this->swap_data(tmp);
+    other.clear();
+}
+
 template <typename T, typename A>
 template <typename OperationError, typename ... Args>
 typename list<T, A>::node_type*
@@ -1297,6 +1566,60 @@ list<T, A>::transfer(ListIterator1 pos, ListIterator2 first, ListIterator3 last)
     pos.get_list_node()->transfer(first.get_list_node(), last.get_list_node());
 }
 
+template <typename T, typename A>
+template <typename ListIterator1, typename ListIterator2, typename ListIterator3>
+void
+list<T, A>::transfer(list& other, ListIterator1 pos, ListIterator2 first, ListIterator3 last, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    transfer(pos, first, last);
+
+    if (this != &other)
+    {
+        m_size += count;
+        other.m_size -= count;
+    }
+}
+
+template <typename T, typename A>
+template <typename OperationError, typename ... Args>
+void
+list<T, A>::do_resize(OperationError& err, size_type count, const Args& ... args) NESTL_NOEXCEPT_SPEC
+{
+    if (count <= m_size)
+    {
+        /// walk from the nearest end of list
+        iterator first = end();
+        if (count < m_size / 2)
+        {
+            first = begin();
+            std::advance(first, count);
+        }
+        else
+        {
+            for (size_type i = m_size; i != count; --i)
+            {
+                --first;
+            }
+        }
+
+        erase(first, end());
+        return;
+    }
+
+    /// new elements are created aside, so list is left untouched on failure
+    list appended(get_allocator());
+    for (size_type i = m_size; i != count; ++i)
+    {
+        appended.emplace_back_nothrow(err, args ...);
+        if (err)
+        {
+            return;
+        }
+    }
+
+    splice(cend(), appended);
+}
+
 } // namespace impl
 } // namespace nestl
 
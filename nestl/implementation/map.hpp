@@ -0,0 +1,654 @@
+#ifndef NESTL_IMPLEMENTATION_MAP_HPP
+#define NESTL_IMPLEMENTATION_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/detail/key_of_value.hpp>
+#include <nestl/implementation/detail/red_black_tree.hpp>
+
+#include <utility>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Map with unique keys stored in red-black tree
+ *
+ * @note Piecewise constructor of pair is not noexcept, so members of values are constructed one by one
+ * in storage of node (see detail/piecewise.hpp). Neither key nor mapped type has to be default constructible.
+ */
+template<typename Key,
+         typename T,
+         typename Compare = std::less<Key>,
+         typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+class map
+{
+    map(const map& ) = delete;
+    map& operator=(const map& ) = delete;
+public:
+
+    typedef Alloc                                                                   allocator_type;
+    typedef T                                                                       mapped_type;
+
+    typedef detail::select1st<std::pair<const Key, T> >                             key_of_value;
+    typedef detail::rb_tree<Key, std::pair<const Key, T>, key_of_value, Compare, allocator_type> impl_type;
+
+    typedef typename impl_type::key_type                                            key_type;
+    typedef typename impl_type::value_type                                          value_type;
+    typedef Compare                                                                 key_compare;
+
+    typedef typename impl_type::size_type                                           size_type;
+    typedef typename impl_type::difference_type                                     difference_type;
+
+    typedef typename impl_type::reference                                           reference;
+    typedef typename impl_type::const_reference                                     const_reference;
+
+    typedef typename nestl::allocator_traits<Alloc>::pointer                        pointer;
+    typedef typename nestl::allocator_traits<Alloc>::const_pointer                  const_pointer;
+
+    typedef typename impl_type::iterator                                            iterator;
+    typedef typename impl_type::const_iterator                                      const_iterator;
+    typedef typename impl_type::reverse_iterator                                    reverse_iterator;
+    typedef typename impl_type::const_reverse_iterator                              const_reverse_iterator;
+
+    typedef std::pair<iterator, bool>                                               iterator_with_flag;
+
+// constructors
+    explicit map(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) NESTL_NOEXCEPT_SPEC;
+    explicit map(const Alloc& alloc) NESTL_NOEXCEPT_SPEC;
+
+    map(map&& other) NESTL_NOEXCEPT_SPEC;
+
+// allocator support
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
+
+// observers
+    key_compare key_comp() const NESTL_NOEXCEPT_SPEC;
+
+// assignment operators and functions
+    /**
+     * @note Does not compile for allocators which neither propagate on move assignment
+     * nor are always equal, use move_assign_nothrow for such allocators.
+     */
+    map& operator=(map&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, map&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const map& other) NESTL_NOEXCEPT_SPEC;
+
+
+// iterators
+    iterator begin() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC;
+
+    iterator end() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rbegin() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crbegin() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rend() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rend() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crend() const NESTL_NOEXCEPT_SPEC;
+
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC;
+
+    size_type size() const NESTL_NOEXCEPT_SPEC;
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC;
+
+
+// modifiers
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts elements of range whose keys are not present yet
+     *
+     * In case of error elements inserted before failed one are kept.
+     */
+    template <typename OperationError, typename InputIterator>
+    void insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts value constructed from key and args if key is not present, otherwise args are left untouched
+     *
+     * Key is looked up first, so for present key neither node is allocated nor mapped value is built.
+     */
+    template <typename OperationError, typename ... Args>
+    iterator_with_flag try_emplace_nothrow(OperationError& err, const key_type& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator_with_flag try_emplace_nothrow(OperationError& err, key_type&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Assigns obj to mapped value of present key, otherwise inserts value constructed from key and obj
+     *
+     * @return iterator to element and true if it was inserted, false if it was assigned
+     */
+    template <typename OperationError, typename M>
+    iterator_with_flag insert_or_assign_nothrow(OperationError& err, const key_type& key, M&& obj) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename M>
+    iterator_with_flag insert_or_assign_nothrow(OperationError& err, key_type&& key, M&& obj) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Replaces content by elements of range sorted by Compare
+     *
+     * Tree is built balanced straight from the range in linear time, while inserting elements
+     * one by one takes O(n log n). Of equivalent elements only the first one is kept.
+     * In case of error map is left unchanged.
+     */
+    template <typename OperationError, typename ForwardIterator>
+    void assign_sorted_nothrow(OperationError& err, ForwardIterator first, ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    iterator erase(const_iterator pos) NESTL_NOEXCEPT_SPEC;
+
+    size_type erase(const key_type& key) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @note Allocators are swapped only if allocator_type::propagate_on_container_swap is true,
+     * otherwise they should be equal
+     */
+    void swap(map& other) NESTL_NOEXCEPT_SPEC;
+
+
+// lookup
+
+    iterator find(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator find(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    size_type count(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator lower_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator lower_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator upper_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator upper_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    std::pair<iterator, iterator> equal_range(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup by any type which Compare compares with keys
+     *
+     * Available if Compare is transparent (nestl::less<> for example), key is never built from argument,
+     * so lookup neither allocates nor fails.
+     */
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    find(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    find(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, size_type>::type
+    count(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    lower_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    upper_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<iterator, iterator> >::type
+    equal_range(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+private:
+    impl_type m_impl;
+};
+
+
+// implementation
+
+template <typename K, typename T, typename C, typename A>
+map<K, T, C, A>::map(const C& comp, const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(comp, alloc)
+{
+}
+
+template <typename K, typename T, typename C, typename A>
+map<K, T, C, A>::map(const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(alloc)
+{
+}
+
+template <typename K, typename T, typename C, typename A>
+map<K, T, C, A>::map(map&& other) NESTL_NOEXCEPT_SPEC
+    : m_impl(std::move(other.m_impl))
+{
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::allocator_type
+map<K, T, C, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+{
+    return allocator_type(m_impl.get_allocator());
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::key_compare
+map<K, T, C, A>::key_comp() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.key_comp();
+}
+
+
+template <typename K, typename T, typename C, typename A>
+map<K, T, C, A>&
+map<K, T, C, A>::operator=(map&& other) NESTL_NOEXCEPT_SPEC
+{
+    static_assert(nestl::detail::alloc_move_takes_storage<allocator_type>::value,
+                  "move assignment may fail for this allocator, use move_assign_nothrow");
+
+    m_impl.m_move_assign(other.m_impl);
+    return *this;
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+void
+map<K, T, C, A>::move_assign_nothrow(OperationError& err, map&& other) NESTL_NOEXCEPT_SPEC
+{
+    if (!m_impl.m_move_assign(other.m_impl))
+    {
+        m_impl.m_move_elements(err, other.m_impl);
+    }
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+void
+map<K, T, C, A>::copy_nothrow(OperationError& err, const map& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.copy_nothrow(err, other.m_impl);
+}
+
+
+// iterators
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::iterator
+map<K, T, C, A>::begin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_iterator
+map<K, T, C, A>::begin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_iterator
+map<K, T, C, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::iterator
+map<K, T, C, A>::end() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_iterator
+map<K, T, C, A>::end() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_iterator
+map<K, T, C, A>::cend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::reverse_iterator
+map<K, T, C, A>::rbegin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_reverse_iterator
+map<K, T, C, A>::rbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_reverse_iterator
+map<K, T, C, A>::crbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::reverse_iterator
+map<K, T, C, A>::rend() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_reverse_iterator
+map<K, T, C, A>::rend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_reverse_iterator
+map<K, T, C, A>::crend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+
+// capacity
+template <typename K, typename T, typename C, typename A>
+bool
+map<K, T, C, A>::empty() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.empty();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::size_type
+map<K, T, C, A>::size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.size();
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::size_type
+map<K, T, C, A>::max_size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.max_size();
+}
+
+
+// modifiers
+template <typename K, typename T, typename C, typename A>
+void
+map<K, T, C, A>::clear() NESTL_NOEXCEPT_SPEC
+{
+    m_impl.clear();
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+typename map<K, T, C, A>::iterator_with_flag
+map<K, T, C, A>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, val);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError>
+typename map<K, T, C, A>::iterator_with_flag
+map<K, T, C, A>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, std::move(val));
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename InputIterator>
+void
+map<K, T, C, A>::insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_insert_unique(err, first, last);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename ... Args>
+typename map<K, T, C, A>::iterator_with_flag
+map<K, T, C, A>::try_emplace_nothrow(OperationError& err, const key_type& key, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_try_emplace_unique(err, key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename ... Args>
+typename map<K, T, C, A>::iterator_with_flag
+map<K, T, C, A>::try_emplace_nothrow(OperationError& err, key_type&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_try_emplace_unique(err, std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename M>
+typename map<K, T, C, A>::iterator_with_flag
+map<K, T, C, A>::insert_or_assign_nothrow(OperationError& err, const key_type& key, M&& obj) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_or_assign_unique(err, key, std::forward<M>(obj));
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename M>
+typename map<K, T, C, A>::iterator_with_flag
+map<K, T, C, A>::insert_or_assign_nothrow(OperationError& err, key_type&& key, M&& obj) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_or_assign_unique(err, std::move(key), std::forward<M>(obj));
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename OperationError, typename ForwardIterator>
+void
+map<K, T, C, A>::assign_sorted_nothrow(OperationError& err, ForwardIterator first, ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_assign_sorted_unique(err, first, last);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::iterator
+map<K, T, C, A>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase(pos);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::size_type
+map<K, T, C, A>::erase(const key_type& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+void
+map<K, T, C, A>::swap(map& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.swap(other.m_impl);
+}
+
+
+
+// lookup
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::iterator
+map<K, T, C, A>::find(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_iterator
+map<K, T, C, A>::find(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::size_type
+map<K, T, C, A>::count(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.count(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::iterator
+map<K, T, C, A>::lower_bound(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_iterator
+map<K, T, C, A>::lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::iterator
+map<K, T, C, A>::upper_bound(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+typename map<K, T, C, A>::const_iterator
+map<K, T, C, A>::upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+std::pair<typename map<K, T, C, A>::iterator, typename map<K, T, C, A>::iterator>
+map<K, T, C, A>::equal_range(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+std::pair<typename map<K, T, C, A>::const_iterator, typename map<K, T, C, A>::const_iterator>
+map<K, T, C, A>::equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename map<K, T, C, A>::iterator>::type
+map<K, T, C, A>::find(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename map<K, T, C, A>::const_iterator>::type
+map<K, T, C, A>::find(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename map<K, T, C, A>::size_type>::type
+map<K, T, C, A>::count(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.count(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename map<K, T, C, A>::iterator>::type
+map<K, T, C, A>::lower_bound(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename map<K, T, C, A>::const_iterator>::type
+map<K, T, C, A>::lower_bound(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename map<K, T, C, A>::iterator>::type
+map<K, T, C, A>::upper_bound(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename map<K, T, C, A>::const_iterator>::type
+map<K, T, C, A>::upper_bound(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, std::pair<typename map<K, T, C, A>::iterator, typename map<K, T, C, A>::iterator>>::type
+map<K, T, C, A>::equal_range(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename K, typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, std::pair<typename map<K, T, C, A>::const_iterator, typename map<K, T, C, A>::const_iterator>>::type
+map<K, T, C, A>::equal_range(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_MAP_HPP */
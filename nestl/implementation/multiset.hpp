@@ -0,0 +1,576 @@
+#ifndef NESTL_IMPLEMENTATION_MULTISET_HPP
+#define NESTL_IMPLEMENTATION_MULTISET_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/detail/key_of_value.hpp>
+#include <nestl/implementation/detail/red_black_tree.hpp>
+
+#include <utility>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Set with equivalent keys allowed, stored in red-black tree
+ *
+ * Elements with equivalent keys keep order of their insertion.
+ */
+template<typename Key, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<Key> >
+class multiset
+{
+    multiset(const multiset& ) = delete;
+    multiset& operator=(const multiset& ) = delete;
+public:
+
+    typedef Alloc                                                                   allocator_type;
+
+    typedef detail::identity<Key>                                                   key_of_value;
+    typedef detail::rb_tree<Key, Key, key_of_value, Compare, allocator_type>        impl_type;
+
+    typedef typename impl_type::key_type                                            key_type;
+    typedef typename impl_type::value_type                                          value_type;
+    typedef Compare                                                                 key_compare;
+
+    typedef typename impl_type::size_type                                           size_type;
+    typedef typename impl_type::difference_type                                     difference_type;
+
+    typedef typename impl_type::reference                                           reference;
+    typedef typename impl_type::const_reference                                     const_reference;
+
+    typedef typename nestl::allocator_traits<Alloc>::pointer                        pointer;
+    typedef typename nestl::allocator_traits<Alloc>::const_pointer                  const_pointer;
+
+    typedef typename impl_type::iterator                                            iterator;
+    typedef typename impl_type::const_iterator                                      const_iterator;
+    typedef typename impl_type::reverse_iterator                                    reverse_iterator;
+    typedef typename impl_type::const_reverse_iterator                              const_reverse_iterator;
+
+// constructors
+    explicit multiset(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) NESTL_NOEXCEPT_SPEC;
+    explicit multiset(const Alloc& alloc) NESTL_NOEXCEPT_SPEC;
+
+    multiset(multiset&& other) NESTL_NOEXCEPT_SPEC;
+
+// allocator support
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
+
+// observers
+    key_compare key_comp() const NESTL_NOEXCEPT_SPEC;
+
+// assignment operators and functions
+    /**
+     * @note Does not compile for allocators which neither propagate on move assignment
+     * nor are always equal, use move_assign_nothrow for such allocators.
+     */
+    multiset& operator=(multiset&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, multiset&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const multiset& other) NESTL_NOEXCEPT_SPEC;
+
+
+// iterators
+    iterator begin() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC;
+
+    iterator end() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rbegin() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crbegin() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rend() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rend() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crend() const NESTL_NOEXCEPT_SPEC;
+
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC;
+
+    size_type size() const NESTL_NOEXCEPT_SPEC;
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC;
+
+
+// modifiers
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Inserts value after all elements with equivalent key
+    template <typename OperationError>
+    iterator insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts all elements of range
+     *
+     * In case of error elements inserted before failed one are kept.
+     */
+    template <typename OperationError, typename InputIterator>
+    void insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    iterator erase(const_iterator pos) NESTL_NOEXCEPT_SPEC;
+
+    size_type erase(const key_type& key) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @note Allocators are swapped only if allocator_type::propagate_on_container_swap is true,
+     * otherwise they should be equal
+     */
+    void swap(multiset& other) NESTL_NOEXCEPT_SPEC;
+
+
+// lookup
+
+    iterator find(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator find(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    size_type count(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator lower_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator lower_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator upper_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator upper_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    std::pair<iterator, iterator> equal_range(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup by any type which Compare compares with keys
+     *
+     * Available if Compare is transparent (nestl::less<> for example), key is never built from argument,
+     * so lookup neither allocates nor fails.
+     */
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    find(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    find(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, size_type>::type
+    count(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    lower_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    upper_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<iterator, iterator> >::type
+    equal_range(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+private:
+    impl_type m_impl;
+};
+
+
+// implementation
+
+template <typename T, typename C, typename A>
+multiset<T, C, A>::multiset(const C& comp, const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(comp, alloc)
+{
+}
+
+template <typename T, typename C, typename A>
+multiset<T, C, A>::multiset(const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(alloc)
+{
+}
+
+template <typename T, typename C, typename A>
+multiset<T, C, A>::multiset(multiset&& other) NESTL_NOEXCEPT_SPEC
+    : m_impl(std::move(other.m_impl))
+{
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::allocator_type
+multiset<T, C, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+{
+    return allocator_type(m_impl.get_allocator());
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::key_compare
+multiset<T, C, A>::key_comp() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.key_comp();
+}
+
+
+template <typename T, typename C, typename A>
+multiset<T, C, A>&
+multiset<T, C, A>::operator=(multiset&& other) NESTL_NOEXCEPT_SPEC
+{
+    static_assert(nestl::detail::alloc_move_takes_storage<allocator_type>::value,
+                  "move assignment may fail for this allocator, use move_assign_nothrow");
+
+    m_impl.m_move_assign(other.m_impl);
+    return *this;
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+void
+multiset<T, C, A>::move_assign_nothrow(OperationError& err, multiset&& other) NESTL_NOEXCEPT_SPEC
+{
+    if (!m_impl.m_move_assign(other.m_impl))
+    {
+        m_impl.m_move_elements(err, other.m_impl);
+    }
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+void
+multiset<T, C, A>::copy_nothrow(OperationError& err, const multiset& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.copy_nothrow(err, other.m_impl);
+}
+
+
+// iterators
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::begin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_iterator
+multiset<T, C, A>::begin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_iterator
+multiset<T, C, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::end() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_iterator
+multiset<T, C, A>::end() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_iterator
+multiset<T, C, A>::cend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::reverse_iterator
+multiset<T, C, A>::rbegin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_reverse_iterator
+multiset<T, C, A>::rbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_reverse_iterator
+multiset<T, C, A>::crbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rbegin();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::reverse_iterator
+multiset<T, C, A>::rend() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_reverse_iterator
+multiset<T, C, A>::rend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_reverse_iterator
+multiset<T, C, A>::crend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.rend();
+}
+
+
+// capacity
+template <typename T, typename C, typename A>
+bool
+multiset<T, C, A>::empty() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.empty();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::size_type
+multiset<T, C, A>::size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.size();
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::size_type
+multiset<T, C, A>::max_size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.max_size();
+}
+
+
+// modifiers
+template <typename T, typename C, typename A>
+void
+multiset<T, C, A>::clear() NESTL_NOEXCEPT_SPEC
+{
+    m_impl.clear();
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_equal(err, val);
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_equal(err, std::move(val));
+}
+
+template <typename T, typename C, typename A>
+template <typename OperationError, typename InputIterator>
+void
+multiset<T, C, A>::insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_insert_equal(err, first, last);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase(pos);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::size_type
+multiset<T, C, A>::erase(const key_type& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase(key);
+}
+
+template <typename T, typename C, typename A>
+void
+multiset<T, C, A>::swap(multiset& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.swap(other.m_impl);
+}
+
+
+
+// lookup
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::find(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_iterator
+multiset<T, C, A>::find(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::size_type
+multiset<T, C, A>::count(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.count(key);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::lower_bound(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_iterator
+multiset<T, C, A>::lower_bound(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::iterator
+multiset<T, C, A>::upper_bound(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A>
+typename multiset<T, C, A>::const_iterator
+multiset<T, C, A>::upper_bound(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A>
+std::pair<typename multiset<T, C, A>::iterator, typename multiset<T, C, A>::iterator>
+multiset<T, C, A>::equal_range(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename T, typename C, typename A>
+std::pair<typename multiset<T, C, A>::const_iterator, typename multiset<T, C, A>::const_iterator>
+multiset<T, C, A>::equal_range(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename multiset<T, C, A>::iterator>::type
+multiset<T, C, A>::find(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename multiset<T, C, A>::const_iterator>::type
+multiset<T, C, A>::find(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename multiset<T, C, A>::size_type>::type
+multiset<T, C, A>::count(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.count(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename multiset<T, C, A>::iterator>::type
+multiset<T, C, A>::lower_bound(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename multiset<T, C, A>::const_iterator>::type
+multiset<T, C, A>::lower_bound(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename multiset<T, C, A>::iterator>::type
+multiset<T, C, A>::upper_bound(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, typename multiset<T, C, A>::const_iterator>::type
+multiset<T, C, A>::upper_bound(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, std::pair<typename multiset<T, C, A>::iterator, typename multiset<T, C, A>::iterator>>::type
+multiset<T, C, A>::equal_range(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename T, typename C, typename A>
+template <typename L>
+typename nestl::transparent_lookup<C, L, std::pair<typename multiset<T, C, A>::const_iterator, typename multiset<T, C, A>::const_iterator>>::type
+multiset<T, C, A>::equal_range(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_MULTISET_HPP */
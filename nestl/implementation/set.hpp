@@ -3,32 +3,20 @@
 
 #include <nestl/config.hpp>
 
+#include <nestl/string_view.hpp>
+#include <nestl/tree_policy.hpp>
+
+#include <nestl/implementation/detail/key_of_value.hpp>
 #include <nestl/implementation/detail/red_black_tree.hpp>
 
 namespace nestl
 {
 namespace impl
 {
-namespace detail
-{
-
-template <typename T>
-struct identity : public std::unary_function<T, T>
-{
-    T& operator()(T& x) const
-    {
-        return x;
-    }
-
-    const T& operator()(const T& x) const
-    {
-        return x;
-    }
-};
-
-} // namespace detail
-
-template<typename Key, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<Key> >
+template<typename Key,
+         typename Compare = std::less<Key>,
+         typename Alloc = nestl::allocator<Key>,
+         typename TreePolicy = nestl::default_tree_policy>
 class set
 {
     set(const set& ) = delete;
@@ -38,7 +26,8 @@ public:
     typedef Alloc                                                                   allocator_type;
 
     typedef detail::identity<Key>                                                   key_of_value;
-    typedef detail::rb_tree<Key, Key, key_of_value, Compare, allocator_type>        impl_type;
+    typedef TreePolicy                                                              tree_policy_type;
+    typedef detail::rb_tree<Key, Key, key_of_value, Compare, allocator_type, TreePolicy> impl_type;
 
     typedef typename impl_type::key_type                                            key_type;
     typedef typename impl_type::value_type                                          value_type;
@@ -72,8 +61,15 @@ public:
     allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
 
 // assignment operators and functions
+    /**
+     * @note Does not compile for allocators which neither propagate on move assignment
+     * nor are always equal, use move_assign_nothrow for such allocators.
+     */
     set& operator=(set&& other) NESTL_NOEXCEPT_SPEC;
 
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, set&& other) NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError>
     void copy_nothrow(OperationError& err, const set& other) NESTL_NOEXCEPT_SPEC;
 
@@ -121,10 +117,42 @@ public:
     template <typename OperationError>
     iterator_with_flag insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC;
 
+    /**
+     * @brief Replaces content by elements of range sorted by Compare
+     *
+     * Tree is built balanced straight from the range in linear time, while inserting elements
+     * one by one takes O(n log n). Of equivalent elements only the first one is kept.
+     * In case of error set is left unchanged.
+     */
+    template <typename OperationError, typename ForwardIterator>
+    void assign_sorted_nothrow(OperationError& err, ForwardIterator first, ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Moves elements of other which are not present here, other is left empty
+     *
+     * With equal allocators nodes are relinked by split and join of trees without allocations,
+     * which takes O(m log(n/m + 1)) for sizes m <= n instead of O(m log n) insertions
+     * or linear merge of sorted sequences. Otherwise elements are moved one by one and
+     * in case of error elements not moved yet are left in other.
+     */
+    template <typename OperationError>
+    void unite_nothrow(OperationError& err, set&& other) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Erases elements which are not present in other by split and join, other is left empty
+    void intersect(set&& other) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Erases elements which are present in other by split and join, other is left empty
+    void subtract(set&& other) NESTL_NOEXCEPT_SPEC;
+
     iterator erase(const_iterator pos) NESTL_NOEXCEPT_SPEC;
 
     size_type erase(const key_type& key) NESTL_NOEXCEPT_SPEC;
 
+    /**
+     * @note Allocators are swapped only if allocator_type::propagate_on_container_swap is true,
+     * otherwise they should be equal
+     */
+    void swap(set& other) NESTL_NOEXCEPT_SPEC;
 
 
 // lookup
@@ -133,6 +161,91 @@ public:
 
     const_iterator find(const Key& key) const NESTL_NOEXCEPT_SPEC;
 
+    size_type count(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator lower_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator lower_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    iterator upper_bound(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator upper_bound(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    std::pair<iterator, iterator> equal_range(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup by any type which Compare compares with keys
+     *
+     * Available if Compare is transparent (nestl::less<> for example), key is never built from argument,
+     * so lookup neither allocates nor fails.
+     */
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    find(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    find(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, size_type>::type
+    count(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    lower_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, iterator>::type
+    upper_bound(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, const_iterator>::type
+    upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<iterator, iterator> >::type
+    equal_range(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup of string key by view, no temporary key is built
+     *
+     * Available for sets of strings with default order.
+     */
+    template <typename C, typename T>
+    typename std::enable_if<nestl::detail::is_string_view_lookup<Key, Compare, basic_string_view<C, T> >::value,
+                            iterator>::type
+    find(basic_string_view<C, T> key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename C, typename T>
+    typename std::enable_if<nestl::detail::is_string_view_lookup<Key, Compare, basic_string_view<C, T> >::value,
+                            const_iterator>::type
+    find(basic_string_view<C, T> key) const NESTL_NOEXCEPT_SPEC;
+
+// order statistics, available with nestl::order_statistic_tree_policy
+
+    /// @brief Element with index n in sorted order or end() if n >= size(), takes O(log n)
+    iterator nth(size_type n) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator nth(size_type n) const NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Number of elements less than key, which is index of key if present, takes O(log n)
+    size_type rank(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_lookup<Compare, K, size_type>::type
+    rank(const K& key) const NESTL_NOEXCEPT_SPEC;
+
 private:
     impl_type m_impl;
 };
@@ -140,223 +253,432 @@ private:
 
 // implementation
 
-template <typename T, typename C, typename A>
-set<T, C, A>::set(const C& comp, const A& alloc) NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+set<T, C, A, P>::set(const C& comp, const A& alloc) NESTL_NOEXCEPT_SPEC
     : m_impl(comp, alloc)
 {
 }
 
-template <typename T, typename C, typename A>
-set<T, C, A>::set(const A& alloc) NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+set<T, C, A, P>::set(const A& alloc) NESTL_NOEXCEPT_SPEC
     : m_impl(alloc)
 {
 }
 
-template <typename T, typename C, typename A>
-set<T, C, A>::set(set&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+set<T, C, A, P>::set(set&& other) NESTL_NOEXCEPT_SPEC
 	: m_impl(std::move(other.m_impl))
 {
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::allocator_type
-set<T, C, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::allocator_type
+set<T, C, A, P>::get_allocator() const NESTL_NOEXCEPT_SPEC
 {
     return allocator_type(m_impl.get_allocator());
 }
 
 
 
-template <typename T, typename C, typename A>
-set<T, C, A>&
-set<T, C, A>::operator=(set&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+set<T, C, A, P>&
+set<T, C, A, P>::operator=(set&& other) NESTL_NOEXCEPT_SPEC
+{
+    static_assert(nestl::detail::alloc_move_takes_storage<allocator_type>::value,
+                  "move assignment may fail for this allocator, use move_assign_nothrow");
+
+    m_impl.m_move_assign(other.m_impl);
+    return *this;
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename OperationError>
+void
+set<T, C, A, P>::move_assign_nothrow(OperationError& err, set&& other) NESTL_NOEXCEPT_SPEC
 {
     if (!m_impl.m_move_assign(other.m_impl))
     {
-        // The rvalue's allocator cannot be moved and is not equal,
-        // so we need to individually move each element.
-        clear();
-        insert(std::make_move_iterator(other.m_impl.begin()),
-               std::make_move_iterator(other.m_impl.end()));
-        other.clear();
-      }
-        return *this;
+        m_impl.m_move_elements(err, other.m_impl);
+    }
 }
 
-template <typename T, typename C, typename A>
+template <typename T, typename C, typename A, typename P>
 template <typename OperationError>
 void
-set<T, C, A>::copy_nothrow(OperationError& err, const set& other) NESTL_NOEXCEPT_SPEC
+set<T, C, A, P>::copy_nothrow(OperationError& err, const set& other) NESTL_NOEXCEPT_SPEC
 {
     m_impl.copy_nothrow(err, other.m_impl);
 }
 
 
 // iterators
-template <typename T, typename C, typename A>
-typename set<T, C, A>::iterator
-set<T, C, A>::begin() NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::iterator
+set<T, C, A, P>::begin() NESTL_NOEXCEPT_SPEC
 {
     return m_impl.begin();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_iterator
-set<T, C, A>::begin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::begin() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.begin();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_iterator
-set<T, C, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::cbegin() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.begin();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::iterator
-set<T, C, A>::end() NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::iterator
+set<T, C, A, P>::end() NESTL_NOEXCEPT_SPEC
 {
     return m_impl.end();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_iterator
-set<T, C, A>::end() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::end() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.end();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_iterator
-set<T, C, A>::cend() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::cend() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.end();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::reverse_iterator
-set<T, C, A>::rbegin() NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::reverse_iterator
+set<T, C, A, P>::rbegin() NESTL_NOEXCEPT_SPEC
 {
     return m_impl.rbegin();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_reverse_iterator
-set<T, C, A>::rbegin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_reverse_iterator
+set<T, C, A, P>::rbegin() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.rbegin();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_reverse_iterator
-set<T, C, A>::crbegin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_reverse_iterator
+set<T, C, A, P>::crbegin() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.crbegin();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::reverse_iterator
-set<T, C, A>::rend() NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::reverse_iterator
+set<T, C, A, P>::rend() NESTL_NOEXCEPT_SPEC
 {
     return m_impl.rend();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_reverse_iterator
-set<T, C, A>::rend() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_reverse_iterator
+set<T, C, A, P>::rend() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.rend();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_reverse_iterator
-set<T, C, A>::crend() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_reverse_iterator
+set<T, C, A, P>::crend() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.crend();
 }
 
 
 // capacity
-template <typename T, typename C, typename A>
+template <typename T, typename C, typename A, typename P>
 bool
-set<T, C, A>::empty() const NESTL_NOEXCEPT_SPEC
+set<T, C, A, P>::empty() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.empty();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::size_type
-set<T, C, A>::size() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::size_type
+set<T, C, A, P>::size() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.size();
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::size_type
-set<T, C, A>::max_size() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::size_type
+set<T, C, A, P>::max_size() const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.max_size();
 }
 
 
 // modifiers
-template <typename T, typename C, typename A>
+template <typename T, typename C, typename A, typename P>
 void
-set<T, C, A>::clear() NESTL_NOEXCEPT_SPEC
+set<T, C, A, P>::clear() NESTL_NOEXCEPT_SPEC
 {
     m_impl.clear();
 }
 
-template <typename T, typename C, typename A>
+template <typename T, typename C, typename A, typename P>
 template <typename OperationError>
-typename set<T, C, A>::iterator_with_flag
-set<T, C, A>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
+typename set<T, C, A, P>::iterator_with_flag
+set<T, C, A, P>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
 {
     return m_impl.m_insert_unique(err, val);
 }
 
-template <typename T, typename C, typename A>
+template <typename T, typename C, typename A, typename P>
 template <typename OperationError>
-typename set<T, C, A>::iterator_with_flag
-set<T, C, A>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
+typename set<T, C, A, P>::iterator_with_flag
+set<T, C, A, P>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
 {
 	return m_impl.m_insert_unique(err, std::forward<value_type>(val));
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::iterator
-set<T, C, A>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+template <typename OperationError, typename ForwardIterator>
+void
+set<T, C, A, P>::assign_sorted_nothrow(OperationError& err, ForwardIterator first, ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_assign_sorted_unique(err, first, last);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename OperationError>
+void
+set<T, C, A, P>::unite_nothrow(OperationError& err, set&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_unite_unique(err, other.m_impl);
+}
+
+template <typename T, typename C, typename A, typename P>
+void
+set<T, C, A, P>::intersect(set&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_intersect_unique(other.m_impl);
+}
+
+template <typename T, typename C, typename A, typename P>
+void
+set<T, C, A, P>::subtract(set&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_subtract_unique(other.m_impl);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::iterator
+set<T, C, A, P>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
 {
     return m_impl.erase(pos);
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::size_type
-set<T, C, A>::erase(const key_type& key) NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::size_type
+set<T, C, A, P>::erase(const key_type& key) NESTL_NOEXCEPT_SPEC
 {
     return m_impl.erase(key);
 }
 
+template <typename T, typename C, typename A, typename P>
+void
+set<T, C, A, P>::swap(set& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.swap(other.m_impl);
+}
+
 
 
 // lookup
-template <typename T, typename C, typename A>
-typename set<T, C, A>::iterator
-set<T, C, A>::find(const T& key) NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::iterator
+set<T, C, A, P>::find(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::find(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::size_type
+set<T, C, A, P>::count(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.count(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::iterator
+set<T, C, A, P>::lower_bound(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::lower_bound(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::iterator
+set<T, C, A, P>::upper_bound(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::upper_bound(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+std::pair<typename set<T, C, A, P>::iterator, typename set<T, C, A, P>::iterator>
+set<T, C, A, P>::equal_range(const T& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+std::pair<typename set<T, C, A, P>::const_iterator, typename set<T, C, A, P>::const_iterator>
+set<T, C, A, P>::equal_range(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::iterator>::type
+set<T, C, A, P>::find(const K& key) NESTL_NOEXCEPT_SPEC
 {
     return m_impl.find(key);
 }
 
-template <typename T, typename C, typename A>
-typename set<T, C, A>::const_iterator
-set<T, C, A>::find(const T& key) const NESTL_NOEXCEPT_SPEC
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::const_iterator>::type
+set<T, C, A, P>::find(const K& key) const NESTL_NOEXCEPT_SPEC
 {
     return m_impl.find(key);
 }
 
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::size_type>::type
+set<T, C, A, P>::count(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.count(key);
+}
 
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::iterator>::type
+set<T, C, A, P>::lower_bound(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::const_iterator>::type
+set<T, C, A, P>::lower_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.lower_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::iterator>::type
+set<T, C, A, P>::upper_bound(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::const_iterator>::type
+set<T, C, A, P>::upper_bound(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.upper_bound(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, std::pair<typename set<T, C, A, P>::iterator, typename set<T, C, A, P>::iterator>>::type
+set<T, C, A, P>::equal_range(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, std::pair<typename set<T, C, A, P>::const_iterator, typename set<T, C, A, P>::const_iterator>>::type
+set<T, C, A, P>::equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.equal_range(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename Ch, typename Tr>
+typename std::enable_if<nestl::detail::is_string_view_lookup<T, C, basic_string_view<Ch, Tr> >::value,
+                        typename set<T, C, A, P>::iterator>::type
+set<T, C, A, P>::find(basic_string_view<Ch, Tr> key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find_with(key, nestl::detail::string_view_less<Ch, Tr>());
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename Ch, typename Tr>
+typename std::enable_if<nestl::detail::is_string_view_lookup<T, C, basic_string_view<Ch, Tr> >::value,
+                        typename set<T, C, A, P>::const_iterator>::type
+set<T, C, A, P>::find(basic_string_view<Ch, Tr> key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.find_with(key, nestl::detail::string_view_less<Ch, Tr>());
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::iterator
+set<T, C, A, P>::nth(size_type n) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_nth(n);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::const_iterator
+set<T, C, A, P>::nth(size_type n) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_nth(n);
+}
+
+template <typename T, typename C, typename A, typename P>
+typename set<T, C, A, P>::size_type
+set<T, C, A, P>::rank(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_rank(key);
+}
+
+template <typename T, typename C, typename A, typename P>
+template <typename K>
+typename nestl::transparent_lookup<C, K, typename set<T, C, A, P>::size_type>::type
+set<T, C, A, P>::rank(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_rank(key);
+}
 
 } // namespace impl
 } // namespace nestl
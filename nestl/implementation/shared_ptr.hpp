@@ -4,141 +4,294 @@
 #include <nestl/config.hpp>
 
 #include <nestl/allocator.hpp>
+#include <nestl/allocator_traits.hpp>
 #include <nestl/alignment.hpp>
 #include <nestl/class_operations.hpp>
+#include <nestl/refcount_policy.hpp>
 
+#include <nestl/detail/allocator_traits_helper.hpp>
 #include <nestl/detail/destroy.hpp>
 
 #include <cassert>
+#include <cstddef>
+#include <type_traits>
 
 namespace nestl
 {
 namespace impl
 {
 
+/**
+ * @brief Control block of shared_ptr
+ *
+ * All shared pointers together hold one weak reference, so control block is destroyed
+ * exactly once: by the thread which releases the last weak reference.
+ *
+ * Control block is not polymorphic: derived block passes single function which destroys
+ * either stored value or the whole block, so there is neither vtable nor virtual destructor.
+ */
+template <typename RefCountPolicy>
 class shared_count_base
 {
     shared_count_base(const shared_count_base& ) = delete;
     shared_count_base& operator=(const shared_count_base& ) = delete;
+
+    typedef RefCountPolicy policy_type;
 public:
 
-    shared_count_base() NESTL_NOEXCEPT_SPEC
-        : m_use_count(0)
-        , m_weak_use_count(0)
+    enum destroy_operation
     {
-    }
+        destroy_value_operation,
+        destroy_self_operation
+    };
+
+    typedef void (*destroyer_type)(shared_count_base* self, destroy_operation operation);
 
-    virtual ~shared_count_base()
+    explicit shared_count_base(destroyer_type destroyer) NESTL_NOEXCEPT_SPEC
+        : m_destroyer(destroyer)
+        , m_use_count(0)
+        , m_weak_use_count(1)
     {
     }
 
     long use_count() const NESTL_NOEXCEPT_SPEC
     {
-		assert(m_use_count >= 0);
-        return m_use_count;
+        const long res = policy_type::load(m_use_count);
+		assert(res >= 0);
+        return res;
     }
 
     void add_ref() NESTL_NOEXCEPT_SPEC
     {
-		assert(m_use_count >= 0);
-        ++m_use_count;
+        policy_type::increment(m_use_count);
+    }
+
+    /// @brief Takes new reference if object is still alive, used by weak_ptr::lock
+    bool add_ref_lock() NESTL_NOEXCEPT_SPEC
+    {
+        return policy_type::increment_if_not_zero(m_use_count);
     }
 
     void release() NESTL_NOEXCEPT_SPEC
     {
-		assert(m_use_count > 0);
-        --m_use_count;
-        if (m_use_count == 0)
+        const long res = policy_type::decrement(m_use_count);
+		assert(res >= 0);
+        if (res == 0)
         {
-            destroy_value();
-            if (m_weak_use_count == 0)
-            {
-                destroy_self();
-            }
+            m_destroyer(this, destroy_value_operation);
+            weak_release();
         }
     }
 
     void weak_add_ref() NESTL_NOEXCEPT_SPEC
     {
-		assert(m_weak_use_count >= 0);
-        ++m_weak_use_count;
+        policy_type::increment(m_weak_use_count);
     }
 
     void weak_release() NESTL_NOEXCEPT_SPEC
     {
-		assert(m_weak_use_count > 0);
-        --m_weak_use_count;
-        if ((m_weak_use_count == 0) && (m_use_count == 0))
+        const long res = policy_type::decrement(m_weak_use_count);
+		assert(res >= 0);
+        if (res == 0)
         {
-            destroy_self();
+            m_destroyer(this, destroy_self_operation);
         }
     }
 
-private:
-    long m_use_count;
-    long m_weak_use_count;
+protected:
 
-    virtual void destroy_value() NESTL_NOEXCEPT_SPEC = 0;
+    /// @brief Block is destroyed by its destroyer only, which knows the actual type
+    ~shared_count_base()
+    {
+    }
 
-    virtual void destroy_self() NESTL_NOEXCEPT_SPEC = 0;
+private:
+    destroyer_type m_destroyer;
+    typename policy_type::counter_type m_use_count;
+    typename policy_type::counter_type m_weak_use_count;
 };
 
 
-template <typename T, typename TypeAllocator>
-class type_stored_by_value : public shared_count_base
+template <typename T, typename TypeAllocator, typename RefCountPolicy>
+class type_stored_by_value : public shared_count_base<RefCountPolicy>
 {
+    typedef shared_count_base<RefCountPolicy> base_type;
 public:
 
-    typedef typename TypeAllocator:: template rebind<type_stored_by_value>::other allocator_type;
+    typedef typename nestl::detail::allocator_rebind<TypeAllocator, type_stored_by_value>::other allocator_type;
 
     type_stored_by_value(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
-        : shared_count_base()
-        , m_value()
-        , m_allocator(alloc)
+        : base_type(&type_stored_by_value::destroy)
+        , m_impl(alloc)
+    {
+    }
+
+    T* get()
+    {
+        return reinterpret_cast<T*>(&m_impl.m_value);
+    }
+
+    template <typename OperationError, typename ... Args>
+    void initialize(OperationError& err, Args&& ... args) NESTL_NOEXCEPT_SPEC
+    {
+        nestl::class_operations::construct(err, get(), std::forward<Args>(args) ...);
+    }
+
+private:
+
+    /// @brief Empty allocator takes no space: it is base of the struct which holds the value
+    struct impl : public allocator_type
+    {
+        impl(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+            : allocator_type(alloc)
+            , m_value()
+        {
+        }
+
+        nestl::aligned_buffer<T> m_value;
+    };
+
+    static void destroy(base_type* base, typename base_type::destroy_operation operation) NESTL_NOEXCEPT_SPEC
+    {
+        type_stored_by_value* self = static_cast<type_stored_by_value*>(base);
+        if (operation == base_type::destroy_value_operation)
+        {
+            T* value = self->get();
+            nestl::detail::destroy(value, value + 1);
+            return;
+        }
+
+        allocator_type alloc(self->m_impl);
+
+        nestl::detail::destroy(self);
+        nestl::allocator_traits<allocator_type>::deallocate(alloc, self, 1);
+    }
+
+    impl m_impl;
+};
+
+
+/**
+ * @brief Control block followed by array of elements in the same allocation
+ *
+ * Memory is allocated in units aligned for both control block and elements,
+ * elements start at the first suitably aligned offset after control block.
+ */
+template <typename T, typename TypeAllocator, typename RefCountPolicy>
+class array_stored_by_value : public shared_count_base<RefCountPolicy>
+{
+    typedef shared_count_base<RefCountPolicy> base_type;
+public:
+
+    static const std::size_t unit_alignment = (alignof(T) > alignof(base_type)) ? alignof(T) : alignof(base_type);
+
+    typedef typename std::aligned_storage<unit_alignment, unit_alignment>::type storage_unit;
+
+    typedef typename nestl::detail::allocator_rebind<TypeAllocator, storage_unit>::other allocator_type;
+
+    array_stored_by_value(const allocator_type& alloc, std::size_t size) NESTL_NOEXCEPT_SPEC
+        : base_type(&array_stored_by_value::destroy)
+        , m_impl(alloc, size)
     {
     }
 
     T* get()
     {
-        return reinterpret_cast<T*>(&m_value);
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(this) + elements_offset());
     }
 
-    virtual void destroy_value() NESTL_NOEXCEPT_SPEC
+    std::size_t size() const NESTL_NOEXCEPT_SPEC
     {
-        T* value = get();
-        nestl::detail::destroy(value, value + 1);
+        return m_impl.m_size;
     }
 
-    virtual void destroy_self() NESTL_NOEXCEPT_SPEC
+    /// @brief Number of storage units for control block and size elements, zero if size is too big
+    static std::size_t units_for(std::size_t size) NESTL_NOEXCEPT_SPEC
     {
-        allocator_type alloc(m_allocator);
+        const std::size_t max_size = static_cast<std::size_t>(-1);
+        if (size > (max_size - elements_offset() - sizeof(storage_unit)) / sizeof(T))
+        {
+            return 0;
+        }
 
-        nestl::detail::destroy(this);
-        alloc.deallocate(this, 1);
+        return (elements_offset() + size * sizeof(T) + sizeof(storage_unit) - 1) / sizeof(storage_unit);
     }
 
+    /**
+     * @brief Constructs each element from args, constructed elements are destroyed on failure
+     */
     template <typename OperationError, typename ... Args>
-    void initialize(OperationError& err, Args&& ... args) NESTL_NOEXCEPT_SPEC
+    void initialize(OperationError& err, const Args& ... args) NESTL_NOEXCEPT_SPEC
     {
-        nestl::class_operations::construct(err, get(), std::forward<Args>(args) ...);
+        T* first = get();
+        T* last = first;
+        nestl::detail::destruction_scoped_guard<T*> guard(first, last);
+
+        for (T* end = first + size(); last != end; ++last)
+        {
+            nestl::class_operations::construct(err, last, args ...);
+            if (err)
+            {
+                return;
+            }
+        }
+
+        guard.release();
     }
 
 private:
-    nestl::aligned_buffer<T> m_value;
-    allocator_type m_allocator;
+
+    /// @brief Empty allocator takes no space: it is base of the struct which holds the size
+    struct impl : public allocator_type
+    {
+        impl(const allocator_type& alloc, std::size_t size) NESTL_NOEXCEPT_SPEC
+            : allocator_type(alloc)
+            , m_size(size)
+        {
+        }
+
+        std::size_t m_size;
+    };
+
+    static std::size_t elements_offset() NESTL_NOEXCEPT_SPEC
+    {
+        return (sizeof(array_stored_by_value) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+
+    static void destroy(base_type* base, typename base_type::destroy_operation operation) NESTL_NOEXCEPT_SPEC
+    {
+        array_stored_by_value* self = static_cast<array_stored_by_value*>(base);
+        if (operation == base_type::destroy_value_operation)
+        {
+            T* first = self->get();
+            nestl::detail::destroy(first, first + self->size());
+            return;
+        }
+
+        allocator_type alloc(self->m_impl);
+        const std::size_t units = units_for(self->size());
+
+        nestl::detail::destroy(self);
+        nestl::allocator_traits<allocator_type>::deallocate(alloc, reinterpret_cast<storage_unit*>(self), units);
+    }
+
+    impl m_impl;
 };
 
 
-template <typename T>
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
 class weak_ptr;
 
-template <typename T>
+struct shared_ptr_access;
+
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
 class shared_ptr
 {
 public:
 
-    typedef T                      element_type;
-    typedef T*                     pointer_type;
+    typedef typename std::remove_extent<T>::type element_type;
+    typedef element_type*          pointer_type;
+    typedef RefCountPolicy         refcount_policy_type;
 
     /// constructors
     shared_ptr() NESTL_NOEXCEPT_SPEC;
@@ -147,8 +300,9 @@ public:
 
     shared_ptr(const shared_ptr& other) NESTL_NOEXCEPT_SPEC;
 
-    template <typename Y>
-    shared_ptr(const shared_ptr<Y>& other) NESTL_NOEXCEPT_SPEC;
+    /// @note Y* should be convertible to T*, so arrays of derived elements are not converted to arrays of base ones
+    template <typename Y, typename = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    shared_ptr(const shared_ptr<Y, RefCountPolicy>& other) NESTL_NOEXCEPT_SPEC;
 
     shared_ptr(shared_ptr&& other) NESTL_NOEXCEPT_SPEC;
 
@@ -158,11 +312,11 @@ public:
     /// assignment operators
     shared_ptr& operator=(const shared_ptr& other) NESTL_NOEXCEPT_SPEC;
 
-    template <typename Y>
-    shared_ptr& operator=(const shared_ptr<Y>& other) NESTL_NOEXCEPT_SPEC;
+    template <typename Y, typename = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    shared_ptr& operator=(const shared_ptr<Y, RefCountPolicy>& other) NESTL_NOEXCEPT_SPEC;
 
-    template <typename Y>
-    shared_ptr& operator=(shared_ptr<Y>&& other) NESTL_NOEXCEPT_SPEC;
+    template <typename Y, typename = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    shared_ptr& operator=(shared_ptr<Y, RefCountPolicy>&& other) NESTL_NOEXCEPT_SPEC;
 
     void reset() NESTL_NOEXCEPT_SPEC;
 
@@ -175,6 +329,13 @@ public:
 
     element_type* operator->() const NESTL_NOEXCEPT_SPEC;
 
+    /// @brief Element of array owned by shared_ptr<T[]>
+    element_type& operator[](std::ptrdiff_t index) const NESTL_NOEXCEPT_SPEC
+    {
+        assert(m_ptr);
+        return m_ptr[index];
+    }
+
     long use_count() const NESTL_NOEXCEPT_SPEC;
 
     bool unique() const NESTL_NOEXCEPT_SPEC;
@@ -185,10 +346,12 @@ public:
     }
 
 private:
+    typedef shared_count_base<RefCountPolicy> shared_count_type;
+
     element_type* m_ptr;
-    shared_count_base* m_refcount;
+    shared_count_type* m_refcount;
 
-    shared_ptr(element_type* ptr, shared_count_base* refcount) NESTL_NOEXCEPT_SPEC
+    shared_ptr(element_type* ptr, shared_count_type* refcount) NESTL_NOEXCEPT_SPEC
         : m_ptr(ptr)
         , m_refcount(refcount)
     {
@@ -198,24 +361,34 @@ private:
         }
     }
 
-    template <typename Type>
+    struct adopt_ref_tag
+    {
+    };
+
+    /// @brief Takes ownership of reference which is already counted
+    shared_ptr(element_type* ptr, shared_count_type* refcount, adopt_ref_tag) NESTL_NOEXCEPT_SPEC
+        : m_ptr(ptr)
+        , m_refcount(refcount)
+    {
+    }
+
+    template <typename Type, typename Policy>
     friend class weak_ptr;
 
-    template <typename Y>
+    template <typename Y, typename Policy>
     friend class shared_ptr;
 
-    template <typename Type, typename OperationError, typename Allocator, typename ... Args>
-    friend
-    shared_ptr<Type> make_shared_a_nothrow(OperationError& err, Allocator& alloc, Args&& ... args);
+    friend struct shared_ptr_access;
 };
 
 
-template <typename T>
+template <typename T, typename RefCountPolicy>
 class weak_ptr
 {
 public:
-    typedef T                      element_type;
-    typedef T*                     pointer_type;
+    typedef typename std::remove_extent<T>::type element_type;
+    typedef element_type*          pointer_type;
+    typedef RefCountPolicy         refcount_policy_type;
 
     weak_ptr() NESTL_NOEXCEPT_SPEC
         : m_ptr(0)
@@ -231,7 +404,7 @@ public:
         other.m_refcount = 0;
     }
 
-    weak_ptr(const shared_ptr<T>& sp) NESTL_NOEXCEPT_SPEC
+    weak_ptr(const shared_ptr<T, RefCountPolicy>& sp) NESTL_NOEXCEPT_SPEC
         : m_ptr(sp.m_ptr)
         , m_refcount(sp.m_refcount)
     {
@@ -271,7 +444,7 @@ public:
         }
     }
 
-    weak_ptr& operator=(const shared_ptr<T>& other) NESTL_NOEXCEPT_SPEC
+    weak_ptr& operator=(const shared_ptr<T, RefCountPolicy>& other) NESTL_NOEXCEPT_SPEC
     {
         if (m_refcount)
         {
@@ -312,6 +485,9 @@ public:
         m_ptr = other.m_ptr;
         m_refcount = other.m_refcount;
 
+        other.m_ptr = 0;
+        other.m_refcount = 0;
+
         return *this;
     }
 
@@ -330,14 +506,27 @@ public:
         return 0;
     }
 
-    shared_ptr<T> lock()
+    /**
+     * @brief Returns owning pointer or empty one if object is destroyed already
+     *
+     * Reference is taken only if use count is not zero, so object which is being
+     * destroyed by other thread is never resurrected.
+     */
+    shared_ptr<T, RefCountPolicy> lock() const NESTL_NOEXCEPT_SPEC
     {
-        return shared_ptr<T>(m_ptr, m_refcount);
+        typedef shared_ptr<T, RefCountPolicy> shared_ptr_type;
+
+        if (m_refcount && m_refcount->add_ref_lock())
+        {
+            return shared_ptr_type(m_ptr, m_refcount, typename shared_ptr_type::adopt_ref_tag());
+        }
+
+        return shared_ptr_type();
     }
 
 private:
     element_type* m_ptr;
-    shared_count_base* m_refcount;
+    shared_count_base<RefCountPolicy>* m_refcount;
 };
 
 
@@ -345,22 +534,22 @@ private:
 
 /// Implementation
 
-template <typename T>
-shared_ptr<T>::shared_ptr() NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+shared_ptr<T, P>::shared_ptr() NESTL_NOEXCEPT_SPEC
     : m_ptr(0)
     , m_refcount(0)
 {
 }
 
-template <typename T>
-shared_ptr<T>::shared_ptr(std::nullptr_t) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+shared_ptr<T, P>::shared_ptr(std::nullptr_t) NESTL_NOEXCEPT_SPEC
     : m_ptr(0)
     , m_refcount(0)
 {
 }
 
-template <typename T>
-shared_ptr<T>::shared_ptr(const shared_ptr& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+shared_ptr<T, P>::shared_ptr(const shared_ptr& other) NESTL_NOEXCEPT_SPEC
     : m_ptr(other.m_ptr)
     , m_refcount(other.m_refcount)
 {
@@ -370,9 +559,9 @@ shared_ptr<T>::shared_ptr(const shared_ptr& other) NESTL_NOEXCEPT_SPEC
     }
 }
 
-template <typename T>
-template <typename Y>
-shared_ptr<T>::shared_ptr(const shared_ptr<Y>& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+template <typename Y, typename>
+shared_ptr<T, P>::shared_ptr(const shared_ptr<Y, P>& other) NESTL_NOEXCEPT_SPEC
     : m_ptr(other.m_ptr)
     , m_refcount(other.m_refcount)
 {
@@ -382,16 +571,16 @@ shared_ptr<T>::shared_ptr(const shared_ptr<Y>& other) NESTL_NOEXCEPT_SPEC
     }
 }
 
-template <typename T>
-shared_ptr<T>::shared_ptr(shared_ptr&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+shared_ptr<T, P>::shared_ptr(shared_ptr&& other) NESTL_NOEXCEPT_SPEC
     : m_ptr(0)
     , m_refcount(0)
 {
     this->swap(other);
 }
 
-template <typename T>
-shared_ptr<T>::~shared_ptr() NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+shared_ptr<T, P>::~shared_ptr() NESTL_NOEXCEPT_SPEC
 {
     if (m_refcount)
     {
@@ -400,8 +589,8 @@ shared_ptr<T>::~shared_ptr() NESTL_NOEXCEPT_SPEC
 }
 
 
-template <typename T>
-shared_ptr<T>& shared_ptr<T>::operator=(const shared_ptr& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+shared_ptr<T, P>& shared_ptr<T, P>::operator=(const shared_ptr& other) NESTL_NOEXCEPT_SPEC
 {
     if (&other != this)
     {
@@ -419,9 +608,9 @@ shared_ptr<T>& shared_ptr<T>::operator=(const shared_ptr& other) NESTL_NOEXCEPT_
     return *this;
 }
 
-template <typename T>
-template <typename Y>
-shared_ptr<T>& shared_ptr<T>::operator=(const shared_ptr<Y>& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+template <typename Y, typename>
+shared_ptr<T, P>& shared_ptr<T, P>::operator=(const shared_ptr<Y, P>& other) NESTL_NOEXCEPT_SPEC
 {
     shared_ptr tmp;
     tmp.swap(*this);
@@ -437,9 +626,9 @@ shared_ptr<T>& shared_ptr<T>::operator=(const shared_ptr<Y>& other) NESTL_NOEXCE
     return *this;
 }
 
-template <typename T>
-template <typename Y>
-shared_ptr<T>& shared_ptr<T>::operator=(shared_ptr<Y>&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+template <typename Y, typename>
+shared_ptr<T, P>& shared_ptr<T, P>::operator=(shared_ptr<Y, P>&& other) NESTL_NOEXCEPT_SPEC
 {
     {
         const shared_ptr tmp(std::move(*this));
@@ -454,59 +643,79 @@ shared_ptr<T>& shared_ptr<T>::operator=(shared_ptr<Y>&& other) NESTL_NOEXCEPT_SP
     return *this;
 }
 
-template <typename T>
-void shared_ptr<T>::reset() NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+void shared_ptr<T, P>::reset() NESTL_NOEXCEPT_SPEC
 {
     shared_ptr tmp;
     tmp.swap(*this);
 }
 
-template <typename T>
-void shared_ptr<T>::swap(shared_ptr& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+void shared_ptr<T, P>::swap(shared_ptr& other) NESTL_NOEXCEPT_SPEC
 {
 	std::swap(m_ptr, other.m_ptr);
 	std::swap(m_refcount, other.m_refcount);
 }
 
-template <typename T>
-typename shared_ptr<T>::element_type* shared_ptr<T>::get() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+typename shared_ptr<T, P>::element_type* shared_ptr<T, P>::get() const NESTL_NOEXCEPT_SPEC
 {
     return m_ptr;
 }
 
-template <typename T>
-typename shared_ptr<T>::element_type& shared_ptr<T>::operator*() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+typename shared_ptr<T, P>::element_type& shared_ptr<T, P>::operator*() const NESTL_NOEXCEPT_SPEC
 {
     assert(m_ptr);
     return *m_ptr;
 }
 
-template <typename T>
-typename shared_ptr<T>::element_type* shared_ptr<T>::operator->() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+typename shared_ptr<T, P>::element_type* shared_ptr<T, P>::operator->() const NESTL_NOEXCEPT_SPEC
 {
     assert(m_ptr);
     return m_ptr;
 }
 
-template <typename T>
-long shared_ptr<T>::use_count() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+long shared_ptr<T, P>::use_count() const NESTL_NOEXCEPT_SPEC
 {
     return m_refcount ? m_refcount->use_count() : 0;
 }
 
-template <typename T>
-bool shared_ptr<T>::unique() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename P>
+bool shared_ptr<T, P>::unique() const NESTL_NOEXCEPT_SPEC
 {
     return (use_count() == 1);
 }
 
-template <typename T, typename OperationError, typename Allocator, typename ... Args>
-shared_ptr<T> make_shared_a_nothrow(OperationError& err, Allocator& /* alloc */, Args&& ... args)
+/**
+ * @brief Gives factory functions access to private constructor of shared_ptr
+ */
+struct shared_ptr_access
+{
+    template <typename T, typename RefCountPolicy>
+    static shared_ptr<T, RefCountPolicy> create(typename shared_ptr<T, RefCountPolicy>::element_type* ptr,
+                                                shared_count_base<RefCountPolicy>* refcount) NESTL_NOEXCEPT_SPEC
+    {
+        return shared_ptr<T, RefCountPolicy>(ptr, refcount);
+    }
+};
+
+/**
+ * @brief Creates object and control block in one allocation made by copy of given allocator
+ *
+ * Allocator is rebound to type of control block and its copy is kept in control block,
+ * so the same allocator state releases memory when the last reference goes away.
+ */
+template <typename T, typename RefCountPolicy, typename OperationError, typename Allocator, typename ... Args>
+typename std::enable_if<!std::is_array<T>::value, shared_ptr<T, RefCountPolicy> >::type
+allocate_shared_nothrow(OperationError& err, const Allocator& alloc, Args&& ... args)
 {
     static_assert(sizeof(T), "T must be complete type");
-    typedef type_stored_by_value<T, Allocator> shared_count_t;
+    typedef type_stored_by_value<T, Allocator, RefCountPolicy> shared_count_t;
     typedef typename shared_count_t::allocator_type SharedCountAllocator;
-    SharedCountAllocator sharedCountAlloc;
+    SharedCountAllocator sharedCountAlloc(alloc);
 
     shared_count_t* ptr = allocator_traits<SharedCountAllocator>::allocate(err, sharedCountAlloc, 1);
     if (err)
@@ -521,21 +730,111 @@ shared_ptr<T> make_shared_a_nothrow(OperationError& err, Allocator& /* alloc */,
         return {nullptr};
     }
 
+    shared_count_t* constructedEnd = ptr + 1;
+    nestl::detail::destruction_scoped_guard<shared_count_t*> destructionGuard(ptr, constructedEnd);
+
     ptr->initialize(err, std::forward<Args>(args) ...);
     if (err)
     {
         return {nullptr};
     }
 
+    destructionGuard.release();
+    deallocationGuard.release();
+    return shared_ptr_access::create<T, RefCountPolicy>(ptr->get(), ptr);
+}
+
+/**
+ * @brief Creates array of size elements and control block in one allocation,
+ * e.g. allocate_shared_nothrow<int[]>(err, alloc, 16)
+ *
+ * Each element is constructed from args. If construction of some element fails,
+ * already constructed elements are destroyed and memory is returned to allocator.
+ */
+template <typename T, typename RefCountPolicy, typename OperationError, typename Allocator, typename ... Args>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, shared_ptr<T, RefCountPolicy> >::type
+allocate_shared_nothrow(OperationError& err, const Allocator& alloc, std::size_t size, const Args& ... args)
+{
+    typedef typename std::remove_extent<T>::type element_type;
+    static_assert(sizeof(element_type), "T must be array of complete type");
+    typedef array_stored_by_value<element_type, Allocator, RefCountPolicy> shared_count_t;
+    typedef typename shared_count_t::storage_unit storage_unit;
+    typedef typename shared_count_t::allocator_type StorageAllocator;
+    static_assert(alignof(shared_count_t) <= alignof(storage_unit), "Storage is not aligned for control block");
+
+    const std::size_t units = shared_count_t::units_for(size);
+    if (units == 0)
+    {
+        build_bad_alloc(err);
+        return {nullptr};
+    }
+
+    StorageAllocator storageAlloc(alloc);
+    storage_unit* storage = allocator_traits<StorageAllocator>::allocate(err, storageAlloc, units);
+    if (err)
+    {
+        return {nullptr};
+    }
+    nestl::detail::deallocation_scoped_guard<storage_unit*, StorageAllocator> deallocationGuard(storageAlloc, storage, units);
+
+    shared_count_t* ptr = reinterpret_cast<shared_count_t*>(storage);
+    nestl::class_operations::construct(err, ptr, storageAlloc, size);
+    if (err)
+    {
+        return {nullptr};
+    }
+
+    shared_count_t* constructedEnd = ptr + 1;
+    nestl::detail::destruction_scoped_guard<shared_count_t*> destructionGuard(ptr, constructedEnd);
+
+    ptr->initialize(err, args ...);
+    if (err)
+    {
+        return {nullptr};
+    }
+
+    destructionGuard.release();
     deallocationGuard.release();
-    return shared_ptr<T>(ptr->get(), ptr);
+    return shared_ptr_access::create<T, RefCountPolicy>(ptr->get(), ptr);
 }
 
+/**
+ * @brief Creates object with default reference counting policy
+ */
+template <typename T, typename OperationError, typename Allocator, typename ... Args>
+shared_ptr<T> allocate_shared_nothrow(OperationError& err, const Allocator& alloc, Args&& ... args)
+{
+    return allocate_shared_nothrow<T, nestl::default_refcount_policy>(err, alloc, std::forward<Args>(args) ...);
+}
+
+/**
+ * @deprecated use allocate_shared_nothrow
+ */
+template <typename T, typename OperationError, typename Allocator, typename ... Args>
+shared_ptr<T> make_shared_a_nothrow(OperationError& err, Allocator& alloc, Args&& ... args)
+{
+    return allocate_shared_nothrow<T>(err, alloc, std::forward<Args>(args) ...);
+}
+
+/**
+ * @brief Creates object, or array for T[]: make_shared_nothrow<int[]>(err, size, args...)
+ */
 template <typename T, typename OperationError, typename ... Args>
 shared_ptr<T> make_shared_nothrow(OperationError& err, Args&& ... args)
 {
-    nestl::allocator<T> alloc;
-	return make_shared_a_nothrow<T>(err, alloc, std::forward<Args>(args) ...);
+    nestl::allocator<typename std::remove_extent<T>::type> alloc;
+	return allocate_shared_nothrow<T>(err, alloc, std::forward<Args>(args) ...);
+}
+
+/**
+ * @brief Creates object with given reference counting policy,
+ * e.g. make_shared_nothrow<T, nestl::single_thread_refcount_policy>(err, args...)
+ */
+template <typename T, typename RefCountPolicy, typename OperationError, typename ... Args>
+shared_ptr<T, RefCountPolicy> make_shared_nothrow(OperationError& err, Args&& ... args)
+{
+    nestl::allocator<typename std::remove_extent<T>::type> alloc;
+    return allocate_shared_nothrow<T, RefCountPolicy>(err, alloc, std::forward<Args>(args) ...);
 }
 
 } // namespace impl
@@ -0,0 +1,31 @@
+#ifndef NESTL_IMPLEMENTATION_SMALL_VECTOR_HPP
+#define NESTL_IMPLEMENTATION_SMALL_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/vector.hpp>
+#include <nestl/implementation/detail/vector_storage.hpp>
+
+#include <cstddef>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Vector which stores up to N elements inline and uses allocator for more elements
+ *
+ * @note value_type should be nothrow relocatable, because inline elements are moved one by one
+ * on move construction, move assignment and swap
+ */
+template <typename T,
+          std::size_t N,
+          typename Allocator = nestl::allocator<T>,
+          typename GrowthPolicy = nestl::default_growth_policy>
+using small_vector = vector<T, Allocator, GrowthPolicy, nestl::impl::detail::vector_inline_storage<T, N, true> >;
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_SMALL_VECTOR_HPP */
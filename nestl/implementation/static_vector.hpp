@@ -0,0 +1,34 @@
+#ifndef NESTL_IMPLEMENTATION_STATIC_VECTOR_HPP
+#define NESTL_IMPLEMENTATION_STATIC_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/vector.hpp>
+#include <nestl/implementation/detail/vector_storage.hpp>
+
+#include <cstddef>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Vector which stores up to N elements inline and never uses allocator
+ *
+ * max_size() is N, so any operation which requires more elements reports length error.
+ * Allocator type is required by vector only formally, it is never called.
+ *
+ * @note value_type should be nothrow relocatable to move or swap static_vector,
+ * because elements are moved one by one
+ */
+template <typename T, std::size_t N>
+using static_vector = vector<T,
+                             nestl::allocator<T>,
+                             nestl::default_growth_policy,
+                             nestl::impl::detail::vector_inline_storage<T, N, false> >;
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_STATIC_VECTOR_HPP */
@@ -4,18 +4,1474 @@
 #include <nestl/config.hpp>
 
 #include <nestl/allocator.hpp>
+#include <nestl/allocator_traits.hpp>
+#include <nestl/class_operations.hpp>
+#include <nestl/growth_policy.hpp>
+#include <nestl/string_view.hpp>
+
+#include <nestl/detail/allocator_traits_helper.hpp>
+#include <nestl/detail/destroy.hpp>
+
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
 
 namespace nestl
 {
 namespace impl
 {
 
-template<typename CharType, typename Traits, typename Alloc>
+/**
+ * @brief String with inline buffer for short content (small string optimization)
+ *
+ * Short strings are kept in buffer which shares space with capacity of heap storage,
+ * so up to inline_capacity characters (15 for char) are stored without allocation.
+ * Content is always terminated by CharType(), so c_str() never allocates.
+ *
+ * @note String may point to its own inline buffer, so it is not trivially relocatable
+ */
+template <typename CharType,
+          typename Traits = std::char_traits<CharType>,
+          typename Allocator = nestl::allocator<CharType> >
 class basic_string
 {
+    basic_string(const basic_string&) = delete;
+    basic_string& operator=(const basic_string&) = delete;
+
+    static const std::size_t local_buffer_size = (16 / sizeof(CharType) > 1) ? 16 / sizeof(CharType) : 2;
+
+public:
+
+    typedef Traits                                                          traits_type;
+    typedef CharType                                                        value_type;
+    typedef Allocator                                                       allocator_type;
+    typedef std::size_t                                                     size_type;
+    typedef std::ptrdiff_t                                                  difference_type;
+    typedef CharType&                                                       reference;
+    typedef const CharType&                                                 const_reference;
+    typedef typename nestl::allocator_traits<allocator_type>::pointer       pointer;
+    typedef typename nestl::allocator_traits<allocator_type>::const_pointer const_pointer;
+
+    typedef pointer                                                         iterator;
+    typedef const_pointer                                                   const_iterator;
+    typedef std::reverse_iterator<iterator>                                 reverse_iterator;
+    typedef std::reverse_iterator<const_iterator>                           const_reverse_iterator;
+
+    typedef nestl::basic_string_view<CharType, Traits>                      string_view_type;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+    /// @brief Number of characters which are stored without allocation
+    static const size_type inline_capacity = local_buffer_size - 1;
+
+// constructors
+    explicit basic_string(const allocator_type& alloc = allocator_type()) NESTL_NOEXCEPT_SPEC;
+
+    basic_string(basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+// destructor
+    ~basic_string() NESTL_NOEXCEPT_SPEC;
+
+// allocator support
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
+
+// assignment operators and functions
+    /**
+     * @note Does not compile for allocators which neither propagate on move assignment
+     * nor are always equal, use move_assign_nothrow for such allocators.
+     */
+    basic_string& operator=(basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void assign_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void assign_nothrow(OperationError& err, const value_type* s, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void assign_nothrow(OperationError& err, const value_type* s) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void assign_nothrow(OperationError& err, size_type count, value_type ch) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void assign_nothrow(OperationError& err, string_view_type str) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename InputIterator>
+    typename std::enable_if<!std::is_integral<InputIterator>::value>::type
+    assign_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+// element access
+    reference operator[](size_type pos) NESTL_NOEXCEPT_SPEC;
+
+    const_reference operator[](size_type pos) const NESTL_NOEXCEPT_SPEC;
+
+    reference front() NESTL_NOEXCEPT_SPEC;
+
+    const_reference front() const NESTL_NOEXCEPT_SPEC;
+
+    reference back() NESTL_NOEXCEPT_SPEC;
+
+    const_reference back() const NESTL_NOEXCEPT_SPEC;
+
+    pointer data() NESTL_NOEXCEPT_SPEC;
+
+    const_pointer data() const NESTL_NOEXCEPT_SPEC;
+
+    const_pointer c_str() const NESTL_NOEXCEPT_SPEC;
+
+    /// @brief View of the whole content, it is valid until string is modified
+    operator string_view_type() const NESTL_NOEXCEPT_SPEC;
+
+// iterators
+    iterator begin() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC;
+
+    iterator end() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rbegin() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crbegin() const NESTL_NOEXCEPT_SPEC;
+
+    reverse_iterator rend() NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator rend() const NESTL_NOEXCEPT_SPEC;
+
+    const_reverse_iterator crend() const NESTL_NOEXCEPT_SPEC;
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC;
+
+    size_type size() const NESTL_NOEXCEPT_SPEC;
+
+    size_type length() const NESTL_NOEXCEPT_SPEC;
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC;
+
+    size_type capacity() const NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC;
+
+// modifiers
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void insert_nothrow(OperationError& err, size_type pos, const value_type* s, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void insert_nothrow(OperationError& err, size_type pos, const value_type* s) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void insert_nothrow(OperationError& err, size_type pos, const basic_string& str) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void insert_nothrow(OperationError& err, size_type pos, string_view_type str) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void insert_nothrow(OperationError& err, size_type pos, size_type count, value_type ch) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator insert_nothrow(OperationError& err, const_iterator pos, value_type ch) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Removes min(count, size() - pos) characters starting at pos
+    void erase(size_type pos = 0, size_type count = npos) NESTL_NOEXCEPT_SPEC;
+
+    iterator erase(const_iterator pos) NESTL_NOEXCEPT_SPEC;
+
+    iterator erase(const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void push_back_nothrow(OperationError& err, value_type ch) NESTL_NOEXCEPT_SPEC;
+
+    void pop_back() NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void append_nothrow(OperationError& err, const value_type* s, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void append_nothrow(OperationError& err, const value_type* s) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void append_nothrow(OperationError& err, const basic_string& str) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void append_nothrow(OperationError& err, string_view_type str) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void append_nothrow(OperationError& err, size_type count, value_type ch) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void resize_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void resize_nothrow(OperationError& err, size_type count, value_type ch) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @note Allocators are swapped only if allocator_type::propagate_on_container_swap is true,
+     * otherwise they should be equal
+     */
+    void swap(basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+// search
+    size_type find(const value_type* s, size_type pos, size_type count) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find(const value_type* s, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find(const basic_string& str, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find(string_view_type str, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find(value_type ch, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type rfind(string_view_type str, size_type pos = npos) const NESTL_NOEXCEPT_SPEC;
+
+    size_type rfind(value_type ch, size_type pos = npos) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find_first_of(string_view_type chars, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find_first_of(value_type ch, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+// operations
+    int compare(const value_type* s, size_type count) const NESTL_NOEXCEPT_SPEC;
+
+    int compare(const value_type* s) const NESTL_NOEXCEPT_SPEC;
+
+    int compare(const basic_string& str) const NESTL_NOEXCEPT_SPEC;
+
+    int compare(string_view_type str) const NESTL_NOEXCEPT_SPEC;
+
+private:
+
+    /// @brief Empty allocator takes no space: it is base of the struct which holds the content
+    struct string_impl : public allocator_type
+    {
+        string_impl(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+            : allocator_type(alloc)
+            , m_data(m_local)
+            , m_size(0)
+        {
+            traits_type::assign(m_local[0], value_type());
+        }
+
+        pointer m_data;
+        size_type m_size;
+
+        /// capacity of heap storage is not required while content is inline
+        union
+        {
+            size_type m_capacity;
+            value_type m_local[local_buffer_size];
+        };
+    };
+
+    string_impl m_impl;
+
+    allocator_type& get_allocator_ref() NESTL_NOEXCEPT_SPEC;
+
+    bool is_local() const NESTL_NOEXCEPT_SPEC;
+
+    void set_length(size_type count) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Storage for count characters and terminator
+    template <typename OperationError>
+    pointer allocate_storage(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    void deallocate_storage() NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Releases current storage and takes ptr which already contains count characters
+    void replace_storage(pointer ptr, size_type new_cap, size_type count) NESTL_NOEXCEPT_SPEC;
+
+    /// @brief Moves content of other into this string, other becomes empty
+    void take_content(basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+    void swap_data(basic_string& other) NESTL_NOEXCEPT_SPEC;
+
+    void move_assign(const std::true_type& /* true_val */, basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+    void move_assign(const std::false_type& /* false_val */, basic_string&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    bool check_length(OperationError& err, size_type count) const NESTL_NOEXCEPT_SPEC;
+
+    size_type recommended_capacity(size_type required) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void do_reserve(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename InputIterator>
+    void assign_iterator(OperationError& err,
+                         std::forward_iterator_tag /* tag */,
+                         InputIterator first,
+                         InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename InputIterator>
+    void assign_iterator(OperationError& err,
+                         std::input_iterator_tag /* tag */,
+                         InputIterator first,
+                         InputIterator last) NESTL_NOEXCEPT_SPEC;
+};
+
+} // namespace impl
+
+template <typename CharType, typename Traits, typename Allocator>
+struct two_phase_initializator<nestl::impl::basic_string<CharType, Traits, Allocator>>
+{
+    typedef nestl::impl::basic_string<CharType, Traits, Allocator> string_t;
+
+    template <typename OperationError>
+    static void init(OperationError& err, string_t& defaultConstructed, const string_t& other) NESTL_NOEXCEPT_SPEC
+    {
+        defaultConstructed.copy_nothrow(err, other);
+    }
+
+    template <typename OperationError>
+    static void init(OperationError& err, string_t& defaultConstructed, const CharType* s) NESTL_NOEXCEPT_SPEC
+    {
+        defaultConstructed.assign_nothrow(err, s);
+    }
 
+    template <typename OperationError>
+    static void init(OperationError& err,
+                     string_t& defaultConstructed,
+                     const CharType* s,
+                     typename string_t::size_type count) NESTL_NOEXCEPT_SPEC
+    {
+        defaultConstructed.assign_nothrow(err, s, count);
+    }
+
+    template <typename OperationError>
+    static void init(OperationError& err,
+                     string_t& defaultConstructed,
+                     typename string_t::string_view_type str) NESTL_NOEXCEPT_SPEC
+    {
+        defaultConstructed.assign_nothrow(err, str);
+    }
+};
+
+/// @brief Strings are hashed as their views, so lookup by view or C string finds them
+template <typename CharType, typename Traits, typename Allocator>
+struct hash<nestl::impl::basic_string<CharType, Traits, Allocator> >
+    : public hash<basic_string_view<CharType, Traits> >
+{
 };
 
+namespace impl
+{
+
+template <typename C, typename T, typename A>
+bool operator==(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.size() == right.size() && left.compare(right) == 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator==(const basic_string<C, T, A>& left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return left.compare(right) == 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator==(const C* left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return right.compare(left) == 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const basic_string<C, T, A>& left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const C* left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator==(const basic_string<C, T, A>& left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return left.size() == right.size() && left.compare(right) == 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator==(basic_string_view<C, T> left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return right == left;
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(const basic_string<C, T, A>& left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator!=(basic_string_view<C, T> left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.compare(right) < 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const basic_string<C, T, A>& left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return left.compare(right) < 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const C* left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return right.compare(left) > 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator<(const basic_string<C, T, A>& left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return left.compare(right) < 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator<(basic_string_view<C, T> left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return right.compare(left) > 0;
+}
+
+template <typename C, typename T, typename A>
+bool operator>(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return right < left;
+}
+
+template <typename C, typename T, typename A>
+bool operator<=(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(right < left);
+}
+
+template <typename C, typename T, typename A>
+bool operator>=(const basic_string<C, T, A>& left, const basic_string<C, T, A>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left < right);
+}
+
+
+
+/// Implementation
+
+template <typename C, typename T, typename A>
+const typename basic_string<C, T, A>::size_type basic_string<C, T, A>::npos;
+
+template <typename C, typename T, typename A>
+const typename basic_string<C, T, A>::size_type basic_string<C, T, A>::inline_capacity;
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(alloc)
+{
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::basic_string(basic_string&& other) NESTL_NOEXCEPT_SPEC
+    : m_impl(other.get_allocator())
+{
+    take_content(other);
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::~basic_string() NESTL_NOEXCEPT_SPEC
+{
+    deallocate_storage();
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::allocator_type
+basic_string<C, T, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>&
+basic_string<C, T, A>::operator=(basic_string&& other) NESTL_NOEXCEPT_SPEC
+{
+    static_assert(nestl::detail::alloc_move_takes_storage<allocator_type>::value,
+                  "move assignment may fail for this allocator, use move_assign_nothrow");
+
+    if (this != &other)
+    {
+        move_assign(typename nestl::allocator_traits<allocator_type>::propagate_on_container_move_assignment(), std::move(other));
+    }
+
+    return *this;
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::move_assign_nothrow(OperationError& err, basic_string&& other) NESTL_NOEXCEPT_SPEC
+{
+    typedef typename nestl::allocator_traits<allocator_type>::propagate_on_container_move_assignment propagate;
+
+    if (this == &other)
+    {
+        return;
+    }
+
+    if (propagate::value || nestl::detail::allocators_equal(get_allocator_ref(), other.get_allocator_ref()))
+    {
+        move_assign(propagate(), std::move(other));
+        return;
+    }
+
+    assign_nothrow(err, other.data(), other.size());
+    if (err)
+    {
+        return;
+    }
+
+    other.clear();
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::copy_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    assign_nothrow(err, other.data(), other.size());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::assign_nothrow(OperationError& err, const basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    assign_nothrow(err, other.data(), other.size());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::assign_nothrow(OperationError& err, const value_type* s, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    if (count <= capacity())
+    {
+        /// s may point into this string
+        traits_type::move(m_impl.m_data, s, count);
+        set_length(count);
+        return;
+    }
+
+    if (!check_length(err, count))
+    {
+        return;
+    }
+
+    const size_type newCapacity = recommended_capacity(count);
+    pointer ptr = allocate_storage(err, newCapacity);
+    if (err)
+    {
+        return;
+    }
+
+    traits_type::copy(ptr, s, count);
+    replace_storage(ptr, newCapacity, count);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::assign_nothrow(OperationError& err, const value_type* s) NESTL_NOEXCEPT_SPEC
+{
+    assign_nothrow(err, s, traits_type::length(s));
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::assign_nothrow(OperationError& err, size_type count, value_type ch) NESTL_NOEXCEPT_SPEC
+{
+    if (count > capacity())
+    {
+        if (!check_length(err, count))
+        {
+            return;
+        }
+
+        const size_type newCapacity = recommended_capacity(count);
+        pointer ptr = allocate_storage(err, newCapacity);
+        if (err)
+        {
+            return;
+        }
+
+        replace_storage(ptr, newCapacity, 0);
+    }
+
+    traits_type::assign(m_impl.m_data, count, ch);
+    set_length(count);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::assign_nothrow(OperationError& err, string_view_type str) NESTL_NOEXCEPT_SPEC
+{
+    assign_nothrow(err, str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError, typename InputIterator>
+typename std::enable_if<!std::is_integral<InputIterator>::value>::type
+basic_string<C, T, A>::assign_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    assign_iterator(err, typename std::iterator_traits<InputIterator>::iterator_category(), first, last);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::reference
+basic_string<C, T, A>::operator[](size_type pos) NESTL_NOEXCEPT_SPEC
+{
+    assert(pos <= size());
+    return m_impl.m_data[pos];
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_reference
+basic_string<C, T, A>::operator[](size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    assert(pos <= size());
+    return m_impl.m_data[pos];
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::reference
+basic_string<C, T, A>::front() NESTL_NOEXCEPT_SPEC
+{
+    assert(!empty());
+    return m_impl.m_data[0];
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_reference
+basic_string<C, T, A>::front() const NESTL_NOEXCEPT_SPEC
+{
+    assert(!empty());
+    return m_impl.m_data[0];
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::reference
+basic_string<C, T, A>::back() NESTL_NOEXCEPT_SPEC
+{
+    assert(!empty());
+    return m_impl.m_data[size() - 1];
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_reference
+basic_string<C, T, A>::back() const NESTL_NOEXCEPT_SPEC
+{
+    assert(!empty());
+    return m_impl.m_data[size() - 1];
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::pointer
+basic_string<C, T, A>::data() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_pointer
+basic_string<C, T, A>::data() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_pointer
+basic_string<C, T, A>::c_str() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data;
+}
+
+template <typename C, typename T, typename A>
+basic_string<C, T, A>::operator string_view_type() const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(m_impl.m_data, m_impl.m_size);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::iterator
+basic_string<C, T, A>::begin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_iterator
+basic_string<C, T, A>::begin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_iterator
+basic_string<C, T, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::iterator
+basic_string<C, T, A>::end() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data + m_impl.m_size;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_iterator
+basic_string<C, T, A>::end() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data + m_impl.m_size;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_iterator
+basic_string<C, T, A>::cend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data + m_impl.m_size;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::reverse_iterator
+basic_string<C, T, A>::rbegin() NESTL_NOEXCEPT_SPEC
+{
+    return reverse_iterator(end());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_reverse_iterator
+basic_string<C, T, A>::rbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_reverse_iterator
+basic_string<C, T, A>::crbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return const_reverse_iterator(cend());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::reverse_iterator
+basic_string<C, T, A>::rend() NESTL_NOEXCEPT_SPEC
+{
+    return reverse_iterator(begin());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_reverse_iterator
+basic_string<C, T, A>::rend() const NESTL_NOEXCEPT_SPEC
+{
+    return const_reverse_iterator(begin());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::const_reverse_iterator
+basic_string<C, T, A>::crend() const NESTL_NOEXCEPT_SPEC
+{
+    return const_reverse_iterator(cbegin());
+}
+
+template <typename C, typename T, typename A>
+bool basic_string<C, T, A>::empty() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_size == 0;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_size;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::length() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_size;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::max_size() const NESTL_NOEXCEPT_SPEC
+{
+    /// one character is reserved for terminator
+    return allocator_traits<allocator_type>::max_size(m_impl) - 1;
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
+{
+    if (new_cap <= capacity())
+    {
+        return;
+    }
+
+    if (!check_length(err, new_cap))
+    {
+        return;
+    }
+
+    do_reserve(err, nestl::default_growth_policy::reserve(get_allocator_ref(), new_cap, max_size()));
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::capacity() const NESTL_NOEXCEPT_SPEC
+{
+    return is_local() ? inline_capacity : m_impl.m_capacity;
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC
+{
+    if (is_local() || capacity() == size())
+    {
+        return;
+    }
+
+    if (size() <= inline_capacity)
+    {
+        /// content goes back to inline buffer, which overlaps with capacity
+        pointer heap = m_impl.m_data;
+        const size_type heapCapacity = m_impl.m_capacity;
+
+        traits_type::copy(m_impl.m_local, heap, size() + 1);
+        m_impl.m_data = m_impl.m_local;
+        allocator_traits<allocator_type>::deallocate(get_allocator_ref(), heap, heapCapacity + 1);
+        return;
+    }
+
+    do_reserve(err, size());
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::clear() NESTL_NOEXCEPT_SPEC
+{
+    set_length(0);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::insert_nothrow(OperationError& err,
+                                      size_type pos,
+                                      const value_type* s,
+                                      size_type count) NESTL_NOEXCEPT_SPEC
+{
+    assert(pos <= size());
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (count > max_size() - size())
+    {
+        build_length_error(err);
+        return;
+    }
+
+    const size_type oldSize = size();
+    const size_type newSize = oldSize + count;
+    pointer data = m_impl.m_data;
+
+    if (newSize > capacity())
+    {
+        /// old storage is alive until new one is filled, so s may point into this string
+        const size_type newCapacity = recommended_capacity(newSize);
+        pointer ptr = allocate_storage(err, newCapacity);
+        if (err)
+        {
+            return;
+        }
+
+        traits_type::copy(ptr, data, pos);
+        traits_type::copy(ptr + pos, s, count);
+        traits_type::copy(ptr + pos + count, data + pos, oldSize - pos);
+        replace_storage(ptr, newCapacity, newSize);
+        return;
+    }
+
+    pointer gap = data + pos;
+    traits_type::move(gap + count, gap, oldSize - pos);
+
+    /// s may point into this string, then part of it after gap was shifted
+    if (s + count <= gap || s > data + oldSize)
+    {
+        traits_type::copy(gap, s, count);
+    }
+    else if (s >= gap)
+    {
+        traits_type::copy(gap, s + count, count);
+    }
+    else
+    {
+        const size_type before = gap - s;
+        traits_type::move(gap, s, before);
+        traits_type::copy(gap + before, gap + count, count - before);
+    }
+
+    set_length(newSize);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::insert_nothrow(OperationError& err, size_type pos, const value_type* s) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, pos, s, traits_type::length(s));
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::insert_nothrow(OperationError& err, size_type pos, const basic_string& str) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, pos, str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::insert_nothrow(OperationError& err, size_type pos, string_view_type str) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, pos, str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::insert_nothrow(OperationError& err,
+                                      size_type pos,
+                                      size_type count,
+                                      value_type ch) NESTL_NOEXCEPT_SPEC
+{
+    assert(pos <= size());
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (count > max_size() - size())
+    {
+        build_length_error(err);
+        return;
+    }
+
+    const size_type oldSize = size();
+    const size_type newSize = oldSize + count;
+    pointer data = m_impl.m_data;
+
+    if (newSize > capacity())
+    {
+        const size_type newCapacity = recommended_capacity(newSize);
+        pointer ptr = allocate_storage(err, newCapacity);
+        if (err)
+        {
+            return;
+        }
+
+        traits_type::copy(ptr, data, pos);
+        traits_type::assign(ptr + pos, count, ch);
+        traits_type::copy(ptr + pos + count, data + pos, oldSize - pos);
+        replace_storage(ptr, newCapacity, newSize);
+        return;
+    }
+
+    traits_type::move(data + pos + count, data + pos, oldSize - pos);
+    traits_type::assign(data + pos, count, ch);
+    set_length(newSize);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+typename basic_string<C, T, A>::iterator
+basic_string<C, T, A>::insert_nothrow(OperationError& err, const_iterator pos, value_type ch) NESTL_NOEXCEPT_SPEC
+{
+    const size_type offset = pos - cbegin();
+
+    insert_nothrow(err, offset, 1, ch);
+    if (err)
+    {
+        return end();
+    }
+
+    return begin() + offset;
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::erase(size_type pos, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    assert(pos <= size());
+
+    const size_type tail = size() - pos;
+    if (count > tail)
+    {
+        count = tail;
+    }
+
+    pointer data = m_impl.m_data;
+    traits_type::move(data + pos, data + pos + count, tail - count);
+    set_length(size() - count);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::iterator
+basic_string<C, T, A>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    const size_type offset = pos - cbegin();
+    erase(offset, 1);
+    return begin() + offset;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::iterator
+basic_string<C, T, A>::erase(const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+{
+    const size_type offset = first - cbegin();
+    erase(offset, last - first);
+    return begin() + offset;
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::push_back_nothrow(OperationError& err, value_type ch) NESTL_NOEXCEPT_SPEC
+{
+    const size_type oldSize = size();
+    if (oldSize < capacity())
+    {
+        traits_type::assign(m_impl.m_data[oldSize], ch);
+        set_length(oldSize + 1);
+        return;
+    }
+
+    insert_nothrow(err, oldSize, 1, ch);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::pop_back() NESTL_NOEXCEPT_SPEC
+{
+    assert(!empty());
+    set_length(size() - 1);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::append_nothrow(OperationError& err, const value_type* s, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, size(), s, count);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::append_nothrow(OperationError& err, const value_type* s) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, size(), s, traits_type::length(s));
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::append_nothrow(OperationError& err, const basic_string& str) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, size(), str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::append_nothrow(OperationError& err, string_view_type str) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, size(), str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::append_nothrow(OperationError& err, size_type count, value_type ch) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, size(), count, ch);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::resize_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    resize_nothrow(err, count, value_type());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::resize_nothrow(OperationError& err, size_type count, value_type ch) NESTL_NOEXCEPT_SPEC
+{
+    if (count <= size())
+    {
+        set_length(count);
+        return;
+    }
+
+    insert_nothrow(err, size(), count - size(), ch);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::swap(basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    nestl::detail::alloc_on_swap(get_allocator_ref(), other.get_allocator_ref());
+    this->swap_data(other);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find(const value_type* s, size_type pos, size_type count) const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(*this).find(s, pos, count);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find(const value_type* s, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return find(s, pos, traits_type::length(s));
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find(const basic_string& str, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return find(str.data(), pos, str.size());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find(string_view_type str, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return find(str.data(), pos, str.size());
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find(value_type ch, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(*this).find(ch, pos);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::rfind(string_view_type str, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(*this).rfind(str, pos);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::rfind(value_type ch, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(*this).rfind(ch, pos);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find_first_of(string_view_type chars, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(*this).find_first_of(chars, pos);
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::find_first_of(value_type ch, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(*this).find_first_of(ch, pos);
+}
+
+template <typename C, typename T, typename A>
+int basic_string<C, T, A>::compare(const value_type* s, size_type count) const NESTL_NOEXCEPT_SPEC
+{
+    return string_view_type(*this).compare(string_view_type(s, count));
+}
+
+template <typename C, typename T, typename A>
+int basic_string<C, T, A>::compare(const value_type* s) const NESTL_NOEXCEPT_SPEC
+{
+    return compare(s, traits_type::length(s));
+}
+
+template <typename C, typename T, typename A>
+int basic_string<C, T, A>::compare(const basic_string& str) const NESTL_NOEXCEPT_SPEC
+{
+    return compare(str.data(), str.size());
+}
+
+template <typename C, typename T, typename A>
+int basic_string<C, T, A>::compare(string_view_type str) const NESTL_NOEXCEPT_SPEC
+{
+    return compare(str.data(), str.size());
+}
+
+/// Private implementation
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::allocator_type&
+basic_string<C, T, A>::get_allocator_ref() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl;
+}
+
+template <typename C, typename T, typename A>
+bool basic_string<C, T, A>::is_local() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_data == m_impl.m_local;
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::set_length(size_type count) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_size = count;
+    traits_type::assign(m_impl.m_data[count], value_type());
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+typename basic_string<C, T, A>::pointer
+basic_string<C, T, A>::allocate_storage(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    return allocator_traits<allocator_type>::allocate(err, get_allocator_ref(), count + 1);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::deallocate_storage() NESTL_NOEXCEPT_SPEC
+{
+    if (!is_local())
+    {
+        allocator_traits<allocator_type>::deallocate(get_allocator_ref(), m_impl.m_data, m_impl.m_capacity + 1);
+    }
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::replace_storage(pointer ptr, size_type new_cap, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    deallocate_storage();
+
+    m_impl.m_data = ptr;
+    m_impl.m_capacity = new_cap;
+    set_length(count);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::take_content(basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    assert(is_local());
+
+    if (other.is_local())
+    {
+        traits_type::copy(m_impl.m_local, other.m_impl.m_local, other.size() + 1);
+    }
+    else
+    {
+        m_impl.m_data = other.m_impl.m_data;
+        m_impl.m_capacity = other.m_impl.m_capacity;
+
+        other.m_impl.m_data = other.m_impl.m_local;
+    }
+
+    m_impl.m_size = other.m_impl.m_size;
+    other.set_length(0);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::swap_data(basic_string& other) NESTL_NOEXCEPT_SPEC
+{
+    if (this == &other)
+    {
+        return;
+    }
+
+    /// inline content can not be swapped by pointers, so it goes through temporary
+    basic_string tmp(get_allocator_ref());
+    tmp.take_content(other);
+    other.take_content(*this);
+    this->take_content(tmp);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::move_assign(const std::true_type& /* true_val */, basic_string&& other) NESTL_NOEXCEPT_SPEC
+{
+    deallocate_storage();
+    m_impl.m_data = m_impl.m_local;
+    set_length(0);
+
+    static_cast<allocator_type&>(m_impl) = other.get_allocator_ref();
+    take_content(other);
+}
+
+template <typename C, typename T, typename A>
+void basic_string<C, T, A>::move_assign(const std::false_type& /* false_val */, basic_string&& other) NESTL_NOEXCEPT_SPEC
+{
+    assert(nestl::detail::allocators_equal(get_allocator_ref(), other.get_allocator_ref()));
+
+    deallocate_storage();
+    m_impl.m_data = m_impl.m_local;
+    set_length(0);
+
+    take_content(other);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+bool basic_string<C, T, A>::check_length(OperationError& err, size_type count) const NESTL_NOEXCEPT_SPEC
+{
+    if (count > max_size())
+    {
+        build_length_error(err);
+        return false;
+    }
+
+    return true;
+}
+
+template <typename C, typename T, typename A>
+typename basic_string<C, T, A>::size_type
+basic_string<C, T, A>::recommended_capacity(size_type required) const NESTL_NOEXCEPT_SPEC
+{
+    assert(required <= max_size());
+
+    const size_type newCapacity = nestl::default_growth_policy::grow(m_impl, capacity(), required, max_size());
+    assert(newCapacity >= required);
+
+    return newCapacity;
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError>
+void
+basic_string<C, T, A>::do_reserve(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
+{
+    pointer ptr = allocate_storage(err, new_cap);
+    if (err)
+    {
+        return;
+    }
+
+    const size_type count = size();
+    traits_type::copy(ptr, m_impl.m_data, count);
+    replace_storage(ptr, new_cap, count);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError, typename InputIterator>
+void
+basic_string<C, T, A>::assign_iterator(OperationError& err,
+                                       std::forward_iterator_tag /* tag */,
+                                       InputIterator first,
+                                       InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    const size_type count = std::distance(first, last);
+    if (count > capacity())
+    {
+        if (!check_length(err, count))
+        {
+            return;
+        }
+
+        const size_type newCapacity = recommended_capacity(count);
+        pointer ptr = allocate_storage(err, newCapacity);
+        if (err)
+        {
+            return;
+        }
+
+        replace_storage(ptr, newCapacity, 0);
+    }
+
+    pointer dest = m_impl.m_data;
+    for (; first != last; ++first, ++dest)
+    {
+        traits_type::assign(*dest, *first);
+    }
+
+    set_length(count);
+}
+
+template <typename C, typename T, typename A>
+template <typename OperationError, typename InputIterator>
+void
+basic_string<C, T, A>::assign_iterator(OperationError& err,
+                                       std::input_iterator_tag /* tag */,
+                                       InputIterator first,
+                                       InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    basic_string tmp(get_allocator_ref());
+    for (; first != last; ++first)
+    {
+        tmp.push_back_nothrow(err, *first);
+        if (err)
+        {
+            return;
+        }
+    }
+
+    this->swap_data(tmp);
+}
+
 } // namespace impl
 } // namespace nestl
 
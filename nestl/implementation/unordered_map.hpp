@@ -0,0 +1,513 @@
+#ifndef NESTL_IMPLEMENTATION_UNORDERED_MAP_HPP
+#define NESTL_IMPLEMENTATION_UNORDERED_MAP_HPP
+
+#include <nestl/config.hpp>
+#include <nestl/functional.hpp>
+
+#include <nestl/implementation/detail/hash_table.hpp>
+#include <nestl/implementation/detail/key_of_value.hpp>
+
+#include <utility>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Map with unique keys stored in open addressing hash table
+ *
+ * Pairs are stored in one flat array without per-element nodes, lookup probes groups
+ * of control bytes by SIMD comparison (see detail/hash_table.hpp).
+ *
+ * @note Members of values are constructed one by one straight in slots (see detail/piecewise.hpp).
+ * Neither key nor mapped type has to be default constructible.
+ *
+ * @note Insertion which grows the table invalidates iterators, erasure invalidates only erased one
+ */
+template <typename Key,
+          typename T,
+          typename Hash = nestl::hash<Key>,
+          typename KeyEqual = nestl::equal_to<Key>,
+          typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+class unordered_map
+{
+    unordered_map(const unordered_map& ) = delete;
+    unordered_map& operator=(const unordered_map& ) = delete;
+public:
+
+    typedef Alloc                                                                   allocator_type;
+    typedef T                                                                       mapped_type;
+
+    typedef detail::select1st<std::pair<const Key, T> >                             key_of_value;
+    typedef detail::hash_table<Key, std::pair<const Key, T>, key_of_value, Hash, KeyEqual, allocator_type> impl_type;
+
+    typedef typename impl_type::key_type                                            key_type;
+    typedef typename impl_type::value_type                                          value_type;
+    typedef typename impl_type::hasher                                              hasher;
+    typedef typename impl_type::key_equal                                           key_equal;
+
+    typedef typename impl_type::size_type                                           size_type;
+    typedef typename impl_type::difference_type                                     difference_type;
+
+    typedef typename impl_type::reference                                           reference;
+    typedef typename impl_type::const_reference                                     const_reference;
+
+    typedef typename impl_type::pointer                                             pointer;
+    typedef typename impl_type::const_pointer                                       const_pointer;
+
+    typedef typename impl_type::iterator                                            iterator;
+    typedef typename impl_type::const_iterator                                      const_iterator;
+
+    typedef std::pair<iterator, bool>                                               iterator_with_flag;
+
+// constructors
+    explicit unordered_map(const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual(),
+                           const Alloc& alloc = Alloc()) NESTL_NOEXCEPT_SPEC;
+
+    explicit unordered_map(const Alloc& alloc) NESTL_NOEXCEPT_SPEC;
+
+    unordered_map(unordered_map&& other) NESTL_NOEXCEPT_SPEC;
+
+// allocator support
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
+
+// observers
+    hasher hash_function() const NESTL_NOEXCEPT_SPEC;
+
+    key_equal key_eq() const NESTL_NOEXCEPT_SPEC;
+
+// assignment operators and functions
+    unordered_map& operator=(unordered_map&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, unordered_map&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const unordered_map& other) NESTL_NOEXCEPT_SPEC;
+
+
+// iterators
+    iterator begin() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC;
+
+    iterator end() NESTL_NOEXCEPT_SPEC;
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC;
+
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC;
+
+    size_type size() const NESTL_NOEXCEPT_SPEC;
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Makes room for count elements, so inserting them does not rehash the map
+     *
+     * Allocation failure is reported by allocator (build_bad_alloc), map is left unchanged then.
+     */
+    template <typename OperationError>
+    void reserve_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC;
+
+// bucket interface
+    /// @brief Number of slots, each slot holds at most one element
+    size_type bucket_count() const NESTL_NOEXCEPT_SPEC;
+
+    float load_factor() const NESTL_NOEXCEPT_SPEC;
+
+
+// modifiers
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts value if its key is not present yet
+     *
+     * If table is full it is grown first. In case of error (allocation failure is reported
+     * by allocator) map is left unchanged.
+     */
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts all elements of range, whose keys are not present yet
+     *
+     * In case of error elements inserted before failure are kept.
+     */
+    template <typename OperationError, typename InputIterator>
+    void insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts value constructed from args if key is not present, otherwise args are left untouched
+     */
+    template <typename OperationError, typename ... Args>
+    iterator_with_flag try_emplace_nothrow(OperationError& err, const key_type& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator_with_flag try_emplace_nothrow(OperationError& err, key_type&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    iterator erase(const_iterator pos) NESTL_NOEXCEPT_SPEC;
+
+    size_type erase(const key_type& key) NESTL_NOEXCEPT_SPEC;
+
+    void swap(unordered_map& other) NESTL_NOEXCEPT_SPEC;
+
+
+// lookup
+
+    iterator find(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    const_iterator find(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    size_type count(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    std::pair<iterator, iterator> equal_range(const Key& key) NESTL_NOEXCEPT_SPEC;
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup by any type which Hash and KeyEqual accept
+     *
+     * Available if both Hash and KeyEqual are transparent (nestl::hash of strings and nestl::equal_to<>
+     * for example), key is never built from argument. Equal arguments should have equal hashes.
+     */
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, iterator>::type
+    find(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, const_iterator>::type
+    find(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, size_type>::type
+    count(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, std::pair<iterator, iterator> >::type
+    equal_range(const K& key) NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+private:
+    impl_type m_impl;
+};
+
+
+// implementation
+
+template <typename K, typename T, typename H, typename E, typename A>
+unordered_map<K, T, H, E, A>::unordered_map(const H& hash, const E& equal, const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(hash, equal, alloc)
+{
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+unordered_map<K, T, H, E, A>::unordered_map(const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(alloc)
+{
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+unordered_map<K, T, H, E, A>::unordered_map(unordered_map&& other) NESTL_NOEXCEPT_SPEC
+    : m_impl(std::move(other.m_impl))
+{
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::allocator_type
+unordered_map<K, T, H, E, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.get_allocator();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::hasher
+unordered_map<K, T, H, E, A>::hash_function() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.hash_function();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::key_equal
+unordered_map<K, T, H, E, A>::key_eq() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.key_eq();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+unordered_map<K, T, H, E, A>&
+unordered_map<K, T, H, E, A>::operator=(unordered_map&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl = std::move(other.m_impl);
+    return *this;
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError>
+void
+unordered_map<K, T, H, E, A>::move_assign_nothrow(OperationError& err, unordered_map&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.move_assign_nothrow(err, std::move(other.m_impl));
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError>
+void
+unordered_map<K, T, H, E, A>::copy_nothrow(OperationError& err, const unordered_map& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.copy_nothrow(err, other.m_impl);
+}
+
+
+// iterators
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::iterator
+unordered_map<K, T, H, E, A>::begin() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::const_iterator
+unordered_map<K, T, H, E, A>::begin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::const_iterator
+unordered_map<K, T, H, E, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::iterator
+unordered_map<K, T, H, E, A>::end() NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::const_iterator
+unordered_map<K, T, H, E, A>::end() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::const_iterator
+unordered_map<K, T, H, E, A>::cend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+
+// capacity
+template <typename K, typename T, typename H, typename E, typename A>
+bool
+unordered_map<K, T, H, E, A>::empty() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.empty();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::size_type
+unordered_map<K, T, H, E, A>::size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.size();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::size_type
+unordered_map<K, T, H, E, A>::max_size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.max_size();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError>
+void
+unordered_map<K, T, H, E, A>::reserve_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.reserve_nothrow(err, count);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::size_type
+unordered_map<K, T, H, E, A>::bucket_count() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.capacity();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+float
+unordered_map<K, T, H, E, A>::load_factor() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.load_factor();
+}
+
+
+// modifiers
+template <typename K, typename T, typename H, typename E, typename A>
+void
+unordered_map<K, T, H, E, A>::clear() NESTL_NOEXCEPT_SPEC
+{
+    m_impl.clear();
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError>
+typename unordered_map<K, T, H, E, A>::iterator_with_flag
+unordered_map<K, T, H, E, A>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, val);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError>
+typename unordered_map<K, T, H, E, A>::iterator_with_flag
+unordered_map<K, T, H, E, A>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, std::move(val));
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError, typename InputIterator>
+void
+unordered_map<K, T, H, E, A>::insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_insert_range_unique(err, first, last);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError, typename ... Args>
+typename unordered_map<K, T, H, E, A>::iterator_with_flag
+unordered_map<K, T, H, E, A>::try_emplace_nothrow(OperationError& err, const key_type& key, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_try_emplace_unique(err, key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename OperationError, typename ... Args>
+typename unordered_map<K, T, H, E, A>::iterator_with_flag
+unordered_map<K, T, H, E, A>::try_emplace_nothrow(OperationError& err, key_type&& key, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_try_emplace_unique(err, std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::iterator
+unordered_map<K, T, H, E, A>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase(pos);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::size_type
+unordered_map<K, T, H, E, A>::erase(const key_type& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_erase(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+void
+unordered_map<K, T, H, E, A>::swap(unordered_map& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.swap(other.m_impl);
+}
+
+
+// lookup
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::iterator
+unordered_map<K, T, H, E, A>::find(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::const_iterator
+unordered_map<K, T, H, E, A>::find(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+typename unordered_map<K, T, H, E, A>::size_type
+unordered_map<K, T, H, E, A>::count(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+std::pair<typename unordered_map<K, T, H, E, A>::iterator, typename unordered_map<K, T, H, E, A>::iterator>
+unordered_map<K, T, H, E, A>::equal_range(const K& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+std::pair<typename unordered_map<K, T, H, E, A>::const_iterator, typename unordered_map<K, T, H, E, A>::const_iterator>
+unordered_map<K, T, H, E, A>::equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename L>
+typename nestl::transparent_hash_lookup<H, E, L, typename unordered_map<K, T, H, E, A>::iterator>::type
+unordered_map<K, T, H, E, A>::find(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename L>
+typename nestl::transparent_hash_lookup<H, E, L, typename unordered_map<K, T, H, E, A>::const_iterator>::type
+unordered_map<K, T, H, E, A>::find(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename L>
+typename nestl::transparent_hash_lookup<H, E, L, typename unordered_map<K, T, H, E, A>::size_type>::type
+unordered_map<K, T, H, E, A>::count(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename L>
+typename nestl::transparent_hash_lookup<H, E, L, std::pair<typename unordered_map<K, T, H, E, A>::iterator, typename unordered_map<K, T, H, E, A>::iterator>>::type
+unordered_map<K, T, H, E, A>::equal_range(const L& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+template <typename L>
+typename nestl::transparent_hash_lookup<H, E, L, std::pair<typename unordered_map<K, T, H, E, A>::const_iterator, typename unordered_map<K, T, H, E, A>::const_iterator>>::type
+unordered_map<K, T, H, E, A>::equal_range(const L& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_UNORDERED_MAP_HPP */
@@ -0,0 +1,426 @@
+#ifndef NESTL_IMPLEMENTATION_UNORDERED_SET_HPP
+#define NESTL_IMPLEMENTATION_UNORDERED_SET_HPP
+
+#include <nestl/config.hpp>
+#include <nestl/functional.hpp>
+
+#include <nestl/implementation/detail/hash_table.hpp>
+#include <nestl/implementation/detail/key_of_value.hpp>
+
+#include <utility>
+
+namespace nestl
+{
+namespace impl
+{
+
+/**
+ * @brief Set of unique keys stored in open addressing hash table
+ *
+ * Elements are stored in one flat array without per-element nodes, lookup probes groups
+ * of control bytes by SIMD comparison (see detail/hash_table.hpp).
+ * Elements can not be modified through iterators, since that would change their hash.
+ *
+ * @note Insertion which grows the table invalidates iterators, erasure invalidates only erased one
+ */
+template <typename Key,
+          typename Hash = nestl::hash<Key>,
+          typename KeyEqual = nestl::equal_to<Key>,
+          typename Alloc = nestl::allocator<Key> >
+class unordered_set
+{
+    unordered_set(const unordered_set& ) = delete;
+    unordered_set& operator=(const unordered_set& ) = delete;
+public:
+
+    typedef Alloc                                                                   allocator_type;
+
+    typedef detail::identity<Key>                                                   key_of_value;
+    typedef detail::hash_table<Key, Key, key_of_value, Hash, KeyEqual, allocator_type> impl_type;
+
+    typedef typename impl_type::key_type                                            key_type;
+    typedef typename impl_type::value_type                                          value_type;
+    typedef typename impl_type::hasher                                              hasher;
+    typedef typename impl_type::key_equal                                           key_equal;
+
+    typedef typename impl_type::size_type                                           size_type;
+    typedef typename impl_type::difference_type                                     difference_type;
+
+    typedef typename impl_type::const_reference                                     reference;
+    typedef typename impl_type::const_reference                                     const_reference;
+
+    typedef typename impl_type::const_pointer                                       pointer;
+    typedef typename impl_type::const_pointer                                       const_pointer;
+
+    typedef typename impl_type::const_iterator                                      iterator;
+    typedef typename impl_type::const_iterator                                      const_iterator;
+
+    typedef std::pair<iterator, bool>                                               iterator_with_flag;
+
+// constructors
+    explicit unordered_set(const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual(),
+                           const Alloc& alloc = Alloc()) NESTL_NOEXCEPT_SPEC;
+
+    explicit unordered_set(const Alloc& alloc) NESTL_NOEXCEPT_SPEC;
+
+    unordered_set(unordered_set&& other) NESTL_NOEXCEPT_SPEC;
+
+// allocator support
+    allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
+
+// observers
+    hasher hash_function() const NESTL_NOEXCEPT_SPEC;
+
+    key_equal key_eq() const NESTL_NOEXCEPT_SPEC;
+
+// assignment operators and functions
+    unordered_set& operator=(unordered_set&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, unordered_set&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void copy_nothrow(OperationError& err, const unordered_set& other) NESTL_NOEXCEPT_SPEC;
+
+
+// iterators
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC;
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC;
+
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC;
+
+    size_type size() const NESTL_NOEXCEPT_SPEC;
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Makes room for count elements, so inserting them does not rehash the set
+     *
+     * Allocation failure is reported by allocator (build_bad_alloc), set is left unchanged then.
+     */
+    template <typename OperationError>
+    void reserve_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC;
+
+// bucket interface
+    /// @brief Number of slots, each slot holds at most one element
+    size_type bucket_count() const NESTL_NOEXCEPT_SPEC;
+
+    float load_factor() const NESTL_NOEXCEPT_SPEC;
+
+
+// modifiers
+    void clear() NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts value if it is not present yet
+     *
+     * If table is full it is grown first. In case of error (allocation failure is reported
+     * by allocator) set is left unchanged.
+     */
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator_with_flag insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Inserts all elements of range, which are not present yet
+     *
+     * In case of error elements inserted before failure are kept.
+     */
+    template <typename OperationError, typename InputIterator>
+    void insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    iterator erase(const_iterator pos) NESTL_NOEXCEPT_SPEC;
+
+    size_type erase(const key_type& key) NESTL_NOEXCEPT_SPEC;
+
+    void swap(unordered_set& other) NESTL_NOEXCEPT_SPEC;
+
+
+// lookup
+
+    const_iterator find(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    size_type count(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const NESTL_NOEXCEPT_SPEC;
+
+    /**
+     * @brief Lookup by any type which Hash and KeyEqual accept
+     *
+     * Available if both Hash and KeyEqual are transparent (nestl::hash of strings and nestl::equal_to<>
+     * for example), key is never built from argument. Equal arguments should have equal hashes.
+     */
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, const_iterator>::type
+    find(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, size_type>::type
+    count(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+    template <typename K>
+    typename nestl::transparent_hash_lookup<Hash, KeyEqual, K, std::pair<const_iterator, const_iterator> >::type
+    equal_range(const K& key) const NESTL_NOEXCEPT_SPEC;
+
+private:
+    impl_type m_impl;
+};
+
+
+// implementation
+
+template <typename T, typename H, typename E, typename A>
+unordered_set<T, H, E, A>::unordered_set(const H& hash, const E& equal, const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(hash, equal, alloc)
+{
+}
+
+template <typename T, typename H, typename E, typename A>
+unordered_set<T, H, E, A>::unordered_set(const A& alloc) NESTL_NOEXCEPT_SPEC
+    : m_impl(alloc)
+{
+}
+
+template <typename T, typename H, typename E, typename A>
+unordered_set<T, H, E, A>::unordered_set(unordered_set&& other) NESTL_NOEXCEPT_SPEC
+    : m_impl(std::move(other.m_impl))
+{
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::allocator_type
+unordered_set<T, H, E, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.get_allocator();
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::hasher
+unordered_set<T, H, E, A>::hash_function() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.hash_function();
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::key_equal
+unordered_set<T, H, E, A>::key_eq() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.key_eq();
+}
+
+template <typename T, typename H, typename E, typename A>
+unordered_set<T, H, E, A>&
+unordered_set<T, H, E, A>::operator=(unordered_set&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl = std::move(other.m_impl);
+    return *this;
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename OperationError>
+void
+unordered_set<T, H, E, A>::move_assign_nothrow(OperationError& err, unordered_set&& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.move_assign_nothrow(err, std::move(other.m_impl));
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename OperationError>
+void
+unordered_set<T, H, E, A>::copy_nothrow(OperationError& err, const unordered_set& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.copy_nothrow(err, other.m_impl);
+}
+
+
+// iterators
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::const_iterator
+unordered_set<T, H, E, A>::begin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::const_iterator
+unordered_set<T, H, E, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.begin();
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::const_iterator
+unordered_set<T, H, E, A>::end() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::const_iterator
+unordered_set<T, H, E, A>::cend() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.end();
+}
+
+
+// capacity
+template <typename T, typename H, typename E, typename A>
+bool
+unordered_set<T, H, E, A>::empty() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.empty();
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::size_type
+unordered_set<T, H, E, A>::size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.size();
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::size_type
+unordered_set<T, H, E, A>::max_size() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.max_size();
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename OperationError>
+void
+unordered_set<T, H, E, A>::reserve_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.reserve_nothrow(err, count);
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::size_type
+unordered_set<T, H, E, A>::bucket_count() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.capacity();
+}
+
+template <typename T, typename H, typename E, typename A>
+float
+unordered_set<T, H, E, A>::load_factor() const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.load_factor();
+}
+
+
+// modifiers
+template <typename T, typename H, typename E, typename A>
+void
+unordered_set<T, H, E, A>::clear() NESTL_NOEXCEPT_SPEC
+{
+    m_impl.clear();
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename OperationError>
+typename unordered_set<T, H, E, A>::iterator_with_flag
+unordered_set<T, H, E, A>::insert_nothrow(OperationError& err, const value_type& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, val);
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename OperationError>
+typename unordered_set<T, H, E, A>::iterator_with_flag
+unordered_set<T, H, E, A>::insert_nothrow(OperationError& err, value_type&& val) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_insert_unique(err, std::move(val));
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename OperationError, typename InputIterator>
+void
+unordered_set<T, H, E, A>::insert_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.m_insert_range_unique(err, first, last);
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::iterator
+unordered_set<T, H, E, A>::erase(const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.erase(pos);
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::size_type
+unordered_set<T, H, E, A>::erase(const key_type& key) NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_erase(key);
+}
+
+template <typename T, typename H, typename E, typename A>
+void
+unordered_set<T, H, E, A>::swap(unordered_set& other) NESTL_NOEXCEPT_SPEC
+{
+    m_impl.swap(other.m_impl);
+}
+
+
+// lookup
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::const_iterator
+unordered_set<T, H, E, A>::find(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename T, typename H, typename E, typename A>
+typename unordered_set<T, H, E, A>::size_type
+unordered_set<T, H, E, A>::count(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename T, typename H, typename E, typename A>
+std::pair<typename unordered_set<T, H, E, A>::const_iterator, typename unordered_set<T, H, E, A>::const_iterator>
+unordered_set<T, H, E, A>::equal_range(const T& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename K>
+typename nestl::transparent_hash_lookup<H, E, K, typename unordered_set<T, H, E, A>::const_iterator>::type
+unordered_set<T, H, E, A>::find(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_find(key);
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename K>
+typename nestl::transparent_hash_lookup<H, E, K, typename unordered_set<T, H, E, A>::size_type>::type
+unordered_set<T, H, E, A>::count(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_count(key);
+}
+
+template <typename T, typename H, typename E, typename A>
+template <typename K>
+typename nestl::transparent_hash_lookup<H, E, K,
+                                        std::pair<typename unordered_set<T, H, E, A>::const_iterator,
+                                                  typename unordered_set<T, H, E, A>::const_iterator> >::type
+unordered_set<T, H, E, A>::equal_range(const K& key) const NESTL_NOEXCEPT_SPEC
+{
+    return m_impl.m_equal_range(key);
+}
+
+} // namespace impl
+} // namespace nestl
+
+#endif /* NESTL_IMPLEMENTATION_UNORDERED_SET_HPP */
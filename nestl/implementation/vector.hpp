@@ -6,12 +6,21 @@
 #include <nestl/allocator.hpp>
 #include <nestl/allocator_traits.hpp>
 #include <nestl/algorithm.hpp>
+#include <nestl/alignment.hpp>
 #include <nestl/class_operations.hpp>
+#include <nestl/growth_policy.hpp>
 
+#include <nestl/detail/allocator_traits_helper.hpp>
 #include <nestl/detail/destroy.hpp>
+#include <nestl/detail/relocate.hpp>
+#include <nestl/detail/repeat_iterator.hpp>
 #include <nestl/detail/uninitialised_copy.hpp>
 
+#include <nestl/implementation/detail/vector_storage.hpp>
+
+
 #include <cassert>
+#include <iterator>
 
 namespace nestl
 {
@@ -20,9 +29,18 @@ namespace impl
 
 /**
  * @brief
+ *
+ * @tparam GrowthPolicy decides how much storage is allocated on growth, see nestl/growth_policy.hpp
+ * @tparam Storage provides optional inline buffer for elements, see nestl/implementation/detail/vector_storage.hpp
+ *
+ * @note Vector with inline storage moves and swaps elements of inline buffer one by one,
+ * so such operations require nothrow relocatable value_type
  */
-template <typename T, typename Allocator = nestl::allocator<T> >
-class vector
+template <typename T,
+          typename Allocator = nestl::allocator<T>,
+          typename GrowthPolicy = nestl::default_growth_policy,
+          typename Storage = nestl::impl::detail::vector_heap_storage<T> >
+class vector : private Storage
 {
     vector(const vector&) = delete;
     vector& operator=(const vector&) = delete;
@@ -31,6 +49,8 @@ public:
 
     typedef T                                                               value_type;
     typedef Allocator                                                       allocator_type;
+    typedef GrowthPolicy                                                    growth_policy_type;
+    typedef Storage                                                         storage_type;
     typedef std::size_t                                                     size_type;
     typedef std::ptrdiff_t                                                  difference_type;
     typedef T&                                                              reference;
@@ -55,8 +75,15 @@ public:
     allocator_type get_allocator() const NESTL_NOEXCEPT_SPEC;
 
 // assignment operators and functions
+    /**
+     * @note Does not compile for allocators which neither propagate on move assignment
+     * nor are always equal, use move_assign_nothrow for such allocators.
+     */
     vector& operator=(vector&& other) NESTL_NOEXCEPT_SPEC;
 
+    template <typename OperationError>
+    void move_assign_nothrow(OperationError& err, vector&& other) NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError>
     void copy_nothrow(OperationError& err, const vector& other) NESTL_NOEXCEPT_SPEC;
 
@@ -165,6 +192,10 @@ public:
     template <typename OperationError>
     void resize_nothrow(OperationError& err, size_type count, const value_type& value) NESTL_NOEXCEPT_SPEC;
 
+    /**
+     * @note Allocators are swapped only if allocator_type::propagate_on_container_swap is true,
+     * otherwise they should be equal
+     */
     void swap(vector& other) NESTL_NOEXCEPT_SPEC;
 
 private:
@@ -174,10 +205,26 @@ private:
     pointer m_finish;
     pointer m_end_of_storage;
 
+    typedef std::integral_constant<bool, (storage_type::inline_capacity != 0)> has_inline_storage;
+    typedef std::integral_constant<bool, storage_type::may_allocate> may_allocate;
+
+    bool is_inline() const NESTL_NOEXCEPT_SPEC;
+
+    void deallocate_storage(pointer ptr, size_type n) NESTL_NOEXCEPT_SPEC;
+
     void swap_data(vector& other) NESTL_NOEXCEPT_SPEC;
 
+    void swap_data(vector& other, std::false_type /* has inline storage */) NESTL_NOEXCEPT_SPEC;
+
+    void swap_data(vector& other, std::true_type /* has inline storage */) NESTL_NOEXCEPT_SPEC;
+
     void move_assign(const std::true_type& /* true_val */, vector&& other) NESTL_NOEXCEPT_SPEC;
 
+    void move_assign(const std::false_type& /* false_val */, vector&& other) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void move_elements(OperationError& err, vector& other) NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError, typename InputIterator>
     void assign_iterator(OperationError& err,
                          std::random_access_iterator_tag /* tag */,
@@ -190,15 +237,160 @@ private:
                          InputIterator first,
                          InputIterator last) NESTL_NOEXCEPT_SPEC;
 
+    template <typename OperationError, typename Integer>
+    void insert_dispatch(OperationError& err,
+                         const_iterator pos,
+                         Integer count,
+                         Integer value,
+                         std::true_type /* is integral */) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename InputIterator>
+    void insert_dispatch(OperationError& err,
+                         const_iterator pos,
+                         InputIterator first,
+                         InputIterator last,
+                         std::false_type /* is integral */) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator erase_range(OperationError& err,
+                         std::true_type /* nothrow relocatable */,
+                         value_type* first,
+                         value_type* last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator erase_range(OperationError& err,
+                         std::false_type /* nothrow relocatable */,
+                         value_type* first,
+                         value_type* last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator erase_range(OperationError& err,
+                         std::false_type /* nothrow relocatable */,
+                         std::true_type /* move assignable */,
+                         value_type* first,
+                         value_type* last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    iterator erase_range(OperationError& err,
+                         std::false_type /* nothrow relocatable */,
+                         std::false_type /* move assignable */,
+                         value_type* first,
+                         value_type* last) NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError, typename ... Args>
     iterator insert_value(OperationError& err, const_iterator pos, Args&& ... args) NESTL_NOEXCEPT_SPEC;
 
     template <typename OperationError, typename InputIterator>
     iterator insert_range(OperationError& err, const_iterator pos, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC;
 
+    template <typename OperationError, typename InputIterator>
+    iterator insert_range(OperationError& err,
+                          std::input_iterator_tag /* tag */,
+                          size_type offset,
+                          InputIterator first,
+                          InputIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ForwardIterator>
+    iterator insert_range(OperationError& err,
+                          std::forward_iterator_tag /* tag */,
+                          size_type offset,
+                          ForwardIterator first,
+                          ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ForwardIterator>
+    iterator insert_range_in_place(OperationError& err,
+                                   std::true_type /* nothrow relocatable */,
+                                   size_type offset,
+                                   size_type count,
+                                   ForwardIterator first,
+                                   ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ForwardIterator>
+    iterator insert_range_in_place(OperationError& err,
+                                   std::false_type /* nothrow relocatable */,
+                                   size_type offset,
+                                   size_type count,
+                                   ForwardIterator first,
+                                   ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ForwardIterator>
+    iterator insert_range_in_place(OperationError& err,
+                                   std::false_type /* nothrow relocatable */,
+                                   std::true_type /* may allocate */,
+                                   size_type offset,
+                                   size_type count,
+                                   ForwardIterator first,
+                                   ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ForwardIterator>
+    iterator insert_range_in_place(OperationError& err,
+                                   std::false_type /* nothrow relocatable */,
+                                   std::false_type /* may allocate */,
+                                   size_type offset,
+                                   size_type count,
+                                   ForwardIterator first,
+                                   ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ForwardIterator>
+    iterator insert_range_realloc(OperationError& err,
+                                  size_type offset,
+                                  size_type count,
+                                  ForwardIterator first,
+                                  ForwardIterator last) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator insert_value_in_place(OperationError& err,
+                                   std::true_type /* nothrow relocatable */,
+                                   size_type offset,
+                                   Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator insert_value_in_place(OperationError& err,
+                                   std::false_type /* nothrow relocatable */,
+                                   size_type offset,
+                                   Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator insert_value_in_place(OperationError& err,
+                                   std::false_type /* nothrow relocatable */,
+                                   std::true_type /* may allocate */,
+                                   size_type offset,
+                                   Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator insert_value_in_place(OperationError& err,
+                                   std::false_type /* nothrow relocatable */,
+                                   std::false_type /* may allocate */,
+                                   size_type offset,
+                                   Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator insert_value_shifted(OperationError& err,
+                                  std::true_type /* move assignable */,
+                                  size_type offset,
+                                  Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator insert_value_shifted(OperationError& err,
+                                  std::false_type /* move assignable */,
+                                  size_type offset,
+                                  Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError, typename ... Args>
+    iterator insert_value_realloc(OperationError& err, size_type offset, Args&& ... args) NESTL_NOEXCEPT_SPEC;
+
+    template <typename OperationError>
+    void relocate_around(OperationError& err,
+                         value_type* ptr,
+                         size_type newCapacity,
+                         size_type offset,
+                         size_type count) NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError, typename ... Args>
     void do_resize(OperationError& err, size_type count, Args&& ... args) NESTL_NOEXCEPT_SPEC;
 
+    size_type recommended_capacity(size_type requiredCapacity) const NESTL_NOEXCEPT_SPEC;
+
     template <typename OperationError>
     void grow(OperationError& err, size_type requiredCapacity) NESTL_NOEXCEPT_SPEC;
 
@@ -208,10 +400,10 @@ private:
 
 } // namespace impl
 
-template <typename T, typename Allocator>
-struct two_phase_initializator<nestl::impl::vector<T, Allocator>>
+template <typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+struct two_phase_initializator<nestl::impl::vector<T, Allocator, GrowthPolicy, Storage>>
 {
-    typedef nestl::impl::vector<T, Allocator> vector_t;
+    typedef nestl::impl::vector<T, Allocator, GrowthPolicy, Storage> vector_t;
 
     template <typename OperationError>
     static void construct(OperationError& err, vector_t& defaultConstructed, const vector_t& other) NESTL_NOEXCEPT_SPEC
@@ -220,12 +412,20 @@ struct two_phase_initializator<nestl::impl::vector<T, Allocator>>
     }
 };
 
+/// @brief vector without inline buffer does not store pointers to itself,
+/// so it may be relocated by copying its bytes when allocator may
+template <typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+struct is_trivially_relocatable<nestl::impl::vector<T, Allocator, GrowthPolicy, Storage>>
+    : public std::integral_constant<bool, is_trivially_relocatable<Allocator>::value && (Storage::inline_capacity == 0)>
+{
+};
+
 namespace impl
 {
 
-template <typename T, typename Allocator>
-bool operator == (const vector<T, Allocator>& left,
-                  const vector<T, Allocator>& right) NESTL_NOEXCEPT_SPEC
+template <typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+bool operator == (const vector<T, Allocator, GrowthPolicy, Storage>& left,
+                  const vector<T, Allocator, GrowthPolicy, Storage>& right) NESTL_NOEXCEPT_SPEC
 {
     if (left.size() != right.size())
     {
@@ -256,62 +456,83 @@ bool operator == (const vector<T, Allocator>& left,
 
 /// Implementation
 
-template <typename T, typename A>
-vector<T, A>::vector(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
-    : m_allocator(alloc)
-    , m_start(0)
-    , m_finish(0)
-    , m_end_of_storage(0)
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::vector(const allocator_type& alloc) NESTL_NOEXCEPT_SPEC
+    : storage_type()
+    , m_allocator(alloc)
+    , m_start(this->inline_data())
+    , m_finish(m_start)
+    , m_end_of_storage(m_start + storage_type::inline_capacity)
 {
 }
 
 
-template <typename T, typename A>
-vector<T, A>::vector(vector&& other) NESTL_NOEXCEPT_SPEC
-	: m_allocator(std::move(other.get_allocator()))
-    , m_start(0)
-    , m_finish(0)
-    , m_end_of_storage(0)
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::vector(vector&& other) NESTL_NOEXCEPT_SPEC
+    : storage_type()
+	, m_allocator(std::move(other.get_allocator()))
+    , m_start(this->inline_data())
+    , m_finish(m_start)
+    , m_end_of_storage(m_start + storage_type::inline_capacity)
 {
     this->swap_data(other);
 }
 
-template <typename T, typename A>
-vector<T, A>::~vector() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>::~vector() NESTL_NOEXCEPT_SPEC
 {
     nestl::detail::destroy(m_start, m_finish);
-    m_allocator.deallocate(m_start, m_end_of_storage - m_start);
+    deallocate_storage(m_start, m_end_of_storage - m_start);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::allocator_type
-vector<T, A>::get_allocator() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::allocator_type
+vector<T, A, G, S>::get_allocator() const NESTL_NOEXCEPT_SPEC
 {
     return m_allocator;
 }
 
-template <typename T, typename A>
-vector<T, A>&
-vector<T, A>::operator=(vector&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+vector<T, A, G, S>&
+vector<T, A, G, S>::operator=(vector&& other) NESTL_NOEXCEPT_SPEC
 {
+    static_assert(nestl::detail::alloc_move_takes_storage<allocator_type>::value,
+                  "move assignment may fail for this allocator, use move_assign_nothrow");
+
 	move_assign(typename nestl::allocator_traits<allocator_type>::propagate_on_container_move_assignment(), std::move(other));
     return *this;
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::copy_nothrow(OperationError& err, const vector& other) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::move_assign_nothrow(OperationError& err, vector&& other) NESTL_NOEXCEPT_SPEC
+{
+    typedef typename nestl::allocator_traits<allocator_type>::propagate_on_container_move_assignment propagate;
+
+    if (propagate::value || nestl::detail::allocators_equal(m_allocator, other.m_allocator))
+    {
+        move_assign(propagate(), std::move(other));
+        return;
+    }
+
+    move_elements(err, other);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+void
+vector<T, A, G, S>::copy_nothrow(OperationError& err, const vector& other) NESTL_NOEXCEPT_SPEC
 {
     this->assign_nothrow(err, other.cbegin(), other.cend());
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::assign_nothrow(OperationError& err, size_type n, const_reference val) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::assign_nothrow(OperationError& err, size_type n, const_reference val) NESTL_NOEXCEPT_SPEC
 {
-    vector tmp; tmp.swap(*this);
+    vector tmp(m_allocator); tmp.swap(*this);
 
     assert(empty());
 
@@ -332,188 +553,193 @@ vector<T, A>::assign_nothrow(OperationError& err, size_type n, const_reference v
     }
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError, typename InputIterator>
 void
-vector<T, A>::assign_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::assign_nothrow(OperationError& err, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
 {
-    vector tmp; tmp.swap(*this);
+    vector tmp(m_allocator); tmp.swap(*this);
 
     assign_iterator(err, typename std::iterator_traits<InputIterator>::iterator_category(), first, last);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::reference
-vector<T, A>::operator[](typename vector<T, A>::size_type pos) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::reference
+vector<T, A, G, S>::operator[](typename vector<T, A, G, S>::size_type pos) NESTL_NOEXCEPT_SPEC
 {
     assert(pos < size());
     return m_start[pos];
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_reference
-vector<T, A>::operator[](typename vector<T, A>::size_type pos) const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_reference
+vector<T, A, G, S>::operator[](typename vector<T, A, G, S>::size_type pos) const NESTL_NOEXCEPT_SPEC
 {
     assert(pos < size());
     return m_start[pos];
 }
 
-template <typename T, typename A>
-typename vector<T, A>::reference
-vector<T, A>::front() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::reference
+vector<T, A, G, S>::front() NESTL_NOEXCEPT_SPEC
 {
     assert(!empty());
     return *begin();
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_reference
-vector<T, A>::front() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_reference
+vector<T, A, G, S>::front() const NESTL_NOEXCEPT_SPEC
 {
     assert(!empty());
     return *begin();
 }
 
-template <typename T, typename A>
-typename vector<T, A>::reference
-vector<T, A>::back() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::reference
+vector<T, A, G, S>::back() NESTL_NOEXCEPT_SPEC
 {
     assert(!empty());
     return *rbegin();
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_reference
-vector<T, A>::back() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_reference
+vector<T, A, G, S>::back() const NESTL_NOEXCEPT_SPEC
 {
     assert(!empty());
     return *rbegin();
 }
 
-template <typename T, typename A>
-typename vector<T, A>::pointer
-vector<T, A>::data() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::pointer
+vector<T, A, G, S>::data() NESTL_NOEXCEPT_SPEC
 {
     assert(!empty());
     return m_start;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_pointer
-vector<T, A>::data() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_pointer
+vector<T, A, G, S>::data() const NESTL_NOEXCEPT_SPEC
 {
     assert(!empty());
     return m_start;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::iterator
-vector<T, A>::begin() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::begin() NESTL_NOEXCEPT_SPEC
 {
     return m_start;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_iterator
-vector<T, A>::begin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_iterator
+vector<T, A, G, S>::begin() const NESTL_NOEXCEPT_SPEC
 {
     return m_start;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_iterator
-vector<T, A>::cbegin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_iterator
+vector<T, A, G, S>::cbegin() const NESTL_NOEXCEPT_SPEC
 {
     return m_start;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::iterator
-vector<T, A>::end() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::end() NESTL_NOEXCEPT_SPEC
 {
     return m_finish;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_iterator
-vector<T, A>::end() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_iterator
+vector<T, A, G, S>::end() const NESTL_NOEXCEPT_SPEC
 {
     return m_finish;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_iterator
-vector<T, A>::cend() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_iterator
+vector<T, A, G, S>::cend() const NESTL_NOEXCEPT_SPEC
 {
     return m_finish;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::reverse_iterator
-vector<T, A>::rbegin() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::reverse_iterator
+vector<T, A, G, S>::rbegin() NESTL_NOEXCEPT_SPEC
 {
     return reverse_iterator(m_finish);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_reverse_iterator
-vector<T, A>::rbegin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_reverse_iterator
+vector<T, A, G, S>::rbegin() const NESTL_NOEXCEPT_SPEC
 {
     return const_reverse_iterator(m_finish);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_reverse_iterator
-vector<T, A>::crbegin() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_reverse_iterator
+vector<T, A, G, S>::crbegin() const NESTL_NOEXCEPT_SPEC
 {
     return const_reverse_iterator(m_finish);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::reverse_iterator
-vector<T, A>::rend() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::reverse_iterator
+vector<T, A, G, S>::rend() NESTL_NOEXCEPT_SPEC
 {
     return reverse_iterator(m_start);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_reverse_iterator
-vector<T, A>::rend() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_reverse_iterator
+vector<T, A, G, S>::rend() const NESTL_NOEXCEPT_SPEC
 {
     return const_reverse_iterator(m_start);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::const_reverse_iterator
-vector<T, A>::crend() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::const_reverse_iterator
+vector<T, A, G, S>::crend() const NESTL_NOEXCEPT_SPEC
 {
     return const_reverse_iterator(m_start);
 }
 
-template <typename T, typename A>
-bool vector<T, A>::empty() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+bool vector<T, A, G, S>::empty() const NESTL_NOEXCEPT_SPEC
 {
     return m_start == m_finish;
 }
 
-template <typename T, typename A>
-typename vector<T, A>::size_type
-vector<T, A>::size() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::size_type
+vector<T, A, G, S>::size() const NESTL_NOEXCEPT_SPEC
 {
     return std::distance(m_start, m_finish);
 }
 
-template <typename T, typename A>
-typename vector<T, A>::size_type
-vector<T, A>::max_size() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::size_type
+vector<T, A, G, S>::max_size() const NESTL_NOEXCEPT_SPEC
 {
-    return std::numeric_limits<size_type>::max();
+    if (!storage_type::may_allocate)
+    {
+        return storage_type::inline_capacity;
+    }
+
+    return allocator_traits<allocator_type>::max_size(m_allocator);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
 {
     if (new_cap <= capacity())
     {
@@ -528,133 +754,308 @@ vector<T, A>::reserve_nothrow(OperationError& err, size_type new_cap) NESTL_NOEX
         }
     }
 
-    do_reserve(err, new_cap);
+    do_reserve(err, growth_policy_type::reserve(m_allocator, new_cap, max_size()));
 }
 
-template <typename T, typename A>
-typename vector<T, A>::size_type
-vector<T, A>::capacity() const NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::size_type
+vector<T, A, G, S>::capacity() const NESTL_NOEXCEPT_SPEC
 {
     return std::distance(m_start, m_end_of_storage);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::shrink_to_fit_nothrow(OperationError& err) NESTL_NOEXCEPT_SPEC
 {
-    if (capacity() > size())
+    if (!is_inline() && capacity() > size())
     {
         do_reserve(err, size());
     }
 }
 
 
-template <typename T, typename A>
-void vector<T, A>::clear() NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::clear() NESTL_NOEXCEPT_SPEC
 {
-    nestl::detail::destroy(m_allocator, m_start, m_finish);
+    nestl::detail::destroy(m_start, m_finish);
     m_finish = m_start;
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
-typename vector<T, A>::iterator
-vector<T, A>::insert_nothrow(OperationError& err, const_iterator pos, const value_type& value) NESTL_NOEXCEPT_SPEC
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_nothrow(OperationError& err, const_iterator pos, const value_type& value) NESTL_NOEXCEPT_SPEC
 {
     return insert_value(err, pos, value);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
-typename vector<T, A>::iterator
-vector<T, A>::insert_nothrow(OperationError& err, const_iterator pos, value_type&& value) NESTL_NOEXCEPT_SPEC
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_nothrow(OperationError& err, const_iterator pos, value_type&& value) NESTL_NOEXCEPT_SPEC
 {
 	return insert_value(err, pos, std::move(value));
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template<typename OperationError, typename InputIterator>
 void
-vector<T, A>::insert_nothrow(OperationError& err,
+vector<T, A, G, S>::insert_nothrow(OperationError& err,
                              const_iterator pos,
                              InputIterator first,
                              InputIterator last) NESTL_NOEXCEPT_SPEC
 {
-    insert_range(err, pos, first, last);
+    insert_dispatch(err, pos, first, last, std::is_integral<InputIterator>());
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+void
+vector<T, A, G, S>::insert_nothrow(OperationError& err,
+                             const_iterator pos,
+                             size_type count,
+                             const value_type& value) NESTL_NOEXCEPT_SPEC
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    /// value may refer to element of this vector, which is moved by insertion, so it is copied aside first
+    nestl::aligned_buffer<value_type> tmp;
+    nestl::class_operations::construct(err, tmp.ptr(), value);
+    if (err)
+    {
+        return;
+    }
+    value_type* tmpEnd = tmp.ptr() + 1;
+    nestl::detail::destruction_scoped_guard<value_type*> tmpGuard(tmp.ptr(), tmpEnd);
+
+    const value_type& copy = *tmp.ptr();
+    insert_range(err,
+                 pos,
+                 nestl::detail::repeat_iterator<value_type>(copy, 0),
+                 nestl::detail::repeat_iterator<value_type>(copy, count));
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::erase_nothrow(OperationError& err, const_iterator pos) NESTL_NOEXCEPT_SPEC
+{
+    assert(pos != m_finish);
+
+    return erase_nothrow(err, pos, pos + 1);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::erase_nothrow(OperationError& err, const_iterator first, const_iterator last) NESTL_NOEXCEPT_SPEC
+{
+    assert(first >= m_start);
+    assert(first <= last);
+    assert(last <= m_finish);
+
+    value_type* from = m_start + (first - m_start);
+    value_type* to = m_start + (last - m_start);
+    if (from == to)
+    {
+        return from;
+    }
+
+    return erase_range(err, nestl::detail::is_nothrow_relocatable<value_type>(), from, to);
 }
 
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::push_back_nothrow(OperationError& err, const value_type& value) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::push_back_nothrow(OperationError& err, const value_type& value) NESTL_NOEXCEPT_SPEC
 {
     insert_nothrow(err, cend(), value);
 }
 
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::push_back_nothrow(OperationError& err, value_type&& value) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::push_back_nothrow(OperationError& err, value_type&& value) NESTL_NOEXCEPT_SPEC
 {
 	insert_nothrow(err, cend(), std::move(value));
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
+template<typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::emplace_nothrow(OperationError& err, const_iterator pos, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return insert_value(err, pos, std::forward<Args>(args) ...);
+}
+
+template <typename T, typename A, typename G, typename S>
 template<typename OperationError, typename ... Args>
 void
-vector<T, A>::emplace_back_nothrow(OperationError& err, Args&& ... args) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::emplace_back_nothrow(OperationError& err, Args&& ... args) NESTL_NOEXCEPT_SPEC
 {
 	insert_value(err, cend(), std::forward<Args>(args) ...);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::pop_back() NESTL_NOEXCEPT_SPEC
+{
+    assert(!empty());
+
+    --m_finish;
+    nestl::detail::destroy(m_finish);
+}
+
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::resize_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::resize_nothrow(OperationError& err, size_type count) NESTL_NOEXCEPT_SPEC
 {
     do_resize(err, count);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::resize_nothrow(OperationError& err, size_type count, const value_type& value) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::resize_nothrow(OperationError& err, size_type count, const value_type& value) NESTL_NOEXCEPT_SPEC
 {
     do_resize(err, count, value);
 }
 
-template <typename T, typename A>
-void vector<T, A>::swap(vector& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::swap(vector& other) NESTL_NOEXCEPT_SPEC
 {
-	std::swap(m_allocator, other.m_allocator);
+    nestl::detail::alloc_on_swap(m_allocator, other.m_allocator);
     this->swap_data(other);
 }
 
 /// Private implementation
 
-template <typename T, typename A>
-void vector<T, A>::swap_data(vector& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+bool vector<T, A, G, S>::is_inline() const NESTL_NOEXCEPT_SPEC
+{
+    return has_inline_storage::value && (m_start == const_cast<vector*>(this)->inline_data());
+}
+
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::deallocate_storage(pointer ptr, size_type n) NESTL_NOEXCEPT_SPEC
+{
+    if (ptr && (ptr != this->inline_data()))
+    {
+        allocator_traits<allocator_type>::deallocate(m_allocator, ptr, n);
+    }
+}
+
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::swap_data(vector& other) NESTL_NOEXCEPT_SPEC
+{
+    swap_data(other, has_inline_storage());
+}
+
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::swap_data(vector& other, std::false_type /* has inline storage */) NESTL_NOEXCEPT_SPEC
 {
 	std::swap(this->m_start, other.m_start);
 	std::swap(this->m_finish, other.m_finish);
 	std::swap(this->m_end_of_storage, other.m_end_of_storage);
 }
 
-template <typename T, typename A>
-void vector<T, A>::move_assign(const std::true_type& /* true_val */, vector&& other) NESTL_NOEXCEPT_SPEC
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::swap_data(vector& other, std::true_type /* has inline storage */) NESTL_NOEXCEPT_SPEC
+{
+    if (!this->is_inline() && !other.is_inline())
+    {
+        swap_data(other, std::false_type());
+        return;
+    }
+
+    if (!this->is_inline())
+    {
+        other.swap_data(*this, std::true_type());
+        return;
+    }
+
+    const size_type thisSize = this->size();
+    const size_type otherSize = other.size();
+
+    if (!other.is_inline())
+    {
+        /// our elements go to inline buffer of other, we take its allocated storage
+        value_type* otherInline = other.inline_data();
+        nestl::detail::relocate_overlapping(m_start, m_finish, otherInline);
+
+        m_start = other.m_start;
+        m_finish = other.m_finish;
+        m_end_of_storage = other.m_end_of_storage;
+
+        other.m_start = otherInline;
+        other.m_finish = otherInline + thisSize;
+        other.m_end_of_storage = otherInline + storage_type::inline_capacity;
+        return;
+    }
+
+    /// both vectors use inline buffers, swap elements one by one
+    const size_type common = (thisSize < otherSize) ? thisSize : otherSize;
+    for (size_type i = 0; i != common; ++i)
+    {
+        nestl::aligned_buffer<value_type> tmp;
+        nestl::detail::relocate_overlapping(m_start + i, m_start + i + 1, tmp.ptr());
+        nestl::detail::relocate_overlapping(other.m_start + i, other.m_start + i + 1, m_start + i);
+        nestl::detail::relocate_overlapping(tmp.ptr(), tmp.ptr() + 1, other.m_start + i);
+    }
+
+    nestl::detail::relocate_overlapping(m_start + common, m_finish, other.m_start + common);
+    nestl::detail::relocate_overlapping(other.m_start + common, other.m_finish, m_start + common);
+
+    m_finish = m_start + otherSize;
+    other.m_finish = other.m_start + thisSize;
+}
+
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::move_assign(const std::true_type& /* true_val */, vector&& other) NESTL_NOEXCEPT_SPEC
 {
 	const vector destroyContentAtExit(std::move(*this));
 
+    m_allocator = other.m_allocator;
     this->swap_data(other);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
+void vector<T, A, G, S>::move_assign(const std::false_type& /* false_val */, vector&& other) NESTL_NOEXCEPT_SPEC
+{
+    assert(nestl::detail::allocators_equal(m_allocator, other.m_allocator));
+
+    const vector destroyContentAtExit(std::move(*this));
+
+    this->swap_data(other);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+void vector<T, A, G, S>::move_elements(OperationError& err, vector& other) NESTL_NOEXCEPT_SPEC
+{
+    /// memory of other can not be taken, so elements are moved into storage of our allocator
+    vector tmp(m_allocator);
+    tmp.assign_nothrow(err, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    if (err)
+    {
+        return;
+    }
+
+    this->swap_data(tmp);
+    other.clear();
+}
+
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError, typename InputIterator>
 void
-vector<T, A>::assign_iterator(OperationError& err,
+vector<T, A, G, S>::assign_iterator(OperationError& err,
                               std::random_access_iterator_tag /* tag */,
                               InputIterator first,
                               InputIterator last) NESTL_NOEXCEPT_SPEC
@@ -671,10 +1072,10 @@ vector<T, A>::assign_iterator(OperationError& err,
     assign_iterator(err, std::input_iterator_tag(), first, last);
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError, typename InputIterator>
 void
-vector<T, A>::assign_iterator(OperationError& err,
+vector<T, A, G, S>::assign_iterator(OperationError& err,
                               std::input_iterator_tag /* tag */,
                               InputIterator first,
                               InputIterator last) NESTL_NOEXCEPT_SPEC
@@ -693,80 +1094,615 @@ vector<T, A>::assign_iterator(OperationError& err,
     }
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename Integer>
+void
+vector<T, A, G, S>::insert_dispatch(OperationError& err,
+                              const_iterator pos,
+                              Integer count,
+                              Integer value,
+                              std::true_type /* is integral */) NESTL_NOEXCEPT_SPEC
+{
+    insert_nothrow(err, pos, static_cast<size_type>(count), static_cast<value_type>(value));
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename InputIterator>
+void
+vector<T, A, G, S>::insert_dispatch(OperationError& err,
+                              const_iterator pos,
+                              InputIterator first,
+                              InputIterator last,
+                              std::false_type /* is integral */) NESTL_NOEXCEPT_SPEC
+{
+    insert_range(err, pos, first, last);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::erase_range(OperationError& /* err */,
+                          std::true_type /* nothrow relocatable */,
+                          value_type* first,
+                          value_type* last) NESTL_NOEXCEPT_SPEC
+{
+    /// tail is shifted once and never fails
+    nestl::detail::destroy(first, last);
+    nestl::detail::relocate_overlapping(last, m_finish, first);
+
+    m_finish -= (last - first);
+    return first;
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::erase_range(OperationError& err,
+                          std::false_type /* nothrow relocatable */,
+                          value_type* first,
+                          value_type* last) NESTL_NOEXCEPT_SPEC
+{
+    typedef nestl::class_operations::is_assignable<value_type, value_type&&> move_assignable;
+    return erase_range(err, std::false_type(), move_assignable(), first, last);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::erase_range(OperationError& err,
+                          std::false_type /* nothrow relocatable */,
+                          std::true_type /* move assignable */,
+                          value_type* first,
+                          value_type* last) NESTL_NOEXCEPT_SPEC
+{
+    /// Tail is shifted by move assignment, as std::vector does, vacated end is destroyed afterwards.
+    /// @note Only basic guarantee is provided: if assignment fails in the middle,
+    /// all elements stay in vector, but some of them may be moved from
+    value_type* dst = first;
+    for (value_type* src = last; src != m_finish; ++src, ++dst)
+    {
+        nestl::class_operations::assign(err, *dst, std::move(*src));
+        if (err)
+        {
+            return end();
+        }
+    }
+
+    nestl::detail::destroy(dst, m_finish);
+    m_finish = dst;
+    return first;
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::erase_range(OperationError& err,
+                          std::false_type /* nothrow relocatable */,
+                          std::false_type /* move assignable */,
+                          value_type* first,
+                          value_type* last) NESTL_NOEXCEPT_SPEC
+{
+    /// Tail is shifted by copying, element by element.
+    /// @note Only basic guarantee is provided: if copying fails in the middle,
+    /// elements which are not shifted yet are removed from vector
+    nestl::detail::destroy(first, last);
+
+    value_type* dst = first;
+    for (value_type* src = last; src != m_finish; ++src, ++dst)
+    {
+        const value_type& value = *src;
+        nestl::class_operations::construct(err, dst, value);
+        if (err)
+        {
+            nestl::detail::destroy(src, m_finish);
+            m_finish = dst;
+            return end();
+        }
+
+        nestl::detail::destroy(src);
+    }
+
+    m_finish = dst;
+    return first;
+}
+
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError, typename ... Args>
-typename vector<T, A>::iterator
-vector<T, A>::insert_value(OperationError& err, const_iterator pos, Args&& ... args) NESTL_NOEXCEPT_SPEC
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value(OperationError& err, const_iterator pos, Args&& ... args) NESTL_NOEXCEPT_SPEC
 {
     assert(pos >= m_start);
     assert(pos <= m_finish);
 
     /// we should calculate offset before possible reallocation
-    size_t offset = pos - m_start;
+    size_type offset = pos - m_start;
 
     if (capacity() == size())
     {
-        grow(err, capacity() + 1);
+        if (size() == max_size())
+        {
+            build_length_error(err);
+            return end();
+        }
+
+        return insert_value_realloc(err, offset, std::forward<Args>(args) ...);
+    }
+
+    if (m_start + offset == m_finish)
+    {
+        nestl::class_operations::construct(err, m_finish, std::forward<Args>(args) ...);
         if (err)
         {
             return end();
         }
+
+        return m_finish++;
     }
-    assert(capacity() > size());
 
-    value_type* last = m_finish;
-    value_type* first = m_start + offset;
-    for (value_type* val = last; val != first; --val)
+    return insert_value_in_place(err,
+                                 nestl::detail::is_nothrow_relocatable<value_type>(),
+                                 offset,
+                                 std::forward<Args>(args) ...);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value_in_place(OperationError& err,
+                                    std::true_type /* nothrow relocatable */,
+                                    size_type offset,
+                                    Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    /// new value is constructed aside first, as args may refer to elements of this vector.
+    /// Everything after that never fails
+    nestl::aligned_buffer<value_type> tmp;
+    nestl::class_operations::construct(err, tmp.ptr(), std::forward<Args>(args) ...);
+    if (err)
     {
-        value_type* oldLocation = val - 1;
-        nestl::class_operations::construct(err, val, *oldLocation);
+        return end();
+    }
+
+    value_type* gap = m_start + offset;
+    nestl::detail::relocate_overlapping(gap, m_finish, gap + 1);
+    nestl::detail::relocate(err, tmp.ptr(), tmp.ptr() + 1, gap);
+    assert(!err);
+
+    ++m_finish;
+    return gap;
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value_in_place(OperationError& err,
+                                    std::false_type /* nothrow relocatable */,
+                                    size_type offset,
+                                    Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    return insert_value_in_place(err, std::false_type(), may_allocate(), offset, std::forward<Args>(args) ...);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value_in_place(OperationError& err,
+                                    std::false_type /* nothrow relocatable */,
+                                    std::true_type /* may allocate */,
+                                    size_type offset,
+                                    Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    /// tail can not be shifted without possible failure in the middle,
+    /// copy everything to new storage instead
+    return insert_value_realloc(err, offset, std::forward<Args>(args) ...);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value_in_place(OperationError& err,
+                                    std::false_type /* nothrow relocatable */,
+                                    std::false_type /* may allocate */,
+                                    size_type offset,
+                                    Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    typedef nestl::class_operations::is_assignable<value_type, value_type&&> move_assignable;
+    return insert_value_shifted(err, move_assignable(), offset, std::forward<Args>(args) ...);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value_shifted(OperationError& err,
+                                   std::true_type /* move assignable */,
+                                   size_type offset,
+                                   Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    /// tail should not be empty, elements at the end are constructed without shifting
+    assert(m_start + offset < m_finish);
+
+    /// new value is constructed aside first, as args may refer to elements of this vector
+    nestl::aligned_buffer<value_type> tmp;
+    nestl::class_operations::construct(err, tmp.ptr(), std::forward<Args>(args) ...);
+    if (err)
+    {
+        return end();
+    }
+    value_type* tmpEnd = tmp.ptr() + 1;
+    nestl::detail::destruction_scoped_guard<value_type*> tmpGuard(tmp.ptr(), tmpEnd);
+
+    /// There is no other storage, so tail is shifted in place as std::vector does:
+    /// new last element is copied from the old one, the rest is move assigned backwards.
+    /// @note Only basic guarantee is provided: if assignment fails in the middle,
+    /// all elements stay in vector, but some of them may be moved from
+    const value_type& last = *(m_finish - 1);
+    nestl::class_operations::construct(err, m_finish, last);
+    if (err)
+    {
+        return end();
+    }
+    ++m_finish;
+
+    value_type* gap = m_start + offset;
+    for (value_type* dst = m_finish - 2; dst != gap; --dst)
+    {
+        nestl::class_operations::assign(err, *dst, std::move(*(dst - 1)));
         if (err)
         {
             return end();
         }
-        nestl::detail::destroy(oldLocation, val);
     }
 
+    nestl::class_operations::assign(err, *gap, std::move(*tmp.ptr()));
+    if (err)
+    {
+        return end();
+    }
 
-	nestl::class_operations::construct(err, first, std::forward<Args>(args) ...);
+    return gap;
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value_shifted(OperationError& err,
+                                   std::false_type /* move assignable */,
+                                   size_type offset,
+                                   Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    /// tail should not be empty, elements at the end are constructed without shifting
+    assert(m_start + offset < m_finish);
+
+    /// Elements can not be assigned, so tail is shifted by copying in place.
+    /// @note Only basic guarantee is provided: if shifting fails in the middle,
+    /// elements starting from failed position are removed from vector
+    nestl::aligned_buffer<value_type> tmp;
+    nestl::class_operations::construct(err, tmp.ptr(), std::forward<Args>(args) ...);
     if (err)
     {
         return end();
     }
+    value_type* tmpEnd = tmp.ptr() + 1;
+    nestl::detail::destruction_scoped_guard<value_type*> tmpGuard(tmp.ptr(), tmpEnd);
+
+    value_type* gap = m_start + offset;
+    for (value_type* dst = m_finish; dst != gap; --dst)
+    {
+        if (dst != m_finish)
+        {
+            nestl::detail::destroy(dst);
+        }
+
+        const value_type& src = *(dst - 1);
+        nestl::class_operations::construct(err, dst, src);
+        if (err)
+        {
+            if (dst != m_finish)
+            {
+                nestl::detail::destroy(dst + 1, m_finish + 1);
+                m_finish = dst;
+            }
+            return end();
+        }
+    }
+
+    nestl::detail::destroy(gap);
+    const value_type& value = *tmp.ptr();
+    nestl::class_operations::construct(err, gap, value);
+    if (err)
+    {
+        nestl::detail::destroy(gap + 1, m_finish + 1);
+        m_finish = gap;
+        return end();
+    }
 
     ++m_finish;
-    return first;
+    return gap;
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ... Args>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_value_realloc(OperationError& err, size_type offset, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    const size_type newCapacity = (size() == capacity()) ? recommended_capacity(size() + 1) : capacity();
+
+    auto ptr = allocator_traits<allocator_type>::allocate(err, m_allocator, newCapacity);
+    if (err)
+    {
+        return end();
+    }
+    nestl::detail::deallocation_scoped_guard<value_type*, allocator_type> guard(m_allocator, ptr, newCapacity);
+
+    /// new element is constructed first, so args may refer to old storage
+    nestl::class_operations::construct(err, ptr + offset, std::forward<Args>(args) ...);
+    if (err)
+    {
+        return end();
+    }
+    value_type* insertedEnd = ptr + offset + 1;
+    nestl::detail::destruction_scoped_guard<value_type*> insertedGuard(ptr + offset, insertedEnd);
+
+    relocate_around(err, ptr, newCapacity, offset, 1);
+    if (err)
+    {
+        return end();
+    }
+
+    insertedGuard.release();
+    guard.release();
+
+    return m_start + offset;
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError, typename InputIterator>
-typename vector<T, A>::iterator
-vector<T, A>::insert_range(OperationError& err, const_iterator pos, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range(OperationError& err, const_iterator pos, InputIterator first, InputIterator last) NESTL_NOEXCEPT_SPEC
 {
-    NESTL_ASSERT(pos >= m_start);
-    NESTL_ASSERT(pos <= m_finish);
+    assert(pos >= m_start);
+    assert(pos <= m_finish);
 
     /// we should calculate offset before possible reallocation
-    size_t offset = pos - m_start;
+    size_type offset = pos - m_start;
+
+    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+    return insert_range(err, category(), offset, first, last);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename InputIterator>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range(OperationError& err,
+                           std::input_iterator_tag /* tag */,
+                           size_type offset,
+                           InputIterator first,
+                           InputIterator last) NESTL_NOEXCEPT_SPEC
+{
+    /// size of input range is unknown, so collect it first and insert all elements at once
+    vector tmp(m_allocator);
+    tmp.assign_iterator(err, std::input_iterator_tag(), first, last);
+    if (err)
+    {
+        return end();
+    }
+
+    return insert_range(err,
+                        std::forward_iterator_tag(),
+                        offset,
+                        std::make_move_iterator(tmp.begin()),
+                        std::make_move_iterator(tmp.end()));
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ForwardIterator>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range(OperationError& err,
+                           std::forward_iterator_tag /* tag */,
+                           size_type offset,
+                           ForwardIterator first,
+                           ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    const size_type count = std::distance(first, last);
+    if (count == 0)
+    {
+        return m_start + offset;
+    }
+
+    if (count > max_size() - size())
+    {
+        build_length_error(err);
+        return end();
+    }
+
+    if (count > capacity() - size())
+    {
+        return insert_range_realloc(err, offset, count, first, last);
+    }
+
+    return insert_range_in_place(err,
+                                 nestl::detail::is_nothrow_relocatable<value_type>(),
+                                 offset,
+                                 count,
+                                 first,
+                                 last);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ForwardIterator>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range_in_place(OperationError& err,
+                                    std::true_type /* nothrow relocatable */,
+                                    size_type offset,
+                                    size_type count,
+                                    ForwardIterator first,
+                                    ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    /// tail is shifted once, new elements are constructed in the gap.
+    /// In case of failure tail is shifted back, so vector is left untouched
+    value_type* gap = m_start + offset;
+    nestl::detail::relocate_overlapping(gap, m_finish, gap + count);
 
-    iterator res;
-    for ( ; first != last; ++first, ++offset)
+    value_type* cur = gap;
+    for ( ; first != last; ++first, ++cur)
     {
-        const_iterator newPos = m_start + offset;
-        res = insert_value(err, newPos, *first);
+        nestl::class_operations::construct(err, cur, *first);
         if (err)
         {
+            nestl::detail::destroy(gap, cur);
+            nestl::detail::relocate_overlapping(gap + count, m_finish + count, gap);
             return end();
         }
     }
 
-    return res;
+    m_finish += count;
+    return gap;
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ForwardIterator>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range_in_place(OperationError& err,
+                                    std::false_type /* nothrow relocatable */,
+                                    size_type offset,
+                                    size_type count,
+                                    ForwardIterator first,
+                                    ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    return insert_range_in_place(err, std::false_type(), may_allocate(), offset, count, first, last);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ForwardIterator>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range_in_place(OperationError& err,
+                                    std::false_type /* nothrow relocatable */,
+                                    std::true_type /* may allocate */,
+                                    size_type offset,
+                                    size_type count,
+                                    ForwardIterator first,
+                                    ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    /// tail can not be shifted without possible failure in the middle,
+    /// copy everything to new storage instead
+    return insert_range_realloc(err, offset, count, first, last);
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ForwardIterator>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range_in_place(OperationError& err,
+                                    std::false_type /* nothrow relocatable */,
+                                    std::false_type /* may allocate */,
+                                    size_type offset,
+                                    size_type /* count */,
+                                    ForwardIterator first,
+                                    ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    /// There is no other storage, insert elements one by one (basic guarantee only)
+    for (size_type pos = offset; first != last; ++first, ++pos)
+    {
+        if (m_start + pos == m_finish)
+        {
+            nestl::class_operations::construct(err, m_finish, *first);
+            if (err)
+            {
+                return end();
+            }
+
+            ++m_finish;
+            continue;
+        }
+
+        insert_value_in_place(err, std::false_type(), std::false_type(), pos, *first);
+        if (err)
+        {
+            return end();
+        }
+    }
+
+    return m_start + offset;
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError, typename ForwardIterator>
+typename vector<T, A, G, S>::iterator
+vector<T, A, G, S>::insert_range_realloc(OperationError& err,
+                                   size_type offset,
+                                   size_type count,
+                                   ForwardIterator first,
+                                   ForwardIterator last) NESTL_NOEXCEPT_SPEC
+{
+    const size_type newCapacity = (size() + count > capacity()) ? recommended_capacity(size() + count) : capacity();
+
+    auto ptr = allocator_traits<allocator_type>::allocate(err, m_allocator, newCapacity);
+    if (err)
+    {
+        return end();
+    }
+    nestl::detail::deallocation_scoped_guard<value_type*, allocator_type> guard(m_allocator, ptr, newCapacity);
+
+    /// new elements are constructed first, so their source may refer to old storage
+    value_type* inserted = ptr + offset;
+    value_type* insertedEnd = nestl::detail::uninitialised_copy(err, first, last, inserted);
+    if (err)
+    {
+        return end();
+    }
+    nestl::detail::destruction_scoped_guard<value_type*> insertedGuard(inserted, insertedEnd);
+
+    relocate_around(err, ptr, newCapacity, offset, count);
+    if (err)
+    {
+        return end();
+    }
+
+    insertedGuard.release();
+    guard.release();
+
+    return inserted;
+}
+
+template <typename T, typename A, typename G, typename S>
+template <typename OperationError>
+void
+vector<T, A, G, S>::relocate_around(OperationError& err,
+                              value_type* ptr,
+                              size_type newCapacity,
+                              size_type offset,
+                              size_type count) NESTL_NOEXCEPT_SPEC
+{
+    /// [ptr + offset, ptr + offset + count) is already constructed,
+    /// relocate old elements around it and take ownership of new storage.
+    /// On failure old storage is left untouched
+    value_type* pos = m_start + offset;
+
+    value_type* prefixEnd = nestl::detail::uninitialised_relocate(err, m_start, pos, ptr);
+    if (err)
+    {
+        return;
+    }
+    nestl::detail::destruction_scoped_guard<value_type*> prefixGuard(ptr, prefixEnd);
+
+    value_type* newFinish = nestl::detail::uninitialised_relocate(err, pos, m_finish, ptr + offset + count);
+    if (err)
+    {
+        return;
+    }
+
+    prefixGuard.release();
+
+    nestl::detail::destroy_relocated(m_start, m_finish);
+    deallocate_storage(m_start, m_end_of_storage - m_start);
+
+    m_start = ptr;
+    m_finish = newFinish;
+    m_end_of_storage = ptr + newCapacity;
+}
+
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError, typename ... Args>
 void
-vector<T, A>::do_resize(OperationError& err, size_type count, Args&& ... args) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::do_resize(OperationError& err, size_type count, Args&& ... args) NESTL_NOEXCEPT_SPEC
 {
     if (count <= size())
     {
@@ -793,28 +1729,67 @@ vector<T, A>::do_resize(OperationError& err, size_type count, Args&& ... args) N
     }
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
+typename vector<T, A, G, S>::size_type
+vector<T, A, G, S>::recommended_capacity(size_type requiredCapacity) const NESTL_NOEXCEPT_SPEC
+{
+    assert(requiredCapacity <= max_size());
+
+    const size_type newCapacity = growth_policy_type::grow(m_allocator, capacity(), requiredCapacity, max_size());
+    assert(newCapacity >= requiredCapacity);
+    assert(newCapacity <= max_size());
+
+    return newCapacity;
+}
+
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::grow(OperationError& err, size_type requiredCapacity) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::grow(OperationError& err, size_type requiredCapacity) NESTL_NOEXCEPT_SPEC
 {
-    size_t newCapacity = (((capacity() + 1) * 3) / 2);
-    if (newCapacity < requiredCapacity)
+    if (requiredCapacity <= capacity())
     {
-        newCapacity = requiredCapacity;
+        return;
     }
 
-    /// @bug overflow error
-    assert(newCapacity > capacity());
+    if (requiredCapacity > max_size())
+    {
+        build_length_error(err);
+        return;
+    }
 
-    reserve_nothrow(err, newCapacity);
+    do_reserve(err, recommended_capacity(requiredCapacity));
 }
 
-template <typename T, typename A>
+template <typename T, typename A, typename G, typename S>
 template <typename OperationError>
 void
-vector<T, A>::do_reserve(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
+vector<T, A, G, S>::do_reserve(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_SPEC
 {
+    if (new_cap <= storage_type::inline_capacity)
+    {
+        /// elements fit into inline buffer (possible only after shrink_to_fit)
+        if (is_inline())
+        {
+            return;
+        }
+
+        value_type* buffer = this->inline_data();
+        nestl::detail::relocate(err, m_start, m_finish, buffer);
+        if (err)
+        {
+            return;
+        }
+
+        const size_t current_size = size();
+        deallocate_storage(m_start, m_end_of_storage - m_start);
+
+        m_start = buffer;
+        m_finish = buffer + current_size;
+        m_end_of_storage = buffer + storage_type::inline_capacity;
+        return;
+    }
+
     auto ptr = allocator_traits<allocator_type>::allocate(err, m_allocator, new_cap);
     if (err)
     {
@@ -822,15 +1797,15 @@ vector<T, A>::do_reserve(OperationError& err, size_type new_cap) NESTL_NOEXCEPT_
     }
     nestl::detail::deallocation_scoped_guard<value_type*, allocator_type> guard(m_allocator, ptr, new_cap);
 
-    nestl::detail::uninitialised_copy(err, m_start, m_finish, ptr);
+    /// elements are moved (or even memcpy-ed) when possible, old storage is left untouched on failure
+    nestl::detail::relocate(err, m_start, m_finish, ptr);
     if (err)
     {
         return;
     }
 
     const size_t current_size = size();
-    nestl::detail::destroy(m_start, m_finish);
-    m_allocator.deallocate(m_start, m_end_of_storage - m_start);
+    deallocate_storage(m_start, m_end_of_storage - m_start);
 
     m_start = ptr;
     m_finish = ptr + current_size;
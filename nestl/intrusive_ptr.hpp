@@ -0,0 +1,319 @@
+#ifndef NESTL_INTRUSIVE_PTR_HPP
+#define NESTL_INTRUSIVE_PTR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/allocator.hpp>
+#include <nestl/allocator_traits.hpp>
+#include <nestl/class_operations.hpp>
+#include <nestl/refcount_policy.hpp>
+
+#include <nestl/detail/allocator_traits_helper.hpp>
+#include <nestl/detail/destroy.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file Smart pointer which keeps reference counter inside of object
+ *
+ * Object has no separate control block, so pointer is one word and copying it touches
+ * the object only. Pointer manages any type for which following functions are found by ADL:
+ * @code
+ * void intrusive_ptr_add_ref(const T* ptr);
+ * void intrusive_ptr_release(const T* ptr);
+ * @endcode
+ * Base class intrusive_ref_counter provides them for objects created by make_intrusive_nothrow.
+ */
+
+namespace nestl
+{
+
+/**
+ * @brief Reference counter which lives inside of Derived
+ *
+ * Object is destroyed and its memory is returned to default constructed Allocator
+ * when the last reference goes away, so Allocator should be stateless.
+ *
+ * @note Copy of object gets its own counter, references to original object are not copied.
+ * Object is destroyed as Derived, so make_intrusive_nothrow accepts Derived only.
+ */
+template <typename Derived,
+          typename RefCountPolicy = nestl::default_refcount_policy,
+          typename Allocator = nestl::allocator<Derived> >
+class intrusive_ref_counter
+{
+    typedef RefCountPolicy policy_type;
+public:
+
+    typedef Derived derived_type;
+    typedef RefCountPolicy refcount_policy_type;
+    typedef typename nestl::detail::allocator_rebind<Allocator, Derived>::other intrusive_allocator_type;
+
+    long use_count() const NESTL_NOEXCEPT_SPEC
+    {
+        const long res = policy_type::load(m_ref_count);
+        assert(res >= 0);
+        return res;
+    }
+
+    friend void intrusive_ptr_add_ref(const intrusive_ref_counter* ptr) NESTL_NOEXCEPT_SPEC
+    {
+        policy_type::increment(ptr->m_ref_count);
+    }
+
+    friend void intrusive_ptr_release(const intrusive_ref_counter* ptr) NESTL_NOEXCEPT_SPEC
+    {
+        const long res = policy_type::decrement(ptr->m_ref_count);
+        assert(res >= 0);
+        if (res == 0)
+        {
+            Derived* self = static_cast<Derived*>(const_cast<intrusive_ref_counter*>(ptr));
+            intrusive_allocator_type alloc;
+
+            nestl::detail::destroy(self);
+            nestl::allocator_traits<intrusive_allocator_type>::deallocate(alloc, self, 1);
+        }
+    }
+
+protected:
+
+    intrusive_ref_counter() NESTL_NOEXCEPT_SPEC
+        : m_ref_count(0)
+    {
+    }
+
+    intrusive_ref_counter(const intrusive_ref_counter& /* other */) NESTL_NOEXCEPT_SPEC
+        : m_ref_count(0)
+    {
+    }
+
+    intrusive_ref_counter& operator=(const intrusive_ref_counter& /* other */) NESTL_NOEXCEPT_SPEC
+    {
+        return *this;
+    }
+
+    ~intrusive_ref_counter() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+private:
+    mutable typename policy_type::counter_type m_ref_count;
+};
+
+
+template <typename T>
+class intrusive_ptr
+{
+public:
+
+    typedef T   element_type;
+    typedef T*  pointer_type;
+
+    intrusive_ptr() NESTL_NOEXCEPT_SPEC
+        : m_ptr(nullptr)
+    {
+    }
+
+    intrusive_ptr(std::nullptr_t) NESTL_NOEXCEPT_SPEC
+        : m_ptr(nullptr)
+    {
+    }
+
+    /**
+     * @brief Takes new reference to object, or adopts reference which is already counted if add_ref is false
+     */
+    explicit intrusive_ptr(T* ptr, bool add_ref = true) NESTL_NOEXCEPT_SPEC
+        : m_ptr(ptr)
+    {
+        if (m_ptr && add_ref)
+        {
+            intrusive_ptr_add_ref(m_ptr);
+        }
+    }
+
+    intrusive_ptr(const intrusive_ptr& other) NESTL_NOEXCEPT_SPEC
+        : m_ptr(other.m_ptr)
+    {
+        if (m_ptr)
+        {
+            intrusive_ptr_add_ref(m_ptr);
+        }
+    }
+
+    template <typename Y>
+    intrusive_ptr(const intrusive_ptr<Y>& other) NESTL_NOEXCEPT_SPEC
+        : m_ptr(other.get())
+    {
+        if (m_ptr)
+        {
+            intrusive_ptr_add_ref(m_ptr);
+        }
+    }
+
+    intrusive_ptr(intrusive_ptr&& other) NESTL_NOEXCEPT_SPEC
+        : m_ptr(other.m_ptr)
+    {
+        other.m_ptr = nullptr;
+    }
+
+    template <typename Y>
+    intrusive_ptr(intrusive_ptr<Y>&& other) NESTL_NOEXCEPT_SPEC
+        : m_ptr(other.detach())
+    {
+    }
+
+    ~intrusive_ptr() NESTL_NOEXCEPT_SPEC
+    {
+        if (m_ptr)
+        {
+            intrusive_ptr_release(m_ptr);
+        }
+    }
+
+    intrusive_ptr& operator=(const intrusive_ptr& other) NESTL_NOEXCEPT_SPEC
+    {
+        intrusive_ptr(other).swap(*this);
+        return *this;
+    }
+
+    template <typename Y>
+    intrusive_ptr& operator=(const intrusive_ptr<Y>& other) NESTL_NOEXCEPT_SPEC
+    {
+        intrusive_ptr(other).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr&& other) NESTL_NOEXCEPT_SPEC
+    {
+        intrusive_ptr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    template <typename Y>
+    intrusive_ptr& operator=(intrusive_ptr<Y>&& other) NESTL_NOEXCEPT_SPEC
+    {
+        intrusive_ptr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    void reset() NESTL_NOEXCEPT_SPEC
+    {
+        intrusive_ptr().swap(*this);
+    }
+
+    void reset(T* ptr, bool add_ref = true) NESTL_NOEXCEPT_SPEC
+    {
+        intrusive_ptr(ptr, add_ref).swap(*this);
+    }
+
+    /**
+     * @brief Gives up ownership without releasing reference, caller becomes responsible for it
+     */
+    T* detach() NESTL_NOEXCEPT_SPEC
+    {
+        T* res = m_ptr;
+        m_ptr = nullptr;
+        return res;
+    }
+
+    void swap(intrusive_ptr& other) NESTL_NOEXCEPT_SPEC
+    {
+        std::swap(m_ptr, other.m_ptr);
+    }
+
+    T* get() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_ptr;
+    }
+
+    T& operator*() const NESTL_NOEXCEPT_SPEC
+    {
+        assert(m_ptr);
+        return *m_ptr;
+    }
+
+    T* operator->() const NESTL_NOEXCEPT_SPEC
+    {
+        assert(m_ptr);
+        return m_ptr;
+    }
+
+    explicit operator bool() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_ptr != nullptr;
+    }
+
+private:
+    T* m_ptr;
+};
+
+template <typename T, typename U>
+bool operator==(const intrusive_ptr<T>& left, const intrusive_ptr<U>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.get() == right.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const intrusive_ptr<T>& left, const intrusive_ptr<U>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.get() != right.get();
+}
+
+template <typename T>
+bool operator==(const intrusive_ptr<T>& left, std::nullptr_t) NESTL_NOEXCEPT_SPEC
+{
+    return !left;
+}
+
+template <typename T>
+bool operator!=(const intrusive_ptr<T>& left, std::nullptr_t) NESTL_NOEXCEPT_SPEC
+{
+    return static_cast<bool>(left);
+}
+
+template <typename T>
+void swap(intrusive_ptr<T>& left, intrusive_ptr<T>& right) NESTL_NOEXCEPT_SPEC
+{
+    left.swap(right);
+}
+
+
+/**
+ * @brief Creates object derived from intrusive_ref_counter
+ *
+ * Memory is taken from allocator of intrusive_ref_counter, object is constructed by
+ * class_operations::construct, so two-phase initialization errors are reported as well.
+ * T should be the Derived type of its intrusive_ref_counter, as the object is deallocated as Derived.
+ */
+template <typename T, typename OperationError, typename ... Args>
+intrusive_ptr<T> make_intrusive_nothrow(OperationError& err, Args&& ... args) NESTL_NOEXCEPT_SPEC
+{
+    static_assert(sizeof(T), "T must be complete type");
+    static_assert(std::is_same<T, typename T::derived_type>::value,
+                  "object is deallocated as Derived of intrusive_ref_counter, so T should be Derived");
+    typedef typename T::intrusive_allocator_type allocator_type;
+    allocator_type alloc;
+
+    T* ptr = nestl::allocator_traits<allocator_type>::allocate(err, alloc, 1);
+    if (err)
+    {
+        return intrusive_ptr<T>();
+    }
+    nestl::detail::deallocation_scoped_guard<T*, allocator_type> deallocationGuard(alloc, ptr, 1);
+
+    nestl::class_operations::construct(err, ptr, std::forward<Args>(args) ...);
+    if (err)
+    {
+        return intrusive_ptr<T>();
+    }
+
+    deallocationGuard.release();
+    return intrusive_ptr<T>(ptr);
+}
+
+} // namespace nestl
+
+#endif /* NESTL_INTRUSIVE_PTR_HPP */
@@ -0,0 +1,24 @@
+#ifndef NESTL_MAP_HPP
+#define NESTL_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/exception_support.hpp>
+
+#include <nestl/has_exceptions/map.hpp>
+#include <nestl/no_exceptions/map.hpp>
+
+namespace nestl
+{
+
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+using map = exception_support::dispatch<has_exceptions::map<Key, T, Compare, Alloc>,
+                                        no_exceptions::map<Key, T, Compare, Alloc>>;
+
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+using multimap = exception_support::dispatch<has_exceptions::multimap<Key, T, Compare, Alloc>,
+                                             no_exceptions::multimap<Key, T, Compare, Alloc>>;
+
+} // namespace nestl
+
+#endif /* NESTL_MAP_HPP */
@@ -0,0 +1,243 @@
+#ifndef NESTL_MEMORY_RESOURCE_HPP
+#define NESTL_MEMORY_RESOURCE_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/type_traits.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+/**
+ * @file Polymorphic memory resources and allocator which uses them
+ *
+ * Memory resource hides strategy of allocation behind virtual interface,
+ * so containers with the same type may take memory from different sources (arenas, pools, heap).
+ * Resources report failure by null pointer, errors are built by callers which know OperationError.
+ */
+
+namespace nestl
+{
+
+class memory_resource
+{
+public:
+
+    virtual ~memory_resource() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    /**
+     * @brief Allocates bytes with given alignment
+     *
+     * @note bad_alloc is reported if resource can not provide memory
+     */
+    template <typename OperationError>
+    void* allocate(OperationError& err,
+                   std::size_t bytes,
+                   std::size_t alignment = alignof(std::max_align_t)) NESTL_NOEXCEPT_SPEC
+    {
+        void* res = do_allocate(bytes, alignment);
+        if (!res)
+        {
+            build_bad_alloc(err);
+        }
+
+        return res;
+    }
+
+    /// @brief Allocates bytes with given alignment, returns null pointer on failure
+    void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) NESTL_NOEXCEPT_SPEC
+    {
+        return do_allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr,
+                    std::size_t bytes,
+                    std::size_t alignment = alignof(std::max_align_t)) NESTL_NOEXCEPT_SPEC
+    {
+        do_deallocate(ptr, bytes, alignment);
+    }
+
+    /// @brief Checks whether memory allocated by this resource may be deallocated by other one
+    bool is_equal(const memory_resource& other) const NESTL_NOEXCEPT_SPEC
+    {
+        return do_is_equal(other);
+    }
+
+protected:
+
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC = 0;
+
+    virtual void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC = 0;
+
+    virtual bool do_is_equal(const memory_resource& other) const NESTL_NOEXCEPT_SPEC
+    {
+        return this == &other;
+    }
+};
+
+inline bool operator==(const memory_resource& left, const memory_resource& right) NESTL_NOEXCEPT_SPEC
+{
+    return (&left == &right) || left.is_equal(right);
+}
+
+inline bool operator!=(const memory_resource& left, const memory_resource& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+
+namespace detail
+{
+
+class new_delete_resource_impl : public memory_resource
+{
+protected:
+
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC
+    {
+        if (alignment > alignof(std::max_align_t))
+        {
+            // over-aligned allocation can not be requested from operator new in C++11
+            return nullptr;
+        }
+
+        return ::operator new(bytes, std::nothrow);
+    }
+
+    virtual void do_deallocate(void* ptr, std::size_t /* bytes */, std::size_t /* alignment */) NESTL_NOEXCEPT_SPEC
+    {
+        ::operator delete(ptr);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Resource which uses global operator new and operator delete
+ *
+ * Resource is never destroyed, so containers with static storage duration may use it safely.
+ */
+inline memory_resource* new_delete_resource() NESTL_NOEXCEPT_SPEC
+{
+    typedef detail::new_delete_resource_impl resource_t;
+
+    static typename std::aligned_storage<sizeof(resource_t), alignof(resource_t)>::type storage;
+    static resource_t* resource = ::new(static_cast<void*>(&storage)) resource_t();
+
+    return resource;
+}
+
+
+/**
+ * @brief Allocator which takes memory from memory_resource
+ *
+ * Allocator does not own resource, resource should outlive all containers which use it.
+ * Allocator stays with container on copy, move and swap, so elements of container are
+ * always allocated from the resource given at construction.
+ */
+template <typename T>
+class polymorphic_allocator
+{
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef polymorphic_allocator<U> other;
+    };
+
+    polymorphic_allocator() NESTL_NOEXCEPT_SPEC
+        : m_resource(new_delete_resource())
+    {
+    }
+
+    polymorphic_allocator(memory_resource* resource) NESTL_NOEXCEPT_SPEC
+        : m_resource(resource)
+    {
+    }
+
+    polymorphic_allocator(const polymorphic_allocator& other) NESTL_NOEXCEPT_SPEC
+        : m_resource(other.m_resource)
+    {
+    }
+
+    template <typename Y>
+    polymorphic_allocator(const polymorphic_allocator<Y>& other) NESTL_NOEXCEPT_SPEC
+        : m_resource(other.resource())
+    {
+    }
+
+    polymorphic_allocator& operator=(const polymorphic_allocator& other) NESTL_NOEXCEPT_SPEC
+    {
+        m_resource = other.m_resource;
+        return *this;
+    }
+
+    template<typename OperationError>
+    pointer allocate(OperationError& err, size_type n, const void* /* hint */ = 0) NESTL_NOEXCEPT_SPEC
+    {
+        if (n > max_size())
+        {
+            build_bad_alloc(err);
+            return nullptr;
+        }
+
+        return static_cast<pointer>(m_resource->allocate(err, n * sizeof(value_type), alignof(value_type)));
+    }
+
+    void deallocate(pointer p, size_type n) NESTL_NOEXCEPT_SPEC
+    {
+        m_resource->deallocate(p, n * sizeof(value_type), alignof(value_type));
+    }
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    memory_resource* resource() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_resource;
+    }
+
+private:
+    memory_resource* m_resource;
+};
+
+template <typename T, typename U>
+bool operator==(const polymorphic_allocator<T>& left, const polymorphic_allocator<U>& right) NESTL_NOEXCEPT_SPEC
+{
+    return *left.resource() == *right.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const polymorphic_allocator<T>& left, const polymorphic_allocator<U>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+/// @brief allocator keeps only pointer to resource, so it may be relocated by copying its bytes
+template <typename T>
+struct is_trivially_relocatable<polymorphic_allocator<T> > : public std::true_type
+{
+};
+
+} // namespace nestl
+
+#endif /* NESTL_MEMORY_RESOURCE_HPP */
@@ -0,0 +1,232 @@
+#ifndef NESTL_MONOTONIC_BUFFER_HPP
+#define NESTL_MONOTONIC_BUFFER_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/memory_resource.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/**
+ * @file Arena which hands out memory by bumping pointer and releases it all at once
+ *
+ * Suits request-scoped data: containers allocate from arena while request is processed,
+ * whole memory goes back to upstream resource when arena is released or destroyed.
+ * Deallocation of separate blocks does nothing.
+ */
+
+namespace nestl
+{
+
+class monotonic_buffer : public memory_resource
+{
+public:
+
+    /// @brief size of the first chunk requested from upstream when no initial size is given
+    static const std::size_t default_chunk_size = 1024;
+
+    explicit monotonic_buffer(memory_resource* upstream = new_delete_resource()) NESTL_NOEXCEPT_SPEC
+        : m_upstream(upstream)
+        , m_initial_buffer(nullptr)
+        , m_initial_size(0)
+        , m_current(nullptr)
+        , m_space(0)
+        , m_chunks(nullptr)
+        , m_next_chunk_size(default_chunk_size)
+    {
+    }
+
+    /// @brief First chunk requested from upstream has at least initial_size bytes
+    explicit monotonic_buffer(std::size_t initial_size, memory_resource* upstream = new_delete_resource()) NESTL_NOEXCEPT_SPEC
+        : m_upstream(upstream)
+        , m_initial_buffer(nullptr)
+        , m_initial_size(0)
+        , m_current(nullptr)
+        , m_space(0)
+        , m_chunks(nullptr)
+        , m_next_chunk_size(first_chunk_size(initial_size))
+    {
+    }
+
+    /**
+     * @brief Memory is taken from buffer first, upstream is used only when buffer is exhausted
+     *
+     * @note Buffer is not owned by arena. Upstream may be null pointer,
+     * then bad_alloc is reported when buffer is exhausted.
+     */
+    monotonic_buffer(void* buffer, std::size_t size, memory_resource* upstream = new_delete_resource()) NESTL_NOEXCEPT_SPEC
+        : m_upstream(upstream)
+        , m_initial_buffer(static_cast<char*>(buffer))
+        , m_initial_size(size)
+        , m_current(m_initial_buffer)
+        , m_space(size)
+        , m_chunks(nullptr)
+        , m_next_chunk_size(first_chunk_size(size * growth_factor))
+    {
+    }
+
+    virtual ~monotonic_buffer() NESTL_NOEXCEPT_SPEC
+    {
+        release();
+    }
+
+    /**
+     * @brief Returns all chunks to upstream, memory of initial buffer becomes available again
+     *
+     * @note All objects allocated from arena should be destroyed already
+     */
+    void release() NESTL_NOEXCEPT_SPEC
+    {
+        while (m_chunks)
+        {
+            chunk_header* next = m_chunks->m_next;
+            m_upstream->deallocate(m_chunks, m_chunks->m_size, alignof(std::max_align_t));
+            m_chunks = next;
+        }
+
+        m_current = m_initial_buffer;
+        m_space = m_initial_size;
+    }
+
+    memory_resource* upstream_resource() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_upstream;
+    }
+
+    /// @brief Number of chunks which are taken from upstream
+    std::size_t chunk_count() const NESTL_NOEXCEPT_SPEC
+    {
+        std::size_t res = 0;
+        for (const chunk_header* chunk = m_chunks; chunk; chunk = chunk->m_next)
+        {
+            ++res;
+        }
+
+        return res;
+    }
+
+protected:
+
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC
+    {
+        void* res = take(bytes, alignment);
+        if (res)
+        {
+            return res;
+        }
+
+        if (!add_chunk(bytes, alignment))
+        {
+            return nullptr;
+        }
+
+        return take(bytes, alignment);
+    }
+
+    virtual void do_deallocate(void* /* ptr */, std::size_t /* bytes */, std::size_t /* alignment */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+private:
+    monotonic_buffer(const monotonic_buffer&) = delete;
+    monotonic_buffer& operator=(const monotonic_buffer&) = delete;
+
+    static const std::size_t growth_factor = 2;
+
+    struct chunk_header
+    {
+        chunk_header* m_next;
+        std::size_t m_size;
+    };
+
+    static const std::size_t header_size = (sizeof(chunk_header) + alignof(std::max_align_t) - 1)
+        / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    static std::size_t first_chunk_size(std::size_t requested) NESTL_NOEXCEPT_SPEC
+    {
+        if (requested > 0)
+        {
+            return requested;
+        }
+
+        return default_chunk_size;
+    }
+
+    /// @brief Takes memory from current chunk, returns null pointer if it does not fit
+    void* take(std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC
+    {
+        if (!m_current)
+        {
+            return nullptr;
+        }
+
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_current);
+        const std::size_t padding = (alignment - address % alignment) % alignment;
+        if (padding > m_space || bytes > m_space - padding)
+        {
+            return nullptr;
+        }
+
+        char* res = m_current + padding;
+        m_current = res + bytes;
+        m_space -= padding + bytes;
+
+        return res;
+    }
+
+    /// @brief Requests chunk big enough for given allocation, chunks grow geometrically
+    bool add_chunk(std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC
+    {
+        if (!m_upstream)
+        {
+            return false;
+        }
+
+        const std::size_t max_size = static_cast<std::size_t>(-1);
+        if (bytes > max_size - header_size - alignment)
+        {
+            return false;
+        }
+
+        const std::size_t required = header_size + bytes + alignment;
+        const std::size_t size = (m_next_chunk_size > required) ? m_next_chunk_size : required;
+
+        void* memory = m_upstream->try_allocate(size, alignof(std::max_align_t));
+        if (!memory)
+        {
+            return false;
+        }
+
+        chunk_header* chunk = ::new(memory) chunk_header;
+        chunk->m_next = m_chunks;
+        chunk->m_size = size;
+        m_chunks = chunk;
+
+        m_current = static_cast<char*>(memory) + header_size;
+        m_space = size - header_size;
+
+        if (size <= max_size / growth_factor)
+        {
+            m_next_chunk_size = size * growth_factor;
+        }
+
+        return true;
+    }
+
+    memory_resource* m_upstream;
+
+    char* m_initial_buffer;
+    std::size_t m_initial_size;
+
+    char* m_current;
+    std::size_t m_space;
+
+    chunk_header* m_chunks;
+    std::size_t m_next_chunk_size;
+};
+
+} // namespace nestl
+
+#endif /* NESTL_MONOTONIC_BUFFER_HPP */
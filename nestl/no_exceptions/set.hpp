@@ -4,14 +4,21 @@
 #include <nestl/config.hpp>
 
 #include <nestl/implementation/set.hpp>
+#include <nestl/implementation/multiset.hpp>
 
 namespace nestl
 {
 namespace no_exceptions
 {
 
+template<typename Key,
+         typename Compare = std::less<Key>,
+         typename Alloc = nestl::allocator<Key>,
+         typename TreePolicy = nestl::default_tree_policy>
+using set = impl::set<Key, Compare, Alloc, TreePolicy>;
+
 template<typename Key, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<Key> >
-using set = impl::set<Key, Compare, Alloc>;
+using multiset = impl::multiset<Key, Compare, Alloc>;
 
 } // namespace no_exceptions
 } // namespace nestl
@@ -11,13 +11,14 @@ namespace no_exceptions
 {
 
 
-template <typename T>
-using weak_ptr = impl::weak_ptr<T>;
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
+using weak_ptr = impl::weak_ptr<T, RefCountPolicy>;
 
-template <typename T>
-using shared_ptr = impl::shared_ptr<T>;
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
+using shared_ptr = impl::shared_ptr<T, RefCountPolicy>;
 
 using impl::make_shared_a_nothrow;
+using impl::allocate_shared_nothrow;
 using impl::make_shared_nothrow;
 
 } // namespace has_exceptions
@@ -0,0 +1,23 @@
+#ifndef NESTL_NO_EXCEPTIONS_SMALL_VECTOR_HPP
+#define NESTL_NO_EXCEPTIONS_SMALL_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/small_vector.hpp>
+
+namespace nestl
+{
+namespace no_exceptions
+{
+
+
+template <typename T,
+          std::size_t N,
+          typename Allocator = nestl::allocator<T>,
+          typename GrowthPolicy = nestl::default_growth_policy>
+using small_vector = impl::small_vector<T, N, Allocator, GrowthPolicy>;
+
+} // namespace no_exceptions
+} // namespace nestl
+
+#endif /* NESTL_NO_EXCEPTIONS_SMALL_VECTOR_HPP */
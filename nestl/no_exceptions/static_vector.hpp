@@ -0,0 +1,20 @@
+#ifndef NESTL_NO_EXCEPTIONS_STATIC_VECTOR_HPP
+#define NESTL_NO_EXCEPTIONS_STATIC_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/implementation/static_vector.hpp>
+
+namespace nestl
+{
+namespace no_exceptions
+{
+
+
+template <typename T, std::size_t N>
+using static_vector = impl::static_vector<T, N>;
+
+} // namespace no_exceptions
+} // namespace nestl
+
+#endif /* NESTL_NO_EXCEPTIONS_STATIC_VECTOR_HPP */
@@ -11,7 +11,9 @@ namespace no_exceptions
 {
 
 
-template<typename CharType, typename Traits, typename Alloc>
+template <typename CharType,
+          typename Traits = std::char_traits<CharType>,
+          typename Alloc = nestl::allocator<CharType> >
 using basic_string = impl::basic_string<CharType, Traits, Alloc>;
 
 
@@ -11,8 +11,8 @@ namespace no_exceptions
 {
 
 
-template <typename T, typename Allocator = nestl::allocator<T> >
-using vector = impl::vector<T, Allocator>;
+template <typename T, typename Allocator = nestl::allocator<T>, typename GrowthPolicy = nestl::default_growth_policy>
+using vector = impl::vector<T, Allocator, GrowthPolicy>;
 
 } // namespace no_exceptions
 } // namespace nestl
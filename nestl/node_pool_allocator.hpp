@@ -0,0 +1,346 @@
+#ifndef NESTL_NODE_POOL_ALLOCATOR_HPP
+#define NESTL_NODE_POOL_ALLOCATOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/type_traits.hpp>
+
+#include <nestl/detail/node_pool.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file Allocators which take single objects from pools of fixed size blocks
+ *
+ * Node based containers (list, set) allocate one node per element, so pool makes such allocation
+ * a pop from free list instead of call of global operator new.
+ * Requests for several objects at once are forwarded to global operator new.
+ *
+ * Allocators of the same policy with objects of the same size and alignment share one pool.
+ * Policy provides handle of pools which is stored in allocator and decides which allocators are equal.
+ */
+
+namespace nestl
+{
+
+/**
+ * @brief Pools are shared by all threads, access is serialized by spin lock
+ *
+ * Pools are never destroyed, so containers with static storage duration may use them safely.
+ * Handle is empty, so allocators are stateless and always equal.
+ */
+struct shared_node_pool_policy
+{
+    template <typename Pool>
+    class handle
+    {
+    public:
+        handle() NESTL_NOEXCEPT_SPEC
+        {
+        }
+
+        template <typename OtherPool>
+        handle(const handle<OtherPool>& /* other */) NESTL_NOEXCEPT_SPEC
+        {
+        }
+
+        template <typename OperationError>
+        void* allocate(OperationError& err) NESTL_NOEXCEPT_SPEC
+        {
+            locked_pool<Pool>& holder = instance<Pool>();
+            nestl::detail::lock_guard<nestl::detail::spin_lock> guard(holder.m_lock);
+
+            return holder.m_pool.allocate(err);
+        }
+
+        void deallocate(void* ptr) NESTL_NOEXCEPT_SPEC
+        {
+            locked_pool<Pool>& holder = instance<Pool>();
+            nestl::detail::lock_guard<nestl::detail::spin_lock> guard(holder.m_lock);
+
+            holder.m_pool.deallocate(ptr);
+        }
+
+        template <typename OtherPool>
+        bool equals(const handle<OtherPool>& /* other */) const NESTL_NOEXCEPT_SPEC
+        {
+            return true;
+        }
+    };
+
+private:
+
+    template <typename Pool>
+    struct locked_pool
+    {
+        Pool m_pool;
+        nestl::detail::spin_lock m_lock;
+    };
+
+    template <typename Pool>
+    static locked_pool<Pool>& instance() NESTL_NOEXCEPT_SPEC
+    {
+        static typename std::aligned_storage<sizeof(locked_pool<Pool>), alignof(locked_pool<Pool>)>::type storage;
+        static locked_pool<Pool>* pool = ::new(static_cast<void*>(&storage)) locked_pool<Pool>();
+
+        return *pool;
+    }
+};
+
+
+/**
+ * @brief Each thread has its own pools, no synchronization is required
+ *
+ * Handle refers to pools of thread which created it (see detail::thread_node_pools), so allocators
+ * of different threads are not equal. Pools are released when thread exits and no allocator
+ * or allocated block refers to them anymore.
+ *
+ * @note Allocators and allocated objects should be used only by the thread which created them
+ */
+struct thread_local_node_pool_policy
+{
+    template <typename Pool>
+    class handle
+    {
+        template <typename>
+        friend class handle;
+
+    public:
+        handle() NESTL_NOEXCEPT_SPEC
+            : m_pools(nestl::detail::thread_node_pools::acquire_current())
+            , m_pool(nullptr)
+        {
+        }
+
+        handle(const handle& other) NESTL_NOEXCEPT_SPEC
+            : m_pools(other.m_pools)
+            , m_pool(other.m_pool)
+        {
+            acquire();
+        }
+
+        template <typename OtherPool>
+        handle(const handle<OtherPool>& other) NESTL_NOEXCEPT_SPEC
+            : m_pools(other.m_pools)
+            , m_pool(nullptr)
+        {
+            acquire();
+        }
+
+        handle& operator=(const handle& other) NESTL_NOEXCEPT_SPEC
+        {
+            handle tmp(other);
+            std::swap(m_pools, tmp.m_pools);
+            std::swap(m_pool, tmp.m_pool);
+            return *this;
+        }
+
+        ~handle() NESTL_NOEXCEPT_SPEC
+        {
+            if (m_pools)
+            {
+                m_pools->release();
+            }
+        }
+
+        /// @note Each allocated block holds reference to pools
+        template <typename OperationError>
+        void* allocate(OperationError& err) NESTL_NOEXCEPT_SPEC
+        {
+            Pool* pool = get_pool();
+            if (!pool)
+            {
+                build_bad_alloc(err);
+                return nullptr;
+            }
+
+            void* res = pool->allocate(err);
+            if (err)
+            {
+                return nullptr;
+            }
+
+            m_pools->acquire();
+            return res;
+        }
+
+        void deallocate(void* ptr) NESTL_NOEXCEPT_SPEC
+        {
+            /// pool already exists, since block was taken from it
+            get_pool()->deallocate(ptr);
+            m_pools->release();
+        }
+
+        template <typename OtherPool>
+        bool equals(const handle<OtherPool>& other) const NESTL_NOEXCEPT_SPEC
+        {
+            return m_pools == other.m_pools;
+        }
+
+    private:
+        void acquire() NESTL_NOEXCEPT_SPEC
+        {
+            if (m_pools)
+            {
+                m_pools->acquire();
+            }
+        }
+
+        /// @brief Pool is looked up on first use
+        Pool* get_pool() NESTL_NOEXCEPT_SPEC
+        {
+            if (!m_pool && m_pools)
+            {
+                m_pool = m_pools->template pool<Pool>();
+            }
+            return m_pool;
+        }
+
+        nestl::detail::thread_node_pools* m_pools;
+        Pool* m_pool;
+    };
+};
+
+
+template <typename T, typename PoolPolicy>
+class basic_node_pool_allocator
+    : private PoolPolicy::template handle<nestl::detail::node_pool<sizeof(T), alignof(T)> >
+{
+    template <typename, typename>
+    friend class basic_node_pool_allocator;
+
+    template <typename T1, typename U1, typename P1>
+    friend bool operator==(const basic_node_pool_allocator<T1, P1>& left,
+                           const basic_node_pool_allocator<U1, P1>& right) NESTL_NOEXCEPT_SPEC;
+
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+
+    typedef PoolPolicy      pool_policy_type;
+
+    typedef std::true_type  propagate_on_container_move_assignment;
+    typedef std::true_type  propagate_on_container_swap;
+
+    typedef nestl::detail::node_pool<sizeof(T), alignof(T)> pool_type;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef basic_node_pool_allocator<U, PoolPolicy> other;
+    };
+
+    basic_node_pool_allocator() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    basic_node_pool_allocator(const basic_node_pool_allocator& other) NESTL_NOEXCEPT_SPEC
+        : handle_type(other.get_handle())
+    {
+    }
+
+    template <typename Y>
+    basic_node_pool_allocator(const basic_node_pool_allocator<Y, PoolPolicy>& other) NESTL_NOEXCEPT_SPEC
+        : handle_type(other.get_handle())
+    {
+    }
+
+    basic_node_pool_allocator& operator=(const basic_node_pool_allocator& other) NESTL_NOEXCEPT_SPEC
+    {
+        handle_type::operator=(other.get_handle());
+        return *this;
+    }
+
+    ~basic_node_pool_allocator() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template<typename OperationError>
+    pointer allocate(OperationError& err, size_type n, const void* /* hint */ = 0) NESTL_NOEXCEPT_SPEC
+    {
+        if (n == 1)
+        {
+            return static_cast<pointer>(handle_type::allocate(err));
+        }
+
+        if (n > max_size())
+        {
+            build_bad_alloc(err);
+            return nullptr;
+        }
+
+        pointer res = static_cast<pointer>(::operator new(n * sizeof(value_type), std::nothrow));
+        if (res == nullptr)
+        {
+            build_bad_alloc(err);
+        }
+
+        return res;
+    }
+
+    void deallocate(pointer p, size_type n) NESTL_NOEXCEPT_SPEC
+    {
+        if (n == 1)
+        {
+            handle_type::deallocate(p);
+            return;
+        }
+
+        ::operator delete(p);
+    }
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+private:
+    typedef typename PoolPolicy::template handle<pool_type> handle_type;
+
+    const handle_type& get_handle() const NESTL_NOEXCEPT_SPEC
+    {
+        return *this;
+    }
+};
+
+template <typename T, typename U, typename PoolPolicy>
+bool operator==(const basic_node_pool_allocator<T, PoolPolicy>& left,
+                const basic_node_pool_allocator<U, PoolPolicy>& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.get_handle().equals(right.get_handle());
+}
+
+template <typename T, typename U, typename PoolPolicy>
+bool operator!=(const basic_node_pool_allocator<T, PoolPolicy>& left,
+                const basic_node_pool_allocator<U, PoolPolicy>& right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+/// @brief allocator does not point to itself, so it may be relocated by copying its bytes
+template <typename T, typename PoolPolicy>
+struct is_trivially_relocatable<basic_node_pool_allocator<T, PoolPolicy> > : public std::true_type
+{
+};
+
+
+/// @brief Pooled allocator which may be used from any thread
+template <typename T>
+using node_pool_allocator = basic_node_pool_allocator<T, shared_node_pool_policy>;
+
+/// @brief Pooled allocator without synchronization, allocators and memory should not be passed between threads
+template <typename T>
+using thread_local_node_pool_allocator = basic_node_pool_allocator<T, thread_local_node_pool_policy>;
+
+} // namespace nestl
+
+#endif /* NESTL_NODE_POOL_ALLOCATOR_HPP */
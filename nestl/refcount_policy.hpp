@@ -0,0 +1,120 @@
+#ifndef NESTL_REFCOUNT_POLICY_HPP
+#define NESTL_REFCOUNT_POLICY_HPP
+
+#include <nestl/config.hpp>
+
+#include <atomic>
+
+/**
+ * @file Policies of reference counters for smart pointers
+ *
+ * Each policy provides following members:
+ * @code
+ * /// type of counter
+ * typedef ... counter_type;
+ *
+ * /// current value of counter
+ * static long load(const counter_type& counter) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// increments counter which is known to be positive
+ * static void increment(counter_type& counter) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// decrements counter, returns new value
+ * static long decrement(counter_type& counter) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// increments counter unless it is zero, returns false if counter is zero
+ * static bool increment_if_not_zero(counter_type& counter) NESTL_NOEXCEPT_SPEC;
+ * @endcode
+ */
+
+namespace nestl
+{
+
+/**
+ * @brief Counters may be changed by several threads at once
+ *
+ * Increment is relaxed: new reference is created from existing one, so object can not go away meanwhile.
+ * Decrement is acquire/release: all writes to object are visible to the thread which destroys it.
+ *
+ * @note Counters are int sized, as in common standard libraries: two of them fit in one word
+ * of control block.
+ */
+struct atomic_refcount_policy
+{
+    typedef std::atomic<int> counter_type;
+
+    static long load(const counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    static void increment(counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static long decrement(counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        return counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
+    static bool increment_if_not_zero(counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        int current = counter.load(std::memory_order_relaxed);
+        while (current != 0)
+        {
+            if (counter.compare_exchange_weak(current,
+                                              current + 1,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+
+/**
+ * @brief Plain counters for objects which never leave one thread
+ */
+struct single_thread_refcount_policy
+{
+    typedef int counter_type;
+
+    static long load(const counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        return counter;
+    }
+
+    static void increment(counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        ++counter;
+    }
+
+    static long decrement(counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        return --counter;
+    }
+
+    static bool increment_if_not_zero(counter_type& counter) NESTL_NOEXCEPT_SPEC
+    {
+        if (counter == 0)
+        {
+            return false;
+        }
+
+        ++counter;
+        return true;
+    }
+};
+
+
+/// @brief Smart pointers are thread safe unless other policy is requested
+typedef atomic_refcount_policy default_refcount_policy;
+
+} // namespace nestl
+
+#endif /* NESTL_REFCOUNT_POLICY_HPP */
@@ -11,8 +11,15 @@
 namespace nestl
 {
 
+template<typename Key,
+         typename Compare = std::less<Key>,
+         typename Alloc = nestl::allocator<Key>,
+         typename TreePolicy = nestl::default_tree_policy>
+using set = exception_support::dispatch<has_exceptions::set<Key, Compare, Alloc, TreePolicy>,
+                                        no_exceptions::set<Key, Compare, Alloc, TreePolicy>>;
+
 template<typename Key, typename Compare = std::less<Key>, typename Alloc = nestl::allocator<Key> >
-using set = exception_support::dispatch<has_exceptions::set<Key, Compare, Alloc>, no_exceptions::set<Key, Compare, Alloc>>;
+using multiset = exception_support::dispatch<has_exceptions::multiset<Key, Compare, Alloc>, no_exceptions::multiset<Key, Compare, Alloc>>;
 
 } // namespace nestl
 
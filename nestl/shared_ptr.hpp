@@ -11,14 +11,15 @@
 namespace nestl
 {
 
-template <typename T>
-using weak_ptr = exception_support::dispatch<has_exceptions::weak_ptr<T>, no_exceptions::weak_ptr<T>>;
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
+using weak_ptr = exception_support::dispatch<has_exceptions::weak_ptr<T, RefCountPolicy>, no_exceptions::weak_ptr<T, RefCountPolicy>>;
 
-template <typename T>
-using shared_ptr = exception_support::dispatch<has_exceptions::shared_ptr<T>, no_exceptions::shared_ptr<T>>;
+template <typename T, typename RefCountPolicy = nestl::default_refcount_policy>
+using shared_ptr = exception_support::dispatch<has_exceptions::shared_ptr<T, RefCountPolicy>, no_exceptions::shared_ptr<T, RefCountPolicy>>;
 
 using impl::make_shared_nothrow;
 using impl::make_shared_a_nothrow;
+using impl::allocate_shared_nothrow;
 
 
 } // namespace nestl
@@ -0,0 +1,23 @@
+#ifndef NESTL_SMALL_VECTOR_HPP
+#define NESTL_SMALL_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/exception_support.hpp>
+
+#include <nestl/has_exceptions/small_vector.hpp>
+#include <nestl/no_exceptions/small_vector.hpp>
+
+namespace nestl
+{
+
+template <typename T,
+          std::size_t N,
+          typename Allocator = nestl::allocator<T>,
+          typename GrowthPolicy = nestl::default_growth_policy>
+using small_vector = exception_support::dispatch<has_exceptions::small_vector<T, N, Allocator, GrowthPolicy>,
+                                                 no_exceptions::small_vector<T, N, Allocator, GrowthPolicy>>;
+
+} // namespace nestl
+
+#endif /* NESTL_SMALL_VECTOR_HPP */
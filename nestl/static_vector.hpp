@@ -0,0 +1,20 @@
+#ifndef NESTL_STATIC_VECTOR_HPP
+#define NESTL_STATIC_VECTOR_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/exception_support.hpp>
+
+#include <nestl/has_exceptions/static_vector.hpp>
+#include <nestl/no_exceptions/static_vector.hpp>
+
+namespace nestl
+{
+
+template <typename T, std::size_t N>
+using static_vector = exception_support::dispatch<has_exceptions::static_vector<T, N>,
+                                                  no_exceptions::static_vector<T, N>>;
+
+} // namespace nestl
+
+#endif /* NESTL_STATIC_VECTOR_HPP */
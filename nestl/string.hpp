@@ -11,7 +11,9 @@
 namespace nestl
 {
 
-template<typename CharType, typename Traits, typename Alloc>
+template <typename CharType,
+          typename Traits = std::char_traits<CharType>,
+          typename Alloc = nestl::allocator<CharType> >
 using basic_string = exception_support::dispatch<has_exceptions::basic_string<CharType, Traits, Alloc>,
                                                  no_exceptions::basic_string<CharType, Traits, Alloc>>;
 
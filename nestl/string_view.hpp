@@ -0,0 +1,555 @@
+#ifndef NESTL_STRING_VIEW_HPP
+#define NESTL_STRING_VIEW_HPP
+
+#include <nestl/config.hpp>
+#include <nestl/functional.hpp>
+
+#include <nestl/detail/char_search.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+/**
+ * @file Non-owning reference to sequence of characters
+ *
+ * View is pointer and size, it never allocates, so all operations are nothrow.
+ * It is meant for parsing and lookup: keys may be taken from raw buffers and compared
+ * with strings without building temporary string for each of them.
+ *
+ * Search and comparison of char strings run on vector kernels of detail/char_search.hpp.
+ */
+
+namespace nestl
+{
+
+/**
+ * @brief Constant contiguous sequence of characters which is owned by somebody else
+ *
+ * @note View is trivially copyable and should be passed by value.
+ * Referenced characters should outlive the view, they are not required to be terminated by CharType().
+ */
+template <typename CharType, typename Traits = std::char_traits<CharType> >
+class basic_string_view
+{
+public:
+
+    typedef Traits                                          traits_type;
+    typedef CharType                                        value_type;
+    typedef std::size_t                                     size_type;
+    typedef std::ptrdiff_t                                  difference_type;
+    typedef const CharType*                                 pointer;
+    typedef const CharType*                                 const_pointer;
+    typedef const CharType&                                 reference;
+    typedef const CharType&                                 const_reference;
+
+    typedef const_pointer                                   iterator;
+    typedef const_pointer                                   const_iterator;
+    typedef std::reverse_iterator<const_iterator>           reverse_iterator;
+    typedef std::reverse_iterator<const_iterator>           const_reverse_iterator;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+// constructors
+    basic_string_view() NESTL_NOEXCEPT_SPEC
+        : m_data(nullptr)
+        , m_size(0)
+    {
+    }
+
+    basic_string_view(const value_type* s, size_type count) NESTL_NOEXCEPT_SPEC
+        : m_data(s)
+        , m_size(count)
+    {
+    }
+
+    basic_string_view(const value_type* s) NESTL_NOEXCEPT_SPEC
+        : m_data(s)
+        , m_size(traits_type::length(s))
+    {
+    }
+
+// iterators
+    const_iterator begin() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_data;
+    }
+
+    const_iterator cbegin() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_data;
+    }
+
+    const_iterator end() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_data + m_size;
+    }
+
+    const_iterator cend() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_data + m_size;
+    }
+
+    const_reverse_iterator rbegin() const NESTL_NOEXCEPT_SPEC
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const NESTL_NOEXCEPT_SPEC
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const NESTL_NOEXCEPT_SPEC
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const NESTL_NOEXCEPT_SPEC
+    {
+        return const_reverse_iterator(begin());
+    }
+
+// element access
+    const_reference operator[](size_type pos) const NESTL_NOEXCEPT_SPEC
+    {
+        assert(pos < m_size);
+        return m_data[pos];
+    }
+
+    const_reference front() const NESTL_NOEXCEPT_SPEC
+    {
+        assert(m_size > 0);
+        return m_data[0];
+    }
+
+    const_reference back() const NESTL_NOEXCEPT_SPEC
+    {
+        assert(m_size > 0);
+        return m_data[m_size - 1];
+    }
+
+    const_pointer data() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_data;
+    }
+
+// capacity
+    bool empty() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_size == 0;
+    }
+
+    size_type size() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_size;
+    }
+
+    size_type length() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_size;
+    }
+
+    size_type max_size() const NESTL_NOEXCEPT_SPEC
+    {
+        return (npos - sizeof(size_type)) / sizeof(value_type);
+    }
+
+// modifiers
+    void remove_prefix(size_type count) NESTL_NOEXCEPT_SPEC
+    {
+        assert(count <= m_size);
+        m_data += count;
+        m_size -= count;
+    }
+
+    void remove_suffix(size_type count) NESTL_NOEXCEPT_SPEC
+    {
+        assert(count <= m_size);
+        m_size -= count;
+    }
+
+    void swap(basic_string_view& other) NESTL_NOEXCEPT_SPEC
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+
+// operations
+    /**
+     * @brief View of at most count characters starting at pos
+     *
+     * @note Position beyond the end gives empty view instead of error, so parser may
+     * step over the end of input without extra checks
+     */
+    basic_string_view substr(size_type pos = 0, size_type count = npos) const NESTL_NOEXCEPT_SPEC;
+
+    int compare(basic_string_view other) const NESTL_NOEXCEPT_SPEC;
+
+    int compare(size_type pos, size_type count, basic_string_view other) const NESTL_NOEXCEPT_SPEC;
+
+    int compare(const value_type* s) const NESTL_NOEXCEPT_SPEC;
+
+    bool starts_with(basic_string_view prefix) const NESTL_NOEXCEPT_SPEC;
+
+    bool ends_with(basic_string_view suffix) const NESTL_NOEXCEPT_SPEC;
+
+// search
+    size_type find(basic_string_view str, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find(value_type ch, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find(const value_type* s, size_type pos, size_type count) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find(const value_type* s, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type rfind(basic_string_view str, size_type pos = npos) const NESTL_NOEXCEPT_SPEC;
+
+    size_type rfind(value_type ch, size_type pos = npos) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find_first_of(basic_string_view chars, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+    size_type find_first_of(value_type ch, size_type pos = 0) const NESTL_NOEXCEPT_SPEC;
+
+private:
+    typedef nestl::detail::string_search<CharType, Traits> search_type;
+
+    const_pointer m_data;
+    size_type m_size;
+};
+
+
+typedef basic_string_view<char> string_view;
+typedef basic_string_view<wchar_t> wstring_view;
+
+
+namespace detail
+{
+
+/**
+ * @brief Orders any types which are convertible to basic_string_view<C, T> as their views
+ *
+ * It gives the same order as std::less of basic_string, so tree of strings may be searched with it.
+ */
+template <typename C, typename T>
+struct string_view_less
+{
+    template <typename Left, typename Right>
+    bool operator()(const Left& left, const Right& right) const NESTL_NOEXCEPT_SPEC
+    {
+        return basic_string_view<C, T>(left).compare(basic_string_view<C, T>(right)) < 0;
+    }
+};
+
+/**
+ * @brief True if container of Key ordered by Compare may be searched by view K
+ *
+ * Lookup is allowed for the default order only, custom Compare may order strings differently.
+ */
+template <typename Key, typename Compare, typename K>
+struct is_string_view_lookup : public std::false_type
+{
+};
+
+template <typename Key, typename C, typename T>
+struct is_string_view_lookup<Key, std::less<Key>, basic_string_view<C, T> >
+    : public std::integral_constant<bool,
+                                    std::is_convertible<const Key&, basic_string_view<C, T> >::value &&
+                                    !std::is_same<Key, basic_string_view<C, T> >::value>
+{
+};
+
+/**
+ * @brief Hash of count bytes at data
+ *
+ * Bytes are consumed in 8-byte words, each word is mixed by multiplication.
+ * Result is not final: hash containers mix it once more before use.
+ */
+inline std::size_t hash_bytes(const void* data, std::size_t count) NESTL_NOEXCEPT_SPEC
+{
+    const std::uint64_t mul = 0x9E3779B97F4A7C15ull;
+
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t h = 0x243F6A8885A308D3ull ^ count;
+    for (; count >= sizeof(std::uint64_t); count -= sizeof(std::uint64_t), p += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        h = (h ^ word) * mul;
+        h ^= h >> 29;
+    }
+
+    if (count != 0)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, p, count);
+        h = (h ^ word) * mul;
+        h ^= h >> 29;
+    }
+
+    return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+} // namespace detail
+
+
+/**
+ * @brief Hash of characters referenced by view
+ *
+ * Hash is transparent: strings and C strings are hashed as their views,
+ * so hash containers of strings may be searched by them without building temporary string.
+ */
+template <typename C, typename T>
+struct hash<basic_string_view<C, T> >
+{
+    typedef void is_transparent;
+
+    std::size_t operator()(basic_string_view<C, T> str) const NESTL_NOEXCEPT_SPEC
+    {
+        return detail::hash_bytes(str.data(), str.size() * sizeof(C));
+    }
+};
+
+
+// comparison operators
+
+template <typename C, typename T>
+bool operator==(basic_string_view<C, T> left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return left.size() == right.size() && left.compare(right) == 0;
+}
+
+template <typename C, typename T>
+bool operator==(basic_string_view<C, T> left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return left == basic_string_view<C, T>(right);
+}
+
+template <typename C, typename T>
+bool operator==(const C* left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return basic_string_view<C, T>(left) == right;
+}
+
+template <typename C, typename T>
+bool operator!=(basic_string_view<C, T> left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T>
+bool operator!=(basic_string_view<C, T> left, const C* right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T>
+bool operator!=(const C* left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left == right);
+}
+
+template <typename C, typename T>
+bool operator<(basic_string_view<C, T> left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return left.compare(right) < 0;
+}
+
+template <typename C, typename T>
+bool operator>(basic_string_view<C, T> left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return right < left;
+}
+
+template <typename C, typename T>
+bool operator<=(basic_string_view<C, T> left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return !(right < left);
+}
+
+template <typename C, typename T>
+bool operator>=(basic_string_view<C, T> left, basic_string_view<C, T> right) NESTL_NOEXCEPT_SPEC
+{
+    return !(left < right);
+}
+
+
+// implementation
+
+template <typename C, typename T>
+const typename basic_string_view<C, T>::size_type basic_string_view<C, T>::npos;
+
+template <typename C, typename T>
+basic_string_view<C, T>
+basic_string_view<C, T>::substr(size_type pos, size_type count) const NESTL_NOEXCEPT_SPEC
+{
+    if (pos > m_size)
+    {
+        pos = m_size;
+    }
+
+    const size_type rest = m_size - pos;
+    return basic_string_view(m_data + pos, count < rest ? count : rest);
+}
+
+template <typename C, typename T>
+int basic_string_view<C, T>::compare(basic_string_view other) const NESTL_NOEXCEPT_SPEC
+{
+    const size_type common = (m_size < other.m_size) ? m_size : other.m_size;
+
+    const int res = search_type::compare(m_data, other.m_data, common);
+    if (res != 0)
+    {
+        return res;
+    }
+
+    if (m_size < other.m_size)
+    {
+        return -1;
+    }
+
+    return (m_size > other.m_size) ? 1 : 0;
+}
+
+template <typename C, typename T>
+int basic_string_view<C, T>::compare(size_type pos, size_type count, basic_string_view other) const NESTL_NOEXCEPT_SPEC
+{
+    return substr(pos, count).compare(other);
+}
+
+template <typename C, typename T>
+int basic_string_view<C, T>::compare(const value_type* s) const NESTL_NOEXCEPT_SPEC
+{
+    return compare(basic_string_view(s));
+}
+
+template <typename C, typename T>
+bool basic_string_view<C, T>::starts_with(basic_string_view prefix) const NESTL_NOEXCEPT_SPEC
+{
+    return m_size >= prefix.m_size && search_type::compare(m_data, prefix.m_data, prefix.m_size) == 0;
+}
+
+template <typename C, typename T>
+bool basic_string_view<C, T>::ends_with(basic_string_view suffix) const NESTL_NOEXCEPT_SPEC
+{
+    return m_size >= suffix.m_size &&
+           search_type::compare(m_data + m_size - suffix.m_size, suffix.m_data, suffix.m_size) == 0;
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::find(basic_string_view str, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return find(str.m_data, pos, str.m_size);
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::find(value_type ch, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    if (pos >= m_size)
+    {
+        return npos;
+    }
+
+    const_pointer res = search_type::find_char(m_data + pos, m_size - pos, ch);
+    return res ? static_cast<size_type>(res - m_data) : npos;
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::find(const value_type* s, size_type pos, size_type count) const NESTL_NOEXCEPT_SPEC
+{
+    if (pos > m_size || count > m_size - pos)
+    {
+        return npos;
+    }
+
+    if (count == 0)
+    {
+        return pos;
+    }
+
+    const_pointer res = search_type::find(m_data + pos, m_size - pos, s, count);
+    return res ? static_cast<size_type>(res - m_data) : npos;
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::find(const value_type* s, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return find(s, pos, traits_type::length(s));
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::rfind(basic_string_view str, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    if (str.m_size > m_size)
+    {
+        return npos;
+    }
+
+    size_type i = m_size - str.m_size;
+    if (pos < i)
+    {
+        i = pos;
+    }
+
+    for (;;)
+    {
+        if (search_type::compare(m_data + i, str.m_data, str.m_size) == 0)
+        {
+            return i;
+        }
+
+        if (i == 0)
+        {
+            return npos;
+        }
+        --i;
+    }
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::rfind(value_type ch, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    size_type count = m_size;
+    if (pos < count)
+    {
+        count = pos + 1;
+    }
+
+    const_pointer res = search_type::rfind_char(m_data, count, ch);
+    return res ? static_cast<size_type>(res - m_data) : npos;
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::find_first_of(basic_string_view chars, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    if (pos >= m_size || chars.empty())
+    {
+        return npos;
+    }
+
+    const_pointer res = search_type::find_any(m_data + pos, m_size - pos, chars.m_data, chars.m_size);
+    return res ? static_cast<size_type>(res - m_data) : npos;
+}
+
+template <typename C, typename T>
+typename basic_string_view<C, T>::size_type
+basic_string_view<C, T>::find_first_of(value_type ch, size_type pos) const NESTL_NOEXCEPT_SPEC
+{
+    return find(ch, pos);
+}
+
+} // namespace nestl
+
+#endif /* NESTL_STRING_VIEW_HPP */
@@ -0,0 +1,151 @@
+#ifndef NESTL_TREE_POLICY_HPP
+#define NESTL_TREE_POLICY_HPP
+
+#include <nestl/config.hpp>
+
+#include <cstddef>
+
+/**
+ * @file Node policies for tree based containers
+ *
+ * Node policy decides which data tree node keeps besides links and color.
+ * Each policy provides following members:
+ * @code
+ * /// node base extended by policy data, NodeBase has m_parent, m_left and m_right links
+ * template <typename NodeBase>
+ * struct node;
+ *
+ * /// recomputes data of node x from its children
+ * template <typename NodeBase>
+ * static void update(NodeBase* x) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// recomputes data of x and its ancestors up to (not including) end
+ * template <typename NodeBase>
+ * static void update_path(NodeBase* x, const NodeBase* end) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// initializes data of new leaf x and updates its ancestors up to (not including) end
+ * template <typename NodeBase>
+ * static void on_insert(NodeBase* x, const NodeBase* end) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// updates x and its ancestors up to (not including) end before one node is unlinked from subtree of x
+ * template <typename NodeBase>
+ * static void on_erase(NodeBase* x, const NodeBase* end) NESTL_NOEXCEPT_SPEC;
+ *
+ * /// copies data of node from to node to of the same shape
+ * template <typename NodeBase>
+ * static void copy(NodeBase* to, const NodeBase* from) NESTL_NOEXCEPT_SPEC;
+ * @endcode
+ *
+ * Tree calls update for both nodes of each rotation, on_insert and on_erase for single node
+ * modifications and update_path from other places where subtree was changed.
+ */
+
+namespace nestl
+{
+
+/// @brief Nodes keep nothing besides links and color, tree does not pay for augmentation
+struct plain_tree_policy
+{
+    static const bool keeps_subtree_size = false;
+
+    template <typename NodeBase>
+    struct node : public NodeBase
+    {
+    };
+
+    template <typename NodeBase>
+    static void update(NodeBase* /* x */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename NodeBase>
+    static void update_path(NodeBase* /* x */, const NodeBase* /* end */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename NodeBase>
+    static void on_insert(NodeBase* /* x */, const NodeBase* /* end */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename NodeBase>
+    static void on_erase(NodeBase* /* x */, const NodeBase* /* end */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename NodeBase>
+    static void copy(NodeBase* /* to */, const NodeBase* /* from */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+};
+
+/**
+ * @brief Nodes keep sizes of their subtrees
+ *
+ * Each modification pays O(log n) on the way from changed node to root, in return
+ * element is found by its index and index of element is found in O(log n).
+ */
+struct order_statistic_tree_policy
+{
+    static const bool keeps_subtree_size = true;
+
+    template <typename NodeBase>
+    struct node : public NodeBase
+    {
+        std::size_t m_size;
+    };
+
+    /// @brief Number of nodes in subtree of x, x may be null
+    template <typename NodeBase>
+    static std::size_t size(const NodeBase* x) NESTL_NOEXCEPT_SPEC
+    {
+        return x ? static_cast<const node<NodeBase>*>(x)->m_size : 0;
+    }
+
+    template <typename NodeBase>
+    static void update(NodeBase* x) NESTL_NOEXCEPT_SPEC
+    {
+        static_cast<node<NodeBase>*>(x)->m_size = size(x->m_left) + size(x->m_right) + 1;
+    }
+
+    template <typename NodeBase>
+    static void update_path(NodeBase* x, const NodeBase* end) NESTL_NOEXCEPT_SPEC
+    {
+        for (; x != end; x = x->m_parent)
+        {
+            update(x);
+        }
+    }
+
+    /// @brief Sizes on the path just change by one, so siblings of path nodes are not touched
+    template <typename NodeBase>
+    static void on_insert(NodeBase* x, const NodeBase* end) NESTL_NOEXCEPT_SPEC
+    {
+        static_cast<node<NodeBase>*>(x)->m_size = 1;
+        for (x = x->m_parent; x != end; x = x->m_parent)
+        {
+            ++static_cast<node<NodeBase>*>(x)->m_size;
+        }
+    }
+
+    template <typename NodeBase>
+    static void on_erase(NodeBase* x, const NodeBase* end) NESTL_NOEXCEPT_SPEC
+    {
+        for (; x != end; x = x->m_parent)
+        {
+            --static_cast<node<NodeBase>*>(x)->m_size;
+        }
+    }
+
+    template <typename NodeBase>
+    static void copy(NodeBase* to, const NodeBase* from) NESTL_NOEXCEPT_SPEC
+    {
+        static_cast<node<NodeBase>*>(to)->m_size = static_cast<const node<NodeBase>*>(from)->m_size;
+    }
+};
+
+typedef plain_tree_policy default_tree_policy;
+
+} // namespace nestl
+
+#endif /* NESTL_TREE_POLICY_HPP */
@@ -4,6 +4,7 @@
 #include <nestl/config.hpp>
 
 #include <type_traits>
+#include <utility>
 
 namespace nestl
 {
@@ -17,6 +18,35 @@ struct void_t
 };
 
 
+/// @brief True if Compare accepts arguments of any types which it may compare (C++14 transparent comparator)
+///
+/// Comparator opts in by declaring member type is_transparent, as std::less<void> does
+template <typename Compare, typename = void>
+struct is_transparent : public std::false_type
+{
+};
+
+template <typename Compare>
+struct is_transparent<Compare, typename void_t<typename Compare::is_transparent>::type> : public std::true_type
+{
+};
+
+/// @brief Result of heterogeneous lookup by K, available only if Compare is transparent
+///
+/// K is not used, but it makes condition depend on template argument of lookup method
+template <typename Compare, typename K, typename Result>
+struct transparent_lookup : public std::enable_if<is_transparent<Compare>::value, Result>
+{
+};
+
+/// @brief Result of heterogeneous lookup by K in hash container, both Hash and KeyEqual should be transparent
+template <typename Hash, typename KeyEqual, typename K, typename Result>
+struct transparent_hash_lookup
+    : public std::enable_if<is_transparent<Hash>::value && is_transparent<KeyEqual>::value, Result>
+{
+};
+
+
 /// @brief This template describes ability of two-phase initialization of given type T
 ///
 /// Client may allow two-phase initialization by specialization this struct with concrete type T
@@ -35,6 +65,35 @@ struct two_phase_initializator
 {
 };
 
+
+/// @brief This template describes whether object of type T may be relocated by copying its bytes
+///
+/// Relocation is move construction to new location followed by destruction of source.
+/// By default only trivially copyable types are relocated this way,
+/// client may opt-in other types (for example types which own heap memory but
+/// do not store pointers to itself) by specialization of this struct with concrete type T:
+/// @code
+/// namespace nestl
+/// {
+/// template <>
+/// struct is_trivially_relocatable<MyType> : public std::true_type
+/// {
+/// };
+/// }
+/// @endcode
+template <typename T>
+struct is_trivially_relocatable : public std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+{
+};
+
+/// @brief Pair is relocated by copying its bytes if both members are (const key of map value as well)
+template <typename First, typename Second>
+struct is_trivially_relocatable<std::pair<First, Second> >
+    : public std::integral_constant<bool, is_trivially_relocatable<typename std::remove_const<First>::type>::value &&
+                                          is_trivially_relocatable<typename std::remove_const<Second>::type>::value>
+{
+};
+
 } // namespace nestl
 
 #endif /* NESTL_TYPE_TRAITS_H */
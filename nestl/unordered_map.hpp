@@ -0,0 +1,24 @@
+#ifndef NESTL_UNORDERED_MAP_HPP
+#define NESTL_UNORDERED_MAP_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/exception_support.hpp>
+
+#include <nestl/has_exceptions/unordered_map.hpp>
+#include <nestl/no_exceptions/unordered_map.hpp>
+
+namespace nestl
+{
+
+template <typename Key,
+          typename T,
+          typename Hash = nestl::hash<Key>,
+          typename KeyEqual = nestl::equal_to<Key>,
+          typename Alloc = nestl::allocator<std::pair<const Key, T> > >
+using unordered_map = exception_support::dispatch<has_exceptions::unordered_map<Key, T, Hash, KeyEqual, Alloc>,
+                                                  no_exceptions::unordered_map<Key, T, Hash, KeyEqual, Alloc>>;
+
+} // namespace nestl
+
+#endif /* NESTL_UNORDERED_MAP_HPP */
@@ -0,0 +1,23 @@
+#ifndef NESTL_UNORDERED_SET_HPP
+#define NESTL_UNORDERED_SET_HPP
+
+#include <nestl/config.hpp>
+
+#include <nestl/exception_support.hpp>
+
+#include <nestl/has_exceptions/unordered_set.hpp>
+#include <nestl/no_exceptions/unordered_set.hpp>
+
+namespace nestl
+{
+
+template <typename Key,
+          typename Hash = nestl::hash<Key>,
+          typename KeyEqual = nestl::equal_to<Key>,
+          typename Alloc = nestl::allocator<Key> >
+using unordered_set = exception_support::dispatch<has_exceptions::unordered_set<Key, Hash, KeyEqual, Alloc>,
+                                                  no_exceptions::unordered_set<Key, Hash, KeyEqual, Alloc>>;
+
+} // namespace nestl
+
+#endif /* NESTL_UNORDERED_SET_HPP */
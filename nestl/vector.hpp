@@ -11,8 +11,9 @@
 namespace nestl
 {
 
-template <typename T, typename Allocator = nestl::allocator<T>>
-using vector = exception_support::dispatch<has_exceptions::vector<T, Allocator>, no_exceptions::vector<T, Allocator>>;
+template <typename T, typename Allocator = nestl::allocator<T>, typename GrowthPolicy = nestl::default_growth_policy>
+using vector = exception_support::dispatch<has_exceptions::vector<T, Allocator, GrowthPolicy>,
+                                           no_exceptions::vector<T, Allocator, GrowthPolicy>>;
 
 } // namespace nestl
 
@@ -106,6 +106,9 @@ public:
 
     typedef T               value_type;
 
+    /// tests swap containers with allocators which own different storages
+    typedef std::true_type  propagate_on_container_swap;
+
     allocator_with_state() NESTL_NOEXCEPT_SPEC
         : m_allocated_storage()
     {
@@ -167,7 +170,8 @@ public:
 
     ~allocator_with_state() NESTL_NOEXCEPT_SPEC
     {
-        if (m_allocated_storage && !m_allocated_storage->empty())
+        // storage is shared by copies of allocator, so leaks are checked by the last one
+        if (m_allocated_storage && m_allocated_storage.unique() && !m_allocated_storage->empty())
         {
             fatal_failure("memory leaks detected!!!");
         }
@@ -223,13 +227,101 @@ public:
 template <typename T>
 bool operator == (const allocator_with_state<T>& left, const allocator_with_state<T>& right)
 {
-    return left.m_allocated_storage == right.m_allocated_storage;
+    return left.m_allocated_storage.get() == right.m_allocated_storage.get();
 }
 
 template <typename T>
 bool operator != (const allocator_with_state<T>& left, const allocator_with_state<T>& right)
 {
-    return left.m_allocated_storage != right.m_allocated_storage;
+    return left.m_allocated_storage.get() != right.m_allocated_storage.get();
+}
+
+/**
+ * Allocator with state which moves to container on move assignment together with storage
+ */
+template <typename T>
+class propagating_allocator_with_state : public allocator_with_state<T>
+{
+public:
+
+    typedef std::true_type  propagate_on_container_move_assignment;
+
+    propagating_allocator_with_state() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename Y>
+    propagating_allocator_with_state(const propagating_allocator_with_state<Y>& other) NESTL_NOEXCEPT_SPEC
+        : allocator_with_state<T>(other)
+    {
+    }
+};
+
+template <typename Dummy = void>
+struct allocation_budget
+{
+    static int value;
+};
+
+template <typename Dummy>
+int allocation_budget<Dummy>::value = 0;
+
+/**
+ * @brief Allocator which succeeds given number of times, then fails
+ *
+ * Budget is shared by allocators of all types, so it limits node based containers
+ * which allocate with rebound allocator as well.
+ */
+template <typename T>
+class budget_allocator
+{
+public:
+
+    typedef T               value_type;
+
+    budget_allocator() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename Y>
+    budget_allocator(const budget_allocator<Y>& /* other */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename OperationError>
+    T* allocate(OperationError& err, std::size_t n, const void* /* hint */ = 0) NESTL_NOEXCEPT_SPEC
+    {
+        if (budget == 0)
+        {
+            build_bad_alloc(err);
+            return nullptr;
+        }
+        --budget;
+
+        return static_cast<T*>(::operator new(n * sizeof(value_type)));
+    }
+
+    void deallocate(T* p, std::size_t /* n */) NESTL_NOEXCEPT_SPEC
+    {
+        ::operator delete(p);
+    }
+
+    static int& budget;
+};
+
+template <typename T>
+int& budget_allocator<T>::budget = allocation_budget<>::value;
+
+template <typename T>
+bool operator==(const budget_allocator<T>&, const budget_allocator<T>&)
+{
+    return true;
+}
+
+template <typename T>
+bool operator!=(const budget_allocator<T>&, const budget_allocator<T>&)
+{
+    return false;
 }
 
 } // namespace test
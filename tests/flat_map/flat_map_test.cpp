@@ -0,0 +1,125 @@
+#include <nestl/flat_map.hpp>
+#include <nestl/functional.hpp>
+#include <nestl/string.hpp>
+#include <nestl/string_view.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include "tests/test_common.hpp"
+
+#include <iterator>
+#include <utility>
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(flat_map_test)
+{
+    // insertion keeps keys sorted, values are modifiable
+    {
+        typedef nestl::flat_map<int, int> map_t;
+        map_t m;
+
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(3, 30)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(1, 10)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(2, 20)));
+
+        nestl::default_operation_error err;
+        map_t::iterator_with_flag res = m.insert_nothrow(err, std::make_pair(2, 200));
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(20, res.first->second);
+
+        NESTL_CHECK_EQ(3u, m.size());
+        NESTL_CHECK_EQ(1, m.begin()->first);
+        NESTL_CHECK_EQ(3, m.rbegin()->first);
+
+        m.find(3)->second = 33;
+        const map_t& cm = m;
+        NESTL_CHECK_EQ(33, cm.find(3)->second);
+        NESTL_CHECK_EQ(true, cm.find(4) == cm.end());
+
+        const std::pair<int, int> range[] = {{5, 50}, {0, 0}, {2, 222}, {4, 40}, {5, 55}};
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::begin(range), std::end(range)));
+        NESTL_CHECK_EQ(6u, m.size());
+        for (int i = 0; i != 6; ++i)
+        {
+            NESTL_CHECK_EQ(i, m.begin()[i].first);
+        }
+        NESTL_CHECK_EQ(20, m.find(2)->second);
+
+        NESTL_CHECK_EQ(1u, m.erase_nothrow(err, 0));
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(1, m.begin()->first);
+        NESTL_CHECK_EQ(4, m.lower_bound(4)->first);
+        NESTL_CHECK_EQ(5, m.upper_bound(4)->first);
+        NESTL_CHECK_EQ(1u, m.count(5));
+    }
+
+    // values are constructed in place only for absent keys
+    {
+        typedef nestl::flat_map<nestl::string, nestl::string, nestl::less<>> map_t;
+        map_t m;
+
+        nestl::string key;
+        NESTL_CHECK_OPERATION(key.assign_nothrow(_, "key which does not fit into inline buffer"));
+
+        nestl::default_operation_error err;
+        map_t::iterator_with_flag res = m.try_emplace_nothrow(err, std::move(key), "first value");
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(true, res.second);
+        NESTL_CHECK_EQ(true, res.first->second == "first value");
+
+        nestl::string sameKey;
+        NESTL_CHECK_OPERATION(sameKey.assign_nothrow(_, "key which does not fit into inline buffer"));
+        res = m.try_emplace_nothrow(err, sameKey, "second value");
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(true, res.first->second == "first value");
+
+        nestl::string shortKey;
+        NESTL_CHECK_OPERATION(shortKey.assign_nothrow(_, "a"));
+        NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, shortKey));
+        NESTL_CHECK_EQ(2u, m.size());
+        NESTL_CHECK_EQ(true, m.begin()->first == "a");
+        NESTL_CHECK_EQ(true, m.begin()->second.empty());
+
+        // transparent lookup by literal and view
+        NESTL_CHECK_EQ(true, m.find("a") == m.begin());
+        NESTL_CHECK_EQ(1u, m.count(nestl::string_view("key which does not fit into inline buffer")));
+        NESTL_CHECK_EQ(true, m.find(nestl::string_view("key")) == m.end());
+
+        auto range = m.equal_range("b");
+        NESTL_CHECK_EQ(true, range.first == range.second);
+        NESTL_CHECK_EQ(true, range.first->first == "key which does not fit into inline buffer");
+    }
+}
+
+NESTL_ADD_TEST(flat_map_test_no_default_constructor)
+{
+    // members of pair are constructed in storage of vector one by one
+    typedef nestl::flat_map<int, explicit_value> map_t;
+    map_t m;
+
+    NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, 3, 30));
+    NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, 1, 10));
+    NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, 2, m.find(1)->second));
+
+    nestl::default_operation_error err;
+    map_t::iterator_with_flag res = m.try_emplace_nothrow(err, 3, 300);
+    NESTL_CHECK_EQ(false, !!err);
+    NESTL_CHECK_EQ(false, res.second);
+    NESTL_CHECK_EQ(30, res.first->second.value);
+
+    NESTL_CHECK_EQ(3u, m.size());
+    int expected = 1;
+    for (map_t::const_iterator it = m.begin(); it != m.end(); ++it, ++expected)
+    {
+        NESTL_CHECK_EQ(expected, it->first);
+    }
+    NESTL_CHECK_EQ(10, m.find(2)->second.value);
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,213 @@
+#include <nestl/flat_set.hpp>
+#include <nestl/functional.hpp>
+#include <nestl/string.hpp>
+#include <nestl/string_view.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include "tests/test_common.hpp"
+#include "tests/allocators.hpp"
+
+#include <iterator>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+template <typename Set, typename T, std::size_t N>
+void CheckFlatSet(const Set& s, const T (&expected)[N])
+{
+    if (s.size() != N)
+    {
+        fatal_failure("expected size: ", N, ", got: ", s.size());
+    }
+
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        if (!(s.begin()[i] == expected[i]))
+        {
+            fatal_failure("element ", i, " is ", s.begin()[i], ", expected ", expected[i]);
+        }
+    }
+}
+
+} // namespace
+
+NESTL_ADD_TEST(flat_set_test_insert)
+{
+    // single elements keep order and uniqueness
+    {
+        nestl::flat_set<int> s;
+        NESTL_CHECK_EQ(true, s.empty());
+
+        const int values[] = {5, 1, 9, 3, 5, 7, 1};
+        for (int value : values)
+        {
+            NESTL_CHECK_OPERATION(s.insert_nothrow(_, value));
+        }
+
+        const int expected[] = {1, 3, 5, 7, 9};
+        CheckFlatSet(s, expected);
+
+        nestl::default_operation_error err;
+        nestl::flat_set<int>::iterator_with_flag res = s.insert_nothrow(err, 3);
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(3, *res.first);
+
+        res = s.insert_nothrow(err, 4);
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(true, res.second);
+        NESTL_CHECK_EQ(2, std::distance(s.begin(), res.first));
+    }
+
+    // range is merged with present elements
+    {
+        nestl::flat_set<int> s;
+        const int initial[] = {10, 20, 30, 40};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(initial), std::end(initial)));
+
+        const int added[] = {35, 5, 20, 25, 5, 50, 10, 45};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(added), std::end(added)));
+
+        const int expected[] = {5, 10, 20, 25, 30, 35, 40, 45, 50};
+        CheckFlatSet(s, expected);
+
+        // only greater elements are appended
+        const int greater[] = {70, 60, 60};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(greater), std::end(greater)));
+        const int expected2[] = {5, 10, 20, 25, 30, 35, 40, 45, 50, 60, 70};
+        CheckFlatSet(s, expected2);
+
+        // nothing new
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(initial), std::end(initial)));
+        CheckFlatSet(s, expected2);
+
+        // empty range
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(initial), std::begin(initial)));
+        CheckFlatSet(s, expected2);
+    }
+
+    // bulk insertion of strings which do not fit into inline buffer
+    {
+        nestl::flat_set<nestl::string, nestl::less<>> s;
+        const char* const words[] = {"pear which is long enough to allocate",
+                                     "apple which is long enough to allocate",
+                                     "fig"};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(words), std::end(words)));
+
+        const char* const more[] = {"banana which is long enough to allocate", "fig", "kiwi"};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(more), std::end(more)));
+
+        NESTL_CHECK_EQ(5u, s.size());
+        NESTL_CHECK_EQ(true, s.begin()[0] == "apple which is long enough to allocate");
+        NESTL_CHECK_EQ(true, s.begin()[1] == "banana which is long enough to allocate");
+        NESTL_CHECK_EQ(true, s.begin()[2] == "fig");
+        NESTL_CHECK_EQ(true, s.begin()[3] == "kiwi");
+
+        // transparent lookup
+        NESTL_CHECK_EQ(true, s.find("kiwi") != s.end());
+        NESTL_CHECK_EQ(1u, s.count(nestl::string_view("fig")));
+        NESTL_CHECK_EQ(true, *s.lower_bound("c") == "fig");
+    }
+
+    // failed insertion leaves set unchanged
+    {
+        typedef nestl::flat_set<int, std::less<int>, budget_allocator<int> > set_t;
+
+        budget_allocator<int>::budget = 1;
+        set_t s;
+        const int initial[] = {1, 3, 5, 7};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(initial), std::end(initial)));
+        NESTL_CHECK_OPERATION(s.reserve_nothrow(_, 0));
+
+        // storage is reallocated
+        const int added[] = {2, 4, 6, 8, 10, 12, 14, 16};
+        nestl::default_operation_error err;
+        s.insert_nothrow(err, std::begin(added), std::end(added));
+        NESTL_CHECK_EQ(true, !!err);
+        CheckFlatSet(s, initial);
+
+        // storage is enough, but merge buffer can not be allocated
+        budget_allocator<int>::budget = 1;
+        NESTL_CHECK_OPERATION(s.reserve_nothrow(_, 16));
+
+        err = nestl::default_operation_error();
+        s.insert_nothrow(err, std::begin(added), std::end(added));
+        NESTL_CHECK_EQ(true, !!err);
+        CheckFlatSet(s, initial);
+
+        // greater elements need no buffer
+        const int greater[] = {9, 11};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(greater), std::end(greater)));
+        const int expected[] = {1, 3, 5, 7, 9, 11};
+        CheckFlatSet(s, expected);
+    }
+}
+
+NESTL_ADD_TEST(flat_set_test_lookup_and_erase)
+{
+    nestl::flat_set<int> s;
+    for (int i = 0; i < 100; i += 2)
+    {
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, i));
+    }
+    NESTL_CHECK_EQ(50u, s.size());
+
+    NESTL_CHECK_EQ(42, *s.find(42));
+    NESTL_CHECK_EQ(true, s.find(43) == s.end());
+    NESTL_CHECK_EQ(true, s.find(-1) == s.end());
+    NESTL_CHECK_EQ(true, s.find(100) == s.end());
+    NESTL_CHECK_EQ(1u, s.count(0));
+    NESTL_CHECK_EQ(0u, s.count(1));
+
+    NESTL_CHECK_EQ(44, *s.lower_bound(43));
+    NESTL_CHECK_EQ(42, *s.lower_bound(42));
+    NESTL_CHECK_EQ(44, *s.upper_bound(42));
+    NESTL_CHECK_EQ(true, s.upper_bound(98) == s.end());
+
+    auto range = s.equal_range(10);
+    NESTL_CHECK_EQ(1, std::distance(range.first, range.second));
+    range = s.equal_range(11);
+    NESTL_CHECK_EQ(true, range.first == range.second);
+    NESTL_CHECK_EQ(12, *range.first);
+
+    nestl::default_operation_error err;
+    NESTL_CHECK_EQ(1u, s.erase_nothrow(err, 42));
+    NESTL_CHECK_EQ(false, !!err);
+    NESTL_CHECK_EQ(true, s.find(42) == s.end());
+    NESTL_CHECK_EQ(49u, s.size());
+
+    NESTL_CHECK_EQ(0u, s.erase_nothrow(err, 43));
+    NESTL_CHECK_EQ(false, !!err);
+
+    nestl::flat_set<int>::iterator it = s.erase_nothrow(err, s.begin());
+    NESTL_CHECK_EQ(false, !!err);
+    NESTL_CHECK_EQ(2, *it);
+
+    s.erase_nothrow(err, s.lower_bound(50), s.end());
+    NESTL_CHECK_EQ(false, !!err);
+    NESTL_CHECK_EQ(23u, s.size());
+    NESTL_CHECK_EQ(48, *s.rbegin());
+
+    nestl::flat_set<int> copy;
+    NESTL_CHECK_OPERATION(copy.copy_nothrow(_, s));
+    NESTL_CHECK_EQ(23u, copy.size());
+
+    nestl::flat_set<int> other;
+    other.swap(copy);
+    NESTL_CHECK_EQ(true, copy.empty());
+    NESTL_CHECK_EQ(23u, other.size());
+
+    nestl::flat_set<int> moved(std::move(other));
+    NESTL_CHECK_EQ(23u, moved.size());
+
+    moved.clear();
+    NESTL_CHECK_EQ(true, moved.empty());
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,225 @@
+#include <nestl/intrusive_ptr.hpp>
+
+#include "tests/allocators.hpp"
+#include "tests/test_common.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+/// counts alive objects to check that each object is destroyed exactly once
+template <typename RefCountPolicy>
+struct counted_node : public nestl::intrusive_ref_counter<counted_node<RefCountPolicy>, RefCountPolicy>
+{
+    counted_node() NESTL_NOEXCEPT_SPEC
+        : value(0)
+    {
+        ++alive;
+    }
+
+    explicit counted_node(int v) NESTL_NOEXCEPT_SPEC
+        : value(v)
+    {
+        ++alive;
+    }
+
+    counted_node(const counted_node& other) NESTL_NOEXCEPT_SPEC
+        : nestl::intrusive_ref_counter<counted_node<RefCountPolicy>, RefCountPolicy>(other)
+        , value(other.value)
+    {
+        ++alive;
+    }
+
+    ~counted_node() NESTL_NOEXCEPT_SPEC
+    {
+        --alive;
+    }
+
+    int value;
+
+    static int alive;
+};
+
+template <typename RefCountPolicy>
+int counted_node<RefCountPolicy>::alive = 0;
+
+
+/// initialization fails for negative values
+struct fragile_node : public nestl::intrusive_ref_counter<fragile_node>
+{
+    fragile_node() NESTL_NOEXCEPT_SPEC
+        : value(0)
+    {
+    }
+
+    int value;
+
+private:
+    fragile_node(const fragile_node&) = delete;
+    fragile_node& operator=(const fragile_node&) = delete;
+};
+
+
+struct node_without_memory : public nestl::intrusive_ref_counter<node_without_memory,
+                                                                 nestl::default_refcount_policy,
+                                                                 zero_allocator<node_without_memory> >
+{
+};
+
+
+template <typename RefCountPolicy>
+void check_basic_operations()
+{
+    typedef counted_node<RefCountPolicy> node_t;
+    typedef nestl::intrusive_ptr<node_t> ptr_t;
+
+    {
+        ptr_t p;
+        NESTL_CHECK_EQ(true, p == nullptr);
+
+        NESTL_CHECK_OPERATION(p = nestl::make_intrusive_nothrow<node_t>(_, 42));
+        NESTL_CHECK_EQ(true, p != nullptr);
+        NESTL_CHECK_EQ(42, p->value);
+        NESTL_CHECK_EQ(1L, p->use_count());
+        NESTL_CHECK_EQ(1, node_t::alive);
+
+        // pointer is one word, counter is inside of object
+        static_assert(sizeof(ptr_t) == sizeof(node_t*), "intrusive_ptr should be a single pointer");
+
+        ptr_t copy(p);
+        NESTL_CHECK_EQ(2L, p->use_count());
+        NESTL_CHECK_EQ(true, copy == p);
+
+        ptr_t moved(std::move(copy));
+        NESTL_CHECK_EQ(true, copy == nullptr);
+        NESTL_CHECK_EQ(2L, p->use_count());
+
+        // pointer to const shares the same counter
+        nestl::intrusive_ptr<const node_t> constPtr(p);
+        NESTL_CHECK_EQ(3L, p->use_count());
+        constPtr.reset();
+        NESTL_CHECK_EQ(2L, p->use_count());
+
+        // raw pointer obtained from object takes new reference
+        ptr_t fromRaw(moved.get());
+        NESTL_CHECK_EQ(3L, p->use_count());
+
+        // detached reference may be adopted back
+        node_t* raw = fromRaw.detach();
+        NESTL_CHECK_EQ(3L, p->use_count());
+        fromRaw.reset(raw, false);
+        NESTL_CHECK_EQ(3L, p->use_count());
+
+        moved.reset();
+        fromRaw = nullptr;
+        NESTL_CHECK_EQ(1L, p->use_count());
+        NESTL_CHECK_EQ(1, node_t::alive);
+
+        // copy of object has its own counter
+        node_t copyOfNode(*p);
+        NESTL_CHECK_EQ(0L, copyOfNode.use_count());
+    }
+
+    NESTL_CHECK_EQ(0, node_t::alive);
+}
+
+} // namespace
+
+} // namespace test
+
+
+template <>
+struct two_phase_initializator<test::fragile_node>
+{
+    template <typename OperationError>
+    static void init(OperationError& err, test::fragile_node& defaultConstructed, int value) NESTL_NOEXCEPT_SPEC
+    {
+        if (value < 0)
+        {
+            build_bad_alloc(err);
+            return;
+        }
+
+        defaultConstructed.value = value;
+    }
+};
+
+
+namespace test
+{
+
+NESTL_ADD_TEST(intrusive_ptr_test)
+{
+    check_basic_operations<nestl::atomic_refcount_policy>();
+    check_basic_operations<nestl::single_thread_refcount_policy>();
+
+    // two-phase initialization goes through class_operations::construct
+    {
+        nestl::intrusive_ptr<fragile_node> p;
+        NESTL_CHECK_OPERATION(p = nestl::make_intrusive_nothrow<fragile_node>(_, 5));
+        NESTL_CHECK_EQ(5, p->value);
+
+        nestl::default_operation_error err;
+        p = nestl::make_intrusive_nothrow<fragile_node>(err, -1);
+        if (!err)
+        {
+            fatal_failure("failed initialization should be reported");
+        }
+        NESTL_CHECK_EQ(true, p == nullptr);
+    }
+
+    // failed allocation is reported
+    {
+        nestl::default_operation_error err;
+        nestl::intrusive_ptr<node_without_memory> p = nestl::make_intrusive_nothrow<node_without_memory>(err);
+        if (!err)
+        {
+            fatal_failure("allocation by zero_allocator should fail");
+        }
+        NESTL_CHECK_EQ(true, p == nullptr);
+    }
+
+    // atomic counter is shared between threads
+    {
+        typedef counted_node<nestl::atomic_refcount_policy> node_t;
+        typedef nestl::intrusive_ptr<node_t> ptr_t;
+
+        ptr_t p;
+        NESTL_CHECK_OPERATION(p = nestl::make_intrusive_nothrow<node_t>(_, 1));
+
+        const int threadCount = 4;
+        const int iterations = 10000;
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&p, iterations]()
+            {
+                for (int j = 0; j < iterations; ++j)
+                {
+                    ptr_t copy(p);
+                    ptr_t other(std::move(copy));
+                }
+            });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        NESTL_CHECK_EQ(1L, p->use_count());
+        p.reset();
+        NESTL_CHECK_EQ(0, node_t::alive);
+    }
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,158 @@
+#include "tests/list/list_test.hpp"
+
+#include <initializer_list>
+
+namespace nestl
+{
+namespace test
+{
+
+template <typename List>
+void CheckListValues(const List& l, std::initializer_list<int> expected)
+{
+    CheckListSize(l, expected.size());
+
+    auto it = l.cbegin();
+    for (int value : expected)
+    {
+        NESTL_CHECK_EQ(value, *it);
+        ++it;
+    }
+}
+
+template <typename List>
+void FillList(List& l, std::initializer_list<int> values)
+{
+    NESTL_CHECK_OPERATION(l.assign_nothrow(_, values.begin(), values.end()));
+}
+
+
+NESTL_ADD_TEST(list_test_size)
+{
+    // insert and erase
+    {
+        list<int> l;
+        FillList(l, {0, 1, 2, 3});
+
+        NESTL_CHECK_OPERATION(l.insert_nothrow(_, l.cbegin(), 2, -1));
+        CheckListValues(l, {-1, -1, 0, 1, 2, 3});
+
+        l.erase(l.cbegin());
+        l.pop_back();
+        l.pop_front();
+        CheckListValues(l, {0, 1, 2});
+
+        auto last = l.cbegin();
+        ++last;
+        ++last;
+        l.erase(l.cbegin(), last);
+        CheckListValues(l, {2});
+
+        l.clear();
+        CheckListSize(l, 0);
+    }
+
+    // splice
+    {
+        list<int> l1;
+        FillList(l1, {0, 1, 2});
+
+        list<int> l2;
+        FillList(l2, {10, 11, 12, 13});
+
+        l1.splice(l1.cend(), l2, l2.cbegin());
+        CheckListValues(l1, {0, 1, 2, 10});
+        CheckListValues(l2, {11, 12, 13});
+
+        auto last = l2.cbegin();
+        ++last;
+        ++last;
+        l1.splice(l1.cbegin(), l2, l2.cbegin(), last);
+        CheckListValues(l1, {11, 12, 0, 1, 2, 10});
+        CheckListValues(l2, {13});
+
+        last = l1.cbegin();
+        ++last;
+        ++last;
+        l2.splice(l2.cbegin(), l1, l1.cbegin(), last, 2);
+        CheckListValues(l1, {0, 1, 2, 10});
+        CheckListValues(l2, {11, 12, 13});
+
+        // inside of the same list
+        l1.splice(l1.cbegin(), l1, ++l1.cbegin(), l1.cend());
+        CheckListValues(l1, {1, 2, 10, 0});
+
+        l1.splice(l1.cend(), l2);
+        CheckListValues(l1, {1, 2, 10, 0, 11, 12, 13});
+        CheckListSize(l2, 0);
+    }
+
+    // merge, swap and move
+    {
+        list<int> l1;
+        FillList(l1, {0, 2, 4});
+
+        list<int> l2;
+        FillList(l2, {1, 3});
+
+        l1.merge(l2);
+        CheckListValues(l1, {0, 1, 2, 3, 4});
+        CheckListSize(l2, 0);
+
+        FillList(l2, {7});
+        l1.swap(l2);
+        CheckListValues(l1, {7});
+        CheckListValues(l2, {0, 1, 2, 3, 4});
+
+        list<int> l3(std::move(l2));
+        CheckListValues(l3, {0, 1, 2, 3, 4});
+        CheckListSize(l2, 0);
+    }
+
+    // remove, unique, reverse and sort
+    {
+        list<int> l;
+        FillList(l, {3, 1, 1, 2, 3, 3, 1});
+
+        // value refers to element of list
+        l.remove(l.front());
+        CheckListValues(l, {1, 1, 2, 1});
+
+        l.unique();
+        CheckListValues(l, {1, 2, 1});
+
+        l.remove([](int value) { return value == 2; });
+        CheckListValues(l, {1, 1});
+
+        FillList(l, {0, 1, 2, 3});
+        l.reverse();
+        CheckListValues(l, {3, 2, 1, 0});
+
+        l.sort();
+        CheckListValues(l, {0, 1, 2, 3});
+    }
+
+    // resize
+    {
+        list<int> l;
+        FillList(l, {0, 1, 2, 3, 4, 5});
+
+        NESTL_CHECK_OPERATION(l.resize_nothrow(_, 5));
+        CheckListValues(l, {0, 1, 2, 3, 4});
+
+        NESTL_CHECK_OPERATION(l.resize_nothrow(_, 1));
+        CheckListValues(l, {0});
+
+        NESTL_CHECK_OPERATION(l.resize_nothrow(_, 3, 7));
+        CheckListValues(l, {0, 7, 7});
+
+        NESTL_CHECK_OPERATION(l.resize_nothrow(_, 4));
+        CheckListValues(l, {0, 7, 7, 0});
+
+        NESTL_CHECK_OPERATION(l.resize_nothrow(_, 0));
+        CheckListSize(l, 0);
+    }
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,235 @@
+#include <nestl/map.hpp>
+#include <nestl/functional.hpp>
+#include <nestl/string.hpp>
+#include <nestl/string_view.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include "tests/test_common.hpp"
+#include "tests/allocators.hpp"
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(map_test)
+{
+    // insertion keeps keys sorted, values are modifiable
+    {
+        typedef nestl::map<int, int> map_t;
+        map_t m;
+
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(3, 30)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(1, 10)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(2, 20)));
+
+        nestl::default_operation_error err;
+        map_t::iterator_with_flag res = m.insert_nothrow(err, std::make_pair(2, 200));
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(20, res.first->second);
+
+        NESTL_CHECK_EQ(3u, m.size());
+        NESTL_CHECK_EQ(1, m.begin()->first);
+        NESTL_CHECK_EQ(3, m.rbegin()->first);
+
+        m.find(3)->second = 33;
+        const map_t& cm = m;
+        NESTL_CHECK_EQ(33, cm.find(3)->second);
+        NESTL_CHECK_EQ(true, cm.find(4) == cm.end());
+
+        const std::pair<int, int> range[] = {{5, 50}, {0, 0}, {2, 222}, {4, 40}, {5, 55}};
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::begin(range), std::end(range)));
+        NESTL_CHECK_EQ(6u, m.size());
+        int expected = 0;
+        for (map_t::const_iterator it = cm.begin(); it != cm.end(); ++it, ++expected)
+        {
+            NESTL_CHECK_EQ(expected, it->first);
+        }
+        NESTL_CHECK_EQ(20, m.find(2)->second);
+
+        res = m.insert_or_assign_nothrow(err, 2, 2000);
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(2000, m.find(2)->second);
+
+        res = m.insert_or_assign_nothrow(err, 6, 60);
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(true, res.second);
+        NESTL_CHECK_EQ(6, res.first->first);
+        NESTL_CHECK_EQ(7u, m.size());
+
+        NESTL_CHECK_EQ(1u, m.erase(0));
+        NESTL_CHECK_EQ(0u, m.erase(0));
+        NESTL_CHECK_EQ(1, m.begin()->first);
+        NESTL_CHECK_EQ(4, m.lower_bound(4)->first);
+        NESTL_CHECK_EQ(5, m.upper_bound(4)->first);
+        NESTL_CHECK_EQ(1u, m.count(5));
+    }
+
+    // values are constructed only for absent keys
+    {
+        typedef nestl::map<nestl::string, nestl::string, nestl::less<>> map_t;
+        map_t m;
+
+        nestl::string key;
+        NESTL_CHECK_OPERATION(key.assign_nothrow(_, "key which does not fit into inline buffer"));
+        nestl::string value;
+        NESTL_CHECK_OPERATION(value.assign_nothrow(_, "value which does not fit into inline buffer"));
+
+        nestl::default_operation_error err;
+        map_t::iterator_with_flag res = m.try_emplace_nothrow(err, key, std::move(value));
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(true, res.second);
+        NESTL_CHECK_EQ(true, res.first->second == "value which does not fit into inline buffer");
+
+        // present key, value is left untouched
+        NESTL_CHECK_OPERATION(value.assign_nothrow(_, "another value which does not fit into inline buffer"));
+        res = m.try_emplace_nothrow(err, std::move(key), std::move(value));
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(true, value == "another value which does not fit into inline buffer");
+        NESTL_CHECK_EQ(true, key == "key which does not fit into inline buffer");
+
+        res = m.insert_or_assign_nothrow(err, key, std::move(value));
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(true, res.first->second == "another value which does not fit into inline buffer");
+
+        NESTL_CHECK_OPERATION(key.assign_nothrow(_, "b"));
+        NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, key, "second"));
+        NESTL_CHECK_OPERATION(key.assign_nothrow(_, "a"));
+        NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, std::move(key)));
+        NESTL_CHECK_EQ(3u, m.size());
+        NESTL_CHECK_EQ(true, m.begin()->first == "a");
+        NESTL_CHECK_EQ(true, m.begin()->second.empty());
+
+        // transparent lookup by literal and view
+        NESTL_CHECK_EQ(true, m.find("b")->second == "second");
+        NESTL_CHECK_EQ(1u, m.count(nestl::string_view("a")));
+        NESTL_CHECK_EQ(true, m.find(nestl::string_view("c")) == m.end());
+
+        map_t copy;
+        NESTL_CHECK_OPERATION(copy.copy_nothrow(_, m));
+        NESTL_CHECK_EQ(3u, copy.size());
+        NESTL_CHECK_EQ(true, copy.find("key which does not fit into inline buffer")->second ==
+                             "another value which does not fit into inline buffer");
+
+        map_t moved(std::move(copy));
+        NESTL_CHECK_EQ(3u, moved.size());
+        NESTL_CHECK_EQ(true, copy.empty());
+    }
+}
+
+NESTL_ADD_TEST(map_test_const_keys)
+{
+    // keys are const, members of values are constructed in nodes one by one
+    {
+        typedef nestl::map<explicit_value, explicit_value> map_t;
+        static_assert(std::is_same<map_t::value_type, std::pair<const explicit_value, explicit_value> >::value,
+                      "keys of map should not be modifiable");
+
+        map_t m;
+        NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, explicit_value(2), 20));
+        NESTL_CHECK_OPERATION(m.insert_or_assign_nothrow(_, explicit_value(1), explicit_value(10)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(explicit_value(3), explicit_value(30))));
+
+        const map_t::value_type val(explicit_value(0), explicit_value(0));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, val));
+        NESTL_CHECK_EQ(4u, m.size());
+
+        map_t copy;
+        NESTL_CHECK_OPERATION(copy.copy_nothrow(_, m));
+        int expected = 0;
+        for (map_t::const_iterator it = copy.begin(); it != copy.end(); ++it, ++expected)
+        {
+            NESTL_CHECK_EQ(expected, it->first.value);
+            NESTL_CHECK_EQ(expected * 10, it->second.value);
+        }
+        NESTL_CHECK_EQ(4, expected);
+    }
+
+    {
+        typedef nestl::multimap<explicit_value, nestl::string> map_t;
+        static_assert(std::is_same<map_t::value_type, std::pair<const explicit_value, nestl::string> >::value,
+                      "keys of multimap should not be modifiable");
+
+        map_t m;
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(explicit_value(1), nestl::string())));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(explicit_value(1), nestl::string())));
+
+        map_t copy;
+        NESTL_CHECK_OPERATION(copy.copy_nothrow(_, m));
+        NESTL_CHECK_EQ(2u, copy.count(explicit_value(1)));
+    }
+}
+
+NESTL_ADD_TEST(map_test_allocation_failure)
+{
+    typedef nestl::map<int, int, std::less<int>, budget_allocator<std::pair<const int, int> > > map_t;
+    map_t m;
+
+    budget_allocator<int>::budget = 2;
+    NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, 1, 10));
+    NESTL_CHECK_OPERATION(m.insert_or_assign_nothrow(_, 2, 20));
+
+    // present keys do not allocate
+    NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, 1, 100));
+    NESTL_CHECK_OPERATION(m.insert_or_assign_nothrow(_, 2, 200));
+    NESTL_CHECK_EQ(10, m.find(1)->second);
+    NESTL_CHECK_EQ(200, m.find(2)->second);
+
+    nestl::default_operation_error err;
+    map_t::iterator_with_flag res = m.try_emplace_nothrow(err, 3, 30);
+    NESTL_CHECK_EQ(true, !!err);
+    NESTL_CHECK_EQ(false, res.second);
+
+    err = nestl::default_operation_error();
+    res = m.insert_or_assign_nothrow(err, 3, 30);
+    NESTL_CHECK_EQ(true, !!err);
+    NESTL_CHECK_EQ(false, res.second);
+
+    NESTL_CHECK_EQ(2u, m.size());
+    NESTL_CHECK_EQ(true, m.find(3) == m.end());
+}
+
+NESTL_ADD_TEST(multimap_test)
+{
+    typedef nestl::multimap<int, nestl::string> map_t;
+    map_t m;
+
+    NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(2, nestl::string())));
+    for (int i = 0; i != 3; ++i)
+    {
+        std::pair<int, nestl::string> val;
+        val.first = 1;
+        NESTL_CHECK_OPERATION(val.second.push_back_nothrow(_, static_cast<char>('a' + i)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::move(val)));
+    }
+    NESTL_CHECK_EQ(4u, m.size());
+    NESTL_CHECK_EQ(3u, m.count(1));
+
+    // equivalent keys keep order of insertion
+    std::pair<map_t::iterator, map_t::iterator> range = m.equal_range(1);
+    NESTL_CHECK_EQ(3, std::distance(range.first, range.second));
+    NESTL_CHECK_EQ(true, range.first->second == "a");
+    NESTL_CHECK_EQ(true, (++range.first)->second == "b");
+    NESTL_CHECK_EQ(true, (++range.first)->second == "c");
+    NESTL_CHECK_EQ(2, (++range.first)->first);
+
+    map_t copy;
+    NESTL_CHECK_OPERATION(copy.copy_nothrow(_, m));
+    NESTL_CHECK_EQ(4u, copy.size());
+
+    NESTL_CHECK_EQ(3u, m.erase(1));
+    NESTL_CHECK_EQ(1u, m.size());
+    NESTL_CHECK_EQ(2, m.begin()->first);
+    NESTL_CHECK_EQ(3u, copy.count(1));
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,352 @@
+#include <nestl/memory_resource.hpp>
+#include <nestl/monotonic_buffer.hpp>
+#include <nestl/list.hpp>
+#include <nestl/set.hpp>
+#include <nestl/vector.hpp>
+
+#include "tests/test_common.hpp"
+
+#include <cstdint>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+/**
+ * Upstream resource which counts outstanding memory and refuses requests above the limit
+ */
+class counting_resource : public nestl::memory_resource
+{
+public:
+    explicit counting_resource(std::size_t limit = static_cast<std::size_t>(-1)) NESTL_NOEXCEPT_SPEC
+        : m_limit(limit)
+        , m_bytes(0)
+        , m_blocks(0)
+    {
+    }
+
+    ~counting_resource() NESTL_NOEXCEPT_SPEC
+    {
+        if (m_blocks != 0)
+        {
+            fatal_failure("memory leaks detected!!!");
+        }
+    }
+
+    std::size_t bytes() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_bytes;
+    }
+
+    std::size_t blocks() const NESTL_NOEXCEPT_SPEC
+    {
+        return m_blocks;
+    }
+
+protected:
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC
+    {
+        if (bytes > m_limit - m_bytes)
+        {
+            return nullptr;
+        }
+
+        void* res = nestl::new_delete_resource()->try_allocate(bytes, alignment);
+        if (res)
+        {
+            m_bytes += bytes;
+            ++m_blocks;
+        }
+
+        return res;
+    }
+
+    virtual void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) NESTL_NOEXCEPT_SPEC
+    {
+        nestl::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        m_bytes -= bytes;
+        --m_blocks;
+    }
+
+private:
+    std::size_t m_limit;
+    std::size_t m_bytes;
+    std::size_t m_blocks;
+};
+
+bool is_aligned(const void* ptr, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+} // namespace
+
+
+NESTL_ADD_TEST(monotonic_buffer_test)
+{
+    // allocations are aligned and taken from one chunk while it has space
+    {
+        counting_resource upstream;
+        nestl::monotonic_buffer arena(&upstream);
+        NESTL_CHECK_EQ(0u, arena.chunk_count());
+
+        void* first = nullptr;
+        NESTL_CHECK_OPERATION(first = arena.allocate(_, 1, 1));
+
+        void* second = nullptr;
+        NESTL_CHECK_OPERATION(second = arena.allocate(_, 16, 16));
+        NESTL_CHECK_EQ(true, is_aligned(second, 16));
+        NESTL_CHECK_EQ(true, first != second);
+        NESTL_CHECK_EQ(1u, arena.chunk_count());
+
+        // deallocation does not return memory to upstream
+        arena.deallocate(first, 1, 1);
+        arena.deallocate(second, 16, 16);
+        NESTL_CHECK_EQ(1u, upstream.blocks());
+
+        // chunks grow, so number of chunks is logarithmic in total size
+        for (int i = 0; i < 1000; ++i)
+        {
+            NESTL_CHECK_OPERATION(arena.allocate(_, 100, 8));
+        }
+        NESTL_CHECK_EQ(true, arena.chunk_count() < 10u);
+        NESTL_CHECK_EQ(arena.chunk_count(), upstream.blocks());
+
+        // request bigger than next chunk gets its own chunk
+        NESTL_CHECK_OPERATION(arena.allocate(_, 1024 * 1024, 8));
+
+        arena.release();
+        NESTL_CHECK_EQ(0u, arena.chunk_count());
+        NESTL_CHECK_EQ(0u, upstream.blocks());
+    }
+
+    // initial buffer is used before upstream
+    {
+        counting_resource upstream;
+        alignas(std::max_align_t) char buffer[256];
+        nestl::monotonic_buffer arena(buffer, sizeof(buffer), &upstream);
+
+        void* ptr = nullptr;
+        NESTL_CHECK_OPERATION(ptr = arena.allocate(_, 200, 8));
+        NESTL_CHECK_EQ(static_cast<void*>(buffer), ptr);
+        NESTL_CHECK_EQ(0u, upstream.blocks());
+
+        NESTL_CHECK_OPERATION(arena.allocate(_, 200, 8));
+        NESTL_CHECK_EQ(1u, upstream.blocks());
+
+        // buffer is reused after release
+        arena.release();
+        NESTL_CHECK_EQ(0u, upstream.blocks());
+
+        NESTL_CHECK_OPERATION(ptr = arena.allocate(_, 200, 8));
+        NESTL_CHECK_EQ(static_cast<void*>(buffer), ptr);
+    }
+
+    // exhausted arena without upstream reports error
+    {
+        char buffer[64];
+        nestl::monotonic_buffer arena(buffer, sizeof(buffer), nullptr);
+
+        NESTL_CHECK_OPERATION(arena.allocate(_, 64, 1));
+
+        nestl::default_operation_error err;
+        void* ptr = arena.allocate(err, 1, 1);
+        if (!err)
+        {
+            fatal_failure("allocation from exhausted arena should fail");
+        }
+        NESTL_CHECK_EQ(static_cast<void*>(nullptr), ptr);
+    }
+
+    // failure of upstream is reported by arena
+    {
+        counting_resource upstream(4096);
+        nestl::monotonic_buffer arena(&upstream);
+
+        nestl::default_operation_error err;
+        arena.allocate(err, 8192, 8);
+        if (!err)
+        {
+            fatal_failure("allocation above limit of upstream should fail");
+        }
+        NESTL_CHECK_EQ(0u, upstream.blocks());
+    }
+}
+
+
+NESTL_ADD_TEST(polymorphic_allocator_test)
+{
+    typedef nestl::polymorphic_allocator<int> allocator_t;
+
+    // containers take memory from given resource
+    {
+        counting_resource upstream;
+        nestl::monotonic_buffer arena(&upstream);
+
+        nestl::vector<int, allocator_t> v(&arena);
+        nestl::list<int, allocator_t> l(&arena);
+        nestl::set<int, std::less<int>, allocator_t> s(&arena);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(v.push_back_nothrow(_, i));
+            NESTL_CHECK_OPERATION(l.push_back_nothrow(_, i));
+            NESTL_CHECK_OPERATION(s.insert_nothrow(_, i));
+        }
+
+        NESTL_CHECK_EQ(true, upstream.blocks() > 0u);
+        NESTL_CHECK_EQ(true, v.get_allocator().resource() == &arena);
+        NESTL_CHECK_EQ(true, l.get_allocator().resource() == &arena);
+        NESTL_CHECK_EQ(true, s.get_allocator().resource() == &arena);
+    }
+
+    // move assignment with equal resources takes memory of other container,
+    // operator= is not available as resources may differ
+    static_assert(!nestl::detail::alloc_move_takes_storage<allocator_t>::value, "polymorphic allocator does not propagate");
+    {
+        nestl::monotonic_buffer arena;
+
+        nestl::vector<int, allocator_t> v1(&arena);
+        nestl::vector<int, allocator_t> v2(&arena);
+        NESTL_CHECK_OPERATION(v2.push_back_nothrow(_, 1));
+
+        const int* data = &v2[0];
+        NESTL_CHECK_OPERATION(v1.move_assign_nothrow(_, std::move(v2)));
+        NESTL_CHECK_EQ(data, &v1[0]);
+        NESTL_CHECK_EQ(true, v2.empty());
+    }
+
+    // move assignment with different resources moves elements, allocators are kept
+    {
+        counting_resource upstream1;
+        counting_resource upstream2;
+        nestl::monotonic_buffer arena1(&upstream1);
+        nestl::monotonic_buffer arena2(&upstream2);
+
+        {
+            nestl::vector<int, allocator_t> v1(&arena1);
+            nestl::vector<int, allocator_t> v2(&arena2);
+            NESTL_CHECK_OPERATION(v2.push_back_nothrow(_, 1));
+            NESTL_CHECK_OPERATION(v2.push_back_nothrow(_, 2));
+
+            const std::size_t blocks = upstream1.blocks();
+            NESTL_CHECK_OPERATION(v1.move_assign_nothrow(_, std::move(v2)));
+            NESTL_CHECK_EQ(2u, v1.size());
+            NESTL_CHECK_EQ(2, v1[1]);
+            NESTL_CHECK_EQ(true, v1.get_allocator().resource() == &arena1);
+            NESTL_CHECK_EQ(true, v2.get_allocator().resource() == &arena2);
+            NESTL_CHECK_EQ(true, upstream1.blocks() > blocks);
+        }
+
+        {
+            nestl::list<int, allocator_t> l1(&arena1);
+            nestl::list<int, allocator_t> l2(&arena2);
+            NESTL_CHECK_OPERATION(l2.push_back_nothrow(_, 1));
+            NESTL_CHECK_OPERATION(l2.push_back_nothrow(_, 2));
+
+            NESTL_CHECK_OPERATION(l1.move_assign_nothrow(_, std::move(l2)));
+            NESTL_CHECK_EQ(2u, l1.size());
+            NESTL_CHECK_EQ(2, l1.back());
+            NESTL_CHECK_EQ(true, l1.get_allocator().resource() == &arena1);
+            NESTL_CHECK_EQ(true, l2.empty());
+        }
+
+        {
+            nestl::set<int, std::less<int>, allocator_t> s1(&arena1);
+            nestl::set<int, std::less<int>, allocator_t> s2(&arena2);
+            NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 2));
+            NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 1));
+
+            NESTL_CHECK_OPERATION(s1.move_assign_nothrow(_, std::move(s2)));
+            NESTL_CHECK_EQ(2u, s1.size());
+            NESTL_CHECK_EQ(1, *s1.begin());
+            NESTL_CHECK_EQ(true, s1.get_allocator().resource() == &arena1);
+            NESTL_CHECK_EQ(true, s2.empty());
+        }
+    }
+
+    // failure to grow arena is reported by move_assign_nothrow
+    {
+        char buffer[16];
+        nestl::monotonic_buffer small(buffer, sizeof(buffer), nullptr);
+        nestl::monotonic_buffer big;
+
+        nestl::vector<int, allocator_t> v1(&small);
+        nestl::vector<int, allocator_t> v2(&big);
+        for (int i = 0; i < 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(v2.push_back_nothrow(_, i));
+        }
+
+        nestl::default_operation_error err;
+        v1.move_assign_nothrow(err, std::move(v2));
+        if (!err)
+        {
+            fatal_failure("move into exhausted arena should fail");
+        }
+        NESTL_CHECK_EQ(true, v1.empty());
+        NESTL_CHECK_EQ(100u, v2.size());
+
+        nestl::list<int, allocator_t> l1(&small);
+        nestl::list<int, allocator_t> l2(&big);
+        NESTL_CHECK_OPERATION(l2.push_back_nothrow(_, 1));
+
+        err = nestl::default_operation_error();
+        l1.move_assign_nothrow(err, std::move(l2));
+        if (!err)
+        {
+            fatal_failure("move into exhausted arena should fail");
+        }
+        NESTL_CHECK_EQ(1u, l2.size());
+
+        nestl::set<int, std::less<int>, allocator_t> s1(&small);
+        nestl::set<int, std::less<int>, allocator_t> s2(&big);
+        NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 1));
+
+        err = nestl::default_operation_error();
+        s1.move_assign_nothrow(err, std::move(s2));
+        if (!err)
+        {
+            fatal_failure("move into exhausted arena should fail");
+        }
+        NESTL_CHECK_EQ(1u, s2.size());
+    }
+
+    // swap keeps allocators, so it is allowed for containers with equal resources only
+    {
+        nestl::monotonic_buffer arena;
+
+        nestl::list<int, allocator_t> l1(&arena);
+        nestl::list<int, allocator_t> l2(&arena);
+        NESTL_CHECK_OPERATION(l2.push_back_nothrow(_, 1));
+
+        l1.swap(l2);
+        NESTL_CHECK_EQ(1u, l1.size());
+        NESTL_CHECK_EQ(true, l2.empty());
+
+        nestl::set<int, std::less<int>, allocator_t> s1(&arena);
+        nestl::set<int, std::less<int>, allocator_t> s2(&arena);
+        NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 1));
+
+        s1.swap(s2);
+        NESTL_CHECK_EQ(1u, s1.size());
+        NESTL_CHECK_EQ(true, s2.empty());
+    }
+
+    // rebound allocators share resource
+    {
+        nestl::monotonic_buffer arena;
+        allocator_t intAlloc(&arena);
+        nestl::polymorphic_allocator<double> doubleAlloc(intAlloc);
+
+        NESTL_CHECK_EQ(true, intAlloc == doubleAlloc);
+        NESTL_CHECK_EQ(false, intAlloc == allocator_t());
+    }
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,192 @@
+#include <nestl/node_pool_allocator.hpp>
+#include <nestl/list.hpp>
+#include <nestl/set.hpp>
+
+#include "tests/test_common.hpp"
+
+#include <thread>
+#include <utility>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+struct big_node
+{
+    char data[100];
+};
+
+typedef nestl::list<int, nestl::thread_local_node_pool_allocator<int> > thread_local_list;
+
+/// @brief Pools of main thread should be kept until this list is destroyed at exit
+thread_local_list staticList;
+
+} // namespace
+
+
+template <typename Allocator>
+void CheckRecycling()
+{
+    Allocator alloc;
+
+    typename Allocator::pointer first = nullptr;
+    NESTL_CHECK_OPERATION(first = alloc.allocate(_, 1));
+
+    typename Allocator::pointer second = nullptr;
+    NESTL_CHECK_OPERATION(second = alloc.allocate(_, 1));
+    NESTL_CHECK_EQ(true, first != second);
+
+    // freed block is reused by next allocation
+    alloc.deallocate(first, 1);
+
+    typename Allocator::pointer third = nullptr;
+    NESTL_CHECK_OPERATION(third = alloc.allocate(_, 1));
+    NESTL_CHECK_EQ(first, third);
+
+    alloc.deallocate(second, 1);
+    alloc.deallocate(third, 1);
+
+    // arrays are not taken from pool
+    typename Allocator::pointer array = nullptr;
+    NESTL_CHECK_OPERATION(array = alloc.allocate(_, 10));
+    alloc.deallocate(array, 10);
+}
+
+template <typename Allocator>
+void CheckContainers()
+{
+    {
+        nestl::list<int, Allocator> l;
+        for (int i = 0; i < 1000; ++i)
+        {
+            NESTL_CHECK_OPERATION(l.push_back_nothrow(_, i));
+        }
+        NESTL_CHECK_EQ(1000u, l.size());
+
+        l.remove([](int value) { return value % 2 == 0; });
+        NESTL_CHECK_EQ(500u, l.size());
+        NESTL_CHECK_EQ(1, l.front());
+        NESTL_CHECK_EQ(999, l.back());
+    }
+
+    {
+        nestl::set<int, std::less<int>, Allocator> s;
+        for (int i = 0; i < 1000; ++i)
+        {
+            NESTL_CHECK_OPERATION(s.insert_nothrow(_, (i * 7) % 1000));
+        }
+        NESTL_CHECK_EQ(1000u, s.size());
+
+        int expected = 0;
+        for (int value : s)
+        {
+            NESTL_CHECK_EQ(expected, value);
+            ++expected;
+        }
+    }
+}
+
+
+NESTL_ADD_TEST(node_pool_allocator_test)
+{
+    CheckRecycling<nestl::node_pool_allocator<int> >();
+    CheckRecycling<nestl::node_pool_allocator<big_node> >();
+    CheckRecycling<nestl::thread_local_node_pool_allocator<int> >();
+
+    CheckContainers<nestl::node_pool_allocator<int> >();
+    CheckContainers<nestl::thread_local_node_pool_allocator<int> >();
+
+    // rebound allocators are equal and share pools of the same block size
+    {
+        nestl::node_pool_allocator<int> intAlloc;
+        nestl::node_pool_allocator<float>::rebind<int>::other reboundAlloc(intAlloc);
+        NESTL_CHECK_EQ(true, intAlloc == reboundAlloc);
+
+        int* ptr = nullptr;
+        NESTL_CHECK_OPERATION(ptr = intAlloc.allocate(_, 1));
+        reboundAlloc.deallocate(ptr, 1);
+    }
+}
+
+
+NESTL_ADD_TEST(thread_local_node_pool_allocator_test)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        NESTL_CHECK_OPERATION(staticList.push_back_nothrow(_, i));
+    }
+
+    // container outlives thread which filled it, allocators of different threads are not equal
+    thread_local_list fromThread;
+    std::thread worker([&fromThread]()
+    {
+        thread_local_list l;
+        for (int i = 0; i < 1000; ++i)
+        {
+            NESTL_CHECK_OPERATION(l.push_back_nothrow(_, i));
+        }
+
+        fromThread = std::move(l);
+    });
+    worker.join();
+
+    NESTL_CHECK_EQ(false, fromThread.get_allocator() == staticList.get_allocator());
+    NESTL_CHECK_EQ(1000u, fromThread.size());
+    NESTL_CHECK_EQ(0, fromThread.front());
+    NESTL_CHECK_EQ(999, fromThread.back());
+
+    fromThread.clear();
+    NESTL_CHECK_EQ(true, fromThread.get_allocator() == fromThread.get_allocator());
+
+    // allocators of one thread are equal
+    nestl::thread_local_node_pool_allocator<int> intAlloc;
+    nestl::thread_local_node_pool_allocator<big_node> bigAlloc(intAlloc);
+    NESTL_CHECK_EQ(true, intAlloc == bigAlloc);
+    NESTL_CHECK_EQ(true, intAlloc == staticList.get_allocator());
+}
+
+
+NESTL_ADD_TEST(node_pool_test)
+{
+    typedef nestl::detail::node_pool<sizeof(big_node), alignof(big_node)> pool_t;
+
+    NESTL_CHECK_EQ(true, pool_t::block_size >= sizeof(big_node));
+    NESTL_CHECK_EQ(0u, pool_t::block_size % pool_t::block_alignment);
+
+    pool_t pool;
+    NESTL_CHECK_EQ(0u, pool.slab_count());
+
+    // slabs are allocated on demand and reused after deallocation
+    void* blocks[pool_t::blocks_per_slab + 1];
+    for (void*& block : blocks)
+    {
+        NESTL_CHECK_OPERATION(block = pool.allocate(_));
+    }
+    NESTL_CHECK_EQ(2u, pool.slab_count());
+
+    for (void* block : blocks)
+    {
+        pool.deallocate(block);
+    }
+
+    for (void*& block : blocks)
+    {
+        NESTL_CHECK_OPERATION(block = pool.allocate(_));
+    }
+    NESTL_CHECK_EQ(2u, pool.slab_count());
+
+    for (void* block : blocks)
+    {
+        pool.deallocate(block);
+    }
+
+    pool.release();
+    NESTL_CHECK_EQ(0u, pool.slab_count());
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,84 @@
+#include "tests/set/set_test.hpp"
+
+#include <nestl/implementation/detail/key_of_value.hpp>
+#include <nestl/implementation/detail/red_black_tree.hpp>
+#include <nestl/default_operation_error.hpp>
+#include <nestl/vector.hpp>
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(set_test_assign_sorted)
+{
+    // tree built from sorted range is valid red-black tree of any size
+    {
+        typedef nestl::impl::detail::rb_tree<int, int, nestl::impl::detail::identity<int>, std::less<int> > tree_t;
+
+        nestl::vector<int> values;
+        for (int count = 0; count != 130; ++count)
+        {
+            tree_t tree;
+            NESTL_CHECK_OPERATION(tree.m_assign_sorted_unique(_, values.begin(), values.end()));
+            NESTL_CHECK_EQ(true, tree.__rb_verify());
+            NESTL_CHECK_EQ(static_cast<size_t>(count), tree.size());
+
+            int expected = 0;
+            for (tree_t::const_iterator it = tree.begin(); it != tree.end(); ++it, ++expected)
+            {
+                NESTL_CHECK_EQ(expected, *it);
+            }
+
+            // tree stays valid under regular modifications
+            NESTL_CHECK_OPERATION(tree.m_insert_unique(_, -1));
+            NESTL_CHECK_OPERATION(tree.m_insert_unique(_, count));
+            tree.erase(count / 2);
+            NESTL_CHECK_EQ(true, tree.__rb_verify());
+
+            NESTL_CHECK_OPERATION(values.push_back_nothrow(_, count));
+        }
+    }
+
+    // equivalent elements are skipped, previous content is replaced
+    {
+        nestl::set<int> s;
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 100));
+
+        const int values[] = {1, 1, 2, 3, 3, 3, 5, 8, 8};
+        NESTL_CHECK_OPERATION(s.assign_sorted_nothrow(_, std::begin(values), std::end(values)));
+        CheckSetSize(s, 5);
+
+        const int expected[] = {1, 2, 3, 5, 8};
+        NESTL_CHECK_EQ(true, nestl::equal(s.begin(), s.end(), std::begin(expected)));
+        NESTL_CHECK_EQ(0u, s.count(100));
+
+        NESTL_CHECK_OPERATION(s.assign_sorted_nothrow(_, values, values));
+        CheckSetSize(s, 0);
+    }
+
+    // set is left unchanged if allocation fails
+    {
+        typedef nestl::set<int, std::less<int>, budget_allocator<int> > set_t;
+
+        budget_allocator<int>::budget = 3;
+        set_t s;
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 10));
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 20));
+
+        const int values[] = {1, 2, 3, 4, 5, 6, 7};
+        nestl::default_operation_error err;
+        s.assign_sorted_nothrow(err, std::begin(values), std::end(values));
+        NESTL_CHECK_EQ(true, !!err);
+        CheckSetSize(s, 2);
+        NESTL_CHECK_EQ(10, *s.begin());
+
+        budget_allocator<int>::budget = 7;
+        NESTL_CHECK_OPERATION(s.assign_sorted_nothrow(_, std::begin(values), std::end(values)));
+        CheckSetSize(s, 7);
+        NESTL_CHECK_EQ(0, budget_allocator<int>::budget);
+    }
+}
+
+} // namespace test
+} // namespace nestl
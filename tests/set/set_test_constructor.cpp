@@ -1,5 +1,7 @@
 #include "tests/set/set_test.hpp"
 
+#include <nestl/default_operation_error.hpp>
+
 namespace nestl
 {
 namespace test
@@ -144,5 +146,40 @@ NESTL_ADD_TEST(set_test_constructor)
     }
 }
 
+NESTL_ADD_TEST(set_test_copy)
+{
+    typedef nestl::set<int, std::less<int>, budget_allocator<int> > set_t;
+
+    for (int count = 0; count != 40; ++count)
+    {
+        budget_allocator<int>::budget = count;
+        set_t source;
+        for (int i = 0; i != count; ++i)
+        {
+            // alternate ends, so tree gets both left and right subtrees
+            NESTL_CHECK_OPERATION(source.insert_nothrow(_, (i % 2) ? i : -i));
+        }
+
+        // copy fails on every possible node, nodes copied before failure are released
+        for (int budget = 0; budget != count; ++budget)
+        {
+            budget_allocator<int>::budget = budget;
+            set_t copy;
+
+            nestl::default_operation_error err;
+            copy.copy_nothrow(err, source);
+            NESTL_CHECK_EQ(true, !!err);
+            CheckSetSize(copy, 0);
+        }
+
+        budget_allocator<int>::budget = count;
+        set_t copy;
+        NESTL_CHECK_OPERATION(copy.copy_nothrow(_, source));
+        CheckSetSize(copy, count);
+        NESTL_CHECK_EQ(true, nestl::equal(copy.begin(), copy.end(), source.begin()));
+        NESTL_CHECK_EQ(true, nestl::equal(copy.rbegin(), copy.rend(), source.rbegin()));
+    }
+}
+
 } // namespace test
 } // namespace nestl
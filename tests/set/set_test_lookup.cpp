@@ -0,0 +1,163 @@
+#include "tests/set/set_test.hpp"
+
+#include <nestl/functional.hpp>
+#include <nestl/string.hpp>
+#include <nestl/string_view.hpp>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+struct record
+{
+    explicit record(int i) NESTL_NOEXCEPT_SPEC
+        : id(i)
+    {
+        ++constructed;
+    }
+
+    record(const record& other) NESTL_NOEXCEPT_SPEC
+        : id(other.id)
+    {
+        ++constructed;
+    }
+
+    int id;
+
+    static int constructed;
+};
+
+int record::constructed = 0;
+
+/**
+ * @brief Compares records by id and lets lookup use bare id
+ */
+struct record_less
+{
+    typedef void is_transparent;
+
+    bool operator()(const record& left, const record& right) const NESTL_NOEXCEPT_SPEC
+    {
+        return left.id < right.id;
+    }
+
+    bool operator()(const record& left, int right) const NESTL_NOEXCEPT_SPEC
+    {
+        return left.id < right;
+    }
+
+    bool operator()(int left, const record& right) const NESTL_NOEXCEPT_SPEC
+    {
+        return left < right.id;
+    }
+};
+
+} // namespace
+
+static_assert(nestl::is_transparent<nestl::less<>>::value, "less<> should be transparent");
+static_assert(!nestl::is_transparent<nestl::less<int>>::value, "less<int> should not be transparent");
+static_assert(!nestl::is_transparent<std::less<int>>::value, "std::less<int> should not be transparent");
+
+NESTL_ADD_TEST(set_test_lookup)
+{
+    // lookup by key type
+    {
+        nestl::set<int> s;
+        for (int i = 0; i < 10; i += 2)
+        {
+            NESTL_CHECK_OPERATION(s.insert_nothrow(_, i));
+        }
+        CheckSetSize(s, 5);
+
+        NESTL_CHECK_EQ(1u, s.count(4));
+        NESTL_CHECK_EQ(0u, s.count(5));
+
+        NESTL_CHECK_EQ(4, *s.lower_bound(4));
+        NESTL_CHECK_EQ(6, *s.lower_bound(5));
+        NESTL_CHECK_EQ(6, *s.upper_bound(4));
+        NESTL_CHECK_EQ(true, s.lower_bound(9) == s.end());
+        NESTL_CHECK_EQ(true, s.upper_bound(8) == s.end());
+
+        auto range = s.equal_range(4);
+        NESTL_CHECK_EQ(4, *range.first);
+        NESTL_CHECK_EQ(6, *range.second);
+
+        const nestl::set<int>& cs = s;
+        auto crange = cs.equal_range(5);
+        NESTL_CHECK_EQ(true, crange.first == crange.second);
+        NESTL_CHECK_EQ(6, *crange.first);
+    }
+
+    // strings are found by literals and views without building temporary key
+    {
+        typedef nestl::set<nestl::string, nestl::less<>> set_type;
+        set_type keys;
+
+        const char* const values[] = {"alpha", "beta", "gamma", "delta which does not fit into inline buffer"};
+        for (const char* value : values)
+        {
+            nestl::string key;
+            NESTL_CHECK_OPERATION(key.assign_nothrow(_, value));
+            NESTL_CHECK_OPERATION(keys.insert_nothrow(_, std::move(key)));
+        }
+        CheckSetSize(keys, 4);
+
+        set_type::iterator it = keys.find("beta");
+        NESTL_CHECK_EQ(false, it == keys.end());
+        NESTL_CHECK_EQ(true, *it == "beta");
+        NESTL_CHECK_EQ(true, keys.find("bet") == keys.end());
+
+        const char packet[] = "gamma|delta which does not fit into inline buffer";
+        nestl::string_view input(packet);
+        const set_type& constKeys = keys;
+        set_type::const_iterator cit = constKeys.find(input.substr(6));
+        NESTL_CHECK_EQ(false, cit == constKeys.end());
+        NESTL_CHECK_EQ(true, *cit == input.substr(6));
+
+        NESTL_CHECK_EQ(1u, keys.count(input.substr(0, 5)));
+        NESTL_CHECK_EQ(0u, keys.count(input.substr(0, 4)));
+
+        NESTL_CHECK_EQ(true, *keys.lower_bound("b") == "beta");
+        NESTL_CHECK_EQ(true, *keys.upper_bound("beta") == "delta which does not fit into inline buffer");
+        NESTL_CHECK_EQ(true, keys.upper_bound(nestl::string_view("z")) == keys.end());
+
+        auto range = keys.equal_range("gamma");
+        NESTL_CHECK_EQ(1, std::distance(range.first, range.second));
+        NESTL_CHECK_EQ(true, *range.first == "gamma");
+
+        auto empty = constKeys.equal_range(nestl::string_view("c"));
+        NESTL_CHECK_EQ(true, empty.first == empty.second);
+    }
+
+    // custom transparent comparator
+    {
+        nestl::set<record, record_less> records;
+        for (int i = 1; i <= 5; ++i)
+        {
+            NESTL_CHECK_OPERATION(records.insert_nothrow(_, record(i * 10)));
+        }
+        CheckSetSize(records, 5);
+
+        const int constructedBefore = record::constructed;
+
+        NESTL_CHECK_EQ(30, records.find(30)->id);
+        NESTL_CHECK_EQ(true, records.find(35) == records.end());
+        NESTL_CHECK_EQ(1u, records.count(50));
+        NESTL_CHECK_EQ(40, records.lower_bound(35)->id);
+        NESTL_CHECK_EQ(40, records.upper_bound(30)->id);
+
+        auto range = records.equal_range(20);
+        NESTL_CHECK_EQ(20, range.first->id);
+        NESTL_CHECK_EQ(30, range.second->id);
+
+        // lookups by id never construct a record
+        NESTL_CHECK_EQ(constructedBefore, record::constructed);
+    }
+}
+
+} // namespace test
+} // namespace nestl
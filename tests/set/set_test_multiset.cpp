@@ -0,0 +1,51 @@
+#include "tests/set/set_test.hpp"
+
+#include <nestl/default_operation_error.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(set_test_multiset)
+{
+    typedef nestl::multiset<int> set_t;
+    set_t s;
+
+    const int values[] = {3, 1, 2, 3, 1, 3};
+    NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(values), std::end(values)));
+    CheckSetSize(s, 6);
+
+    nestl::default_operation_error err;
+    set_t::iterator it = s.insert_nothrow(err, 2);
+    NESTL_CHECK_EQ(false, !!err);
+    NESTL_CHECK_EQ(2, *it);
+    NESTL_CHECK_EQ(3, *++it);
+    CheckSetSize(s, 7);
+
+    NESTL_CHECK_EQ(true, std::is_sorted(s.begin(), s.end()));
+    NESTL_CHECK_EQ(2u, s.count(1));
+    NESTL_CHECK_EQ(2u, s.count(2));
+    NESTL_CHECK_EQ(3u, s.count(3));
+    NESTL_CHECK_EQ(0u, s.count(4));
+
+    std::pair<set_t::iterator, set_t::iterator> range = s.equal_range(3);
+    NESTL_CHECK_EQ(3, std::distance(range.first, range.second));
+    NESTL_CHECK_EQ(true, range.second == s.end());
+
+    NESTL_CHECK_EQ(3u, s.erase(3));
+    CheckSetSize(s, 4);
+    s.erase(s.begin());
+    CheckSetSize(s, 3);
+    NESTL_CHECK_EQ(1, *s.begin());
+
+    set_t copy;
+    NESTL_CHECK_OPERATION(copy.copy_nothrow(_, s));
+    CheckSetSize(copy, 3);
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,280 @@
+#include "tests/set/set_test.hpp"
+
+#include <nestl/implementation/detail/key_of_value.hpp>
+#include <nestl/implementation/detail/red_black_tree.hpp>
+#include <nestl/default_operation_error.hpp>
+#include <nestl/vector.hpp>
+
+#include <new>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+typedef nestl::impl::detail::rb_tree<int, int, nestl::impl::detail::identity<int>, std::less<int> > tree_t;
+
+/// @brief Fills tree by count multiples of step inserted in scrambled order, so trees differ in shape
+void FillTree(tree_t& tree, int count, int step)
+{
+    for (int i = 0; i != count; ++i)
+    {
+        const int key = static_cast<int>((static_cast<unsigned int>(i) * 7919u) % static_cast<unsigned int>(count));
+        NESTL_CHECK_OPERATION(tree.m_insert_unique(_, key * step));
+    }
+}
+
+void CheckTree(const tree_t& tree, const int* first, const int* last)
+{
+    NESTL_CHECK_EQ(true, tree.__rb_verify());
+    NESTL_CHECK_EQ(static_cast<size_t>(last - first), tree.size());
+    NESTL_CHECK_EQ(true, nestl::equal(tree.begin(), tree.end(), first));
+}
+
+#if NESTL_HAS_EXCEPTIONS == 1
+
+/// @brief Value whose assignment from 3 throws
+struct throwing_value
+{
+    throwing_value(int v = 0) NESTL_NOEXCEPT_SPEC
+        : value(v)
+    {
+    }
+
+    throwing_value& operator=(const throwing_value& other)
+    {
+        if (other.value == 3)
+        {
+            throw std::bad_alloc();
+        }
+        value = other.value;
+        return *this;
+    }
+
+    bool operator<(const throwing_value& other) const NESTL_NOEXCEPT_SPEC
+    {
+        return value < other.value;
+    }
+
+    int value;
+};
+
+#endif /* NESTL_HAS_EXCEPTIONS */
+
+} // namespace
+
+NESTL_ADD_TEST(set_test_algorithms)
+{
+    const int first[] = {1, 2, 2, 4, 6, 8};
+    const int second[] = {2, 3, 4, 4, 9};
+
+    {
+        int out[11] = {};
+        const int expected[] = {1, 2, 2, 2, 3, 4, 4, 4, 6, 8, 9};
+        int* end = nullptr;
+        NESTL_CHECK_OPERATION(end = nestl::merge(_, std::begin(first), std::end(first),
+                                                 std::begin(second), std::end(second), out));
+        NESTL_CHECK_EQ(11, end - out);
+        NESTL_CHECK_EQ(true, nestl::equal(out, end, std::begin(expected)));
+    }
+
+    {
+        int out[11] = {};
+        const int expected[] = {1, 2, 2, 3, 4, 4, 6, 8, 9};
+        int* end = nullptr;
+        NESTL_CHECK_OPERATION(end = nestl::set_union(_, std::begin(first), std::end(first),
+                                                     std::begin(second), std::end(second), out));
+        NESTL_CHECK_EQ(9, end - out);
+        NESTL_CHECK_EQ(true, nestl::equal(out, end, std::begin(expected)));
+    }
+
+    {
+        int out[11] = {};
+        const int expected[] = {2, 4};
+        int* end = nullptr;
+        NESTL_CHECK_OPERATION(end = nestl::set_intersection(_, std::begin(first), std::end(first),
+                                                            std::begin(second), std::end(second), out));
+        NESTL_CHECK_EQ(2, end - out);
+        NESTL_CHECK_EQ(true, nestl::equal(out, end, std::begin(expected)));
+    }
+
+    {
+        int out[11] = {};
+        const int expected[] = {1, 2, 6, 8};
+        int* end = nullptr;
+        NESTL_CHECK_OPERATION(end = nestl::set_difference(_, std::begin(first), std::end(first),
+                                                          std::begin(second), std::end(second), out));
+        NESTL_CHECK_EQ(4, end - out);
+        NESTL_CHECK_EQ(true, nestl::equal(out, end, std::begin(expected)));
+    }
+
+    // comparator defines order of ranges
+    {
+        const int descending1[] = {5, 3, 1};
+        const int descending2[] = {4, 3};
+        int out[5] = {};
+        const int expected[] = {5, 4, 3, 1};
+        int* end = nullptr;
+        NESTL_CHECK_OPERATION(end = nestl::set_union(_, std::begin(descending1), std::end(descending1),
+                                                     std::begin(descending2), std::end(descending2),
+                                                     out, std::greater<int>()));
+        NESTL_CHECK_EQ(4, end - out);
+        NESTL_CHECK_EQ(true, nestl::equal(out, end, std::begin(expected)));
+    }
+
+    {
+        const int sub[] = {2, 2, 6};
+        const int notSub[] = {2, 2, 2};
+        NESTL_CHECK_EQ(true, nestl::includes(std::begin(first), std::end(first), std::begin(sub), std::end(sub)));
+        NESTL_CHECK_EQ(false, nestl::includes(std::begin(first), std::end(first), std::begin(notSub), std::end(notSub)));
+        NESTL_CHECK_EQ(false, nestl::includes(std::begin(first), std::end(first), std::begin(second), std::end(second)));
+        NESTL_CHECK_EQ(true, nestl::includes(std::begin(first), std::end(first), sub, sub));
+    }
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    // failed assignment stops algorithm at the failed position
+    {
+        const throwing_value values1[] = {1, 2, 5};
+        const throwing_value values2[] = {3, 4};
+        throwing_value out[5];
+
+        nestl::default_operation_error err;
+        throwing_value* end = nestl::set_union(err, std::begin(values1), std::end(values1),
+                                               std::begin(values2), std::end(values2), out);
+        NESTL_CHECK_EQ(true, !!err);
+        NESTL_CHECK_EQ(2, end - out);
+        NESTL_CHECK_EQ(2, out[1].value);
+        NESTL_CHECK_EQ(0, out[2].value);
+    }
+#endif /* NESTL_HAS_EXCEPTIONS */
+}
+
+NESTL_ADD_TEST(set_test_tree_operations)
+{
+    // results of tree operations are valid trees with the same elements as results of algorithms
+    const int sizes[] = {0, 1, 2, 5, 17, 64, 300, 1000};
+    for (int size1 : sizes)
+    {
+        for (int size2 : sizes)
+        {
+            tree_t source1;
+            tree_t source2;
+            FillTree(source1, size1, 2);
+            FillTree(source2, size2, 3);
+
+            nestl::vector<int> expected;
+            NESTL_CHECK_OPERATION(expected.resize_nothrow(_, source1.size() + source2.size()));
+            int* end = nullptr;
+
+            {
+                tree_t tree1;
+                tree_t tree2;
+                NESTL_CHECK_OPERATION(tree1.copy_nothrow(_, source1));
+                NESTL_CHECK_OPERATION(tree2.copy_nothrow(_, source2));
+
+                NESTL_CHECK_OPERATION(end = nestl::set_union(_, source1.begin(), source1.end(),
+                                                             source2.begin(), source2.end(), expected.begin()));
+
+                NESTL_CHECK_OPERATION(tree1.m_unite_unique(_, tree2));
+                CheckTree(tree1, expected.begin(), end);
+                NESTL_CHECK_EQ(true, tree2.__rb_verify());
+                NESTL_CHECK_EQ(0u, tree2.size());
+            }
+
+            {
+                tree_t tree1;
+                tree_t tree2;
+                NESTL_CHECK_OPERATION(tree1.copy_nothrow(_, source1));
+                NESTL_CHECK_OPERATION(tree2.copy_nothrow(_, source2));
+
+                NESTL_CHECK_OPERATION(end = nestl::set_intersection(_, source1.begin(), source1.end(),
+                                                                    source2.begin(), source2.end(), expected.begin()));
+
+                tree1.m_intersect_unique(tree2);
+                CheckTree(tree1, expected.begin(), end);
+                NESTL_CHECK_EQ(0u, tree2.size());
+            }
+
+            {
+                tree_t tree1;
+                tree_t tree2;
+                NESTL_CHECK_OPERATION(tree1.copy_nothrow(_, source1));
+                NESTL_CHECK_OPERATION(tree2.copy_nothrow(_, source2));
+
+                NESTL_CHECK_OPERATION(end = nestl::set_difference(_, source1.begin(), source1.end(),
+                                                                  source2.begin(), source2.end(), expected.begin()));
+
+                tree1.m_subtract_unique(tree2);
+                CheckTree(tree1, expected.begin(), end);
+                NESTL_CHECK_EQ(0u, tree2.size());
+
+                // tree stays valid under regular modifications
+                NESTL_CHECK_OPERATION(tree1.m_insert_unique(_, -1));
+                tree1.erase(tree1.begin());
+                NESTL_CHECK_EQ(true, tree1.__rb_verify());
+            }
+        }
+    }
+}
+
+NESTL_ADD_TEST(set_test_operations_allocators)
+{
+    // nodes are relinked between sets with equal allocators without allocations
+    {
+        typedef nestl::set<int, std::less<int>, budget_allocator<int> > set_t;
+
+        budget_allocator<int>::budget = 4;
+        set_t s1;
+        set_t s2;
+        NESTL_CHECK_OPERATION(s1.insert_nothrow(_, 1));
+        NESTL_CHECK_OPERATION(s1.insert_nothrow(_, 3));
+        NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 2));
+        NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 3));
+        NESTL_CHECK_EQ(0, budget_allocator<int>::budget);
+
+        NESTL_CHECK_OPERATION(s1.unite_nothrow(_, std::move(s2)));
+        const int expected[] = {1, 2, 3};
+        CheckSetSize(s1, 3);
+        CheckSetSize(s2, 0);
+        NESTL_CHECK_EQ(true, nestl::equal(s1.begin(), s1.end(), std::begin(expected)));
+    }
+
+    // elements are moved one by one between sets with different allocators
+    {
+        typedef nestl::set<int, std::less<int>, allocator_with_state<int> > set_t;
+
+        set_t s1;
+        set_t s2;
+        NESTL_CHECK_OPERATION(s1.insert_nothrow(_, 1));
+        NESTL_CHECK_OPERATION(s1.insert_nothrow(_, 3));
+        NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 2));
+        NESTL_CHECK_OPERATION(s2.insert_nothrow(_, 3));
+
+        NESTL_CHECK_OPERATION(s1.unite_nothrow(_, std::move(s2)));
+        const int expected[] = {1, 2, 3};
+        CheckSetSize(s1, 3);
+        CheckSetSize(s2, 0);
+        NESTL_CHECK_EQ(true, nestl::equal(s1.begin(), s1.end(), std::begin(expected)));
+
+        // only nodes of the other set are destroyed by its allocator
+        set_t s3;
+        NESTL_CHECK_OPERATION(s3.insert_nothrow(_, 2));
+        NESTL_CHECK_OPERATION(s3.insert_nothrow(_, 5));
+        s1.intersect(std::move(s3));
+        CheckSetSize(s1, 1);
+        CheckSetSize(s3, 0);
+        NESTL_CHECK_EQ(2, *s1.begin());
+
+        set_t s4;
+        NESTL_CHECK_OPERATION(s4.insert_nothrow(_, 2));
+        s1.subtract(std::move(s4));
+        CheckSetSize(s1, 0);
+        CheckSetSize(s4, 0);
+    }
+}
+
+} // namespace test
+} // namespace nestl
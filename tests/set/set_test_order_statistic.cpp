@@ -0,0 +1,147 @@
+#include "tests/set/set_test.hpp"
+
+#include <nestl/implementation/detail/key_of_value.hpp>
+#include <nestl/implementation/detail/red_black_tree.hpp>
+#include <nestl/default_operation_error.hpp>
+#include <nestl/functional.hpp>
+#include <nestl/tree_policy.hpp>
+#include <nestl/vector.hpp>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+typedef nestl::impl::detail::rb_tree<int,
+                                     int,
+                                     nestl::impl::detail::identity<int>,
+                                     std::less<int>,
+                                     nestl::allocator<int>,
+                                     nestl::order_statistic_tree_policy> tree_t;
+
+/// @brief Checks tree structure, subtree sizes and order statistics of every element
+void CheckOrderStatistics(const tree_t& tree)
+{
+    NESTL_CHECK_EQ(true, tree.__rb_verify());
+
+    size_t index = 0;
+    for (tree_t::const_iterator it = tree.begin(); it != tree.end(); ++it, ++index)
+    {
+        NESTL_CHECK_EQ(true, tree.m_nth(index) == it);
+        NESTL_CHECK_EQ(index, tree.m_rank(*it));
+        NESTL_CHECK_EQ(index + 1, tree.m_rank(*it + 1));
+    }
+    NESTL_CHECK_EQ(tree.size(), index);
+    NESTL_CHECK_EQ(true, tree.m_nth(index) == tree.end());
+}
+
+} // namespace
+
+NESTL_ADD_TEST(set_test_order_statistic_tree)
+{
+    // subtree sizes survive insertions and erasures with rebalancing
+    {
+        tree_t tree;
+        for (int i = 0; i != 500; ++i)
+        {
+            NESTL_CHECK_OPERATION(tree.m_insert_unique(_, static_cast<int>((i * 7919) % 500) * 2));
+        }
+        CheckOrderStatistics(tree);
+        NESTL_CHECK_EQ(0u, tree.m_rank(-1));
+        NESTL_CHECK_EQ(500u, tree.m_rank(1000));
+
+        for (int i = 0; i < 500; i += 3)
+        {
+            NESTL_CHECK_EQ(1u, tree.erase(static_cast<int>((i * 7919) % 500) * 2));
+        }
+        CheckOrderStatistics(tree);
+
+        // erasure of inner nodes, whose successor takes their place
+        while (tree.size() > 10)
+        {
+            tree.erase(tree.m_nth(tree.size() / 2));
+        }
+        CheckOrderStatistics(tree);
+
+        tree_t copy;
+        NESTL_CHECK_OPERATION(copy.copy_nothrow(_, tree));
+        CheckOrderStatistics(copy);
+    }
+
+    // subtree sizes of trees built from sorted range and by split and join
+    {
+        nestl::vector<int> values;
+        for (int i = 0; i != 300; ++i)
+        {
+            NESTL_CHECK_OPERATION(values.push_back_nothrow(_, i * 2));
+        }
+
+        tree_t tree;
+        NESTL_CHECK_OPERATION(tree.m_assign_sorted_unique(_, values.begin(), values.end()));
+        CheckOrderStatistics(tree);
+
+        tree_t other;
+        for (int i = 0; i != 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(other.m_insert_unique(_, i * 5));
+        }
+        NESTL_CHECK_OPERATION(tree.m_unite_unique(_, other));
+        NESTL_CHECK_EQ(350u, tree.size());
+        CheckOrderStatistics(tree);
+
+        for (int i = 0; i != 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(other.m_insert_unique(_, i * 3));
+        }
+        tree.m_subtract_unique(other);
+        NESTL_CHECK_EQ(290u, tree.size());
+        CheckOrderStatistics(tree);
+
+        for (int i = 0; i != 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(other.m_insert_unique(_, i * 7));
+        }
+        tree.m_intersect_unique(other);
+        NESTL_CHECK_EQ(41u, tree.size());
+        CheckOrderStatistics(tree);
+    }
+}
+
+NESTL_ADD_TEST(set_test_order_statistic)
+{
+    typedef nestl::set<int, nestl::less<>, nestl::allocator<int>, nestl::order_statistic_tree_policy> set_t;
+
+    set_t scores;
+    const int values[] = {50, 10, 40, 30, 20};
+    for (int value : values)
+    {
+        NESTL_CHECK_OPERATION(scores.insert_nothrow(_, value));
+    }
+    CheckSetSize(scores, 5);
+
+    NESTL_CHECK_EQ(10, *scores.nth(0));
+    NESTL_CHECK_EQ(30, *scores.nth(2));
+    NESTL_CHECK_EQ(50, *scores.nth(4));
+    NESTL_CHECK_EQ(true, scores.nth(5) == scores.end());
+
+    const set_t& cscores = scores;
+    NESTL_CHECK_EQ(40, *cscores.nth(3));
+
+    NESTL_CHECK_EQ(0u, scores.rank(10));
+    NESTL_CHECK_EQ(2u, scores.rank(30));
+    NESTL_CHECK_EQ(3u, scores.rank(35));
+    NESTL_CHECK_EQ(5u, scores.rank(100));
+
+    // transparent comparator ranks values of other types without conversion
+    NESTL_CHECK_EQ(3u, scores.rank(30.5));
+
+    scores.erase(30);
+    NESTL_CHECK_EQ(40, *scores.nth(2));
+    NESTL_CHECK_EQ(2u, scores.rank(40));
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,63 @@
+#include "tests/shared_ptr/shared_ptr_test.hpp"
+#include "tests/allocators.hpp"
+
+#include <nestl/memory_resource.hpp>
+#include <nestl/monotonic_buffer.hpp>
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(shared_ptr_test_allocator)
+{
+    // control block is allocated by copy of given allocator
+    {
+        allocator_with_state<int> alloc;
+
+        shared_ptr<int> sp;
+        NESTL_CHECK_OPERATION(sp = allocate_shared_nothrow<int>(_, alloc, 42));
+        CheckSharedPtr(sp, 1);
+        NESTL_CHECK_EQ(42, *sp);
+        NESTL_CHECK_EQ(1u, alloc.m_allocated_storage->size());
+
+        sp.reset();
+        NESTL_CHECK_EQ(true, alloc.m_allocated_storage->empty());
+    }
+
+    // allocator without rebind member
+    {
+        minimal_allocator<int> alloc;
+
+        shared_ptr<int> sp;
+        NESTL_CHECK_OPERATION(sp = allocate_shared_nothrow<int>(_, alloc, 42));
+        CheckSharedPtr(sp, 1);
+    }
+
+    // control block goes to arena
+    {
+        nestl::monotonic_buffer arena;
+        nestl::polymorphic_allocator<int> alloc(&arena);
+
+        shared_ptr<int> sp;
+        NESTL_CHECK_OPERATION(sp = allocate_shared_nothrow<int>(_, alloc, 42));
+        CheckSharedPtr(sp, 1);
+        NESTL_CHECK_EQ(1u, arena.chunk_count());
+    }
+
+    // allocation failure is reported
+    {
+        zero_allocator<int> alloc;
+
+        nestl::default_operation_error err;
+        shared_ptr<int> sp = allocate_shared_nothrow<int>(err, alloc, 42);
+        if (!err)
+        {
+            fatal_failure("allocation by zero_allocator should fail");
+        }
+        CheckSharedPtr(sp, 0);
+    }
+}
+
+} // namespace test
+} // namespace nestl
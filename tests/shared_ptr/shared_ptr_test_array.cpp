@@ -0,0 +1,217 @@
+#include "tests/shared_ptr/shared_ptr_test.hpp"
+#include "tests/allocators.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+/// counts alive elements, construction fails when budget of constructions is exhausted
+struct fragile_element
+{
+    fragile_element() NESTL_NOEXCEPT_SPEC
+        : value(0)
+    {
+        ++alive;
+    }
+
+    ~fragile_element() NESTL_NOEXCEPT_SPEC
+    {
+        --alive;
+    }
+
+    int value;
+
+    static int alive;
+    static int budget;
+
+private:
+    fragile_element(const fragile_element&) = delete;
+    fragile_element& operator=(const fragile_element&) = delete;
+};
+
+int fragile_element::alive = 0;
+int fragile_element::budget = 0;
+
+
+/// aligned stricter than control block, but still supported by global operator new
+struct alignas(alignof(std::max_align_t)) over_aligned
+{
+    over_aligned() NESTL_NOEXCEPT_SPEC
+        : value(1)
+    {
+    }
+
+    int value;
+};
+
+struct array_base
+{
+    int value;
+};
+
+struct array_derived : public array_base
+{
+    int extra;
+};
+
+// indexing of array through pointer to base would use wrong element size
+static_assert(!std::is_constructible<shared_ptr<array_base[]>, const shared_ptr<array_derived[]>&>::value,
+              "array of derived elements should not be converted to array of base ones");
+static_assert(!std::is_assignable<shared_ptr<array_base[]>&, shared_ptr<array_derived[]>&&>::value,
+              "array of derived elements should not be assigned to array of base ones");
+static_assert(!std::is_constructible<shared_ptr<int>, const shared_ptr<int[]>&>::value,
+              "array should not be converted to single object");
+static_assert(!std::is_constructible<shared_ptr<int[]>, const shared_ptr<int>&>::value,
+              "single object should not be converted to array");
+static_assert(std::is_constructible<shared_ptr<const int[]>, const shared_ptr<int[]>&>::value,
+              "array of const elements should be constructible from array of mutable ones");
+static_assert(std::is_constructible<shared_ptr<array_base>, const shared_ptr<array_derived>&>::value,
+              "pointer to derived should be converted to pointer to base");
+
+} // namespace
+
+} // namespace test
+
+
+template <>
+struct two_phase_initializator<test::fragile_element>
+{
+    template <typename OperationError>
+    static void init(OperationError& err, test::fragile_element& defaultConstructed, int value) NESTL_NOEXCEPT_SPEC
+    {
+        if (test::fragile_element::budget == 0)
+        {
+            build_bad_alloc(err);
+            return;
+        }
+
+        --test::fragile_element::budget;
+        defaultConstructed.value = value;
+    }
+};
+
+
+namespace test
+{
+
+NESTL_ADD_TEST(shared_ptr_test_array)
+{
+    // elements are value initialized
+    {
+        shared_ptr<int[]> sp;
+        NESTL_CHECK_OPERATION(sp = make_shared_nothrow<int[]>(_, 10));
+        CheckSharedPtr(sp, 1);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            NESTL_CHECK_EQ(0, sp[i]);
+        }
+
+        sp[9] = 42;
+        NESTL_CHECK_EQ(42, sp.get()[9]);
+    }
+
+    // elements are constructed from given value, weak pointer observes array
+    {
+        shared_ptr<int[], nestl::single_thread_refcount_policy> sp;
+        NESTL_CHECK_OPERATION((sp = make_shared_nothrow<int[], nestl::single_thread_refcount_policy>(_, 5, 7)));
+
+        for (int i = 0; i < 5; ++i)
+        {
+            NESTL_CHECK_EQ(7, sp[i]);
+        }
+
+        weak_ptr<int[], nestl::single_thread_refcount_policy> wp(sp);
+        NESTL_CHECK_EQ(7, wp.lock()[4]);
+
+        sp.reset();
+        NESTL_CHECK_EQ(true, wp.expired());
+    }
+
+    // empty array still owns control block
+    {
+        shared_ptr<int[]> sp;
+        NESTL_CHECK_OPERATION(sp = make_shared_nothrow<int[]>(_, 0));
+        CheckSharedPtr(sp, 1);
+    }
+
+    // control block and elements share one allocation
+    {
+        allocator_with_state<int> alloc;
+
+        shared_ptr<int[]> sp;
+        NESTL_CHECK_OPERATION(sp = allocate_shared_nothrow<int[]>(_, alloc, 1000, 3));
+        NESTL_CHECK_EQ(1u, alloc.m_allocated_storage->size());
+        NESTL_CHECK_EQ(3, sp[999]);
+
+        sp.reset();
+        NESTL_CHECK_EQ(true, alloc.m_allocated_storage->empty());
+    }
+
+    // elements are aligned even if control block is not aligned for them
+    {
+        shared_ptr<over_aligned[]> sp;
+        NESTL_CHECK_OPERATION(sp = make_shared_nothrow<over_aligned[]>(_, 3));
+        NESTL_CHECK_EQ(0u, reinterpret_cast<std::uintptr_t>(sp.get()) % alignof(over_aligned));
+        NESTL_CHECK_EQ(1, sp[2].value);
+    }
+
+    // partially constructed array is destroyed and memory is returned on failure
+    {
+        allocator_with_state<fragile_element> alloc;
+
+        fragile_element::budget = 3;
+
+        nestl::default_operation_error err;
+        shared_ptr<fragile_element[]> sp = allocate_shared_nothrow<fragile_element[]>(err, alloc, 5, 1);
+        if (!err)
+        {
+            fatal_failure("construction of array should fail");
+        }
+        CheckSharedPtr(sp, 0);
+        NESTL_CHECK_EQ(0, fragile_element::alive);
+        NESTL_CHECK_EQ(true, alloc.m_allocated_storage->empty());
+
+        fragile_element::budget = 5;
+        NESTL_CHECK_OPERATION(sp = allocate_shared_nothrow<fragile_element[]>(_, alloc, 5, 1));
+        NESTL_CHECK_EQ(5, fragile_element::alive);
+
+        sp.reset();
+        NESTL_CHECK_EQ(0, fragile_element::alive);
+    }
+
+    // failed allocation is reported
+    {
+        zero_allocator<int> alloc;
+
+        nestl::default_operation_error err;
+        shared_ptr<int[]> sp = allocate_shared_nothrow<int[]>(err, alloc, 10);
+        if (!err)
+        {
+            fatal_failure("allocation by zero_allocator should fail");
+        }
+        CheckSharedPtr(sp, 0);
+    }
+
+    // size which does not fit in memory is reported
+    {
+        nestl::default_operation_error err;
+        shared_ptr<int[]> sp = make_shared_nothrow<int[]>(err, static_cast<std::size_t>(-1) / 2);
+        if (!err)
+        {
+            fatal_failure("allocation of huge array should fail");
+        }
+        CheckSharedPtr(sp, 0);
+    }
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,105 @@
+#include "tests/shared_ptr/shared_ptr_test.hpp"
+
+#include <thread>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+template <typename RefCountPolicy>
+void CheckWeakLock()
+{
+    typedef nestl::shared_ptr<int, RefCountPolicy> shared_ptr_t;
+    typedef nestl::weak_ptr<int, RefCountPolicy> weak_ptr_t;
+
+    shared_ptr_t sp;
+    NESTL_CHECK_OPERATION((sp = make_shared_nothrow<int, RefCountPolicy>(_, 42)));
+    CheckSharedPtr(sp, 1);
+
+    weak_ptr_t wp(sp);
+    NESTL_CHECK_EQ(false, wp.expired());
+
+    {
+        shared_ptr_t locked = wp.lock();
+        CheckSharedPtr(locked, 2);
+        NESTL_CHECK_EQ(42, *locked);
+    }
+    CheckSharedPtr(sp, 1);
+
+    // expired pointer is not resurrected by lock
+    sp.reset();
+    NESTL_CHECK_EQ(true, wp.expired());
+
+    shared_ptr_t locked = wp.lock();
+    CheckSharedPtr(locked, 0);
+    NESTL_CHECK_EQ(true, wp.expired());
+
+    // weak pointer keeps control block alive after object is destroyed
+    weak_ptr_t other(std::move(wp));
+    NESTL_CHECK_EQ(0, wp.use_count());
+    NESTL_CHECK_EQ(true, other.expired());
+}
+
+} // namespace
+
+
+NESTL_ADD_TEST(shared_ptr_test_refcount)
+{
+    CheckWeakLock<nestl::atomic_refcount_policy>();
+    CheckWeakLock<nestl::single_thread_refcount_policy>();
+
+    // copies and locks from several threads keep counters consistent
+    {
+        shared_ptr<int> sp;
+        NESTL_CHECK_OPERATION(sp = make_shared_nothrow<int>(_, 42));
+        const weak_ptr<int> wp(sp);
+
+        const int ThreadCount = 4;
+        const int Iterations = 10000;
+
+        std::thread threads[ThreadCount];
+        for (std::thread& t : threads)
+        {
+            t = std::thread([&sp, &wp]()
+            {
+                for (int i = 0; i != Iterations; ++i)
+                {
+                    shared_ptr<int> copy(sp);
+                    shared_ptr<int> locked = wp.lock();
+                    if (!locked || *locked != 42)
+                    {
+                        fatal_failure("weak_ptr::lock failed for alive object");
+                    }
+                }
+            });
+        }
+
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+
+        CheckSharedPtr(sp, 1);
+
+        // the last owner and lock race, lock either fails or keeps object alive
+        std::thread releaser([&sp]()
+        {
+            sp.reset();
+        });
+
+        shared_ptr<int> locked = wp.lock();
+        if (locked && *locked != 42)
+        {
+            fatal_failure("weak_ptr::lock returned destroyed object");
+        }
+
+        releaser.join();
+    }
+}
+
+} // namespace test
+} // namespace nestl
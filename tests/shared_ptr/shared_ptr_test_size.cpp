@@ -0,0 +1,59 @@
+#include "tests/shared_ptr/shared_ptr_test.hpp"
+#include "tests/allocators.hpp"
+
+#include <nestl/allocator.hpp>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+template <typename T, typename Allocator, typename RefCountPolicy = nestl::default_refcount_policy>
+struct control_block
+{
+    typedef nestl::impl::type_stored_by_value<T, Allocator, RefCountPolicy> type;
+};
+
+template <typename T>
+std::size_t round_up(std::size_t size)
+{
+    return (size + alignof(T) - 1) / alignof(T) * alignof(T);
+}
+
+} // namespace
+
+
+NESTL_ADD_TEST(shared_ptr_test_size)
+{
+    typedef nestl::impl::shared_count_base<nestl::atomic_refcount_policy> atomic_base;
+    typedef nestl::impl::shared_count_base<nestl::single_thread_refcount_policy> single_thread_base;
+
+    // control block keeps destroyer and two counters only, there is no vtable
+    static_assert(sizeof(atomic_base) == sizeof(void (*)()) + 2 * sizeof(int),
+                  "unexpected size of control block");
+    static_assert(sizeof(single_thread_base) == sizeof(atomic_base),
+                  "policies should have the same layout");
+
+    // empty allocator takes no space, value follows the counters
+    typedef control_block<int, nestl::allocator<int> >::type int_block;
+    NESTL_CHECK_EQ(round_up<int_block>(sizeof(atomic_base) + sizeof(int)), sizeof(int_block));
+
+    typedef control_block<char, nestl::allocator<char> >::type char_block;
+    NESTL_CHECK_EQ(round_up<char_block>(sizeof(atomic_base) + sizeof(char)), sizeof(char_block));
+
+    typedef control_block<int, nestl::allocator<int>, nestl::single_thread_refcount_policy>::type single_thread_int_block;
+    NESTL_CHECK_EQ(sizeof(int_block), sizeof(single_thread_int_block));
+
+    // on platforms with 8 byte pointers block of int fits in 24 bytes
+    NESTL_CHECK_EQ(true, sizeof(int_block) <= 3 * sizeof(void*));
+
+    // stateful allocator is stored next to the value
+    typedef control_block<int, allocator_with_state<int> >::type stateful_block;
+    NESTL_CHECK_EQ(true, sizeof(stateful_block) >= sizeof(atomic_base) + sizeof(allocator_with_state<int>));
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,200 @@
+#include <nestl/small_vector.hpp>
+
+#include "tests/vector/vector_test.hpp"
+
+namespace nestl
+{
+namespace test
+{
+
+template <typename Vector>
+void CheckSequence(const Vector& vec, int count, int first = 0)
+{
+    CheckVectorSize(vec, count);
+    for (int i = 0; i < count; ++i)
+    {
+        NESTL_CHECK_EQ(first + i, vec[i]);
+    }
+}
+
+template <typename Vector>
+void CheckSwap(int leftCount, int rightCount)
+{
+    Vector left;
+    FillVector(left, leftCount, 0);
+
+    Vector right;
+    FillVector(right, rightCount, 100);
+
+    left.swap(right);
+    CheckSequence(left, rightCount, 100);
+    CheckSequence(right, leftCount, 0);
+
+    left.swap(right);
+    CheckSequence(left, leftCount, 0);
+    CheckSequence(right, rightCount, 100);
+}
+
+
+NESTL_ADD_TEST(small_vector_test_inline)
+{
+    // inline elements do not use allocator
+    {
+        nestl::small_vector<int, 4, zero_allocator<int> > vec;
+        CheckVectorSize(vec, 0);
+        NESTL_CHECK_EQ(4u, vec.capacity());
+
+        FillVector(vec, 4);
+        CheckSequence(vec, 4);
+
+        nestl::default_operation_error err;
+        vec.push_back_nothrow(err, 4);
+        if (!err)
+        {
+            fatal_failure("allocation failure should be reported");
+        }
+        CheckSequence(vec, 4);
+
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 3));
+        NESTL_CHECK_OPERATION(vec.resize_nothrow(_, 3));
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), 10));
+        NESTL_CHECK_EQ(10, vec[0]);
+        NESTL_CHECK_EQ(2, vec[3]);
+
+        // vector is full, so insertion should fail
+        nestl::default_operation_error insertErr;
+        vec.insert_nothrow(insertErr, vec.begin(), 10);
+        if (!insertErr)
+        {
+            fatal_failure("allocation failure should be reported");
+        }
+    }
+
+    // elements spill to allocator
+    {
+        nestl::small_vector<int, 4, allocator_with_state<int> > vec;
+        FillVector(vec, 100);
+        CheckSequence(vec, 100);
+
+        // shrink back into inline buffer
+        NESTL_CHECK_OPERATION(vec.resize_nothrow(_, 3));
+        NESTL_CHECK_OPERATION(vec.shrink_to_fit_nothrow(_));
+        CheckSequence(vec, 3);
+        NESTL_CHECK_EQ(4u, vec.capacity());
+
+        NESTL_CHECK_OPERATION(vec.shrink_to_fit_nothrow(_));
+        NESTL_CHECK_EQ(4u, vec.capacity());
+    }
+
+    // insertion in the middle of inline buffer
+    {
+        nestl::small_vector<int, 8> vec;
+        FillVector(vec, 4);
+
+        const int values[] = {10, 11};
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 2, values, values + 2));
+        NESTL_CHECK_OPERATION(vec.emplace_nothrow(_, vec.begin(), 12));
+
+        CheckVectorSize(vec, 7);
+        NESTL_CHECK_EQ(12, vec[0]);
+        NESTL_CHECK_EQ(0, vec[1]);
+        NESTL_CHECK_EQ(1, vec[2]);
+        NESTL_CHECK_EQ(10, vec[3]);
+        NESTL_CHECK_EQ(11, vec[4]);
+        NESTL_CHECK_EQ(2, vec[5]);
+        NESTL_CHECK_EQ(3, vec[6]);
+    }
+
+    // copy
+    {
+        nestl::small_vector<int, 4> vec1;
+        FillVector(vec1, 3);
+
+        nestl::small_vector<int, 4> vec2;
+        NESTL_CHECK_OPERATION(vec2.assign_nothrow(_, vec1.begin(), vec1.end()));
+        CheckSequence(vec2, 3);
+        CheckSequence(vec1, 3);
+    }
+}
+
+
+NESTL_ADD_TEST(small_vector_test_move)
+{
+    typedef nestl::small_vector<int, 4> vector_t;
+
+    // move inline elements
+    {
+        vector_t vec1;
+        FillVector(vec1, 3);
+
+        vector_t vec2(std::move(vec1));
+        CheckSequence(vec2, 3);
+        CheckVectorSize(vec1, 0);
+
+        vector_t vec3;
+        FillVector(vec3, 10, 50);
+        vec3 = std::move(vec2);
+        CheckSequence(vec3, 3);
+        CheckVectorSize(vec2, 0);
+    }
+
+    // move allocated elements
+    {
+        vector_t vec1;
+        FillVector(vec1, 10);
+
+        vector_t vec2(std::move(vec1));
+        CheckSequence(vec2, 10);
+        CheckVectorSize(vec1, 0);
+        NESTL_CHECK_EQ(4u, vec1.capacity());
+
+        // source is still usable
+        FillVector(vec1, 2);
+        CheckSequence(vec1, 2);
+
+        vector_t vec3;
+        FillVector(vec3, 2, 50);
+        vec3 = std::move(vec2);
+        CheckSequence(vec3, 10);
+    }
+
+    // swap all combinations of inline and allocated storage
+    typedef nestl::small_vector<int, 4, allocator_with_state<int> > stateful_vector_t;
+    CheckSwap<stateful_vector_t>(0, 0);
+    CheckSwap<stateful_vector_t>(1, 3);
+    CheckSwap<stateful_vector_t>(4, 2);
+    CheckSwap<stateful_vector_t>(2, 10);
+    CheckSwap<stateful_vector_t>(10, 0);
+    CheckSwap<stateful_vector_t>(10, 20);
+
+    // non copyable elements
+    {
+        nestl::small_vector<non_copyable, 2> vec1;
+        NESTL_CHECK_OPERATION(vec1.emplace_back_nothrow(_, 1));
+        NESTL_CHECK_OPERATION(vec1.emplace_back_nothrow(_, 2));
+
+        nestl::small_vector<non_copyable, 2> vec2(std::move(vec1));
+        CheckVectorSize(vec2, 2);
+        NESTL_CHECK_EQ(1, vec2[0].v);
+        NESTL_CHECK_EQ(2, vec2[1].v);
+
+        NESTL_CHECK_OPERATION(vec2.emplace_back_nothrow(_, 3));
+        CheckVectorSize(vec2, 3);
+        NESTL_CHECK_EQ(3, vec2[2].v);
+    }
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    {
+        nestl::has_exceptions::small_vector<int, 2> vec;
+        vec.push_back(1);
+        vec.push_back(2);
+        vec.push_back(3);
+
+        nestl::has_exceptions::small_vector<int, 2> copy(vec);
+        CheckSequence(copy, 3, 1);
+    }
+#endif /* NESTL_HAS_EXCEPTIONS */
+}
+
+} // namespace test
+} // namespace nestl
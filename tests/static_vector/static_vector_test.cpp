@@ -0,0 +1,275 @@
+#include <nestl/static_vector.hpp>
+
+#include "tests/vector/vector_test.hpp"
+
+#include <iterator>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+/// type with potentially throwing move constructor, static_vector shifts it by copying
+struct copy_shifted
+{
+    copy_shifted(int x = 0) NESTL_NOEXCEPT_SPEC
+        : v(x)
+    {
+    }
+
+    copy_shifted(const copy_shifted& other) NESTL_NOEXCEPT_SPEC
+        : v(other.v)
+    {
+    }
+
+    copy_shifted(copy_shifted&& other)
+        : v(other.v)
+    {
+    }
+
+    ~copy_shifted() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    int v;
+};
+
+/// assignable type with potentially throwing move constructor, static_vector shifts it by assignment
+struct assignable_copy_shifted
+{
+    assignable_copy_shifted(int x = 0) NESTL_NOEXCEPT_SPEC
+        : v(x)
+    {
+    }
+
+    assignable_copy_shifted(const assignable_copy_shifted& other) NESTL_NOEXCEPT_SPEC
+        : v(other.v)
+    {
+    }
+
+    assignable_copy_shifted(assignable_copy_shifted&& other)
+        : v(other.v)
+    {
+    }
+
+    assignable_copy_shifted& operator=(const assignable_copy_shifted& other) NESTL_NOEXCEPT_SPEC
+    {
+        v = other.v;
+        return *this;
+    }
+
+    ~assignable_copy_shifted() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    int v;
+};
+
+} // namespace
+
+
+/// @brief Appends range and copies of value at end, then inserts range in the middle
+template <typename T>
+void CheckAppend()
+{
+    nestl::static_vector<T, 8> vec;
+
+    const int range[] = {0, 1, 2};
+    NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.end(), std::begin(range), std::end(range)));
+    NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.end(), 2, T(7)));
+    NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 1, std::begin(range), std::begin(range) + 2));
+
+    CheckVectorValues(vec, {0, 0, 1, 1, 2, 7, 7});
+}
+
+void CheckLengthError(const nestl::default_operation_error& err)
+{
+    if (!err)
+    {
+        fatal_failure("length error should be reported");
+    }
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    try
+    {
+        std::rethrow_exception(err.value());
+    }
+    catch (const std::length_error&)
+    {
+        return;
+    }
+    catch (...)
+    {
+    }
+    fatal_failure("unexpected error type");
+#else
+    NESTL_CHECK_EQ(static_cast<int>(nestl::errc::value_too_large), err.value());
+#endif
+}
+
+
+NESTL_ADD_TEST(static_vector_test_capacity)
+{
+    typedef nestl::static_vector<int, 4> vector_t;
+
+    vector_t vec;
+    CheckVectorSize(vec, 0);
+    NESTL_CHECK_EQ(4u, vec.capacity());
+    NESTL_CHECK_EQ(4u, vec.max_size());
+
+    FillVector(vec, 4);
+    CheckVectorValues(vec, {0, 1, 2, 3});
+
+    // exceeding capacity reports length error and leaves vector untouched
+    {
+        nestl::default_operation_error err;
+        vec.push_back_nothrow(err, 4);
+        CheckLengthError(err);
+        CheckVectorValues(vec, {0, 1, 2, 3});
+    }
+
+    {
+        nestl::default_operation_error err;
+        vec.insert_nothrow(err, vec.begin(), 4);
+        CheckLengthError(err);
+        CheckVectorValues(vec, {0, 1, 2, 3});
+    }
+
+    {
+        nestl::default_operation_error err;
+        vec.resize_nothrow(err, 5);
+        CheckLengthError(err);
+        CheckVectorValues(vec, {0, 1, 2, 3});
+    }
+
+    {
+        nestl::default_operation_error err;
+        vec.reserve_nothrow(err, 5);
+        CheckLengthError(err);
+        NESTL_CHECK_EQ(4u, vec.capacity());
+    }
+
+    {
+        const int values[] = {10, 11, 12, 13, 14};
+
+        vector_t other;
+        nestl::default_operation_error err;
+        other.assign_nothrow(err, values, values + 5);
+        CheckLengthError(err);
+    }
+
+    // shrink keeps inline buffer
+    NESTL_CHECK_OPERATION(vec.resize_nothrow(_, 1));
+    NESTL_CHECK_OPERATION(vec.shrink_to_fit_nothrow(_));
+    CheckVectorValues(vec, {0});
+    NESTL_CHECK_EQ(4u, vec.capacity());
+}
+
+
+NESTL_ADD_TEST(static_vector_test_modifiers)
+{
+    typedef nestl::static_vector<int, 8> vector_t;
+
+    // erase and pop_back
+    {
+        vector_t vec;
+        FillVector(vec, 6);
+
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin() + 1));
+        CheckVectorValues(vec, {0, 2, 3, 4, 5});
+
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin() + 1, vec.begin() + 3));
+        CheckVectorValues(vec, {0, 4, 5});
+
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin(), vec.begin()));
+        CheckVectorValues(vec, {0, 4, 5});
+
+        vec.pop_back();
+        CheckVectorValues(vec, {0, 4});
+    }
+
+    // insertion of several copies of value
+    {
+        vector_t vec;
+        FillVector(vec, 3);
+
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 1, 2, 7));
+        CheckVectorValues(vec, {0, 7, 7, 1, 2});
+
+        // value refers to element of vector
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), vector_t::size_type(2), vec[4]));
+        CheckVectorValues(vec, {2, 2, 0, 7, 7, 1, 2});
+
+        nestl::default_operation_error err;
+        vec.insert_nothrow(err, vec.begin(), vector_t::size_type(2), 9);
+        CheckLengthError(err);
+        CheckVectorValues(vec, {2, 2, 0, 7, 7, 1, 2});
+    }
+
+    // elements which are shifted by copying
+    {
+        nestl::static_vector<copy_shifted, 6> vec;
+        FillVector(vec, 4);
+
+        NESTL_CHECK_OPERATION(vec.emplace_nothrow(_, vec.begin() + 1, 10));
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin() + 3, vec.end()));
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin()));
+
+        CheckVectorValues(vec, {10, 1});
+    }
+
+    // elements which are not nothrow movable are appended at end without shifting
+    CheckAppend<copy_shifted>();
+    CheckAppend<assignable_copy_shifted>();
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    {
+        nestl::static_vector<assign_shifted, 6> vec;
+        FillVector(vec, 4);
+
+        NESTL_CHECK_OPERATION(vec.emplace_nothrow(_, vec.begin() + 1, 10));
+        NESTL_CHECK_OPERATION(vec.emplace_nothrow(_, vec.begin(), vec[3]));
+
+        CheckVectorValues(vec, {2, 0, 10, 1, 2, 3});
+    }
+#endif
+
+    // move and swap
+    {
+        vector_t vec1;
+        FillVector(vec1, 3);
+
+        vector_t vec2(std::move(vec1));
+        CheckVectorValues(vec2, {0, 1, 2});
+        CheckVectorSize(vec1, 0);
+
+        FillVector(vec1, 5, 10);
+        vec1.swap(vec2);
+        CheckVectorValues(vec1, {0, 1, 2});
+        CheckVectorValues(vec2, {10, 11, 12, 13, 14});
+    }
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    {
+        nestl::has_exceptions::static_vector<int, 1> vec;
+        vec.push_back(1);
+
+        bool thrown = false;
+        try
+        {
+            vec.push_back(2);
+        }
+        catch (const std::length_error&)
+        {
+            thrown = true;
+        }
+        NESTL_CHECK_EQ(true, thrown);
+    }
+#endif
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,52 @@
+#ifndef NESTL_TESTS_STRING_STRING_TEST_HPP
+#define NESTL_TESTS_STRING_STRING_TEST_HPP
+
+#include <nestl/string.hpp>
+
+#include "tests/test_common.hpp"
+#include "tests/allocators.hpp"
+
+#include <cstring>
+#include <iterator>
+
+namespace nestl
+{
+namespace test
+{
+
+template <typename String>
+void CheckString(const String& s, const char* expected)
+{
+    const std::size_t expectedSize = std::strlen(expected);
+
+    if (s.size() != expectedSize)
+    {
+        fatal_failure("expected size: ", expectedSize, ", got: ", s.size());
+    }
+
+    if (s.empty() != (expectedSize == 0))
+    {
+        fatal_failure("string empty method returns ", s.empty(), ", while size is ", expectedSize);
+    }
+
+    if (s.capacity() < s.size())
+    {
+        fatal_failure("capacity should be at least ", s.size(), " characters, got ", s.capacity());
+    }
+
+    const std::size_t dist = std::distance(s.cbegin(), s.cend());
+    if (dist != expectedSize)
+    {
+        fatal_failure("distance between iterators should be ", expectedSize, ", got ", dist);
+    }
+
+    if (std::strcmp(s.c_str(), expected) != 0)
+    {
+        fatal_failure("expected content: \"", expected, "\", got: \"", s.c_str(), "\"");
+    }
+}
+
+} // namespace test
+} // namespace nestl
+
+#endif /* NESTL_TESTS_STRING_STRING_TEST_HPP */
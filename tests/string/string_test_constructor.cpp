@@ -0,0 +1,175 @@
+#include "tests/string/string_test.hpp"
+
+#include <nestl/vector.hpp>
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(string_test_constructor)
+{
+    // default constructed string is empty and terminated
+    {
+        nestl::string s;
+        CheckString(s, "");
+        NESTL_CHECK_EQ(nestl::string::inline_capacity, s.capacity());
+    }
+
+    // at least 15 characters are stored inline on 64-bit platforms
+    {
+        static_assert(sizeof(void*) < 8 || nestl::string::inline_capacity >= 15, "inline buffer is too small");
+
+        zero_allocator<char> alloc;
+        nestl::no_exceptions::basic_string<char, std::char_traits<char>, zero_allocator<char> > s(alloc);
+
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "0123456789abcde"));
+        CheckString(s, "0123456789abcde");
+
+        // the next character requires heap
+        nestl::default_operation_error err;
+        s.push_back_nothrow(err, 'f');
+        if (!err)
+        {
+            fatal_failure("zero_allocator should not be able to allocate");
+        }
+        CheckString(s, "0123456789abcde");
+    }
+
+    // short and long strings are moved
+    {
+        const char* values[] = {"short", "long string which does not fit into inline buffer"};
+        for (const char* value : values)
+        {
+            nestl::string s1;
+            NESTL_CHECK_OPERATION(s1.assign_nothrow(_, value));
+            const char* data = s1.data();
+
+            nestl::string s2(std::move(s1));
+            CheckString(s2, value);
+            CheckString(s1, "");
+
+            // heap storage is taken by new string
+            NESTL_CHECK_EQ(std::strlen(value) > nestl::string::inline_capacity, data == s2.data());
+
+            nestl::string s3;
+            NESTL_CHECK_OPERATION(s3.assign_nothrow(_, "previous content"));
+            s3 = std::move(s2);
+            CheckString(s3, value);
+            CheckString(s2, "");
+        }
+    }
+
+    // copy of string
+    {
+        nestl::string s1;
+        NESTL_CHECK_OPERATION(s1.assign_nothrow(_, "some string which is long enough"));
+
+        nestl::string s2;
+        NESTL_CHECK_OPERATION(s2.copy_nothrow(_, s1));
+        CheckString(s2, "some string which is long enough");
+        NESTL_CHECK_EQ(true, s1 == s2);
+        NESTL_CHECK_EQ(true, s1.data() != s2.data());
+    }
+
+    // swap of inline and heap strings
+    {
+        nestl::string s1;
+        NESTL_CHECK_OPERATION(s1.assign_nothrow(_, "abc"));
+
+        nestl::string s2;
+        NESTL_CHECK_OPERATION(s2.assign_nothrow(_, "string which lives in heap storage"));
+
+        s1.swap(s2);
+        CheckString(s1, "string which lives in heap storage");
+        CheckString(s2, "abc");
+
+        s1.swap(s2);
+        CheckString(s1, "abc");
+        CheckString(s2, "string which lives in heap storage");
+    }
+
+    // memory is returned to allocator
+    {
+        typedef nestl::no_exceptions::basic_string<char, std::char_traits<char>, allocator_with_state<char> > string_t;
+
+        allocator_with_state<char> alloc;
+        {
+            string_t s(alloc);
+            NESTL_CHECK_OPERATION(s.assign_nothrow(_, "string which lives in heap storage"));
+            NESTL_CHECK_EQ(1u, alloc.m_allocated_storage->size());
+
+            NESTL_CHECK_OPERATION(s.append_nothrow(_, s));
+            NESTL_CHECK_EQ(1u, alloc.m_allocated_storage->size());
+
+            NESTL_CHECK_OPERATION(s.resize_nothrow(_, 3));
+            NESTL_CHECK_OPERATION(s.shrink_to_fit_nothrow(_));
+            NESTL_CHECK_EQ(true, alloc.m_allocated_storage->empty());
+            NESTL_CHECK_EQ(string_t::inline_capacity, s.capacity());
+        }
+        NESTL_CHECK_EQ(true, alloc.m_allocated_storage->empty());
+    }
+
+    // move between different allocators copies characters
+    {
+        typedef nestl::no_exceptions::basic_string<char, std::char_traits<char>, allocator_with_state<char> > string_t;
+
+        allocator_with_state<char> alloc1;
+        allocator_with_state<char> alloc2;
+
+        string_t s1(alloc1);
+        string_t s2(alloc2);
+        NESTL_CHECK_OPERATION(s2.assign_nothrow(_, "string which lives in heap storage"));
+
+        NESTL_CHECK_OPERATION(s1.move_assign_nothrow(_, std::move(s2)));
+        CheckString(s1, "string which lives in heap storage");
+        CheckString(s2, "");
+        NESTL_CHECK_EQ(1u, alloc1.m_allocated_storage->size());
+    }
+
+    // two-phase initialization from C string
+    {
+        nestl::vector<nestl::string> v;
+        NESTL_CHECK_OPERATION(v.emplace_back_nothrow(_, "element"));
+        CheckString(v[0], "element");
+    }
+
+#if NESTL_HAS_EXCEPTIONS == 1
+
+    // throwing constructors and operators
+    {
+        nestl::has_exceptions::string s1("some string which is long enough");
+        nestl::has_exceptions::string s2(s1);
+        CheckString(s2, "some string which is long enough");
+
+        s2 = "abc";
+        s2 += 'd';
+        s2 += "ef";
+        s2 += s2;
+        CheckString(s2, "abcdefabcdef");
+
+        s1 = s2;
+        CheckString(s1, "abcdefabcdef");
+        NESTL_CHECK_EQ(true, s1 == s2);
+    }
+
+    {
+        zero_allocator<char> alloc;
+        bool thrown = false;
+        try
+        {
+            nestl::has_exceptions::basic_string<char, std::char_traits<char>, zero_allocator<char> >
+                s("string which does not fit into inline buffer", alloc);
+        }
+        catch (const std::bad_alloc&)
+        {
+            thrown = true;
+        }
+        NESTL_CHECK_EQ(true, thrown);
+    }
+
+#endif /* NESTL_HAS_EXCEPTIONS */
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,182 @@
+#include "tests/string/string_test.hpp"
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(string_test_modifiers)
+{
+    // append grows from inline buffer to heap
+    {
+        nestl::string s;
+        for (char c = 'a'; c <= 'z'; ++c)
+        {
+            NESTL_CHECK_OPERATION(s.push_back_nothrow(_, c));
+        }
+        CheckString(s, "abcdefghijklmnopqrstuvwxyz");
+
+        NESTL_CHECK_OPERATION(s.append_nothrow(_, "0123", 2));
+        NESTL_CHECK_OPERATION(s.append_nothrow(_, 3, '!'));
+        CheckString(s, "abcdefghijklmnopqrstuvwxyz01!!!");
+
+        s.pop_back();
+        CheckString(s, "abcdefghijklmnopqrstuvwxyz01!!");
+    }
+
+    // append of own content, with and without reallocation
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "abc"));
+        NESTL_CHECK_OPERATION(s.append_nothrow(_, s));
+        CheckString(s, "abcabc");
+
+        NESTL_CHECK_OPERATION(s.append_nothrow(_, s.data(), s.size()));
+        NESTL_CHECK_OPERATION(s.append_nothrow(_, s.data(), s.size()));
+        CheckString(s, "abcabcabcabcabcabcabcabc");
+    }
+
+    // insert in the middle, including parts of own content
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "0123456789"));
+        NESTL_CHECK_OPERATION(s.reserve_nothrow(_, 100));
+
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 0, "ab"));
+        CheckString(s, "ab0123456789");
+
+        // source is before insertion point
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 4, s.data(), 2));
+        CheckString(s, "ab01ab23456789");
+
+        // source is after insertion point, so it is shifted
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 1, s.data() + 10, 3));
+        CheckString(s, "a678b01ab23456789");
+
+        // source ends at insertion point
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 2, s.data() + 1, 2));
+        CheckString(s, "a66778b01ab23456789");
+
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, s.size(), 2, '.'));
+        CheckString(s, "a66778b01ab23456789..");
+
+        nestl::string::iterator it;
+        NESTL_CHECK_OPERATION(it = s.insert_nothrow(_, s.cbegin() + 1, '-'));
+        NESTL_CHECK_EQ('-', *it);
+        CheckString(s, "a-66778b01ab23456789..");
+    }
+
+    // insert which requires reallocation reads source before old storage is released
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "0123456789abcde"));
+        NESTL_CHECK_EQ(s.capacity(), s.size());
+
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 5, s.data(), 10));
+        CheckString(s, "01234012345678956789abcde");
+    }
+
+    // source crosses insertion point
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "abcdef"));
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 3, s.data() + 1, 4));
+        CheckString(s, "abcbcdedef");
+    }
+
+    // erase
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "0123456789"));
+
+        s.erase(8);
+        CheckString(s, "01234567");
+
+        s.erase(1, 2);
+        CheckString(s, "034567");
+
+        nestl::string::iterator it = s.erase(s.cbegin());
+        NESTL_CHECK_EQ('3', *it);
+        CheckString(s, "34567");
+
+        it = s.erase(s.cbegin() + 1, s.cend() - 1);
+        NESTL_CHECK_EQ('7', *it);
+        CheckString(s, "37");
+
+        s.clear();
+        CheckString(s, "");
+    }
+
+    // resize and assign
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.resize_nothrow(_, 3, 'x'));
+        CheckString(s, "xxx");
+
+        NESTL_CHECK_OPERATION(s.resize_nothrow(_, 1));
+        CheckString(s, "x");
+
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, 20, 'y'));
+        CheckString(s, "yyyyyyyyyyyyyyyyyyyy");
+
+        const char text[] = "from iterators";
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, std::begin(text), std::end(text) - 1));
+        CheckString(s, "from iterators");
+
+        // assignment from own content
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, s.data() + 5, 9));
+        CheckString(s, "iterators");
+    }
+
+    // failed allocation leaves content unchanged
+    {
+        typedef nestl::no_exceptions::basic_string<char, std::char_traits<char>, zero_allocator<char> > string_t;
+
+        string_t s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "abc"));
+
+        nestl::default_operation_error err;
+        s.insert_nothrow(err, 1, "string which does not fit into inline buffer");
+        if (!err)
+        {
+            fatal_failure("zero_allocator should not be able to allocate");
+        }
+        CheckString(s, "abc");
+
+        err = nestl::default_operation_error();
+        s.reserve_nothrow(err, s.max_size() + 1);
+        if (!err)
+        {
+            fatal_failure("length error should be reported");
+        }
+        CheckString(s, "abc");
+    }
+
+    // search and comparison
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "abracadabra"));
+
+        NESTL_CHECK_EQ(0u, s.find("abra"));
+        NESTL_CHECK_EQ(7u, s.find("abra", 1));
+        NESTL_CHECK_EQ(nestl::string::npos, s.find("abra", 8));
+        NESTL_CHECK_EQ(4u, s.find('c'));
+        NESTL_CHECK_EQ(nestl::string::npos, s.find('z'));
+        NESTL_CHECK_EQ(10u, s.rfind('a'));
+        NESTL_CHECK_EQ(7u, s.rfind('a', 9));
+        NESTL_CHECK_EQ(3u, s.find("", 3));
+
+        nestl::string other;
+        NESTL_CHECK_OPERATION(other.assign_nothrow(_, "abrz"));
+        NESTL_CHECK_EQ(nestl::string::npos, s.find(other));
+        NESTL_CHECK_EQ(true, s < other);
+        NESTL_CHECK_EQ(true, s != other);
+        NESTL_CHECK_EQ(true, s.compare("abracadabra") == 0);
+        NESTL_CHECK_EQ(true, s.compare("abr") > 0);
+        NESTL_CHECK_EQ(true, s.compare("abracadabraa") < 0);
+        NESTL_CHECK_EQ(true, s == "abracadabra");
+    }
+}
+
+} // namespace test
+} // namespace nestl
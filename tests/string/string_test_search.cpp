@@ -0,0 +1,146 @@
+#include "tests/string/string_test.hpp"
+
+#include <nestl/detail/char_search.hpp>
+#include <nestl/string_view.hpp>
+
+#include <cstdlib>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+typedef nestl::detail::char_search::kernels kernels_t;
+
+const std::size_t MaxInputSize = 200;
+
+
+/// checks one kernel against scalar one for all positions of all short inputs
+void check_kernels(const kernels_t& checked)
+{
+    const kernels_t& expected = nestl::detail::char_search::scalar_kernels();
+
+    // alphabet is small, so there are many matches and partial matches
+    char input[MaxInputSize + 64];
+    for (std::size_t i = 0; i != sizeof(input); ++i)
+    {
+        input[i] = static_cast<char>('a' + std::rand() % 3);
+    }
+    input[17] = static_cast<char>(0xF0);
+
+    const char needles[][6] = {"a", "ab", "cab", "abca", "bbbbb", "\xF0"};
+    const char sets[][11] = {"c", "bc", "xyzc", "\xF0xyz", "pqrstuvwxc"};
+
+    for (std::size_t offset = 0; offset != 33; offset += 11)
+    {
+        for (std::size_t count = 0; count <= MaxInputSize; ++count)
+        {
+            const char* s = input + offset;
+
+            for (std::size_t i = 0; i != sizeof(needles) / sizeof(needles[0]); ++i)
+            {
+                const std::size_t needleSize = std::strlen(needles[i]);
+
+                NESTL_CHECK_EQ(expected.find_char(s, count, needles[i][0]), checked.find_char(s, count, needles[i][0]));
+                NESTL_CHECK_EQ(expected.rfind_char(s, count, needles[i][0]), checked.rfind_char(s, count, needles[i][0]));
+
+                if (needleSize <= count)
+                {
+                    NESTL_CHECK_EQ(expected.find(s, count, needles[i], needleSize),
+                                   checked.find(s, count, needles[i], needleSize));
+                }
+            }
+
+            for (std::size_t i = 0; i != sizeof(sets) / sizeof(sets[0]); ++i)
+            {
+                const std::size_t setSize = std::strlen(sets[i]);
+                NESTL_CHECK_EQ(expected.find_any(s, count, sets[i], setSize), checked.find_any(s, count, sets[i], setSize));
+            }
+
+            // difference at each position
+            char other[MaxInputSize];
+            std::memcpy(other, s, count);
+            NESTL_CHECK_EQ(count, checked.mismatch(s, other, count));
+            for (std::size_t pos = 0; pos != count; ++pos)
+            {
+                other[pos] = 'z';
+                NESTL_CHECK_EQ(pos, checked.mismatch(s, other, count));
+                other[pos] = s[pos];
+            }
+        }
+    }
+}
+
+} // namespace
+
+
+NESTL_ADD_TEST(string_test_search_kernels)
+{
+    check_kernels(nestl::detail::char_search::scalar_kernels());
+
+    if (const kernels_t* sse2 = nestl::detail::char_search::sse2_kernels())
+    {
+        check_kernels(*sse2);
+    }
+
+    if (const kernels_t* avx2 = nestl::detail::char_search::avx2_kernels())
+    {
+        check_kernels(*avx2);
+    }
+}
+
+
+NESTL_ADD_TEST(string_test_search)
+{
+    // long strings are scanned by kernels
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, 1000, '.'));
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 700, "needle;"));
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 100, "needle,"));
+
+        NESTL_CHECK_EQ(100u, s.find("needle"));
+        NESTL_CHECK_EQ(707u, s.find("needle", 101));
+        NESTL_CHECK_EQ(nestl::string::npos, s.find("needles"));
+        NESTL_CHECK_EQ(106u, s.find_first_of(nestl::string_view(";,")));
+        NESTL_CHECK_EQ(713u, s.find_first_of(';'));
+        NESTL_CHECK_EQ(713u, s.find_first_of(nestl::string_view(";,"), 107));
+        NESTL_CHECK_EQ(713u, s.rfind(';'));
+        NESTL_CHECK_EQ(106u, s.rfind(',', 712));
+        NESTL_CHECK_EQ(707u, s.rfind(nestl::string_view("needle")));
+
+        nestl::string other;
+        NESTL_CHECK_OPERATION(other.assign_nothrow(_, s));
+        NESTL_CHECK_EQ(0, s.compare(other));
+
+        other[900] = '-';
+        NESTL_CHECK_EQ(true, s.compare(other) > 0);
+        other[900] = static_cast<char>(0xF0);
+        NESTL_CHECK_EQ(true, s.compare(other) < 0);
+    }
+
+    // characters are compared as unsigned, as in std::char_traits
+    {
+        const char high[] = "\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0";
+        const char low[] = "\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0" "a";
+
+        NESTL_CHECK_EQ(true, nestl::string_view(low) < nestl::string_view(high));
+        NESTL_CHECK_EQ(std::char_traits<char>::compare(low, high, sizeof(low)) < 0,
+                       nestl::string_view(low).compare(high) < 0);
+    }
+
+    // other character types keep generic search through traits
+    {
+        nestl::wstring_view s(L"key=value;other=value");
+        NESTL_CHECK_EQ(3u, s.find(L'='));
+        NESTL_CHECK_EQ(16u, s.find(L"value", 5));
+        NESTL_CHECK_EQ(9u, s.find_first_of(nestl::wstring_view(L";,")));
+        NESTL_CHECK_EQ(15u, s.rfind(L'='));
+    }
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,171 @@
+#include "tests/string/string_test.hpp"
+
+#include <nestl/set.hpp>
+#include <nestl/string_view.hpp>
+#include <nestl/vector.hpp>
+
+#include <type_traits>
+
+namespace nestl
+{
+namespace test
+{
+
+static_assert(std::is_trivially_copyable<nestl::string_view>::value, "view should be trivially copyable");
+static_assert(sizeof(nestl::string_view) == sizeof(const char*) + sizeof(std::size_t), "view is pointer and size");
+
+NESTL_ADD_TEST(string_view_test)
+{
+    // view refers to characters which are not terminated
+    {
+        const char buffer[] = {'k', 'e', 'y', '=', 'v', 'a', 'l', 'u', 'e'};
+        nestl::string_view line(buffer, sizeof(buffer));
+        NESTL_CHECK_EQ(9u, line.size());
+
+        const std::size_t pos = line.find('=');
+        NESTL_CHECK_EQ(3u, pos);
+
+        nestl::string_view key = line.substr(0, pos);
+        nestl::string_view value = line.substr(pos + 1);
+        NESTL_CHECK_EQ(true, key == "key");
+        NESTL_CHECK_EQ(true, value == "value");
+        NESTL_CHECK_EQ(buffer + 4, value.data());
+
+        // position beyond the end gives empty view
+        NESTL_CHECK_EQ(true, line.substr(100).empty());
+        NESTL_CHECK_EQ(true, line.substr(9).empty());
+
+        value.remove_prefix(1);
+        value.remove_suffix(1);
+        NESTL_CHECK_EQ(true, value == "alu");
+    }
+
+    // search and comparison
+    {
+        nestl::string_view s("abracadabra");
+
+        NESTL_CHECK_EQ(0u, s.find("abra"));
+        NESTL_CHECK_EQ(7u, s.find("abra", 1));
+        NESTL_CHECK_EQ(nestl::string_view::npos, s.find("abrz"));
+        NESTL_CHECK_EQ(7u, s.rfind(nestl::string_view("abra")));
+        NESTL_CHECK_EQ(0u, s.rfind(nestl::string_view("abra"), 6));
+        NESTL_CHECK_EQ(10u, s.rfind('a'));
+        NESTL_CHECK_EQ(11u, s.rfind(nestl::string_view()));
+        NESTL_CHECK_EQ(nestl::string_view::npos, s.rfind(nestl::string_view("abracadabra!")));
+
+        NESTL_CHECK_EQ(true, s.starts_with("abra"));
+        NESTL_CHECK_EQ(true, s.ends_with("dabra"));
+        NESTL_CHECK_EQ(false, s.ends_with("abrac"));
+
+        NESTL_CHECK_EQ(true, s.compare("abracadabra") == 0);
+        NESTL_CHECK_EQ(true, s.compare("abr") > 0);
+        NESTL_CHECK_EQ(true, s.compare(4, 3, "cad") == 0);
+        NESTL_CHECK_EQ(true, nestl::string_view("abc") < nestl::string_view("abd"));
+        NESTL_CHECK_EQ(true, nestl::string_view("ab") < nestl::string_view("abc"));
+        NESTL_CHECK_EQ(true, nestl::string_view() == nestl::string_view(""));
+    }
+}
+
+
+NESTL_ADD_TEST(string_test_view)
+{
+    // string is built from views and converts to view without copying
+    {
+        const char buffer[] = "header: some long value of header";
+        nestl::string_view line(buffer);
+
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, line.substr(0, 6)));
+        CheckString(s, "header");
+
+        NESTL_CHECK_OPERATION(s.append_nothrow(_, line.substr(6)));
+        CheckString(s, buffer);
+
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 0, nestl::string_view("> ")));
+        CheckString(s, "> header: some long value of header");
+
+        nestl::string_view view = s;
+        NESTL_CHECK_EQ(s.data(), view.data());
+        NESTL_CHECK_EQ(s.size(), view.size());
+
+        NESTL_CHECK_EQ(10u, s.find(nestl::string_view("some")));
+        NESTL_CHECK_EQ(29u, s.rfind(nestl::string_view("header")));
+        NESTL_CHECK_EQ(false, s == line);
+        NESTL_CHECK_EQ(true, s.compare(line) < 0);
+        NESTL_CHECK_EQ(true, line.substr(0, 6) != s);
+        NESTL_CHECK_EQ(true, s < line);
+    }
+
+    // view of own content
+    {
+        nestl::string s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, "abcdefgh"));
+
+        nestl::string_view view = s;
+        NESTL_CHECK_OPERATION(s.append_nothrow(_, view));
+        CheckString(s, "abcdefghabcdefgh");
+
+        view = s;
+        NESTL_CHECK_OPERATION(s.assign_nothrow(_, view.substr(4, 8)));
+        CheckString(s, "efghabcd");
+    }
+
+    // elements of containers are constructed from view
+    {
+        nestl::vector<nestl::string> v;
+        NESTL_CHECK_OPERATION(v.emplace_back_nothrow(_, nestl::string_view("element which is long enough to allocate")));
+        CheckString(v[0], "element which is long enough to allocate");
+    }
+
+    // set of strings is searched by view
+    {
+        nestl::set<nestl::string> keys;
+
+        const char* const values[] = {"alpha", "beta", "gamma", "delta which does not fit into inline buffer"};
+        for (const char* value : values)
+        {
+            nestl::string key;
+            NESTL_CHECK_OPERATION(key.assign_nothrow(_, value));
+            NESTL_CHECK_OPERATION(keys.insert_nothrow(_, std::move(key)));
+        }
+
+        // keys are taken from network buffer without copying
+        const char packet[] = "beta|delta which does not fit into inline buffer|omega";
+        nestl::string_view input(packet);
+
+        nestl::set<nestl::string>::iterator it = keys.find(input.substr(0, 4));
+        NESTL_CHECK_EQ(false, it == keys.end());
+        CheckString(*it, "beta");
+
+        const nestl::set<nestl::string>& constKeys = keys;
+        nestl::set<nestl::string>::const_iterator cit = constKeys.find(input.substr(5, 43));
+        NESTL_CHECK_EQ(false, cit == constKeys.end());
+        CheckString(*cit, "delta which does not fit into inline buffer");
+
+        NESTL_CHECK_EQ(true, keys.find(input.substr(49)) == keys.end());
+        NESTL_CHECK_EQ(true, keys.find(nestl::string_view("alph")) == keys.end());
+        NESTL_CHECK_EQ(true, keys.find(nestl::string_view("alpha")) == keys.begin());
+    }
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    // throwing wrapper takes views as well
+    {
+        nestl::has_exceptions::string s(nestl::string_view("abc"));
+        s += nestl::string_view("def");
+        s.append(nestl::string_view("gh"));
+        CheckString(s, "abcdefgh");
+
+        s = nestl::string_view("xyz");
+        CheckString(s, "xyz");
+        NESTL_CHECK_EQ(true, s == nestl::string_view("xyz"));
+        NESTL_CHECK_EQ(true, nestl::string_view("xy") < s);
+
+        nestl::has_exceptions::set<nestl::has_exceptions::string> keys;
+        NESTL_CHECK_OPERATION(keys.insert_nothrow(_, std::move(s)));
+        NESTL_CHECK_EQ(false, keys.find(nestl::string_view("xyz")) == keys.end());
+    }
+#endif
+}
+
+} // namespace test
+} // namespace nestl
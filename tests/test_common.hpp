@@ -5,6 +5,8 @@
 
 #include "tests/nestl_test.hpp"
 
+#include <cstddef>
+
 namespace nestl
 {
 namespace test
@@ -75,6 +77,38 @@ std::ostream& operator << (std::ostream& strm, const non_copyable& val)
 }
 
 
+/// @brief Type without default constructor
+struct explicit_value
+{
+    explicit explicit_value(int v) NESTL_NOEXCEPT_SPEC
+        : value(v)
+    {
+    }
+
+    int value;
+};
+
+inline
+bool operator == (const explicit_value& left, const explicit_value& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.value == right.value;
+}
+
+inline
+bool operator < (const explicit_value& left, const explicit_value& right) NESTL_NOEXCEPT_SPEC
+{
+    return left.value < right.value;
+}
+
+struct explicit_value_hash
+{
+    std::size_t operator()(const explicit_value& val) const NESTL_NOEXCEPT_SPEC
+    {
+        return static_cast<std::size_t>(val.value);
+    }
+};
+
+
 } // namespace test
 
 
@@ -0,0 +1,163 @@
+#include <nestl/unordered_map.hpp>
+#include <nestl/functional.hpp>
+#include <nestl/string.hpp>
+#include <nestl/string_view.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include "tests/test_common.hpp"
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(unordered_map_test)
+{
+    // values are modifiable, present keys are not replaced
+    {
+        typedef nestl::unordered_map<int, int> map_t;
+        map_t m;
+
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(3, 30)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(1, 10)));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(2, 20)));
+
+        nestl::default_operation_error err;
+        map_t::iterator_with_flag res = m.insert_nothrow(err, std::make_pair(2, 200));
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(20, res.first->second);
+        NESTL_CHECK_EQ(3u, m.size());
+
+        m.find(3)->second = 33;
+        const map_t& cm = m;
+        NESTL_CHECK_EQ(33, cm.find(3)->second);
+        NESTL_CHECK_EQ(true, cm.find(4) == cm.end());
+
+        const std::pair<int, int> range[] = {{5, 50}, {0, 0}, {2, 222}, {4, 40}, {5, 55}};
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::begin(range), std::end(range)));
+        NESTL_CHECK_EQ(6u, m.size());
+        NESTL_CHECK_EQ(20, m.find(2)->second);
+
+        int sum = 0;
+        for (map_t::iterator it = m.begin(); it != m.end(); ++it)
+        {
+            NESTL_CHECK_EQ(true, it->second == it->first * 10 || it->first == 3);
+            sum += it->first;
+        }
+        NESTL_CHECK_EQ(15, sum);
+
+        NESTL_CHECK_EQ(1u, m.erase(0));
+        NESTL_CHECK_EQ(0u, m.erase(0));
+        NESTL_CHECK_EQ(1u, m.count(5));
+        NESTL_CHECK_EQ(5u, m.size());
+
+        map_t moved(std::move(m));
+        NESTL_CHECK_EQ(5u, moved.size());
+        NESTL_CHECK_EQ(true, m.empty());
+    }
+
+    // values are constructed in place only for absent keys
+    {
+        typedef nestl::unordered_map<nestl::string, nestl::string, nestl::hash<nestl::string>, nestl::equal_to<>> map_t;
+        map_t m;
+
+        nestl::string key;
+        NESTL_CHECK_OPERATION(key.assign_nothrow(_, "key which does not fit into inline buffer"));
+
+        nestl::default_operation_error err;
+        map_t::iterator_with_flag res = m.try_emplace_nothrow(err, std::move(key), "first value");
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(true, res.second);
+        NESTL_CHECK_EQ(true, res.first->second == "first value");
+
+        nestl::string sameKey;
+        NESTL_CHECK_OPERATION(sameKey.assign_nothrow(_, "key which does not fit into inline buffer"));
+        res = m.try_emplace_nothrow(err, sameKey, "second value");
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(true, res.first->second == "first value");
+
+        // many keys which do not fit into inline buffer survive rehashing
+        for (int i = 0; i != 100; ++i)
+        {
+            nestl::string k;
+            NESTL_CHECK_OPERATION(k.assign_nothrow(_, "long key number "));
+            NESTL_CHECK_OPERATION(k.push_back_nothrow(_, static_cast<char>('0' + i / 10)));
+            NESTL_CHECK_OPERATION(k.push_back_nothrow(_, static_cast<char>('0' + i % 10)));
+            NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, std::move(k)));
+        }
+        NESTL_CHECK_EQ(101u, m.size());
+        NESTL_CHECK_EQ(true, m.find("long key number 42") != m.end());
+        NESTL_CHECK_EQ(true, m.find("long key number 42")->second.empty());
+
+        // transparent lookup by literal and view
+        NESTL_CHECK_EQ(true, m.find("key which does not fit into inline buffer")->second == "first value");
+        NESTL_CHECK_EQ(1u, m.count(nestl::string_view("long key number 07")));
+        NESTL_CHECK_EQ(true, m.find(nestl::string_view("key")) == m.end());
+
+        auto range = m.equal_range("long key number 99");
+        NESTL_CHECK_EQ(1, std::distance(range.first, range.second));
+        range = m.equal_range("long key number 100");
+        NESTL_CHECK_EQ(true, range.first == range.second);
+
+        map_t copy;
+        NESTL_CHECK_OPERATION(copy.copy_nothrow(_, m));
+        NESTL_CHECK_EQ(101u, copy.size());
+        NESTL_CHECK_EQ(true, copy.find("key which does not fit into inline buffer")->second == "first value");
+    }
+}
+
+NESTL_ADD_TEST(unordered_map_test_const_keys)
+{
+    // keys are const, members of values are constructed in slots one by one
+    {
+        typedef nestl::unordered_map<int, explicit_value> map_t;
+        static_assert(std::is_same<map_t::value_type, std::pair<const int, explicit_value> >::value,
+                      "keys of unordered_map should not be modifiable");
+
+        map_t m;
+        for (int i = 0; i != 50; ++i)
+        {
+            NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, i, i * 10));
+        }
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::make_pair(50, explicit_value(500))));
+
+        const map_t::value_type val(51, explicit_value(510));
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, val));
+        NESTL_CHECK_EQ(52u, m.size());
+        NESTL_CHECK_EQ(420, m.find(42)->second.value);
+    }
+
+    // values which are not trivially relocatable survive rehashing and copying
+    {
+        typedef nestl::unordered_map<explicit_value, nestl::string, explicit_value_hash> map_t;
+        static_assert(std::is_same<map_t::value_type, std::pair<const explicit_value, nestl::string> >::value,
+                      "keys of unordered_map should not be modifiable");
+
+        map_t m;
+        for (int i = 0; i != 50; ++i)
+        {
+            NESTL_CHECK_OPERATION(m.try_emplace_nothrow(_, explicit_value(i), "value which does not fit into inline buffer"));
+        }
+
+        const std::pair<explicit_value, nestl::string> range[] = {{explicit_value(1), nestl::string()},
+                                                                  {explicit_value(50), nestl::string()}};
+        NESTL_CHECK_OPERATION(m.insert_nothrow(_, std::begin(range), std::end(range)));
+        NESTL_CHECK_EQ(51u, m.size());
+        NESTL_CHECK_EQ(true, m.find(explicit_value(1))->second == "value which does not fit into inline buffer");
+        NESTL_CHECK_EQ(true, m.find(explicit_value(50))->second.empty());
+
+        map_t copy;
+        NESTL_CHECK_OPERATION(copy.copy_nothrow(_, m));
+        NESTL_CHECK_EQ(51u, copy.size());
+        NESTL_CHECK_EQ(true, copy.find(explicit_value(49))->second == "value which does not fit into inline buffer");
+    }
+}
+
+} // namespace test
+} // namespace nestl
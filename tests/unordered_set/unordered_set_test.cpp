@@ -0,0 +1,366 @@
+#include <nestl/unordered_set.hpp>
+#include <nestl/functional.hpp>
+#include <nestl/string.hpp>
+#include <nestl/string_view.hpp>
+#include <nestl/default_operation_error.hpp>
+
+#include <nestl/detail/hash_group.hpp>
+
+#include "tests/test_common.hpp"
+#include "tests/allocators.hpp"
+
+#include <cstdint>
+#include <iterator>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+/// @brief Hash which puts all keys into the same group, so probing has to go past full groups
+struct colliding_hash
+{
+    std::size_t operator()(int /* key */) const NESTL_NOEXCEPT_SPEC
+    {
+        return 42;
+    }
+};
+
+template <typename Set>
+void CheckRange(const Set& s, int first, int last, int step)
+{
+    std::size_t expected = 0;
+    for (int i = first; i < last; i += step)
+    {
+        if (s.count(i) != 1)
+        {
+            fatal_failure("key ", i, " is not found");
+        }
+        ++expected;
+    }
+
+    if (s.size() != expected)
+    {
+        fatal_failure("expected size: ", expected, ", got: ", s.size());
+    }
+
+    if (static_cast<std::size_t>(std::distance(s.begin(), s.end())) != expected)
+    {
+        fatal_failure("iteration does not visit all elements");
+    }
+}
+
+template <typename Group, std::size_t N>
+std::uint64_t MatchBits(const nestl::detail::hash_group::ctrl_t (&ctrl)[N], std::size_t pos, int kind, nestl::detail::hash_group::ctrl_t h2)
+{
+    const Group g(ctrl + pos);
+    typename Group::mask_type mask = kind == 0 ? g.match(h2) : (kind == 1 ? g.mask_empty() : g.mask_empty_or_deleted());
+
+    std::uint64_t res = 0;
+    for ( ; mask; mask.clear_lowest())
+    {
+        res |= std::uint64_t(1) << mask.lowest();
+    }
+    return res;
+}
+
+} // namespace
+
+
+NESTL_ADD_TEST(hash_group_test)
+{
+    namespace hg = nestl::detail::hash_group;
+
+    hg::ctrl_t ctrl[64];
+    std::uint32_t state = 12345;
+    for (hg::ctrl_t& c : ctrl)
+    {
+        state = state * 1664525u + 1013904223u;
+        const unsigned r = (state >> 24) % 8;
+        c = r == 0 ? hg::ctrl_empty : (r == 1 ? hg::ctrl_deleted : (r == 2 ? hg::ctrl_sentinel : static_cast<hg::ctrl_t>(r)));
+    }
+
+    for (std::size_t pos = 0; pos + 16 <= 64; ++pos)
+    {
+        for (int kind = 0; kind != 3; ++kind)
+        {
+            for (hg::ctrl_t h2 = 3; h2 != 8; ++h2)
+            {
+                // portable match may report full slot after true match, others are exact
+                const std::uint64_t portable = MatchBits<hg::portable_group>(ctrl, pos, kind, h2);
+                std::uint64_t exact = 0;
+                for (std::size_t i = 0; i != hg::portable_group::width; ++i)
+                {
+                    const hg::ctrl_t c = ctrl[pos + i];
+                    const bool bit = kind == 0 ? c == h2 : (kind == 1 ? c == hg::ctrl_empty : hg::is_empty_or_deleted(c));
+                    exact |= std::uint64_t(bit) << i;
+                }
+
+                if ((portable & exact) != exact || (kind != 0 && portable != exact))
+                {
+                    fatal_failure("portable group mismatch at ", pos, ", kind ", kind);
+                }
+                for (std::size_t i = 0; i != hg::portable_group::width; ++i)
+                {
+                    if (((portable & ~exact) >> i) & 1u && !hg::is_full(ctrl[pos + i]))
+                    {
+                        fatal_failure("portable group reports slot which is not full at ", pos + i);
+                    }
+                }
+
+#if NESTL_HAS_SSE2_GROUP
+                const std::uint64_t sse2 = MatchBits<hg::sse2_group>(ctrl, pos, kind, h2);
+                if ((sse2 & 0xFF) != exact)
+                {
+                    fatal_failure("sse2 group mismatch at ", pos, ", kind ", kind);
+                }
+#endif
+            }
+        }
+
+        // leading empty or deleted slots are counted the same way
+        unsigned leading = 0;
+        while (leading != hg::portable_group::width && hg::is_empty_or_deleted(ctrl[pos + leading]))
+        {
+            ++leading;
+        }
+        NESTL_CHECK_EQ(leading, hg::portable_group(ctrl + pos).count_leading_empty_or_deleted());
+#if NESTL_HAS_SSE2_GROUP
+        if (leading < hg::portable_group::width)
+        {
+            NESTL_CHECK_EQ(leading, hg::sse2_group(ctrl + pos).count_leading_empty_or_deleted());
+        }
+#endif
+    }
+}
+
+NESTL_ADD_TEST(unordered_set_test_insert_and_erase)
+{
+    // table grows through many capacities
+    {
+        nestl::unordered_set<int> s;
+        NESTL_CHECK_EQ(true, s.empty());
+        NESTL_CHECK_EQ(true, s.begin() == s.end());
+        NESTL_CHECK_EQ(true, s.find(1) == s.end());
+        NESTL_CHECK_EQ(0u, s.erase(1));
+
+        for (int i = 0; i < 10000; i += 2)
+        {
+            nestl::default_operation_error err;
+            nestl::unordered_set<int>::iterator_with_flag res = s.insert_nothrow(err, i);
+            NESTL_CHECK_EQ(false, !!err);
+            NESTL_CHECK_EQ(true, res.second);
+            NESTL_CHECK_EQ(i, *res.first);
+        }
+        CheckRange(s, 0, 10000, 2);
+        NESTL_CHECK_EQ(true, s.load_factor() <= 0.875f);
+
+        nestl::default_operation_error err;
+        nestl::unordered_set<int>::iterator_with_flag res = s.insert_nothrow(err, 42);
+        NESTL_CHECK_EQ(false, !!err);
+        NESTL_CHECK_EQ(false, res.second);
+        NESTL_CHECK_EQ(42, *res.first);
+        NESTL_CHECK_EQ(true, s.find(43) == s.end());
+        NESTL_CHECK_EQ(0u, s.count(-2));
+
+        // erase every second element by key, then by iterator
+        for (int i = 0; i < 10000; i += 4)
+        {
+            NESTL_CHECK_EQ(1u, s.erase(i));
+        }
+        CheckRange(s, 2, 10000, 4);
+
+        for (nestl::unordered_set<int>::const_iterator it = s.begin(); it != s.end(); )
+        {
+            it = (*it % 8 == 2) ? s.erase(it) : std::next(it);
+        }
+        CheckRange(s, 6, 10000, 8);
+
+        auto range = s.equal_range(14);
+        NESTL_CHECK_EQ(1, std::distance(range.first, range.second));
+        range = s.equal_range(15);
+        NESTL_CHECK_EQ(true, range.first == range.second);
+
+        s.clear();
+        NESTL_CHECK_EQ(true, s.empty());
+        NESTL_CHECK_EQ(true, s.begin() == s.end());
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 7));
+        CheckRange(s, 7, 8, 1);
+    }
+
+    // repeated insertion and erasure reuses slots instead of growing
+    {
+        nestl::unordered_set<int> s;
+        NESTL_CHECK_OPERATION(s.reserve_nothrow(_, 100));
+        const std::size_t capacity = s.bucket_count();
+
+        for (int i = 0; i != 100000; ++i)
+        {
+            NESTL_CHECK_OPERATION(s.insert_nothrow(_, i));
+            if (i >= 50)
+            {
+                NESTL_CHECK_EQ(1u, s.erase(i - 50));
+            }
+        }
+        CheckRange(s, 100000 - 50, 100000, 1);
+        NESTL_CHECK_EQ(capacity, s.bucket_count());
+    }
+
+    // all keys collide, so lookup probes many groups
+    {
+        nestl::unordered_set<int, colliding_hash> s;
+        const int values[] = {5, 1, 9, 3, 5, 7, 1, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31, 33, 35};
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(values), std::end(values)));
+        CheckRange(s, 1, 36, 2);
+
+        NESTL_CHECK_EQ(1u, s.erase(17));
+        NESTL_CHECK_EQ(true, s.find(17) == s.end());
+        NESTL_CHECK_EQ(35, *s.find(35));
+        NESTL_CHECK_OPERATION(s.insert_nothrow(_, 17));
+        CheckRange(s, 1, 36, 2);
+    }
+}
+
+NESTL_ADD_TEST(unordered_set_test_strings)
+{
+    typedef nestl::unordered_set<nestl::string, nestl::hash<nestl::string>, nestl::equal_to<>> set_t;
+    static_assert(nestl::is_transparent<nestl::hash<nestl::string>>::value, "string hash should be transparent");
+    static_assert(nestl::is_transparent<nestl::equal_to<>>::value, "equal_to<> should be transparent");
+
+    set_t s;
+    const char* const words[] = {"pear which is long enough to allocate",
+                                 "apple which is long enough to allocate",
+                                 "fig",
+                                 "fig"};
+    NESTL_CHECK_OPERATION(s.insert_nothrow(_, std::begin(words), std::end(words)));
+    NESTL_CHECK_EQ(3u, s.size());
+
+    // string, view and literal of the same characters have the same hash
+    nestl::string fig;
+    NESTL_CHECK_OPERATION(fig.assign_nothrow(_, "fig"));
+    NESTL_CHECK_EQ(nestl::hash<nestl::string>()(fig), nestl::hash<nestl::string_view>()(nestl::string_view("fig")));
+
+    NESTL_CHECK_EQ(true, s.find(fig) != s.end());
+    NESTL_CHECK_EQ(true, *s.find("fig") == "fig");
+    NESTL_CHECK_EQ(1u, s.count(nestl::string_view("apple which is long enough to allocate")));
+    NESTL_CHECK_EQ(0u, s.count(nestl::string_view("apple")));
+    NESTL_CHECK_EQ(0u, s.count("kiwi"));
+
+    auto range = s.equal_range("pear which is long enough to allocate");
+    NESTL_CHECK_EQ(1, std::distance(range.first, range.second));
+
+    set_t copy;
+    NESTL_CHECK_OPERATION(copy.copy_nothrow(_, s));
+    NESTL_CHECK_EQ(3u, copy.size());
+    NESTL_CHECK_EQ(1u, copy.erase(fig));
+
+    set_t other;
+    other.swap(copy);
+    NESTL_CHECK_EQ(true, copy.empty());
+    NESTL_CHECK_EQ(2u, other.size());
+
+    set_t moved(std::move(other));
+    NESTL_CHECK_EQ(2u, moved.size());
+    NESTL_CHECK_EQ(true, other.empty());
+
+    moved = std::move(s);
+    NESTL_CHECK_EQ(3u, moved.size());
+    NESTL_CHECK_EQ(true, moved.find("fig") != moved.end());
+}
+
+NESTL_ADD_TEST(unordered_set_test_allocation_failure)
+{
+    typedef nestl::unordered_set<int, nestl::hash<int>, nestl::equal_to<int>, budget_allocator<int> > set_t;
+
+    budget_allocator<int>::budget = 1;
+    set_t s;
+    NESTL_CHECK_OPERATION(s.reserve_nothrow(_, 7));
+    const std::size_t capacity = s.bucket_count();
+
+    // reserved table is filled without allocations until its growth fails
+    int i = 0;
+    nestl::default_operation_error err;
+    set_t::iterator_with_flag res = s.insert_nothrow(err, i);
+    while (!err)
+    {
+        NESTL_CHECK_EQ(true, res.second);
+        res = s.insert_nothrow(err, ++i);
+    }
+    NESTL_CHECK_EQ(false, res.second);
+    NESTL_CHECK_EQ(true, s.size() >= 7u);
+    NESTL_CHECK_EQ(true, s.size() >= capacity * 3 / 4);
+    CheckRange(s, 0, i, 1);
+    NESTL_CHECK_EQ(capacity, s.bucket_count());
+
+    err = nestl::default_operation_error();
+    s.reserve_nothrow(err, 1000);
+    NESTL_CHECK_EQ(true, !!err);
+    CheckRange(s, 0, i, 1);
+
+    // present keys are found without growth
+    err = nestl::default_operation_error();
+    res = s.insert_nothrow(err, 0);
+    NESTL_CHECK_EQ(false, !!err);
+    NESTL_CHECK_EQ(false, res.second);
+
+    // erased slot is reused without growth
+    NESTL_CHECK_EQ(1u, s.erase(0));
+    NESTL_CHECK_OPERATION(s.insert_nothrow(_, i));
+    CheckRange(s, 1, i + 1, 1);
+
+    budget_allocator<int>::budget = 1;
+    NESTL_CHECK_OPERATION(s.insert_nothrow(_, i + 1));
+    CheckRange(s, 1, i + 2, 1);
+    NESTL_CHECK_EQ(true, s.bucket_count() > capacity);
+}
+
+NESTL_ADD_TEST(unordered_set_test_move_assign_allocators)
+{
+    // propagating allocator moves together with storage it allocated
+    {
+        typedef propagating_allocator_with_state<int> allocator_t;
+        typedef nestl::unordered_set<int, nestl::hash<int>, nestl::equal_to<int>, allocator_t> set_t;
+
+        const allocator_t alloc1;
+        const allocator_t alloc2;
+        set_t s1(alloc1);
+        set_t s2(alloc2);
+        NESTL_CHECK_OPERATION(s1.insert_nothrow(_, 1));
+        for (int i = 0; i != 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(s2.insert_nothrow(_, i));
+        }
+
+        s1 = std::move(s2);
+        NESTL_CHECK_EQ(true, s1.get_allocator() == alloc2);
+        CheckRange(s1, 0, 100, 1);
+
+        NESTL_CHECK_OPERATION(s1.insert_nothrow(_, 100));
+        CheckRange(s1, 0, 101, 1);
+    }
+
+    // elements are moved into storage of own allocator when allocator does not propagate
+    {
+        typedef allocator_with_state<int> allocator_t;
+        typedef nestl::unordered_set<int, nestl::hash<int>, nestl::equal_to<int>, allocator_t> set_t;
+
+        const allocator_t alloc1;
+        const allocator_t alloc2;
+        set_t s1(alloc1);
+        set_t s2(alloc2);
+        for (int i = 0; i != 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(s2.insert_nothrow(_, i));
+        }
+
+        NESTL_CHECK_OPERATION(s1.move_assign_nothrow(_, std::move(s2)));
+        NESTL_CHECK_EQ(true, s1.get_allocator() == alloc1);
+        CheckRange(s1, 0, 100, 1);
+    }
+}
+
+} // namespace test
+} // namespace nestl
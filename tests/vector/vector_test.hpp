@@ -6,11 +6,50 @@
 #include "tests/test_common.hpp"
 #include "tests/allocators.hpp"
 
+#include <initializer_list>
+#include <new>
+
 namespace nestl
 {
 namespace test
 {
 
+#if NESTL_HAS_EXCEPTIONS == 1
+
+/// type with potentially throwing copy, vector shifts it by assignment,
+/// assignment fails for negative values
+struct assign_shifted
+{
+    assign_shifted(int x = 0) NESTL_NOEXCEPT_SPEC
+        : v(x)
+    {
+    }
+
+    assign_shifted(const assign_shifted& other)
+        : v(other.v)
+    {
+    }
+
+    assign_shifted& operator=(const assign_shifted& other)
+    {
+        if (other.v < 0)
+        {
+            throw std::bad_alloc();
+        }
+
+        v = other.v;
+        return *this;
+    }
+
+    ~assign_shifted() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    int v;
+};
+
+#endif
+
 
 template <typename Vector>
 void CheckVectorSize(const Vector& v, size_t expectedSize)
@@ -61,6 +100,40 @@ void CheckVectorSize(const Vector& v, size_t expectedSize)
     }
 }
 
+template <typename Vector>
+void FillVector(Vector& vec, int count, int first = 0)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, first + i));
+    }
+}
+
+inline int element_value(int val) NESTL_NOEXCEPT_SPEC
+{
+    return val;
+}
+
+/// test element types store their value in member v
+template <typename T>
+int element_value(const T& val) NESTL_NOEXCEPT_SPEC
+{
+    return val.v;
+}
+
+template <typename Vector>
+void CheckVectorValues(const Vector& vec, std::initializer_list<int> expected)
+{
+    CheckVectorSize(vec, expected.size());
+
+    size_t i = 0;
+    for (int val : expected)
+    {
+        NESTL_CHECK_EQ(val, element_value(vec[i]));
+        ++i;
+    }
+}
+
 
 } // namespace test
 } // namespace nestl
@@ -0,0 +1,64 @@
+#include "tests/vector/vector_test.hpp"
+
+namespace nestl
+{
+namespace test
+{
+
+NESTL_ADD_TEST(vector_test_erase)
+{
+    // erase single elements and ranges
+    {
+        nestl::vector<int> vec;
+        for (int i = 0; i < 6; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, i));
+        }
+
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin() + 1));
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin() + 2, vec.begin() + 4));
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin(), vec.begin()));
+
+        CheckVectorSize(vec, 3);
+        NESTL_CHECK_EQ(0, vec[0]);
+        NESTL_CHECK_EQ(2, vec[1]);
+        NESTL_CHECK_EQ(5, vec[2]);
+    }
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    // tail is shifted by assignment
+    {
+        nestl::vector<assign_shifted> vec;
+        for (int i = 0; i < 6; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, i));
+        }
+
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin() + 1, vec.begin() + 3));
+        CheckVectorValues(vec, {0, 3, 4, 5});
+
+        NESTL_CHECK_OPERATION(vec.erase_nothrow(_, vec.begin()));
+        CheckVectorValues(vec, {3, 4, 5});
+    }
+
+    // failed shift keeps all elements in vector
+    {
+        nestl::vector<assign_shifted> vec;
+        for (int i = 0; i < 5; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, i == 3 ? -3 : i));
+        }
+
+        nestl::default_operation_error err;
+        vec.erase_nothrow(err, vec.begin());
+        if (!err)
+        {
+            fatal_failure("erase with failing assignment should fail");
+        }
+        CheckVectorValues(vec, {1, 2, 2, -3, 4});
+    }
+#endif
+}
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,138 @@
+#include "tests/vector/vector_test.hpp"
+
+#include <nestl/growth_policy.hpp>
+
+#include <limits>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+/// allocator which rounds every request up to 8 elements and limits total size
+template <typename T>
+class bucket_allocator : public minimal_allocator<T>
+{
+public:
+
+    typedef T value_type;
+
+    bucket_allocator() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    template <typename Y>
+    bucket_allocator(const bucket_allocator<Y>& /* other */) NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    std::size_t usable_size(std::size_t n) const NESTL_NOEXCEPT_SPEC
+    {
+        return (n + 7) / 8 * 8;
+    }
+
+    std::size_t max_size() const NESTL_NOEXCEPT_SPEC
+    {
+        return 20;
+    }
+};
+
+} // namespace
+
+
+NESTL_ADD_TEST(vector_test_growth_policy)
+{
+    const nestl::allocator<int> alloc;
+    const size_t maxSize = nestl::allocator_traits<nestl::allocator<int> >::max_size(alloc);
+
+    NESTL_CHECK_EQ(std::numeric_limits<size_t>::max() / sizeof(int), maxSize);
+
+    // geometric growth
+    NESTL_CHECK_EQ(1u, nestl::default_growth_policy::grow(alloc, 0, 1, maxSize));
+    NESTL_CHECK_EQ(15u, nestl::default_growth_policy::grow(alloc, 10, 11, maxSize));
+    NESTL_CHECK_EQ(20u, nestl::doubling_growth_policy::grow(alloc, 10, 11, maxSize));
+    NESTL_CHECK_EQ(125u, nestl::conservative_growth_policy::grow(alloc, 100, 101, maxSize));
+    NESTL_CHECK_EQ(2u, nestl::conservative_growth_policy::grow(alloc, 1, 2, maxSize));
+
+    // required capacity wins over growth factor
+    NESTL_CHECK_EQ(1000u, nestl::default_growth_policy::grow(alloc, 10, 1000, maxSize));
+
+    // growth saturates at max size instead of overflow
+    NESTL_CHECK_EQ(maxSize, nestl::default_growth_policy::grow(alloc, maxSize - 1, maxSize, maxSize));
+    NESTL_CHECK_EQ(maxSize, nestl::doubling_growth_policy::grow(alloc, maxSize / 2 + 1, maxSize / 2 + 2, maxSize));
+    NESTL_CHECK_EQ(std::numeric_limits<size_t>::max(),
+                   nestl::doubling_growth_policy::grow(nestl::allocator<char>(),
+                                                       std::numeric_limits<size_t>::max() - 1,
+                                                       std::numeric_limits<size_t>::max(),
+                                                       std::numeric_limits<size_t>::max()));
+
+    // size classes
+    typedef nestl::size_class_growth_policy<> size_class_policy;
+    NESTL_CHECK_EQ(16u, size_class_policy::size_class(1));
+    NESTL_CHECK_EQ(128u, size_class_policy::size_class(128));
+    NESTL_CHECK_EQ(160u, size_class_policy::size_class(129));
+    NESTL_CHECK_EQ(1024u, size_class_policy::size_class(1000));
+    NESTL_CHECK_EQ(1280u, size_class_policy::size_class(1025));
+
+    NESTL_CHECK_EQ(4u, size_class_policy::reserve(alloc, 3, maxSize));
+    NESTL_CHECK_EQ(40u, size_class_policy::grow(alloc, 25, 26, maxSize));
+
+    // vector with custom growth policy
+    {
+        nestl::vector<int, nestl::allocator<int>, nestl::doubling_growth_policy> vec;
+        for (int i = 0; i < 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, i));
+        }
+
+        CheckVectorSize(vec, 100);
+        NESTL_CHECK_EQ(128u, vec.capacity());
+        for (int i = 0; i < 100; ++i)
+        {
+            NESTL_CHECK_EQ(i, vec[i]);
+        }
+    }
+
+    {
+        nestl::vector<int, nestl::allocator<int>, size_class_policy> vec;
+        NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, 1));
+        NESTL_CHECK_EQ(4u, vec.capacity());
+    }
+
+    // vector uses slack and limits of allocator
+    {
+        nestl::vector<int, bucket_allocator<int> > vec;
+        NESTL_CHECK_EQ(20u, vec.max_size());
+
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 5));
+        NESTL_CHECK_EQ(8u, vec.capacity());
+
+        for (int i = 0; i < 20; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, i));
+        }
+        NESTL_CHECK_EQ(20u, vec.capacity());
+
+        nestl::default_operation_error err;
+        vec.push_back_nothrow(err, 20);
+        if (!err)
+        {
+            fatal_failure("push_back beyond max_size should fail");
+        }
+        CheckVectorSize(vec, 20);
+
+        nestl::default_operation_error reserveErr;
+        vec.reserve_nothrow(reserveErr, 21);
+        if (!reserveErr)
+        {
+            fatal_failure("reserve beyond max_size should fail");
+        }
+    }
+}
+
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,433 @@
+#include "tests/vector/vector_test.hpp"
+
+#include <list>
+#include <new>
+#include <sstream>
+#include <iterator>
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+/// nothrow movable type, which copying fails for negative values
+struct fragile_movable
+{
+    fragile_movable() NESTL_NOEXCEPT_SPEC
+        : v(0)
+    {
+    }
+
+    fragile_movable(int x) NESTL_NOEXCEPT_SPEC
+        : v(x)
+    {
+    }
+
+    fragile_movable(fragile_movable&& other) NESTL_NOEXCEPT_SPEC
+        : v(other.v)
+    {
+    }
+
+    ~fragile_movable() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    int v;
+
+private:
+    fragile_movable(const fragile_movable&) = delete;
+    fragile_movable& operator=(const fragile_movable&) = delete;
+};
+
+
+/// type which can be only copied, copying fails for negative values
+struct fragile_copyable
+{
+    fragile_copyable() NESTL_NOEXCEPT_SPEC
+        : v(0)
+    {
+    }
+
+    fragile_copyable(int x) NESTL_NOEXCEPT_SPEC
+        : v(x)
+    {
+    }
+
+    ~fragile_copyable() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    int v;
+
+private:
+    fragile_copyable(const fragile_copyable&) = delete;
+    fragile_copyable& operator=(const fragile_copyable&) = delete;
+};
+
+
+#if NESTL_HAS_EXCEPTIONS == 1
+
+/// assignable type with potentially throwing copy, copying fails for negative values
+struct fragile_assignable
+{
+    fragile_assignable(int x = 0) NESTL_NOEXCEPT_SPEC
+        : v(x)
+    {
+    }
+
+    fragile_assignable(const fragile_assignable& other)
+        : v(other.v)
+    {
+        if (other.v < 0)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    fragile_assignable& operator=(const fragile_assignable& other)
+    {
+        if (other.v < 0)
+        {
+            throw std::bad_alloc();
+        }
+
+        v = other.v;
+        return *this;
+    }
+
+    ~fragile_assignable() NESTL_NOEXCEPT_SPEC
+    {
+    }
+
+    int v;
+};
+
+#endif
+
+
+template <typename OperationError, typename T>
+void copy_fragile(OperationError& err, T& defaultConstructed, const T& other) NESTL_NOEXCEPT_SPEC
+{
+    if (other.v < 0)
+    {
+        build_bad_alloc(err);
+        return;
+    }
+
+    defaultConstructed.v = other.v;
+}
+
+} // namespace
+
+} // namespace test
+
+
+template <>
+struct two_phase_initializator<test::fragile_movable>
+{
+    template <typename OperationError>
+    static void init(OperationError& err,
+                     test::fragile_movable& defaultConstructed,
+                     const test::fragile_movable& other) NESTL_NOEXCEPT_SPEC
+    {
+        test::copy_fragile(err, defaultConstructed, other);
+    }
+};
+
+template <>
+struct two_phase_initializator<test::fragile_copyable>
+{
+    template <typename OperationError>
+    static void init(OperationError& err,
+                     test::fragile_copyable& defaultConstructed,
+                     const test::fragile_copyable& other) NESTL_NOEXCEPT_SPEC
+    {
+        test::copy_fragile(err, defaultConstructed, other);
+    }
+};
+
+
+namespace test
+{
+
+template <typename T>
+void CheckFragileRangeInsert()
+{
+    nestl::vector<T> vec;
+    for (int i = 0; i < 5; ++i)
+    {
+        NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, i));
+    }
+
+    T source[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        source[i].v = 10 + i;
+    }
+
+    // insertion without reallocation
+    NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 20));
+    NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 2, source, source + 3));
+    CheckVectorValues(vec, {0, 1, 10, 11, 12, 2, 3, 4});
+
+    // failed insertion leaves vector untouched
+    source[1].v = -1;
+    {
+        nestl::default_operation_error err;
+        vec.insert_nothrow(err, vec.begin() + 1, source, source + 3);
+        if (!err)
+        {
+            fatal_failure("insertion of failing element should fail");
+        }
+        CheckVectorValues(vec, {0, 1, 10, 11, 12, 2, 3, 4});
+    }
+
+    // failed insertion with reallocation leaves vector untouched
+    NESTL_CHECK_OPERATION(vec.shrink_to_fit_nothrow(_));
+    {
+        nestl::default_operation_error err;
+        vec.insert_nothrow(err, vec.begin() + 1, source, source + 3);
+        if (!err)
+        {
+            fatal_failure("insertion of failing element should fail");
+        }
+        CheckVectorValues(vec, {0, 1, 10, 11, 12, 2, 3, 4});
+    }
+
+    // insertion with reallocation
+    source[1].v = 20;
+    NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.end() - 1, source, source + 3));
+    CheckVectorValues(vec, {0, 1, 10, 11, 12, 2, 3, 10, 20, 12, 4});
+}
+
+
+NESTL_ADD_TEST(vector_test_insert_range)
+{
+    const int values[] = {10, 11, 12};
+
+    // insert into empty vector
+    {
+        nestl::vector<int> vec;
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), values, values + 3));
+        CheckVectorValues(vec, {10, 11, 12});
+    }
+
+    // insert empty range
+    {
+        nestl::vector<int> vec;
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), values, values));
+        CheckVectorSize(vec, 0);
+    }
+
+    // insert into begin, middle and end
+    {
+        nestl::vector<int> vec;
+        for (int i = 0; i < 4; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, i));
+        }
+
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), values, values + 1));
+        CheckVectorValues(vec, {10, 0, 1, 2, 3});
+
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 2, values, values + 3));
+        CheckVectorValues(vec, {10, 0, 10, 11, 12, 1, 2, 3});
+
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.end(), values + 1, values + 3));
+        CheckVectorValues(vec, {10, 0, 10, 11, 12, 1, 2, 3, 11, 12});
+    }
+
+    // range insertion reallocates at most once
+    {
+        nestl::vector<int> vec;
+        NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, 0));
+
+        int many[100];
+        for (int i = 0; i < 100; ++i)
+        {
+            many[i] = i + 1;
+        }
+
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 1, many, many + 100));
+        CheckVectorSize(vec, 101);
+        NESTL_CHECK_EQ(true, vec.capacity() >= 101);
+        for (int i = 0; i < 101; ++i)
+        {
+            NESTL_CHECK_EQ(i, vec[i]);
+        }
+    }
+
+    // insert from forward (non random access) iterators
+    {
+        std::list<int> source = {7, 8, 9};
+
+        nestl::vector<int> vec;
+        NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, 1));
+        NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, 2));
+
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 1, source.begin(), source.end()));
+        CheckVectorValues(vec, {1, 7, 8, 9, 2});
+    }
+
+    // insert from input iterators
+    {
+        std::istringstream strm("4 5 6");
+
+        nestl::vector<int> vec;
+        NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, 1));
+        NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, 2));
+
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 1,
+                                                 std::istream_iterator<int>(strm),
+                                                 std::istream_iterator<int>()));
+        CheckVectorValues(vec, {1, 4, 5, 6, 2});
+    }
+
+    // insert into vector with stateful allocator
+    {
+        nestl::vector<int, allocator_with_state<int> > vec;
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), values, values + 3));
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 1, values, values + 3));
+        CheckVectorValues(vec, {10, 10, 11, 12, 11, 12});
+    }
+
+    // insertion failure is reported and does not change vector
+    CheckFragileRangeInsert<fragile_movable>();
+    CheckFragileRangeInsert<fragile_copyable>();
+}
+
+
+template <typename T>
+void CheckFragileValueInsert()
+{
+    nestl::vector<T> vec;
+    for (int i = 0; i < 3; ++i)
+    {
+        NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, i));
+    }
+    NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 10));
+
+    T value;
+    value.v = 10;
+
+    // insertion without reallocation
+    NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 1, value));
+    CheckVectorValues(vec, {0, 10, 1, 2});
+
+    // failed insertion leaves vector untouched
+    value.v = -1;
+    {
+        nestl::default_operation_error err;
+        vec.insert_nothrow(err, vec.begin(), value);
+        if (!err)
+        {
+            fatal_failure("insertion of failing element should fail");
+        }
+        CheckVectorValues(vec, {0, 10, 1, 2});
+    }
+
+    // failed insertion with reallocation leaves vector untouched
+    NESTL_CHECK_OPERATION(vec.shrink_to_fit_nothrow(_));
+    {
+        nestl::default_operation_error err;
+        vec.insert_nothrow(err, vec.begin() + 2, value);
+        if (!err)
+        {
+            fatal_failure("insertion of failing element should fail");
+        }
+        CheckVectorValues(vec, {0, 10, 1, 2});
+    }
+
+    // emplacement with reallocation
+    NESTL_CHECK_OPERATION(vec.emplace_nothrow(_, vec.begin() + 2, 20));
+    CheckVectorValues(vec, {0, 10, 20, 1, 2});
+}
+
+
+NESTL_ADD_TEST(vector_test_insert_value)
+{
+    // insert into begin, middle and end
+    {
+        nestl::vector<int> vec;
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), 1));
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), 0));
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.end(), 3));
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin() + 2, 2));
+        CheckVectorValues(vec, {0, 1, 2, 3});
+    }
+
+    // inserted value may refer to element of the same vector
+    {
+        nestl::vector<int> vec;
+        for (int i = 0; i < 4; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, i));
+        }
+
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 10));
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), vec[2]));
+        CheckVectorValues(vec, {2, 0, 1, 2, 3});
+
+        NESTL_CHECK_OPERATION(vec.shrink_to_fit_nothrow(_));
+        NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, vec[0]));
+        CheckVectorValues(vec, {2, 0, 1, 2, 3, 2});
+    }
+
+    // movable elements are moved when tail is shifted
+    {
+        nestl::vector<non_copyable> vec;
+        for (int i = 0; i < 4; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, i));
+        }
+
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 10));
+        NESTL_CHECK_OPERATION(vec.emplace_nothrow(_, vec.begin() + 1, 10));
+        NESTL_CHECK_OPERATION(vec.insert_nothrow(_, vec.begin(), non_copyable(20)));
+
+        CheckVectorSize(vec, 6);
+        NESTL_CHECK_EQ(20, vec[0].v);
+        NESTL_CHECK_EQ(0, vec[1].v);
+        NESTL_CHECK_EQ(10, vec[2].v);
+        NESTL_CHECK_EQ(1, vec[3].v);
+        NESTL_CHECK_EQ(2, vec[4].v);
+        NESTL_CHECK_EQ(3, vec[5].v);
+    }
+
+    // insertion failure is reported and does not change vector
+    CheckFragileValueInsert<fragile_movable>();
+    CheckFragileValueInsert<fragile_copyable>();
+
+#if NESTL_HAS_EXCEPTIONS == 1
+    // assignable elements are copied to new storage, so failure does not change vector
+    {
+        nestl::vector<fragile_assignable> vec;
+        for (int i = 0; i < 4; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, i));
+        }
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 10));
+
+        NESTL_CHECK_OPERATION(vec.emplace_nothrow(_, vec.begin() + 1, 10));
+        CheckVectorValues(vec, {0, 10, 1, 2, 3});
+
+        vec[2].v = -1;
+        const fragile_assignable* data = &vec[0];
+        nestl::default_operation_error err;
+        vec.emplace_nothrow(err, vec.begin(), 20);
+        if (!err)
+        {
+            fatal_failure("insertion with failing copy should fail");
+        }
+        CheckVectorValues(vec, {0, 10, -1, 2, 3});
+        NESTL_CHECK_EQ(data, &vec[0]);
+    }
+#endif
+}
+
+
+} // namespace test
+} // namespace nestl
@@ -0,0 +1,193 @@
+#include "tests/vector/vector_test.hpp"
+
+namespace nestl
+{
+namespace test
+{
+
+namespace
+{
+
+struct relocation_counters
+{
+    static int copies;
+    static int moves;
+    static int destructions;
+
+    static void reset()
+    {
+        copies = 0;
+        moves = 0;
+        destructions = 0;
+    }
+};
+
+int relocation_counters::copies = 0;
+int relocation_counters::moves = 0;
+int relocation_counters::destructions = 0;
+
+
+/// type with nothrow move constructor, should be moved on reallocation
+struct nothrow_movable
+{
+    explicit nothrow_movable(int v = 0) NESTL_NOEXCEPT_SPEC : value(v)
+    {
+    }
+
+    nothrow_movable(const nothrow_movable& other) NESTL_NOEXCEPT_SPEC : value(other.value)
+    {
+        ++relocation_counters::copies;
+    }
+
+    nothrow_movable(nothrow_movable&& other) NESTL_NOEXCEPT_SPEC : value(other.value)
+    {
+        ++relocation_counters::moves;
+    }
+
+    ~nothrow_movable() NESTL_NOEXCEPT_SPEC
+    {
+        ++relocation_counters::destructions;
+    }
+
+    int value;
+};
+
+
+/// type with potentially throwing move constructor, should be copied on reallocation
+struct throwing_movable
+{
+    explicit throwing_movable(int v = 0) NESTL_NOEXCEPT_SPEC : value(v)
+    {
+    }
+
+    throwing_movable(const throwing_movable& other) NESTL_NOEXCEPT_SPEC : value(other.value)
+    {
+        ++relocation_counters::copies;
+    }
+
+    throwing_movable(throwing_movable&& other) : value(other.value)
+    {
+        ++relocation_counters::moves;
+    }
+
+    ~throwing_movable() NESTL_NOEXCEPT_SPEC
+    {
+        ++relocation_counters::destructions;
+    }
+
+    int value;
+};
+
+
+/// type explicitly marked as trivially relocatable
+struct relocatable
+{
+    explicit relocatable(int v = 0) NESTL_NOEXCEPT_SPEC : value(v)
+    {
+    }
+
+    relocatable(const relocatable& other) NESTL_NOEXCEPT_SPEC : value(other.value)
+    {
+        ++relocation_counters::copies;
+    }
+
+    relocatable(relocatable&& other) NESTL_NOEXCEPT_SPEC : value(other.value)
+    {
+        ++relocation_counters::moves;
+    }
+
+    ~relocatable() NESTL_NOEXCEPT_SPEC
+    {
+        ++relocation_counters::destructions;
+    }
+
+    int value;
+};
+
+} // namespace
+
+} // namespace test
+
+
+template <>
+struct is_trivially_relocatable<nestl::test::relocatable> : public std::true_type
+{
+};
+
+
+namespace test
+{
+
+template <typename T>
+void CheckReserveRelocation(int expectedCopies, int expectedMoves, int expectedDestructions)
+{
+    const int count = 16;
+
+    nestl::vector<T> vec;
+    for (int i = 0; i < count; ++i)
+    {
+        NESTL_CHECK_OPERATION(vec.emplace_back_nothrow(_, i));
+    }
+
+    NESTL_CHECK_OPERATION(vec.shrink_to_fit_nothrow(_));
+
+    relocation_counters::reset();
+    NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, count * 4));
+
+    CheckVectorSize(vec, count);
+    for (int i = 0; i < count; ++i)
+    {
+        NESTL_CHECK_EQ(i, vec[i].value);
+    }
+
+    NESTL_CHECK_EQ(expectedCopies, relocation_counters::copies);
+    NESTL_CHECK_EQ(expectedMoves, relocation_counters::moves);
+    NESTL_CHECK_EQ(expectedDestructions, relocation_counters::destructions);
+}
+
+
+NESTL_ADD_TEST(vector_test_reserve)
+{
+    // trivially copyable values are preserved
+    {
+        nestl::vector<int> vec;
+        for (int i = 0; i < 100; ++i)
+        {
+            NESTL_CHECK_OPERATION(vec.push_back_nothrow(_, i));
+        }
+
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 1000));
+        CheckVectorSize(vec, 100);
+        NESTL_CHECK_EQ(true, vec.capacity() >= 1000);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            NESTL_CHECK_EQ(i, vec[i]);
+        }
+    }
+
+    // reserve less than capacity does nothing
+    {
+        nestl::vector<int> vec;
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 10));
+        const size_t capacity = vec.capacity();
+
+        NESTL_CHECK_OPERATION(vec.reserve_nothrow(_, 5));
+        NESTL_CHECK_EQ(capacity, vec.capacity());
+    }
+
+    const int count = 16;
+
+    // nothrow movable types are moved
+    CheckReserveRelocation<nothrow_movable>(0, count, count);
+
+    // types with throwing move constructor are copied
+    CheckReserveRelocation<throwing_movable>(count, 0, count);
+
+    // trivially relocatable types are neither copied nor moved nor destroyed
+    CheckReserveRelocation<relocatable>(0, 0, 0);
+}
+
+
+} // namespace test
+} // namespace nestl